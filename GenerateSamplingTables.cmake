@@ -0,0 +1,56 @@
+# Generates the tables used by the SIMD shuffling samplers in shuffling/opt_*/sample.c from the value of NTRU_N in
+# params.h: the start vector d[] and the rejection thresholds vt[] (65536 mod s). Each parameter set compiles the same
+# sample.c against its own sampling_tables.h. The thresholds are padded with zeros (i.e. never reject) to a whole number
+# of cache lines, and both tables are cache line aligned, so that vector loads starting at multiples of 16 entries never
+# straddle a cache line.
+set(SAMPLING_TABLES_PATH ${CMAKE_BINARY_DIR}/sampling_tables)
+set(SAMPLING_TABLES_ALIGNMENT 64)
+
+function(generate_sampling_tables PARAMETER_SET)
+    set(PARAMS_H ${CMAKE_SOURCE_DIR}/reference/Reference_Implementation/crypto_kem/ntru${PARAMETER_SET}/params.h)
+    set_property(DIRECTORY ${CMAKE_SOURCE_DIR} APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${PARAMS_H})
+
+    file(STRINGS ${PARAMS_H} NTRU_N_DEFINE REGEX "^#define NTRU_N [0-9]+")
+    string(REGEX REPLACE "^#define NTRU_N ([0-9]+).*" "\\1" NTRU_N "${NTRU_N_DEFINE}")
+
+    if(NOT NTRU_N MATCHES "^[0-9]+$")
+        message(FATAL_ERROR "Could not find the value of NTRU_N in ${PARAMS_H}")
+    endif()
+
+    math(EXPR ENTRIES_PER_LINE "${SAMPLING_TABLES_ALIGNMENT} / 2")
+    math(EXPR SAMPLING_TABLES_LEN
+        "(${NTRU_N} - 1 + ${ENTRIES_PER_LINE} - 1) / ${ENTRIES_PER_LINE} * ${ENTRIES_PER_LINE}")
+
+    set(START_VECTOR "")
+    foreach(I RANGE 15)
+        math(EXPR S "${NTRU_N} - 1 - ${I}")
+        list(APPEND START_VECTOR ${S})
+    endforeach()
+    string(REPLACE ";" ", " START_VECTOR "${START_VECTOR}")
+
+    set(THRESHOLDS "")
+    set(ROW "")
+    math(EXPR LAST "${SAMPLING_TABLES_LEN} - 1")
+    foreach(I RANGE ${LAST})
+        math(EXPR S "${NTRU_N} - 1 - ${I}")
+
+        if(S GREATER 0)
+            math(EXPR T "65536 % ${S}")
+        else()
+            set(T 0)
+        endif()
+
+        list(APPEND ROW ${T})
+        list(LENGTH ROW ROW_LEN)
+
+        if(ROW_LEN EQUAL 16)
+            string(REPLACE ";" ", " ROW "${ROW}")
+            string(APPEND THRESHOLDS "  ${ROW},\n")
+            set(ROW "")
+        endif()
+    endforeach()
+    string(REGEX REPLACE ",\n$" "" THRESHOLDS "${THRESHOLDS}")
+
+    configure_file(${CMAKE_SOURCE_DIR}/shuffling/sampling_tables.h.in
+        ${SAMPLING_TABLES_PATH}/ntru${PARAMETER_SET}/sampling_tables.h @ONLY)
+endfunction()
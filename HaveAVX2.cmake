@@ -0,0 +1,25 @@
+include(CheckCSourceRuns)
+
+# The AVX2 shuffling sampler is only built if the build host can run it; configure with -DHAVE_AVX2=OFF to leave it out
+# (e.g. to build binaries for older x86-64 cores)
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64)$")
+    set(CMAKE_REQUIRED_FLAGS -mavx2)
+    check_c_source_runs("
+#include <immintrin.h>
+
+int main() {
+    __m256i t = _mm256_set1_epi16(1);
+
+    if (!__builtin_cpu_supports(\"avx2\")) {
+        return 1;
+    }
+
+    t = _mm256_mulhi_epu16(t, t);
+
+    return _mm256_movemask_epi8(t);
+}
+" HAVE_AVX2)
+    unset(CMAKE_REQUIRED_FLAGS)
+else()
+    option(HAVE_AVX2 "builds the AVX2 shuffling sampler" OFF)
+endif()
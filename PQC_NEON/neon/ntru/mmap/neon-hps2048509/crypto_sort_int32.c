@@ -1 +0,0 @@
-../../stack/neon-hps2048509/crypto_sort_int32.c
\ No newline at end of file
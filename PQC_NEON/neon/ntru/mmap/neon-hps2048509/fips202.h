@@ -1 +0,0 @@
-../../stack/neon-hps2048509/fips202.h
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include <stddef.h>
+
 #include "kem.h"
 
 #include "api.h"
@@ -9,18 +11,32 @@
 #include "randombytes.h"
 #include "sample.h"
 
+// The expanded secret key of crypto_kem_sk_expand holds f, finv3 and invh in evaluated form, then the PRF key
+#define NTRU_SK_EXPANDED_PRFKEY (3 * sizeof(poly_expanded))
+
+// api.h gives the sizes of the expanded keys as numbers, which must cover poly_expanded and the layout above
+__extension__ _Static_assert(CRYPTO_PUBLICKEYEXPANDEDBYTES >= sizeof(poly_expanded),
+                             "CRYPTO_PUBLICKEYEXPANDEDBYTES cannot hold the expanded public key");
+__extension__ _Static_assert(CRYPTO_SECRETKEYEXPANDEDBYTES >= NTRU_SK_EXPANDED_PRFKEY + NTRU_PRFKEYBYTES,
+                             "CRYPTO_SECRETKEYEXPANDEDBYTES cannot hold the expanded secret key");
+
 // API FUNCTIONS
-int crypto_kem_keypair(unsigned char *pk, unsigned char *sk) {
+int crypto_kem_keypair_ctx(randombytes_ctx_t *ctx, unsigned char *pk, unsigned char *sk) {
     unsigned char seed[NTRU_SAMPLE_FG_BYTES];
 
-    randombytes(seed, NTRU_SAMPLE_FG_BYTES);
+    randombytes_ctx(ctx, seed, NTRU_SAMPLE_FG_BYTES);
     owcpa_keypair(pk, sk, seed);
 
-    randombytes(sk + NTRU_OWCPA_SECRETKEYBYTES, NTRU_PRFKEYBYTES);
+    randombytes_ctx(ctx, sk + NTRU_OWCPA_SECRETKEYBYTES, NTRU_PRFKEYBYTES);
 
     return 0;
 }
 
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk) {
+    return crypto_kem_keypair_ctx(NULL, pk, sk);
+}
+
+// Shared by all threads, like the buffers of owcpa.c: the mmap builds are not thread-safe (see api.h)
 static poly *r_, *m_;
 
 __attribute__((constructor)) static void alloc_r_m(void) {
@@ -28,42 +44,284 @@ __attribute__((constructor)) static void alloc_r_m(void) {
     m_ = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
 }
 
-int crypto_kem_enc(unsigned char *c, unsigned char *k, const unsigned char *pk) {
-    poly *r = r_, *m = m_;
+// Samples r and m, derives the shared secret k from them and lifts r to the ring, the part of
+// encapsulation that does not depend on the public key
+static void crypto_kem_enc_sample(randombytes_ctx_t *ctx, unsigned char *k, poly *r, poly *m) {
     unsigned char rm[NTRU_OWCPA_MSGBYTES];
+
+#ifdef SAMPLE_STREAM
+    // The samplers consume the random bytes as they are generated, see randombytes_stream_begin
+    randombytes_stream_begin(ctx, NTRU_SAMPLE_RM_BYTES);
+    sample_rm_stream(r, m, ctx);
+    randombytes_stream_end(ctx);
+#else
     unsigned char rm_seed[NTRU_SAMPLE_RM_BYTES];
 
-    randombytes(rm_seed, NTRU_SAMPLE_RM_BYTES);
+    randombytes_ctx(ctx, rm_seed, NTRU_SAMPLE_RM_BYTES);
 
     sample_rm(r, m, rm_seed);
+#endif
 
     poly_S3_tobytes(rm, r);
     poly_S3_tobytes(rm + NTRU_PACK_TRINARY_BYTES, m);
     crypto_hash_sha3256(k, rm, NTRU_OWCPA_MSGBYTES);
 
     poly_Z3_to_Zq(r);
+}
+
+int crypto_kem_enc_ctx(randombytes_ctx_t *ctx, unsigned char *c, unsigned char *k, const unsigned char *pk) {
+    poly *r = r_, *m = m_;
+
+    crypto_kem_enc_sample(ctx, k, r, m);
     owcpa_enc(c, r, m, pk);
 
     return 0;
 }
 
+int crypto_kem_enc(unsigned char *c, unsigned char *k, const unsigned char *pk) {
+    return crypto_kem_enc_ctx(NULL, c, k, pk);
+}
+
+int crypto_kem_pk_expand(unsigned char *pk_expanded, const unsigned char *pk) {
+    owcpa_pk_expand((poly_expanded *)pk_expanded, pk);
+
+    return 0;
+}
+
+int crypto_kem_enc_expanded_ctx(randombytes_ctx_t *ctx, unsigned char *c, unsigned char *k,
+                                const unsigned char *pk_expanded) {
+    poly *r = r_, *m = m_;
+
+    crypto_kem_enc_sample(ctx, k, r, m);
+    owcpa_enc_expanded(c, r, m, (const poly_expanded *)pk_expanded);
+
+    return 0;
+}
+
+int crypto_kem_enc_expanded(unsigned char *c, unsigned char *k, const unsigned char *pk_expanded) {
+    return crypto_kem_enc_expanded_ctx(NULL, c, k, pk_expanded);
+}
+
+// Derives the shared secret from the decrypted message rm, or from the PRF key and c if decryption failed
+static void crypto_kem_dec_finish(unsigned char *k, const unsigned char *c, const unsigned char *prfkey,
+                                  const unsigned char *rm, int fail) {
+    int i;
+    unsigned char k_rej[NTRU_SHAREDKEYBYTES];
+    unsigned char buf[NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES];
+
+    /* shake(secret PRF key || input ciphertext) */
+    for (i = 0; i < NTRU_PRFKEYBYTES; i++) buf[i] = prfkey[i];
+    for (i = 0; i < NTRU_CIPHERTEXTBYTES; i++) buf[NTRU_PRFKEYBYTES + i] = c[i];
+
+    /* Both hashes share one pass of a 2-way Keccak */
+    crypto_hash_sha3256_x2(k, k_rej, rm, NTRU_OWCPA_MSGBYTES, buf, NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES);
+
+    cmov(k, k_rej, NTRU_SHAREDKEYBYTES, (unsigned char)fail);
+}
+
 int crypto_kem_dec(unsigned char *k, const unsigned char *c, const unsigned char *sk) {
-    int i, fail;
+    int fail;
     unsigned char rm[NTRU_OWCPA_MSGBYTES];
-    unsigned char buf[NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES];
 
     fail = owcpa_dec(rm, c, sk);
     /* If fail = 0 then c = Enc(h, rm). There is no need to re-encapsulate. */
     /* See comment in owcpa_dec for details.                                */
 
-    crypto_hash_sha3256(k, rm, NTRU_OWCPA_MSGBYTES);
+    crypto_kem_dec_finish(k, c, sk + NTRU_OWCPA_SECRETKEYBYTES, rm, fail);
 
-    /* shake(secret PRF key || input ciphertext) */
-    for (i = 0; i < NTRU_PRFKEYBYTES; i++) buf[i] = sk[i + NTRU_OWCPA_SECRETKEYBYTES];
-    for (i = 0; i < NTRU_CIPHERTEXTBYTES; i++) buf[NTRU_PRFKEYBYTES + i] = c[i];
-    crypto_hash_sha3256(rm, buf, NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES);
+    return 0;
+}
+
+int crypto_kem_sk_expand(unsigned char *sk_expanded, const unsigned char *sk) {
+    int i;
+
+    owcpa_sk_expand((poly_expanded *)sk_expanded, sk);
+
+    /* The PRF key follows the expanded f, finv3 and invh */
+    for(i=0;i<NTRU_PRFKEYBYTES;i++)
+        sk_expanded[i+NTRU_SK_EXPANDED_PRFKEY] = sk[i+NTRU_OWCPA_SECRETKEYBYTES];
+
+    return 0;
+}
+
+int crypto_kem_dec_expanded(unsigned char *k, const unsigned char *c, const unsigned char *sk_expanded) {
+    int fail;
+    unsigned char rm[NTRU_OWCPA_MSGBYTES];
+
+    fail = owcpa_dec_expanded(rm, c, (const poly_expanded *)sk_expanded);
+    /* If fail = 0 then c = Enc(h, rm). There is no need to re-encapsulate. */
+    /* See comment in owcpa_dec for details.                                */
+
+    crypto_kem_dec_finish(k, c, sk_expanded + NTRU_SK_EXPANDED_PRFKEY, rm, fail);
+
+    return 0;
+}
+
+// Batched API: n independent operations whose keys, ciphertexts and shared secrets are stored back to back. This is a
+// grouping API: the operations are taken KEM_BATCH_LANES at a time and owcpa still runs on one lane after the other.
+// What a group shares is a single DRBG request for the random bytes of all its lanes, the multi-way Keccak for the
+// hashes and, in the shuffling builds, one call of the fixed-type sampler for all its messages; a batch therefore
+// consumes the RNG differently from n calls to the scalar functions. crypto_kem_keypair_batch_ctx inverts the f and gf
+// of all n keys with a single S3 and a single Rq inversion (see owcpa_keypair_batch_add).
+#define KEM_BATCH_LANES 8
+
+static poly *r_batch_, *m_batch_, *prod3_batch_, *prodq_batch_;
+
+__attribute__((constructor)) static void alloc_r_m_batch(void) {
+    r_batch_ = MEMORY_ALLOC(KEM_BATCH_LANES * 32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
+    m_batch_ = MEMORY_ALLOC(KEM_BATCH_LANES * 32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
+    prod3_batch_ = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
+    prodq_batch_ = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
+}
+
+// SHA3-256 of lanes messages of inlen bytes, four (then two) at a time
+static void crypto_hash_sha3256_lanes(size_t lanes, unsigned char *out, size_t outstride, const unsigned char *in,
+                                      size_t instride, size_t inlen) {
+    for (; lanes >= 4; lanes -= 4) {
+        crypto_hash_sha3256_x4(out, out + outstride, out + 2 * outstride, out + 3 * outstride, in, in + instride,
+                               in + 2 * instride, in + 3 * instride, inlen);
+        out += 4 * outstride;
+        in += 4 * instride;
+    }
+
+    if (lanes >= 2) {
+        crypto_hash_sha3256_x2(out, out + outstride, in, inlen, in + instride, inlen);
+        out += 2 * outstride;
+        in += 2 * instride;
+        lanes -= 2;
+    }
+
+    if (lanes) crypto_hash_sha3256(out, in, inlen);
+}
+
+// Samples the r and m of lanes encapsulations from a single request of lanes*NTRU_SAMPLE_RM_BYTES random bytes; lane
+// i reads the NTRU_SAMPLE_RM_BYTES at offset i*NTRU_SAMPLE_RM_BYTES, as sample_rm would
+static void crypto_kem_enc_batch_sample(randombytes_ctx_t *ctx, size_t lanes, poly *r, poly *m) {
+    size_t i;
+
+#ifdef SAMPLE_STREAM
+    randombytes_stream_begin(ctx, lanes * NTRU_SAMPLE_RM_BYTES);
+    for (i = 0; i < lanes; i++) {
+        sample_iid_stream(&r[i], ctx, i * NTRU_SAMPLE_RM_BYTES);
+        sample_fixed_type_stream(&m[i], ctx, i * NTRU_SAMPLE_RM_BYTES + NTRU_SAMPLE_IID_BYTES);
+    }
+    randombytes_stream_end(ctx);
+#else
+    unsigned char rm_seeds[KEM_BATCH_LANES][NTRU_SAMPLE_RM_BYTES];
+
+    randombytes_ctx(ctx, rm_seeds[0], lanes * sizeof(rm_seeds[0]));
+
+#ifdef SHUFFLING
+    poly *ms[KEM_BATCH_LANES];
+    const unsigned char *m_seeds[KEM_BATCH_LANES];
+
+    for (i = 0; i < lanes; i++) {
+        sample_iid(&r[i], rm_seeds[i]);
+        ms[i] = &m[i];
+        m_seeds[i] = rm_seeds[i] + NTRU_SAMPLE_IID_BYTES;
+    }
+    sample_fixed_type_xN(ms, m_seeds, lanes);
+#else
+    for (i = 0; i < lanes; i++) sample_rm(&r[i], &m[i], rm_seeds[i]);
+#endif
+#endif
+}
+
+int crypto_kem_keypair_batch_ctx(randombytes_ctx_t *ctx, size_t n, unsigned char *pk, unsigned char *sk) {
+    size_t i, j, k, lanes;
+    unsigned char seeds[KEM_BATCH_LANES][NTRU_SAMPLE_FG_BYTES + NTRU_PRFKEYBYTES];
+
+    if (n == 0)
+        return 0;
+
+    for (i = 0; i < n; i += lanes) {
+        lanes = n - i < KEM_BATCH_LANES ? n - i : KEM_BATCH_LANES;
+
+        randombytes_ctx(ctx, seeds[0], lanes * sizeof(seeds[0]));
+
+        for (j = 0; j < lanes; j++) {
+            owcpa_keypair_batch_add(prod3_batch_, prodq_batch_, i + j, pk + (i + j) * NTRU_PUBLICKEYBYTES,
+                                    sk + (i + j) * NTRU_SECRETKEYBYTES, seeds[j]);
+            for (k = 0; k < NTRU_PRFKEYBYTES; k++)
+                sk[(i + j) * NTRU_SECRETKEYBYTES + NTRU_OWCPA_SECRETKEYBYTES + k] = seeds[j][k + NTRU_SAMPLE_FG_BYTES];
+        }
+    }
+
+    owcpa_keypair_batch_finish(prod3_batch_, prodq_batch_, n, pk, NTRU_PUBLICKEYBYTES, sk, NTRU_SECRETKEYBYTES);
+
+    return 0;
+}
+
+int crypto_kem_keypair_batch(size_t n, unsigned char *pk, unsigned char *sk) {
+    return crypto_kem_keypair_batch_ctx(NULL, n, pk, sk);
+}
+
+int crypto_kem_enc_batch_ctx(randombytes_ctx_t *ctx, size_t n, unsigned char *c, unsigned char *k,
+                             const unsigned char *pk) {
+    size_t i, lanes;
+    poly *r = r_batch_, *m = m_batch_;
+    unsigned char rm[KEM_BATCH_LANES][NTRU_OWCPA_MSGBYTES];
+
+    for (; n > 0; n -= lanes) {
+        lanes = n < KEM_BATCH_LANES ? n : KEM_BATCH_LANES;
+
+        crypto_kem_enc_batch_sample(ctx, lanes, r, m);
+
+        for (i = 0; i < lanes; i++) {
+            poly_S3_tobytes(rm[i], &r[i]);
+            poly_S3_tobytes(rm[i] + NTRU_PACK_TRINARY_BYTES, &m[i]);
+        }
+
+        crypto_hash_sha3256_lanes(lanes, k, NTRU_SHAREDKEYBYTES, rm[0], NTRU_OWCPA_MSGBYTES, NTRU_OWCPA_MSGBYTES);
+
+        for (i = 0; i < lanes; i++) {
+            poly_Z3_to_Zq(&r[i]);
+            owcpa_enc(c + i * NTRU_CIPHERTEXTBYTES, &r[i], &m[i], pk + i * NTRU_PUBLICKEYBYTES);
+        }
+
+        c += lanes * NTRU_CIPHERTEXTBYTES;
+        k += lanes * NTRU_SHAREDKEYBYTES;
+        pk += lanes * NTRU_PUBLICKEYBYTES;
+    }
+
+    return 0;
+}
+
+int crypto_kem_enc_batch(size_t n, unsigned char *c, unsigned char *k, const unsigned char *pk) {
+    return crypto_kem_enc_batch_ctx(NULL, n, c, k, pk);
+}
+
+int crypto_kem_dec_batch(size_t n, unsigned char *k, const unsigned char *c, const unsigned char *sk) {
+    size_t i, j, lanes;
+    int fail[KEM_BATCH_LANES];
+    unsigned char rm[KEM_BATCH_LANES][NTRU_OWCPA_MSGBYTES];
+    unsigned char buf[KEM_BATCH_LANES][NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES];
+
+    for (; n > 0; n -= lanes) {
+        lanes = n < KEM_BATCH_LANES ? n : KEM_BATCH_LANES;
+
+        for (i = 0; i < lanes; i++)
+            fail[i] = owcpa_dec(rm[i], c + i * NTRU_CIPHERTEXTBYTES, sk + i * NTRU_SECRETKEYBYTES);
+
+        crypto_hash_sha3256_lanes(lanes, k, NTRU_SHAREDKEYBYTES, rm[0], NTRU_OWCPA_MSGBYTES, NTRU_OWCPA_MSGBYTES);
+
+        /* shake(secret PRF key || input ciphertext) */
+        for (i = 0; i < lanes; i++) {
+            for (j = 0; j < NTRU_PRFKEYBYTES; j++)
+                buf[i][j] = sk[i * NTRU_SECRETKEYBYTES + j + NTRU_OWCPA_SECRETKEYBYTES];
+            for (j = 0; j < NTRU_CIPHERTEXTBYTES; j++) buf[i][NTRU_PRFKEYBYTES + j] = c[i * NTRU_CIPHERTEXTBYTES + j];
+        }
+
+        crypto_hash_sha3256_lanes(lanes, rm[0], NTRU_OWCPA_MSGBYTES, buf[0], NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES,
+                                  NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES);
+
+        for (i = 0; i < lanes; i++)
+            cmov(k + i * NTRU_SHAREDKEYBYTES, rm[i], NTRU_SHAREDKEYBYTES, (unsigned char)fail[i]);
 
-    cmov(k, rm, NTRU_SHAREDKEYBYTES, (unsigned char)fail);
+        k += lanes * NTRU_SHAREDKEYBYTES;
+        c += lanes * NTRU_CIPHERTEXTBYTES;
+        sk += lanes * NTRU_SECRETKEYBYTES;
+    }
 
     return 0;
 }
@@ -0,0 +1 @@
+../../stack/neon-hps2048509/neon_z3_bitsliced.h
\ No newline at end of file
@@ -7,7 +7,7 @@ void poly_Sq_mul(poly *r, poly *a, poly *b)
   poly_mod_q_Phi_n(r);
 }
 
-void poly_S3_mul(poly *r, poly *a, poly *b)
+void poly_S3_mul_rq(poly *r, poly *a, poly *b)
 {
   /* Our S3 multiplications do not overflow mod q,    */
   /* so we can re-purpose poly_Rq_mul, as long as we  */
@@ -16,6 +16,15 @@ void poly_S3_mul(poly *r, poly *a, poly *b)
   poly_mod_3_Phi_n(r);
 }
 
+void poly_S3_mul(poly *r, poly *a, poly *b)
+{
+#ifdef S3_MUL_BITSLICED
+  poly_S3_mul_bitsliced(r, a, b);
+#else
+  poly_S3_mul_rq(r, a, b);
+#endif
+}
+
 static poly *b_, *c_, *s_;
 
 __attribute__((constructor)) static void alloc_R2_inv_to_Rq_inv(void) {
@@ -1 +0,0 @@
-../../stack/neon-hps2048509/randombytes.c
\ No newline at end of file
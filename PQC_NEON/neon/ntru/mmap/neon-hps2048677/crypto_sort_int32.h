@@ -1 +0,0 @@
-../../stack/neon-hps2048677/crypto_sort_int32.h
\ No newline at end of file
@@ -1 +0,0 @@
-../../stack/neon-hps2048677/fips202.c
\ No newline at end of file
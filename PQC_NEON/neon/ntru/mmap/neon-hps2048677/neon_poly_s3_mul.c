@@ -0,0 +1 @@
+../../stack/neon-hps2048677/neon_poly_s3_mul.c
\ No newline at end of file
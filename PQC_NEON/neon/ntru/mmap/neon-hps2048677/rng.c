@@ -1 +0,0 @@
-../../stack/neon-hps2048677/rng.c
\ No newline at end of file
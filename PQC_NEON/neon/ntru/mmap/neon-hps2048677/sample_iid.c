@@ -1 +0,0 @@
-../../stack/neon-hps2048677/sample_iid.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../stack/neon-hps4096821/crypto_sort_int32.c
\ No newline at end of file
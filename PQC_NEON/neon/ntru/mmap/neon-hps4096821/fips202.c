@@ -1 +0,0 @@
-../../stack/neon-hps4096821/fips202.c
\ No newline at end of file
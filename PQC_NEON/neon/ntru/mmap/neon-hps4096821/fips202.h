@@ -1 +0,0 @@
-../../stack/neon-hps4096821/fips202.h
\ No newline at end of file
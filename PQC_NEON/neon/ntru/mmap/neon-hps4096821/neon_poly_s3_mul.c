@@ -0,0 +1 @@
+../../stack/neon-hps4096821/neon_poly_s3_mul.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../stack/neon-hps4096821/neon_sample_iid.c
\ No newline at end of file
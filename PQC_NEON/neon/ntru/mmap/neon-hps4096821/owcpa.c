@@ -67,7 +67,7 @@ static int owcpa_check_m(const poly *m)
 
 static void alloc_kp(void);
 
-static poly *f_kp, *g_kp, *invf_mod3_kp, *gf_kp, *invgf_kp, *tmp1_kp, *tmp2_kp, *invh_kp, *h_kp;
+static poly *f_kp, *g_kp, *invf_mod3_kp, *gf_kp, *invgf_kp, *tmp1_kp, *tmp2_kp, *invh_kp, *h_kp, *inv3_kp, *invq_kp;
 
 __attribute__((constructor)) static void alloc_kp(void) {
   f_kp = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
@@ -79,6 +79,8 @@ __attribute__((constructor)) static void alloc_kp(void) {
   tmp2_kp = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
   invh_kp = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
   h_kp = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
+  inv3_kp = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
+  invq_kp = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
 }
 
 void owcpa_keypair(unsigned char *pk,
@@ -123,6 +125,148 @@ void owcpa_keypair(unsigned char *pk,
   poly_Sq_tobytes(sk+2*NTRU_PACK_TRINARY_BYTES, invh); // x3
 }
 
+void owcpa_keypair_batch_add(poly *prod3,
+                             poly *prodq,
+                             size_t i,
+                             unsigned char *pk,
+                             unsigned char *sk,
+                             const unsigned char seed[NTRU_SAMPLE_FG_BYTES])
+{
+  poly *f=f_kp, *g=g_kp, *gf=gf_kp, *tmp=tmp1_kp;
+
+  sample_fg(f,g,seed);
+
+  /* g stays in pk until owcpa_keypair_batch_finish replaces it with h */
+  poly_S3_tobytes(sk, f);
+  poly_S3_tobytes(pk, g);
+
+  /* The running products of the previous keys wait where invf_mod3 and invh will go */
+  if(i == 0)
+  {
+    *prod3 = *f;
+  }
+  else
+  {
+    poly_S3_tobytes(sk+NTRU_PACK_TRINARY_BYTES, prod3);
+    poly_Sq_tobytes(sk+2*NTRU_PACK_TRINARY_BYTES, prodq);
+
+    poly_S3_mul(tmp, prod3, f);
+    *prod3 = *tmp;
+  }
+
+  /* Lift coeffs of f and g from Z_p to Z_q */
+  poly_Z3_to_Zq(f);
+  poly_Z3_to_Zq(g);
+
+#ifdef NTRU_HRSS
+  /* g = 3*(x-1)*g */
+  polyhrss_mul3(g);
+#endif
+
+#ifdef NTRU_HPS
+  /* g = 3*g */
+  polyhps_mul3(g);
+#endif
+
+  poly_Rq_mul(gf, g, f);
+
+  if(i == 0)
+  {
+    *prodq = *gf;
+    poly_mod_q_Phi_n(prodq);
+  }
+  else
+  {
+    poly_Sq_mul(tmp, prodq, gf);
+    *prodq = *tmp;
+  }
+}
+
+void owcpa_keypair_batch_finish(poly *prod3,
+                                poly *prodq,
+                                size_t n,
+                                unsigned char *pk,
+                                size_t pkstride,
+                                unsigned char *sk,
+                                size_t skstride)
+{
+  size_t i;
+
+  poly *f=f_kp, *g=g_kp, *invf_mod3=invf_mod3_kp;
+  poly *gf=gf_kp, *invgf=invgf_kp, *tmp1=tmp1_kp, *tmp2=tmp2_kp;
+  poly *invh=invh_kp, *h=h_kp;
+  poly *inv3=inv3_kp, *invq=invq_kp;
+
+  /* The only two inversions of the batch */
+  poly_S3_inv(inv3, prod3);
+  poly_Rq_inv(invq, prodq);
+
+  pk += n*pkstride;
+  sk += n*skstride;
+
+  for(i=n; i-- > 0;)
+  {
+    pk -= pkstride;
+    sk -= skstride;
+
+    poly_S3_frombytes(f, sk);
+    poly_S3_frombytes(g, pk);
+
+    /* inv3 inverts f_0...f_i, the stashed f_0...f_{i-1} turns it into the inverse of f_i */
+    if(i == 0)
+    {
+      *invf_mod3 = *inv3;
+    }
+    else
+    {
+      poly_S3_frombytes(tmp1, sk+NTRU_PACK_TRINARY_BYTES);
+      poly_S3_mul(invf_mod3, inv3, tmp1);
+
+      poly_S3_mul(tmp1, inv3, f);
+      *inv3 = *tmp1;
+    }
+    poly_S3_tobytes(sk+NTRU_PACK_TRINARY_BYTES, invf_mod3);
+
+    /* Lift coeffs of f and g from Z_p to Z_q */
+    poly_Z3_to_Zq(f);
+    poly_Z3_to_Zq(g);
+
+#ifdef NTRU_HRSS
+    /* g = 3*(x-1)*g */
+    polyhrss_mul3(g);
+#endif
+
+#ifdef NTRU_HPS
+    /* g = 3*g */
+    polyhps_mul3(g);
+#endif
+
+    poly_Rq_mul(gf, g, f);
+
+    /* Likewise for invq and gf_0...gf_{i-1} */
+    if(i == 0)
+    {
+      *invgf = *invq;
+    }
+    else
+    {
+      poly_Sq_frombytes(tmp1, sk+2*NTRU_PACK_TRINARY_BYTES);
+      poly_Sq_mul(invgf, invq, tmp1);
+
+      poly_Sq_mul(tmp1, invq, gf);
+      *invq = *tmp1;
+    }
+
+    poly_Rq_mul(tmp1, invgf, f);
+    poly_Rq_mul(tmp2, invgf, g);
+    poly_Sq_mul(invh, tmp1, f);
+    poly_Rq_mul(h, tmp2, g);
+
+    poly_Rq_sum_zero_tobytes(pk, h); // x4
+    poly_Sq_tobytes(sk+2*NTRU_PACK_TRINARY_BYTES, invh); // x3
+  }
+}
+
 static void alloc_enc(void);
 
 static poly *h_enc, *ct_enc;
@@ -150,6 +294,30 @@ void owcpa_enc(unsigned char *c,
   poly_Rq_sum_zero_tobytes(c, ct);
 }
 
+void owcpa_pk_expand(poly_expanded *h,
+                     const unsigned char *pk)
+{
+  poly *b = h_enc;
+
+  poly_Rq_sum_zero_frombytes(b, pk);
+  poly_Rq_expand(h, b);
+}
+
+void owcpa_enc_expanded(unsigned char *c,
+                        poly *r,
+                        const poly *m,
+                        const poly_expanded *h)
+{
+  poly *ct = ct_enc;
+
+  poly_Rq_mul_expanded(ct, r, h);
+
+  // c += Lift(m);
+  poly_lift_add(ct, m);
+
+  poly_Rq_sum_zero_tobytes(c, ct);
+}
+
 static void alloc_dec(void);
 
 static poly *c_dec, *f_dec, *finv3_dec, *cf_dec, *mf_dec, *m_dec, *invh_dec, *r_dec, *b_dec;
@@ -226,3 +394,78 @@ int owcpa_dec(unsigned char *rm,
 
   return fail;
 }
+
+void owcpa_sk_expand(poly_expanded sk[3],
+                     const unsigned char *secretkey)
+{
+  poly *f = f_dec, *finv3 = finv3_dec, *invh = invh_dec;
+
+  poly_S3_frombytes(f, secretkey);
+  poly_Z3_to_Zq(f);
+  poly_Rq_expand(&sk[0], f);
+
+  poly_S3_frombytes(finv3, secretkey+NTRU_PACK_TRINARY_BYTES);
+  poly_Rq_expand(&sk[1], finv3);
+
+  poly_Sq_frombytes(invh, secretkey+2*NTRU_PACK_TRINARY_BYTES);
+  poly_Rq_expand(&sk[2], invh);
+}
+
+int owcpa_dec_expanded(unsigned char *rm,
+                       const unsigned char *ciphertext,
+                       const poly_expanded sk[3])
+{
+  int fail;
+
+  poly *c = c_dec, *cf = cf_dec;
+  poly *mf = mf_dec, *m = m_dec;
+  poly *r = r_dec;
+  poly *b = b_dec;
+
+  poly_Rq_sum_zero_frombytes(c, ciphertext);
+
+  poly_Rq_mul_expanded(cf, c, &sk[0]);
+  poly_Rq_to_S3(mf, cf);
+
+  poly_Rq_mul_expanded(m, mf, &sk[1]);
+  poly_mod_3_Phi_n(m);
+  poly_S3_tobytes(rm+NTRU_PACK_TRINARY_BYTES, m);
+
+  fail = 0;
+
+  /* Check that the unused bits of the last byte of the ciphertext are zero */
+  fail |= owcpa_check_ciphertext(ciphertext);
+
+  /* For the IND-CCA2 KEM we must ensure that c = Enc(h, (r,m)).             */
+  /* We can avoid re-computing r*h + Lift(m) as long as we check that        */
+  /* r (defined as b/h mod (q, Phi_n)) and m are in the message space.       */
+  /* (m can take any value in S3 in NTRU_HRSS) */
+#ifdef NTRU_HPS
+  fail |= owcpa_check_m(m);
+#endif
+
+  /* b = c - Lift(m) mod (q, x^n - 1) */
+  poly_lift_sub(b, c, m);
+
+  /* r = b / h mod (q, Phi_n) */
+  poly_Rq_mul_expanded(r, b, &sk[2]);
+  poly_mod_q_Phi_n(r);
+
+  /* NOTE: Our definition of r as b/h mod (q, Phi_n) follows Figure 4 of     */
+  /*   [Sch18] https://eprint.iacr.org/2018/1174/20181203:032458.            */
+  /* This differs from Figure 10 of Saito--Xagawa--Yamakawa                  */
+  /*   [SXY17] https://eprint.iacr.org/2017/1005/20180516:055500             */
+  /* where r gets a final reduction modulo p.                                */
+  /* We need this change to use Proposition 1 of [Sch18].                    */
+
+  /* Proposition 1 of [Sch18] shows that re-encryption with (r,m) yields c.  */
+  /* if and only if fail==0 after the following call to owcpa_check_r        */
+  /* The procedure given in Fig. 8 of [Sch18] can be skipped because we have */
+  /* c(1) = 0 due to the use of poly_Rq_sum_zero_{to,from}bytes.             */
+  fail |= owcpa_check_r(r);
+
+  poly_trinary_Zq_to_Z3(r);
+  poly_S3_tobytes(rm, r);
+
+  return fail;
+}
@@ -1 +0,0 @@
-../../stack/neon-hps4096821/randombytes.c
\ No newline at end of file
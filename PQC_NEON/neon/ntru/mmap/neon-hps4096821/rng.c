@@ -1 +0,0 @@
-../../stack/neon-hps4096821/rng.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../stack/neon-hps4096821/sample_iid.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../stack/neon-hrss701/fips202.c
\ No newline at end of file
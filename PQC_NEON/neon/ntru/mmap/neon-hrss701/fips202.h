@@ -1 +0,0 @@
-../../stack/neon-hrss701/fips202.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../stack/neon-hrss701/neon_sample_iid.c
\ No newline at end of file
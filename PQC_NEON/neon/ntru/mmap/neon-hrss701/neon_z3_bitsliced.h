@@ -0,0 +1 @@
+../../stack/neon-hrss701/neon_z3_bitsliced.h
\ No newline at end of file
@@ -1 +0,0 @@
-../../stack/neon-hrss701/randombytes.c
\ No newline at end of file
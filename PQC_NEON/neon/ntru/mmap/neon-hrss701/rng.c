@@ -1 +0,0 @@
-../../stack/neon-hrss701/rng.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../stack/neon-hrss701/sample_iid.c
\ No newline at end of file
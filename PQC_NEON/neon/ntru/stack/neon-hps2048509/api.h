@@ -1,10 +1,14 @@
 #ifndef API_H
 #define API_H
 
+#include <stddef.h>
+
 #define CRYPTO_SECRETKEYBYTES 935
 #define CRYPTO_PUBLICKEYBYTES 699
 #define CRYPTO_CIPHERTEXTBYTES 699
 #define CRYPTO_BYTES 32
+#define CRYPTO_PUBLICKEYEXPANDEDBYTES 6144
+#define CRYPTO_SECRETKEYEXPANDEDBYTES 18464
 
 #define CRYPTO_ALGNAME "ntruhps2048509"
 
@@ -17,4 +21,64 @@ int crypto_kem_enc(unsigned char *c, unsigned char *k, const unsigned char *pk);
 #define crypto_kem_dec CRYPTO_NAMESPACE(dec)
 int crypto_kem_dec(unsigned char *k, const unsigned char *c, const unsigned char *sk);
 
+// Variants of crypto_kem_keypair and crypto_kem_enc that draw random bytes from a caller-owned RNG state (see
+// randombytes_ctx); a NULL ctx selects the calling thread's default state. Decapsulation uses no randomness. The
+// mmap (AMX) builds keep their scratch polynomials in process-wide buffers, so no KEM call is thread-safe there,
+// with or without a context.
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+#define crypto_kem_keypair_ctx CRYPTO_NAMESPACE(keypair_ctx)
+int crypto_kem_keypair_ctx(randombytes_ctx_t *ctx, unsigned char *pk, unsigned char *sk);
+
+#define crypto_kem_enc_ctx CRYPTO_NAMESPACE(enc_ctx)
+int crypto_kem_enc_ctx(randombytes_ctx_t *ctx, unsigned char *c, unsigned char *k, const unsigned char *pk);
+
+// Encapsulation against a public key prepared once with crypto_kem_pk_expand, which unpacks it and evaluates it for
+// the polynomial multiplier. The CRYPTO_PUBLICKEYEXPANDEDBYTES buffer is read as 16-bit coefficients and must be
+// 2-byte aligned; its layout is specific to the implementation and is not meant to be stored or transmitted.
+// crypto_kem_enc_expanded_ctx draws its random bytes from ctx, as crypto_kem_enc_ctx does.
+#define crypto_kem_pk_expand CRYPTO_NAMESPACE(pk_expand)
+int crypto_kem_pk_expand(unsigned char *pk_expanded, const unsigned char *pk);
+
+#define crypto_kem_enc_expanded CRYPTO_NAMESPACE(enc_expanded)
+int crypto_kem_enc_expanded(unsigned char *c, unsigned char *k, const unsigned char *pk_expanded);
+
+#define crypto_kem_enc_expanded_ctx CRYPTO_NAMESPACE(enc_expanded_ctx)
+int crypto_kem_enc_expanded_ctx(randombytes_ctx_t *ctx, unsigned char *c, unsigned char *k,
+                                const unsigned char *pk_expanded);
+
+// Decapsulation with a secret key prepared once with crypto_kem_sk_expand, which unpacks f, 1/f mod 3 and 1/h mod q
+// and evaluates them for the polynomial multiplier. The same alignment and layout caveats as for the expanded
+// public key apply to the CRYPTO_SECRETKEYEXPANDEDBYTES buffer, which must be kept as secret as sk.
+#define crypto_kem_sk_expand CRYPTO_NAMESPACE(sk_expand)
+int crypto_kem_sk_expand(unsigned char *sk_expanded, const unsigned char *sk);
+
+#define crypto_kem_dec_expanded CRYPTO_NAMESPACE(dec_expanded)
+int crypto_kem_dec_expanded(unsigned char *k, const unsigned char *c, const unsigned char *sk_expanded);
+
+// Batched variants of crypto_kem_keypair, crypto_kem_enc and crypto_kem_dec for n independent operations. The i-th
+// public key, secret key, ciphertext and shared secret start at offset i times CRYPTO_PUBLICKEYBYTES,
+// CRYPTO_SECRETKEYBYTES, CRYPTO_CIPHERTEXTBYTES and CRYPTO_BYTES. The operations are grouped rather than run lane
+// parallel: only the random bytes, the hashes and the sampling of a group are shared. Randomness comes from ctx as
+// for the _ctx functions above (the calling thread's default state without one), but is drawn per group of
+// operations rather than per operation.
+#define crypto_kem_keypair_batch_ctx CRYPTO_NAMESPACE(keypair_batch_ctx)
+int crypto_kem_keypair_batch_ctx(randombytes_ctx_t *ctx, size_t n, unsigned char *pk, unsigned char *sk);
+
+#define crypto_kem_keypair_batch CRYPTO_NAMESPACE(keypair_batch)
+int crypto_kem_keypair_batch(size_t n, unsigned char *pk, unsigned char *sk);
+
+#define crypto_kem_enc_batch_ctx CRYPTO_NAMESPACE(enc_batch_ctx)
+int crypto_kem_enc_batch_ctx(randombytes_ctx_t *ctx, size_t n, unsigned char *c, unsigned char *k,
+                             const unsigned char *pk);
+
+#define crypto_kem_enc_batch CRYPTO_NAMESPACE(enc_batch)
+int crypto_kem_enc_batch(size_t n, unsigned char *c, unsigned char *k, const unsigned char *pk);
+
+#define crypto_kem_dec_batch CRYPTO_NAMESPACE(dec_batch)
+int crypto_kem_dec_batch(size_t n, unsigned char *k, const unsigned char *c, const unsigned char *sk);
+
 #endif
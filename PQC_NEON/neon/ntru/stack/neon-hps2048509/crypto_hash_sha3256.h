@@ -2,8 +2,11 @@
 #define CRYPTO_HASH_SHA3256
 
 #include "fips202.h"
+#include "fips202x.h"
 
 #define crypto_hash_sha3256 sha3_256
+#define crypto_hash_sha3256_x2 sha3_256_x2
+#define crypto_hash_sha3256_x4 sha3_256_x4
 #define crypto_hash_sha3512 sha3_512
 #define crypto_hash_shake256 shake256
 
@@ -18,168 +18,56 @@ limitations under the License.
 
 =============================================================================*/
 #include <arm_neon.h>
+#include <string.h>
 #include "sample.h"
 
-#if defined(__clang__)
+// Coefficients per call of sample_iid_x32. The last (NTRU_N - 1) % 32 are sampled from a zero-padded copy of the
+// uniform bytes, so that no byte past uniformbytes[NTRU_N - 2] is read and no coefficient past r[NTRU_N - 2] written
+#define SAMPLE_IID_BLOCK 32
+#define SAMPLE_IID_TAIL ((NTRU_N - 1) % SAMPLE_IID_BLOCK)
 
-// load c <= a
-#define sp_vload(c, a) c = vld1q_u16_x4(a);
-
-#elif defined(__GNUC__)
-
-// load c <= a
-#define sp_vload(c, a)          \
-    c.val[0] = vld1q_u16(a);      \
-    c.val[1] = vld1q_u16(a + 8);  \
-    c.val[2] = vld1q_u16(a + 16); \
-    c.val[3] = vld1q_u16(a + 24);
-
-#else
-#error "Unsupported compiler"
-#endif
-
-
-// store c <= a
-#define sp_vstore(c, a)                       \
-    vst1q_u16(c +  0, (uint16x8_t) a.val[0]); \
-    vst1q_u16(c +  8, (uint16x8_t) a.val[1]); \
-    vst1q_u16(c + 16, (uint16x8_t) a.val[2]); \
-    vst1q_u16(c + 24, (uint16x8_t) a.val[3]);
-
-// c = a >> value
-#define sp_vsr(c, a, value)                  \
-    c.val[0] = vshrq_n_u16(a.val[0], value); \
-    c.val[1] = vshrq_n_u16(a.val[1], value); \
-    c.val[2] = vshrq_n_u16(a.val[2], value); \
-    c.val[3] = vshrq_n_u16(a.val[3], value);
-
-// c = a >> value
-#define sp_vsr_sign(c, a, value)             \
-    c.val[0] = vshrq_n_s16(a.val[0], value); \
-    c.val[1] = vshrq_n_s16(a.val[1], value); \
-    c.val[2] = vshrq_n_s16(a.val[2], value); \
-    c.val[3] = vshrq_n_s16(a.val[3], value);
-
-// c = a << value
-#define sp_vsl(c, a, value)                  \
-    c.val[0] = vshlq_n_u16(a.val[0], value); \
-    c.val[1] = vshlq_n_u16(a.val[1], value); \
-    c.val[2] = vshlq_n_u16(a.val[2], value); \
-    c.val[3] = vshlq_n_u16(a.val[3], value);
-
-// c = a & const
-#define sp_vand_const(c, a, b)         \
-    c.val[0] = vandq_u16(a.val[0], b); \
-    c.val[1] = vandq_u16(a.val[1], b); \
-    c.val[2] = vandq_u16(a.val[2], b); \
-    c.val[3] = vandq_u16(a.val[3], b);
-
-// c = a & b
-#define sp_vand_sign(c, a, b)                 \
-    c.val[0] = vandq_s16(a.val[0], (int16x8_t) b.val[0]); \
-    c.val[1] = vandq_s16(a.val[1], (int16x8_t) b.val[1]); \
-    c.val[2] = vandq_s16(a.val[2], (int16x8_t) b.val[2]); \
-    c.val[3] = vandq_s16(a.val[3], (int16x8_t) b.val[3]);
-
-// c = a + b
-#define sp_vadd(c, a, b)                      \
-    c.val[0] = vaddq_u16(a.val[0], b.val[0]); \
-    c.val[1] = vaddq_u16(a.val[1], b.val[1]); \
-    c.val[2] = vaddq_u16(a.val[2], b.val[2]); \
-    c.val[3] = vaddq_u16(a.val[3], b.val[3]);
-
-// c = a - b
-#define sp_vsub_const_sign(c, a, b)    \
-    c.val[0] = vsubq_s16( (int16x8_t) a.val[0], (int16x8_t) b); \
-    c.val[1] = vsubq_s16( (int16x8_t) a.val[1], (int16x8_t) b); \
-    c.val[2] = vsubq_s16( (int16x8_t) a.val[2], (int16x8_t) b); \
-    c.val[3] = vsubq_s16( (int16x8_t) a.val[3], (int16x8_t) b);
-
-// c = a - const
-#define sp_vsub_const(c, a, b)         \
-    c.val[0] = vsubq_u16(a.val[0], b); \
-    c.val[1] = vsubq_u16(a.val[1], b); \
-    c.val[2] = vsubq_u16(a.val[2], b); \
-    c.val[3] = vsubq_u16(a.val[3], b);
-
-// c = a ^ b
-#define sp_vxor_sign(c, a, b)                 \
-    c.val[0] = veorq_s16(a.val[0], b.val[0]); \
-    c.val[1] = veorq_s16(a.val[1], b.val[1]); \
-    c.val[2] = veorq_s16(a.val[2], b.val[2]); \
-    c.val[3] = veorq_s16(a.val[3], b.val[3]);
+// Same reduction as mod3 in the reference sample_iid.c, on 8-bit lanes. Since 16 = 4 = 1 mod 3, each fold keeps a
+// mod 3, and brings a down to at most 30, 9 and 4. The minimum of a and a - 3 (mod 256) is then a mod 3.
+static inline uint8x16_t mod3_x16(uint8x16_t a)
+{
+    const uint8x16_t hex_0x03 = vdupq_n_u8(0x03), hex_0x0f = vdupq_n_u8(0x0f);
 
-// c = a ^ b
-#define sp_vxor_const(c, a, b)         \
-    c.val[0] = veorq_u16(a.val[0], b); \
-    c.val[1] = veorq_u16(a.val[1], b); \
-    c.val[2] = veorq_u16(a.val[2], b); \
-    c.val[3] = veorq_u16(a.val[3], b);
+    // a = (a >> 4) + (a & 0xf)
+    a = vaddq_u8(vshrq_n_u8(a, 4), vandq_u8(a, hex_0x0f));
+    // a = (a >> 2) + (a & 0x3), twice
+    a = vaddq_u8(vshrq_n_u8(a, 2), vandq_u8(a, hex_0x03));
+    a = vaddq_u8(vshrq_n_u8(a, 2), vandq_u8(a, hex_0x03));
 
-// c = ~a
-#define sp_vnot_sign(c, a)          \
-    c.val[0] = vmvnq_s16(a.val[0]); \
-    c.val[1] = vmvnq_s16(a.val[1]); \
-    c.val[2] = vmvnq_s16(a.val[2]); \
-    c.val[3] = vmvnq_s16(a.val[3]);
+    return vminq_u8(a, vsubq_u8(a, hex_0x03));
+}
 
-// c = value
-#define sp_vdup_x1(c, value) c = vdupq_n_u16(value);
+static inline void sample_iid_x32(uint16_t *r, const uint8_t *uniformbytes)
+{
+    uint8x16_t a0 = mod3_x16(vld1q_u8(uniformbytes));
+    uint8x16_t a1 = mod3_x16(vld1q_u8(uniformbytes + 16));
 
+    vst1q_u16(r +  0, vmovl_u8(vget_low_u8(a0)));
+    vst1q_u16(r +  8, vmovl_high_u8(a0));
+    vst1q_u16(r + 16, vmovl_u8(vget_low_u8(a1)));
+    vst1q_u16(r + 24, vmovl_high_u8(a1));
+}
 
 void sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES])
 {
-    // 35 SIMD registers
-    uint16x8x4_t r1, r2, r3;
-    uint8x16x2_t r_buf;
-    int16x8x4_t t, c, a, b;
-    uint16x8_t hex_0x03, hex_0x0f, hex_0xff;
-    sp_vdup_x1(hex_0x03, 0x03);
-    sp_vdup_x1(hex_0xff, 0xff);
-    sp_vdup_x1(hex_0x0f, 0x0f);
-
-    for (uint16_t addr = 0; addr < NTRU_N_32; addr += 32)
-    {
-        r_buf = vld1q_u8_x2(&uniformbytes[addr]);
-        r3.val[0] = vshll_n_u8(vget_low_u8(r_buf.val[0]), 0);
-        r3.val[1] = vshll_high_n_u8(r_buf.val[0], 0);
-        r3.val[2] = vshll_n_u8(vget_low_u8(r_buf.val[1]), 0);
-        r3.val[3] = vshll_high_n_u8(r_buf.val[1], 0);
- 
-        // r3 = (res >> 8) + (res & 0xff)
-        sp_vsr(r1, r3, 8);
-        sp_vand_const(r2, r3, hex_0xff);
-        sp_vadd(r3, r1, r2);
-
-        // r3 = (r3 >> 4) + (r3 & 0xf)
-        sp_vsr(r1, r3, 4);
-        sp_vand_const(r2, r3, hex_0x0f);
-        sp_vadd(r3, r1, r2);
+    int i;
 
-        // r3 = (r3 >> 2) + (r3 & 0x3)
-        sp_vsr(r1, r3, 2);
-        sp_vand_const(r2, r3, hex_0x03);
-        sp_vadd(r3, r1, r2);
+    /* {0,1,...,255} -> {0,1,2}; Pr[0] = 86/256, Pr[1] = Pr[-1] = 85/256 */
+    for (i = 0; i + SAMPLE_IID_BLOCK <= NTRU_N - 1; i += SAMPLE_IID_BLOCK)
+        sample_iid_x32(&r->coeffs[i], &uniformbytes[i]);
 
-        // r3 = (r3 >> 2) + (r3 & 0x3)
-        sp_vsr(r1, r3, 2);
-        sp_vand_const(r2, r3, hex_0x03);
-        sp_vadd(r3, r1, r2);
+#if SAMPLE_IID_TAIL != 0
+    uint8_t tail_bytes[SAMPLE_IID_BLOCK] = {0};
+    uint16_t tail_coeffs[SAMPLE_IID_BLOCK];
 
-        // t = r3 - 3
-        sp_vsub_const_sign(t, r3, hex_0x03);
-        // c = t >> 15
-        sp_vsr_sign(c, t, 15);
-
-        // a = c & r3
-        sp_vand_sign(a, c, r3);
-        // b = ~c & t
-        sp_vnot_sign(b, c);
-        sp_vand_sign(b, b, t);
-        // c = a ^ b
-        sp_vxor_sign(c, a, b);
+    memcpy(tail_bytes, &uniformbytes[i], SAMPLE_IID_TAIL);
+    sample_iid_x32(tail_coeffs, tail_bytes);
+    memcpy(&r->coeffs[i], tail_coeffs, SAMPLE_IID_TAIL * sizeof(uint16_t));
+#endif
 
-        sp_vstore(&r->coeffs[addr], c);
-    }
     r->coeffs[NTRU_N - 1] = 0;
 }
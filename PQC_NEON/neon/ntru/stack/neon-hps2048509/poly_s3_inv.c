@@ -1,6 +1,7 @@
 /* Based on supercop-20200702/crypto_core/invhrss701/simpler/core.c */
 
 #include "poly.h"
+#include "neon_z3_bitsliced.h"
 
 #include <arm_neon.h>
 
@@ -21,99 +22,7 @@ static inline int16_t both_negative_mask(int16_t x, int16_t y) {
     return (x & y) >> 15;
 }
 
-// unsigned Z3
-static inline void mul_Z3_bitsliced(uint64_t *ptr_clo, uint64_t *ptr_chi,
-    uint64_t *ptr_alo, uint64_t *ptr_ahi, uint64_t *ptr_blo, uint64_t *ptr_bhi){
-
-    uint64_t alo, ahi;
-    uint64_t blo, bhi;
-    uint64_t nonzero;
-    uint64_t t;
-
-    alo = *ptr_alo;
-    ahi = *ptr_ahi;
-    blo = *ptr_blo;
-    bhi = *ptr_bhi;
-
-    nonzero = blo | bhi;
-    t = bhi & (alo ^ ahi);
-    alo ^= t;
-    ahi ^= t;
-
-    *ptr_clo = alo & nonzero;
-    *ptr_chi = ahi & nonzero;
-
-}
-
-static inline void mul_Z3_bitsliced_uint8x16(uint8x16_t *ptr_clo, uint8x16_t *ptr_chi,
-    uint8x16_t *ptr_alo, uint8x16_t *ptr_ahi, uint8x16_t *ptr_blo, uint8x16_t *ptr_bhi){
-
-    uint8x16_t alo, ahi;
-    uint8x16_t blo, bhi;
-    uint8x16_t nonzero;
-    uint8x16_t t;
-
-    alo = *ptr_alo;
-    ahi = *ptr_ahi;
-    blo = *ptr_blo;
-    bhi = *ptr_bhi;
-
-    nonzero = blo | bhi;
-    t = bhi & (alo ^ ahi);
-    alo ^= t;
-    ahi ^= t;
-
-    *ptr_clo = alo & nonzero;
-    *ptr_chi = ahi & nonzero;
-
-}
-
-// unsigned Z3
-static inline void add_Z3_bitsliced(uint64_t *ptr_clo, uint64_t *ptr_chi,
-    uint64_t *ptr_alo, uint64_t *ptr_ahi, uint64_t *ptr_blo, uint64_t *ptr_bhi){
-
-    uint64_t alo, ahi;
-    uint64_t blo, bhi;
-    uint64_t t0, t1, t2, t3;
-
-    alo = *ptr_alo;
-    ahi = *ptr_ahi;
-    blo = *ptr_blo;
-    bhi = *ptr_bhi;
-
-    t0 = (~ahi) & (~bhi);
-    t1 = t0 & alo;
-    t2 = (~alo) & (~blo);
-    t3 = t2 & ahi;
-
-    *ptr_clo = (t0 & (~alo) & (blo)) | (t1 & (~blo) ) | (t3 & ( bhi));
-    *ptr_chi = (t2 & (~ahi) & (bhi)) | (t1 & ( blo) ) | (t3 & (~bhi));
-
-}
-
-static inline void add_Z3_bitsliced_uint8x16(uint8x16_t *ptr_clo, uint8x16_t *ptr_chi,
-    uint8x16_t *ptr_alo, uint8x16_t *ptr_ahi, uint8x16_t *ptr_blo, uint8x16_t *ptr_bhi){
-
-    uint8x16_t alo, ahi;
-    uint8x16_t blo, bhi;
-    uint8x16_t t0, t1, t2, t3;
-
-    alo = *ptr_alo;
-    ahi = *ptr_ahi;
-    blo = *ptr_blo;
-    bhi = *ptr_bhi;
-
-    t0 = (~ahi) & (~bhi);
-    t1 = t0 & alo;
-    t2 = (~alo) & (~blo);
-    t3 = t2 & ahi;
-
-    *ptr_clo = (t0 & (~alo) & (blo)) | (t1 & (~blo) ) | (t3 & ( bhi));
-    *ptr_chi = (t2 & (~ahi) & (bhi)) | (t1 & ( blo) ) | (t3 & (~bhi));
-
-}
-
-void poly_S3_inv(poly *r, const poly *a) {
+void poly_S3_inv_divstep(poly *r, const poly *a) {
 
     uint64_t flo[BITARRAY_SIZE], fhi[BITARRAY_SIZE];
     uint64_t glo[BITARRAY_SIZE], ghi[BITARRAY_SIZE];
@@ -330,3 +239,385 @@ void poly_S3_inv(poly *r, const poly *a) {
     }
     r->coeffs[NTRU_N - 1] = 0;
 }
+
+/* Jump divsteps. The swaps and signs of the next 64 divsteps only depend on delta and on the 64 low trits of f    */
+/* and g, so they are computed first on one word of each, as the factors of the 2x2 transition matrix of the      */
+/* block. The factors are then applied to f and g (from the top word down, as g moves right) and to v and w (from */
+/* the bottom word up, as v moves left) in groups of four words that stay in registers for the whole block. Word   */
+/* k of a group runs k divsteps behind the first one, so that it takes the trit that its neighbour has just        */
+/* shifted out, and the four words of a group are independent from each other at each round. f and g only need    */
+/* as many trits as there are divsteps left, and v and w have degree at most the number of divsteps done, so the  */
+/* blocks skip the words out of these bounds. The bounds only depend on n.                                         */
+
+#define JUMP_STEPS 64
+#define JUMP_GROUP 4
+#define JUMP_WORDS(trits) ((trits) + 63 < 64 * BITARRAY_SIZE ? ((trits) + 63) / 64 : BITARRAY_SIZE)
+
+/* One divstep on (x, y) = (f, g) or (v, w), short of the shifts: swap x and y, then y += sign * x. The additions */
+/* take six operations in the (is 1, is 2) representation. Works on uint64_t as well as on uint64x2_t            */
+#define S3_JUMP_STEP(xlo, xhi, ylo, yhi, swap, signlo, signhi, t, blo, bhi) do { \
+    t = (swap) & ((xlo) ^ (ylo)); \
+    xlo ^= t; \
+    ylo ^= t; \
+    t = (swap) & ((xhi) ^ (yhi)); \
+    xhi ^= t; \
+    yhi ^= t; \
+    blo = ((signlo) & (xlo)) | ((signhi) & (xhi)); \
+    bhi = ((signlo) & (xhi)) | ((signhi) & (xlo)); \
+    t = ((yhi) | blo) ^ ((ylo) | bhi); \
+    blo = ((ylo) | blo) ^ t; \
+    ylo = ((yhi) | bhi) ^ t; \
+    yhi = blo; \
+} while(0)
+
+typedef struct {
+    /* The masks of divstep s of the block at index s, and at index steps - 1 - s in the rev arrays */
+    uint64_t swap[JUMP_STEPS], signlo[JUMP_STEPS], signhi[JUMP_STEPS];
+    uint64_t swaprev[JUMP_STEPS], signlorev[JUMP_STEPS], signhirev[JUMP_STEPS];
+    size_t steps;
+} s3_jump;
+
+/* The swap and sign masks of the next steps divsteps, from the low words of f and g */
+static void s3_jump_masks(s3_jump *j, int16_t *delta, uint64_t flo, uint64_t fhi, uint64_t glo, uint64_t ghi) {
+
+    uint64_t t, blo, bhi;
+    size_t s;
+    int16_t sign, swap;
+    uint8_t f0, g0;
+
+    for(s = 0; s < j->steps; s++){
+        g0 = (glo & 1) | ((ghi & 1) << 1);
+        f0 = (flo & 1) | ((fhi & 1) << 1);
+
+        sign = mod3((uint8_t) (2 * g0 * f0));
+        swap = both_negative_mask(-*delta, -(int16_t) g0);
+        *delta ^= swap & (*delta ^ -*delta);
+        *delta += 1;
+
+        j->swap[s] = (uint64_t)(int64_t)swap;
+        j->signlo[s] = -(uint64_t)(sign & 1);
+        j->signhi[s] = -(uint64_t)((sign & 2) >> 1);
+        j->swaprev[j->steps - 1 - s] = j->swap[s];
+        j->signlorev[j->steps - 1 - s] = j->signlo[s];
+        j->signhirev[j->steps - 1 - s] = j->signhi[s];
+
+        S3_JUMP_STEP(flo, fhi, glo, ghi, j->swap[s], j->signlo[s], j->signhi[s], t, blo, bhi);
+
+        glo >>= 1;
+        ghi >>= 1;
+    }
+}
+
+/* Round p on the group of words top, top - 1, ..., top - size + 1 of f and g, one word at a time. c[k] is the    */
+/* trit shifted into word top - k, at bit 63, bit s of rec the trit shifted out of the last word at divstep s    */
+static void s3_jump_fg_round(uint64_t *flo, uint64_t *fhi, uint64_t *glo, uint64_t *ghi, size_t top, size_t size,
+    const s3_jump *j, size_t p, uint64_t clo[JUMP_GROUP + 1], uint64_t chi[JUMP_GROUP + 1], uint64_t *reclo, uint64_t *rechi) {
+
+    uint64_t xlo, xhi, ylo, yhi, t, blo, bhi;
+    size_t k, s;
+
+    for(k = size; k-- > 0;){
+        s = p - k;
+        if(p < k || s >= j->steps){
+            continue;
+        }
+        xlo = flo[top - k];
+        xhi = fhi[top - k];
+        ylo = glo[top - k];
+        yhi = ghi[top - k];
+        S3_JUMP_STEP(xlo, xhi, ylo, yhi, j->swap[s], j->signlo[s], j->signhi[s], t, blo, bhi);
+        flo[top - k] = xlo;
+        fhi[top - k] = xhi;
+        glo[top - k] = (ylo >> 1) | clo[k];
+        ghi[top - k] = (yhi >> 1) | chi[k];
+        clo[k + 1] = ylo << 63;
+        chi[k + 1] = yhi << 63;
+    }
+    if(p >= size - 1 && p - (size - 1) < j->steps){
+        *reclo |= (clo[size] >> 63) << (p - (size - 1));
+        *rechi |= (chi[size] >> 63) << (p - (size - 1));
+    }
+}
+
+/* The block on the first words of f and g */
+static void s3_jump_fg(uint64_t *flo, uint64_t *fhi, uint64_t *glo, uint64_t *ghi, size_t words, const s3_jump *j) {
+
+    uint64_t inlo, inhi, reclo, rechi;
+    uint64_t clo[JUMP_GROUP + 1], chi[JUMP_GROUP + 1];
+    uint64x2_t xlo[2], xhi[2], ylo[2], yhi[2], tl, blol, bhil;
+    uint64x2_t swapl, signlol, signhil;
+    uint64x2_t inlol, inhil, clol[2], chil[2], lowlo[2], lowhi[2], reclol, rechil;
+    size_t end, top, size, p, g;
+
+    inlo = 0;
+    inhi = 0;
+
+    for(end = words; end > 0; end -= size){
+        size = end < JUMP_GROUP ? end : JUMP_GROUP;
+        top = end - 1;
+        reclo = 0;
+        rechi = 0;
+
+        for(p = 0; p < j->steps + size - 1; p++){
+            if(size == JUMP_GROUP && p == JUMP_GROUP - 1 && j->steps >= JUMP_GROUP){
+                /* The rounds where the four words are busy, on (top - 1, top) and (top - 3, top - 2) */
+                for(g = 0; g < 2; g++){
+                    xlo[g] = vld1q_u64(flo + top - 2 * g - 1);
+                    xhi[g] = vld1q_u64(fhi + top - 2 * g - 1);
+                    ylo[g] = vld1q_u64(glo + top - 2 * g - 1);
+                    yhi[g] = vld1q_u64(ghi + top - 2 * g - 1);
+                }
+                inlol = vdupq_n_u64(inlo >> p);
+                inhil = vdupq_n_u64(inhi >> p);
+                clol[0] = vsetq_lane_u64(inlo >> p << 63, vdupq_n_u64(clo[1]), 1);
+                chil[0] = vsetq_lane_u64(inhi >> p << 63, vdupq_n_u64(chi[1]), 1);
+                clol[1] = vsetq_lane_u64(clo[2], vdupq_n_u64(clo[3]), 1);
+                chil[1] = vsetq_lane_u64(chi[2], vdupq_n_u64(chi[3]), 1);
+                reclol = vdupq_n_u64(0);
+                rechil = vdupq_n_u64(0);
+
+                for(; p < j->steps; p++){
+                    for(g = 0; g < 2; g++){
+                        swapl = vld1q_u64(j->swap + p - 2 * g - 1);
+                        signlol = vld1q_u64(j->signlo + p - 2 * g - 1);
+                        signhil = vld1q_u64(j->signhi + p - 2 * g - 1);
+                        S3_JUMP_STEP(xlo[g], xhi[g], ylo[g], yhi[g], swapl, signlol, signhil, tl, blol, bhil);
+                        lowlo[g] = vshlq_n_u64(ylo[g], 63);
+                        lowhi[g] = vshlq_n_u64(yhi[g], 63);
+                        ylo[g] = vshrq_n_u64(ylo[g], 1) | clol[g];
+                        yhi[g] = vshrq_n_u64(yhi[g], 1) | chil[g];
+                    }
+                    reclol = vshrq_n_u64(reclol, 1) | lowlo[1];
+                    rechil = vshrq_n_u64(rechil, 1) | lowhi[1];
+
+                    inlol = vshrq_n_u64(inlol, 1);
+                    inhil = vshrq_n_u64(inhil, 1);
+                    clol[0] = vextq_u64(lowlo[0], vshlq_n_u64(inlol, 63), 1);
+                    chil[0] = vextq_u64(lowhi[0], vshlq_n_u64(inhil, 63), 1);
+                    clol[1] = vextq_u64(lowlo[1], lowlo[0], 1);
+                    chil[1] = vextq_u64(lowhi[1], lowhi[0], 1);
+                }
+
+                for(g = 0; g < 2; g++){
+                    vst1q_u64(flo + top - 2 * g - 1, xlo[g]);
+                    vst1q_u64(fhi + top - 2 * g - 1, xhi[g]);
+                    vst1q_u64(glo + top - 2 * g - 1, ylo[g]);
+                    vst1q_u64(ghi + top - 2 * g - 1, yhi[g]);
+                }
+                clo[1] = vgetq_lane_u64(clol[0], 0);
+                chi[1] = vgetq_lane_u64(chil[0], 0);
+                clo[2] = vgetq_lane_u64(clol[1], 1);
+                chi[2] = vgetq_lane_u64(chil[1], 1);
+                clo[3] = vgetq_lane_u64(clol[1], 0);
+                chi[3] = vgetq_lane_u64(chil[1], 0);
+                reclo = vgetq_lane_u64(reclol, 0) >> (JUMP_STEPS - (j->steps - (JUMP_GROUP - 1)));
+                rechi = vgetq_lane_u64(rechil, 0) >> (JUMP_STEPS - (j->steps - (JUMP_GROUP - 1)));
+            }
+
+            clo[0] = p < j->steps ? inlo >> p << 63 : 0;
+            chi[0] = p < j->steps ? inhi >> p << 63 : 0;
+            s3_jump_fg_round(flo, fhi, glo, ghi, top, size, j, p, clo, chi, &reclo, &rechi);
+        }
+
+        inlo = reclo;
+        inhi = rechi;
+    }
+}
+
+/* Round p on the group of words bottom, bottom + 1, ..., bottom + size - 1 of v and w, one word at a time. c[k] */
+/* is the trit shifted into word bottom + k, at bit 0, bit s of rec the trit shifted out of the last word at      */
+/* divstep s                                                                                                      */
+static void s3_jump_vw_round(uint64_t *vlo, uint64_t *vhi, uint64_t *wlo, uint64_t *whi, size_t bottom, size_t size,
+    const s3_jump *j, size_t p, uint64_t clo[JUMP_GROUP + 1], uint64_t chi[JUMP_GROUP + 1], uint64_t *reclo, uint64_t *rechi) {
+
+    uint64_t xlo, xhi, ylo, yhi, t, blo, bhi;
+    size_t k, s;
+
+    for(k = size; k-- > 0;){
+        s = p - k;
+        if(p < k || s >= j->steps){
+            continue;
+        }
+        xlo = vlo[bottom + k];
+        xhi = vhi[bottom + k];
+        ylo = wlo[bottom + k];
+        yhi = whi[bottom + k];
+        clo[k + 1] = xlo >> 63;
+        chi[k + 1] = xhi >> 63;
+        xlo = (xlo << 1) | clo[k];
+        xhi = (xhi << 1) | chi[k];
+        S3_JUMP_STEP(xlo, xhi, ylo, yhi, j->swap[s], j->signlo[s], j->signhi[s], t, blo, bhi);
+        vlo[bottom + k] = xlo;
+        vhi[bottom + k] = xhi;
+        wlo[bottom + k] = ylo;
+        whi[bottom + k] = yhi;
+    }
+    if(p >= size - 1 && p - (size - 1) < j->steps){
+        *reclo |= clo[size] << (p - (size - 1));
+        *rechi |= chi[size] << (p - (size - 1));
+    }
+}
+
+/* The block on the first words of v and w */
+static void s3_jump_vw(uint64_t *vlo, uint64_t *vhi, uint64_t *wlo, uint64_t *whi, size_t words, const s3_jump *j) {
+
+    uint64_t inlo, inhi, reclo, rechi;
+    uint64_t clo[JUMP_GROUP + 1], chi[JUMP_GROUP + 1];
+    uint64x2_t xlo[2], xhi[2], ylo[2], yhi[2], tl, blol, bhil;
+    uint64x2_t swapl, signlol, signhil;
+    uint64x2_t inlol, inhil, clol[2], chil[2], toplo[2], tophi[2], reclol, rechil;
+    uint64x2_t one = vdupq_n_u64(1);
+    size_t bottom, size, p, g;
+
+    inlo = 0;
+    inhi = 0;
+
+    for(bottom = 0; bottom < words; bottom += size){
+        size = words - bottom < JUMP_GROUP ? words - bottom : JUMP_GROUP;
+        reclo = 0;
+        rechi = 0;
+
+        for(p = 0; p < j->steps + size - 1; p++){
+            if(size == JUMP_GROUP && p == JUMP_GROUP - 1 && j->steps >= JUMP_GROUP){
+                /* The rounds where the four words are busy, on (bottom, bottom + 1) and (bottom + 2, bottom + 3) */
+                for(g = 0; g < 2; g++){
+                    xlo[g] = vld1q_u64(vlo + bottom + 2 * g);
+                    xhi[g] = vld1q_u64(vhi + bottom + 2 * g);
+                    ylo[g] = vld1q_u64(wlo + bottom + 2 * g);
+                    yhi[g] = vld1q_u64(whi + bottom + 2 * g);
+                }
+                inlol = vdupq_n_u64(inlo >> p);
+                inhil = vdupq_n_u64(inhi >> p);
+                clol[0] = vsetq_lane_u64(clo[1], vdupq_n_u64((inlo >> p) & 1), 1);
+                chil[0] = vsetq_lane_u64(chi[1], vdupq_n_u64((inhi >> p) & 1), 1);
+                clol[1] = vsetq_lane_u64(clo[3], vdupq_n_u64(clo[2]), 1);
+                chil[1] = vsetq_lane_u64(chi[3], vdupq_n_u64(chi[2]), 1);
+                reclol = vdupq_n_u64(0);
+                rechil = vdupq_n_u64(0);
+
+                for(; p < j->steps; p++){
+                    for(g = 0; g < 2; g++){
+                        toplo[g] = vshrq_n_u64(xlo[g], 63);
+                        tophi[g] = vshrq_n_u64(xhi[g], 63);
+                        xlo[g] = vshlq_n_u64(xlo[g], 1) | clol[g];
+                        xhi[g] = vshlq_n_u64(xhi[g], 1) | chil[g];
+                        swapl = vld1q_u64(j->swaprev + j->steps - 1 - p + 2 * g);
+                        signlol = vld1q_u64(j->signlorev + j->steps - 1 - p + 2 * g);
+                        signhil = vld1q_u64(j->signhirev + j->steps - 1 - p + 2 * g);
+                        S3_JUMP_STEP(xlo[g], xhi[g], ylo[g], yhi[g], swapl, signlol, signhil, tl, blol, bhil);
+                    }
+                    reclol = vshrq_n_u64(reclol, 1) | vshlq_n_u64(toplo[1], 63);
+                    rechil = vshrq_n_u64(rechil, 1) | vshlq_n_u64(tophi[1], 63);
+
+                    inlol = vshrq_n_u64(inlol, 1);
+                    inhil = vshrq_n_u64(inhil, 1);
+                    clol[0] = vextq_u64(inlol & one, toplo[0], 1);
+                    chil[0] = vextq_u64(inhil & one, tophi[0], 1);
+                    clol[1] = vextq_u64(toplo[0], toplo[1], 1);
+                    chil[1] = vextq_u64(tophi[0], tophi[1], 1);
+                }
+
+                for(g = 0; g < 2; g++){
+                    vst1q_u64(vlo + bottom + 2 * g, xlo[g]);
+                    vst1q_u64(vhi + bottom + 2 * g, xhi[g]);
+                    vst1q_u64(wlo + bottom + 2 * g, ylo[g]);
+                    vst1q_u64(whi + bottom + 2 * g, yhi[g]);
+                }
+                clo[1] = vgetq_lane_u64(clol[0], 1);
+                chi[1] = vgetq_lane_u64(chil[0], 1);
+                clo[2] = vgetq_lane_u64(clol[1], 0);
+                chi[2] = vgetq_lane_u64(chil[1], 0);
+                clo[3] = vgetq_lane_u64(clol[1], 1);
+                chi[3] = vgetq_lane_u64(chil[1], 1);
+                reclo = vgetq_lane_u64(reclol, 1) >> (JUMP_STEPS - (j->steps - (JUMP_GROUP - 1)));
+                rechi = vgetq_lane_u64(rechil, 1) >> (JUMP_STEPS - (j->steps - (JUMP_GROUP - 1)));
+            }
+
+            clo[0] = p < j->steps ? (inlo >> p) & 1 : 0;
+            chi[0] = p < j->steps ? (inhi >> p) & 1 : 0;
+            s3_jump_vw_round(vlo, vhi, wlo, whi, bottom, size, j, p, clo, chi, &reclo, &rechi);
+        }
+
+        inlo = reclo;
+        inhi = rechi;
+    }
+}
+
+void poly_S3_inv_jumpdivstep(poly *r, const poly *a) {
+
+    uint64_t flo[BITARRAY_SIZE], fhi[BITARRAY_SIZE];
+    uint64_t glo[BITARRAY_SIZE], ghi[BITARRAY_SIZE];
+    uint64_t vlo[BITARRAY_SIZE], vhi[BITARRAY_SIZE];
+    uint64_t wlo[BITARRAY_SIZE], whi[BITARRAY_SIZE];
+    uint64_t signlo, signhi;
+
+    s3_jump j;
+
+    uint8_t g[NTRU_N];
+
+    size_t loop;
+    int16_t delta, sign;
+
+    for(size_t i = 0; i < NTRU_N - 1; ++i){
+        g[NTRU_N - 2 - i] = mod3((a->coeffs[i] & 3) + 2 * (a->coeffs[NTRU_N - 1] & 3));
+    }
+    g[NTRU_N - 1] = 0;
+
+    for(size_t i = 0; i < BITARRAY_SIZE; i++){
+        flo[i] = 0xffffffffffffffff;
+        fhi[i] = 0;
+        glo[i] = 0;
+        ghi[i] = 0;
+        vlo[i] = 0;
+        vhi[i] = 0;
+        wlo[i] = 0;
+        whi[i] = 0;
+    }
+    flo[BITARRAY_SIZE - 1] = (1UL << (NTRU_N % 64)) - 1;
+    wlo[0] = 1;
+    for(size_t i = 0; i < NTRU_N; i++){
+        glo[i / 64] |= ((((uint64_t)g[i]) & 1) >> 0) << ((i % 64));
+        ghi[i / 64] |= ((((uint64_t)g[i]) & 2) >> 1) << ((i % 64));
+    }
+
+    delta = 1;
+
+    for(loop = 0; loop < 2 * (NTRU_N - 1) - 1; loop += j.steps) {
+
+        j.steps = 2 * (NTRU_N - 1) - 1 - loop;
+        if(j.steps > JUMP_STEPS){
+            j.steps = JUMP_STEPS;
+        }
+
+        s3_jump_masks(&j, &delta, flo[0], fhi[0], glo[0], ghi[0]);
+
+        /* f and g down from the word of the last trit that a divstep reads, or of the sign of f at the end */
+        s3_jump_fg(flo, fhi, glo, ghi, JUMP_WORDS(2 * (NTRU_N - 1) - loop), &j);
+        /* v and w up to the word of their highest possible degree at the end of the block */
+        s3_jump_vw(vlo, vhi, wlo, whi, JUMP_WORDS(loop + j.steps + 1), &j);
+    }
+
+    sign = (flo[0] & 1) | ((fhi[0] & 1) << 1);
+    signlo = (uint64_t)(-((int64_t)((sign & 1) >> 0)));
+    signhi = (uint64_t)(-((int64_t)((sign & 2) >> 1)));
+
+    for(size_t i = 0; i < BITARRAY_SIZE; i++){
+        mul_Z3_bitsliced(vlo + i, vhi + i, &signlo, &signhi, vlo + i, vhi + i);
+    }
+
+    for(size_t i = 0; i < NTRU_N - 1; i++){
+        r->coeffs[i] = (uint16_t)(
+                        (((vlo[(NTRU_N - 2 - i) / 64] >> ((NTRU_N - 2 - i) % 64)) & 1) << 0) |
+                        (((vhi[(NTRU_N - 2 - i) / 64] >> ((NTRU_N - 2 - i) % 64)) & 1) << 1)
+                        );
+    }
+    r->coeffs[NTRU_N - 1] = 0;
+}
+
+void poly_S3_inv(poly *r, const poly *a) {
+#ifdef INV_JUMPDIVSTEP
+    poly_S3_inv_jumpdivstep(r, a);
+#else
+    poly_S3_inv_divstep(r, a);
+#endif
+}
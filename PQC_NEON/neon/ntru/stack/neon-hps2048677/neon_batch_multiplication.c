@@ -37,399 +37,418 @@ limitations under the License.
 // c = a
 #define sb_dup(c, a) c = vdupq_n_u16(a);
 
+// Transposes the 8x8 matrix of 16-bit coefficients r in registers, r[i] being row i
+static inline void sb_transpose_8x8(uint16x8_t r[8])
+{
+    uint16x8_t t0, t1, t2, t3, t4, t5, t6, t7;
+    uint32x4_t u0, u1, u2, u3, u4, u5, u6, u7;
+
+    t0 = vtrn1q_u16(r[0], r[1]);
+    t1 = vtrn2q_u16(r[0], r[1]);
+    t2 = vtrn1q_u16(r[2], r[3]);
+    t3 = vtrn2q_u16(r[2], r[3]);
+    t4 = vtrn1q_u16(r[4], r[5]);
+    t5 = vtrn2q_u16(r[4], r[5]);
+    t6 = vtrn1q_u16(r[6], r[7]);
+    t7 = vtrn2q_u16(r[6], r[7]);
+
+    u0 = vtrn1q_u32((uint32x4_t)t0, (uint32x4_t)t2);
+    u2 = vtrn2q_u32((uint32x4_t)t0, (uint32x4_t)t2);
+    u1 = vtrn1q_u32((uint32x4_t)t1, (uint32x4_t)t3);
+    u3 = vtrn2q_u32((uint32x4_t)t1, (uint32x4_t)t3);
+    u4 = vtrn1q_u32((uint32x4_t)t4, (uint32x4_t)t6);
+    u6 = vtrn2q_u32((uint32x4_t)t4, (uint32x4_t)t6);
+    u5 = vtrn1q_u32((uint32x4_t)t5, (uint32x4_t)t7);
+    u7 = vtrn2q_u32((uint32x4_t)t5, (uint32x4_t)t7);
+
+    r[0] = (uint16x8_t)vtrn1q_u64((uint64x2_t)u0, (uint64x2_t)u4);
+    r[4] = (uint16x8_t)vtrn2q_u64((uint64x2_t)u0, (uint64x2_t)u4);
+    r[1] = (uint16x8_t)vtrn1q_u64((uint64x2_t)u1, (uint64x2_t)u5);
+    r[5] = (uint16x8_t)vtrn2q_u64((uint64x2_t)u1, (uint64x2_t)u5);
+    r[2] = (uint16x8_t)vtrn1q_u64((uint64x2_t)u2, (uint64x2_t)u6);
+    r[6] = (uint16x8_t)vtrn2q_u64((uint64x2_t)u2, (uint64x2_t)u6);
+    r[3] = (uint16x8_t)vtrn1q_u64((uint64x2_t)u3, (uint64x2_t)u7);
+    r[7] = (uint16x8_t)vtrn2q_u64((uint64x2_t)u3, (uint64x2_t)u7);
+}
+
 #define SB_HALF 8 // Round up of 7*3*3/8
 
 /*
 =========================================
-Schoolbook for left over polynomials
-Input Before Transpose
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-  0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  x
-Input After Transpose
-Input: a_in_mem[128], b_in_mem[128]
-  0   0   0   0   0   0   0   0  |  8   8   8   8   8   8   8   8
-  1   1   1   1   1   1   1   1  |  9   9   9   9   9   9   9   9
-  2   2   2   2   2   2   2   2  | 10  10  10  10  10  10  10  10
-  3   3   3   3   3   3   3   3  | 11  11  11  11  11  11  11  11
-  4   4   4   4   4   4   4   4  | 12  12  12  12  12  12  12  12
-  5   5   5   5   5   5   5   5  | 13  13  13  13  13  13  13  13
-  6   6   6   6   6   6   6   6  | 14  14  14  14  14  14  14  14
-  7   7   7   7   7   7   7   7  |  x   x   x   x   x   x   x   x
+Schoolbook for left over polynomials, 8 at a time, one in each lane. A and C are in the natural layout and are
+transposed in registers: aa[k] holds coefficient k of the 8 polynomials of A, and each group of 8 coefficients of
+C is transposed back just before it is stored. This replaces a transpose in memory before and after the
+multiplication. B is read as transposed by half_transpose_8x16, since it is evaluated once.
+Input: a_in_mem[128]
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14   x
+Input: b_in_mem[128], transposed
+    0   0   0   0   0   0   0   0  |    8   8   8   8   8   8   8   8
+    1   1   1   1   1   1   1   1  |    9   9   9   9   9   9   9   9
+    2   2   2   2   2   2   2   2  |   10  10  10  10  10  10  10  10
+    3   3   3   3   3   3   3   3  |   11  11  11  11  11  11  11  11
+    4   4   4   4   4   4   4   4  |   12  12  12  12  12  12  12  12
+    5   5   5   5   5   5   5   5  |   13  13  13  13  13  13  13  13
+    6   6   6   6   6   6   6   6  |   14  14  14  14  14  14  14  14
+    7   7   7   7   7   7   7   7  |    x   x   x   x   x   x   x   x
 -----------
 Output: c_in_mem[256]
-  0   0   0   0   0   0   0   0  |   8   8   8   8   8   8   8   8  |  16   16   16   16   16   16   16   16  |  24   24   24   24   24   24   24   24
-  1   1   1   1   1   1   1   1  |   9   9   9   9   9   9   9   9  |  17   17   17   17   17   17   17   17  |  25   25   25   25   25   25   25   25
-  2   2   2   2   2   2   2   2  |  10  10  10  10  10  10  10  10  |  18   18   18   18   18   18   18   18  |  26   26   26   26   26   26   26   26
-  3   3   3   3   3   3   3   3  |  11  11  11  11  11  11  11  11  |  19   19   19   19   19   19   19   19  |  27   27   27   27   27   27   27   27
-  4   4   4   4   4   4   4   4  |  12  12  12  12  12  12  12  12  |  20   20   20   20   20   20   20   20  |  28   28   28   28   28   28   28   28
-  5   5   5   5   5   5   5   5  |  13  13  13  13  13  13  13  13  |  21   21   21   21   21   21   21   21  |   x    x    x    x    x    x    x    x
-  6   6   6   6   6   6   6   6  |  14  14  14  14  14  14  14  14  |  22   22   22   22   22   22   22   22  |   x    x    x    x    x    x    x    x
-  7   7   7   7   7   7   7   7  |  15  15  15  15  15  15  15  15  |  23   23   23   23   23   23   23   23  |   x    x    x    x    x    x    x    x
-Output After Transpose
-
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
-  0   1   2   3   4   5   6   7  |   8   9  10  11  12  13  14  15  |  16   17   18   19   20   21   22   23  |  24   25   26   27   28   x   x   x
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
+    0   1   2   3   4   5   6   7  |    8   9  10  11  12  13  14  15  |   16  17  18  19  20  21  22  23  |   24  25  26  27  28   0   0   0
 ------
 */
 void schoolbook_half_8x_neon(uint16_t *restrict c_in_mem,
                              uint16_t *restrict a_in_mem,
                              uint16_t *restrict b_in_mem)
 {
-    uint16x8_t tmp, aa[15], bb[15], zero;
-    sb_dup(zero, 0);
+    uint16x8_t aa[16], bb, cc[8];
     uint16_t *a_mem = a_in_mem, *b_mem = b_in_mem, *c_mem = c_in_mem;
     for (uint16_t i = 0; i < SB_HALF; i++)
     {
         sb_vload(aa[0], &a_mem[0 * 16]);
-        sb_vload(bb[0], &b_mem[0 * 16]);
-
-        sb_vmul(tmp, aa[0], bb[0]);
-        sb_vstore(&c_mem[32 * 0], tmp);
-        //----
         sb_vload(aa[1], &a_mem[1 * 16]);
-        sb_vload(bb[1], &b_mem[1 * 16]);
-
-        sb_vmul(tmp, aa[0], bb[1]);
-        sb_vmla(tmp, aa[1], bb[0]);
-        sb_vstore(&c_mem[32 * 1], tmp);
-        //----
         sb_vload(aa[2], &a_mem[2 * 16]);
-        sb_vload(bb[2], &b_mem[2 * 16]);
-
-        sb_vmul(tmp, aa[0], bb[2]);
-        sb_vmla(tmp, aa[1], bb[1]);
-        sb_vmla(tmp, aa[2], bb[0]);
-        sb_vstore(&c_mem[32 * 2], tmp);
-        //----
         sb_vload(aa[3], &a_mem[3 * 16]);
-        sb_vload(bb[3], &b_mem[3 * 16]);
-
-        sb_vmul(tmp, aa[0], bb[3]);
-        sb_vmla(tmp, aa[1], bb[2]);
-        sb_vmla(tmp, aa[2], bb[1]);
-        sb_vmla(tmp, aa[3], bb[0]);
-        sb_vstore(&c_mem[32 * 3], tmp);
-        //----
         sb_vload(aa[4], &a_mem[4 * 16]);
-        sb_vload(bb[4], &b_mem[4 * 16]);
-
-        sb_vmul(tmp, aa[0], bb[4]);
-        sb_vmla(tmp, aa[1], bb[3]);
-        sb_vmla(tmp, aa[2], bb[2]);
-        sb_vmla(tmp, aa[3], bb[1]);
-        sb_vmla(tmp, aa[4], bb[0]);
-        sb_vstore(&c_mem[32 * 4], tmp);
-        //----
         sb_vload(aa[5], &a_mem[5 * 16]);
-        sb_vload(bb[5], &b_mem[5 * 16]);
-
-        sb_vmul(tmp, aa[0], bb[5]);
-        sb_vmla(tmp, aa[1], bb[4]);
-        sb_vmla(tmp, aa[2], bb[3]);
-        sb_vmla(tmp, aa[3], bb[2]);
-        sb_vmla(tmp, aa[4], bb[1]);
-        sb_vmla(tmp, aa[5], bb[0]);
-        sb_vstore(&c_mem[32 * 5], tmp);
-        //----
         sb_vload(aa[6], &a_mem[6 * 16]);
-        sb_vload(bb[6], &b_mem[6 * 16]);
-
-        sb_vmul(tmp, aa[0], bb[6]);
-        sb_vmla(tmp, aa[1], bb[5]);
-        sb_vmla(tmp, aa[2], bb[4]);
-        sb_vmla(tmp, aa[3], bb[3]);
-        sb_vmla(tmp, aa[4], bb[2]);
-        sb_vmla(tmp, aa[5], bb[1]);
-        sb_vmla(tmp, aa[6], bb[0]);
-        sb_vstore(&c_mem[32 * 6], tmp);
-        //----
         sb_vload(aa[7], &a_mem[7 * 16]);
-        sb_vload(bb[7], &b_mem[7 * 16]);
+        sb_transpose_8x8(&aa[0]);
 
-        sb_vmul(tmp, aa[0], bb[7]);
-        sb_vmla(tmp, aa[1], bb[6]);
-        sb_vmla(tmp, aa[2], bb[5]);
-        sb_vmla(tmp, aa[3], bb[4]);
-        sb_vmla(tmp, aa[4], bb[3]);
-        sb_vmla(tmp, aa[5], bb[2]);
-        sb_vmla(tmp, aa[6], bb[1]);
-        sb_vmla(tmp, aa[7], bb[0]);
-        sb_vstore(&c_mem[32 * 7], tmp);
-        //----
         sb_vload(aa[8], &a_mem[0 * 16 + 8]);
-        sb_vload(bb[8], &b_mem[0 * 16 + 8]);
-
-        sb_vmul(tmp, aa[0], bb[8]);
-        sb_vmla(tmp, aa[1], bb[7]);
-        sb_vmla(tmp, aa[2], bb[6]);
-        sb_vmla(tmp, aa[3], bb[5]);
-        sb_vmla(tmp, aa[4], bb[4]);
-        sb_vmla(tmp, aa[5], bb[3]);
-        sb_vmla(tmp, aa[6], bb[2]);
-        sb_vmla(tmp, aa[7], bb[1]);
-        sb_vmla(tmp, aa[8], bb[0]);
-        sb_vstore(&c_mem[32 * 0 + 8], tmp);
-        //----
         sb_vload(aa[9], &a_mem[1 * 16 + 8]);
-        sb_vload(bb[9], &b_mem[1 * 16 + 8]);
-
-        sb_vmul(tmp, aa[0], bb[9]);
-        sb_vmla(tmp, aa[1], bb[8]);
-        sb_vmla(tmp, aa[2], bb[7]);
-        sb_vmla(tmp, aa[3], bb[6]);
-        sb_vmla(tmp, aa[4], bb[5]);
-        sb_vmla(tmp, aa[5], bb[4]);
-        sb_vmla(tmp, aa[6], bb[3]);
-        sb_vmla(tmp, aa[7], bb[2]);
-        sb_vmla(tmp, aa[8], bb[1]);
-        sb_vmla(tmp, aa[9], bb[0]);
-        sb_vstore(&c_mem[32 * 1 + 8], tmp);
-        //----
         sb_vload(aa[10], &a_mem[2 * 16 + 8]);
-        sb_vload(bb[10], &b_mem[2 * 16 + 8]);
-
-        sb_vmul(tmp, aa[0], bb[10]);
-        sb_vmla(tmp, aa[1], bb[9]);
-        sb_vmla(tmp, aa[2], bb[8]);
-        sb_vmla(tmp, aa[3], bb[7]);
-        sb_vmla(tmp, aa[4], bb[6]);
-        sb_vmla(tmp, aa[5], bb[5]);
-        sb_vmla(tmp, aa[6], bb[4]);
-        sb_vmla(tmp, aa[7], bb[3]);
-        sb_vmla(tmp, aa[8], bb[2]);
-        sb_vmla(tmp, aa[9], bb[1]);
-        sb_vmla(tmp, aa[10], bb[0]);
-        sb_vstore(&c_mem[32 * 2 + 8], tmp);
-        //----
         sb_vload(aa[11], &a_mem[3 * 16 + 8]);
-        sb_vload(bb[11], &b_mem[3 * 16 + 8]);
-
-        sb_vmul(tmp, aa[0], bb[11]);
-        sb_vmla(tmp, aa[1], bb[10]);
-        sb_vmla(tmp, aa[2], bb[9]);
-        sb_vmla(tmp, aa[3], bb[8]);
-        sb_vmla(tmp, aa[4], bb[7]);
-        sb_vmla(tmp, aa[5], bb[6]);
-        sb_vmla(tmp, aa[6], bb[5]);
-        sb_vmla(tmp, aa[7], bb[4]);
-        sb_vmla(tmp, aa[8], bb[3]);
-        sb_vmla(tmp, aa[9], bb[2]);
-        sb_vmla(tmp, aa[10], bb[1]);
-        sb_vmla(tmp, aa[11], bb[0]);
-        sb_vstore(&c_mem[32 * 3 + 8], tmp);
-        //----
         sb_vload(aa[12], &a_mem[4 * 16 + 8]);
-        sb_vload(bb[12], &b_mem[4 * 16 + 8]);
-
-        sb_vmul(tmp, aa[0], bb[12]);
-        sb_vmla(tmp, aa[1], bb[11]);
-        sb_vmla(tmp, aa[2], bb[10]);
-        sb_vmla(tmp, aa[3], bb[9]);
-        sb_vmla(tmp, aa[4], bb[8]);
-        sb_vmla(tmp, aa[5], bb[7]);
-        sb_vmla(tmp, aa[6], bb[6]);
-        sb_vmla(tmp, aa[7], bb[5]);
-        sb_vmla(tmp, aa[8], bb[4]);
-        sb_vmla(tmp, aa[9], bb[3]);
-        sb_vmla(tmp, aa[10], bb[2]);
-        sb_vmla(tmp, aa[11], bb[1]);
-        sb_vmla(tmp, aa[12], bb[0]);
-        sb_vstore(&c_mem[32 * 4 + 8], tmp);
-        //----
         sb_vload(aa[13], &a_mem[5 * 16 + 8]);
-        sb_vload(bb[13], &b_mem[5 * 16 + 8]);
-
-        sb_vmul(tmp, aa[0], bb[13]);
-        sb_vmla(tmp, aa[1], bb[12]);
-        sb_vmla(tmp, aa[2], bb[11]);
-        sb_vmla(tmp, aa[3], bb[10]);
-        sb_vmla(tmp, aa[4], bb[9]);
-        sb_vmla(tmp, aa[5], bb[8]);
-        sb_vmla(tmp, aa[6], bb[7]);
-        sb_vmla(tmp, aa[7], bb[6]);
-        sb_vmla(tmp, aa[8], bb[5]);
-        sb_vmla(tmp, aa[9], bb[4]);
-        sb_vmla(tmp, aa[10], bb[3]);
-        sb_vmla(tmp, aa[11], bb[2]);
-        sb_vmla(tmp, aa[12], bb[1]);
-        sb_vmla(tmp, aa[13], bb[0]);
-        sb_vstore(&c_mem[32 * 5 + 8], tmp);
-        //----
         sb_vload(aa[14], &a_mem[6 * 16 + 8]);
-        sb_vload(bb[14], &b_mem[6 * 16 + 8]);
+        sb_vload(aa[15], &a_mem[7 * 16 + 8]);
+        sb_transpose_8x8(&aa[8]);
+
+        // Coefficients 0 to 7
+        sb_vload(bb, &b_mem[0 * 16]);
+        sb_vmul(cc[0], aa[0], bb);
+        sb_vmul(cc[1], aa[1], bb);
+        sb_vmul(cc[2], aa[2], bb);
+        sb_vmul(cc[3], aa[3], bb);
+        sb_vmul(cc[4], aa[4], bb);
+        sb_vmul(cc[5], aa[5], bb);
+        sb_vmul(cc[6], aa[6], bb);
+        sb_vmul(cc[7], aa[7], bb);
+        sb_vload(bb, &b_mem[1 * 16]);
+        sb_vmla(cc[1], aa[0], bb);
+        sb_vmla(cc[2], aa[1], bb);
+        sb_vmla(cc[3], aa[2], bb);
+        sb_vmla(cc[4], aa[3], bb);
+        sb_vmla(cc[5], aa[4], bb);
+        sb_vmla(cc[6], aa[5], bb);
+        sb_vmla(cc[7], aa[6], bb);
+        sb_vload(bb, &b_mem[2 * 16]);
+        sb_vmla(cc[2], aa[0], bb);
+        sb_vmla(cc[3], aa[1], bb);
+        sb_vmla(cc[4], aa[2], bb);
+        sb_vmla(cc[5], aa[3], bb);
+        sb_vmla(cc[6], aa[4], bb);
+        sb_vmla(cc[7], aa[5], bb);
+        sb_vload(bb, &b_mem[3 * 16]);
+        sb_vmla(cc[3], aa[0], bb);
+        sb_vmla(cc[4], aa[1], bb);
+        sb_vmla(cc[5], aa[2], bb);
+        sb_vmla(cc[6], aa[3], bb);
+        sb_vmla(cc[7], aa[4], bb);
+        sb_vload(bb, &b_mem[4 * 16]);
+        sb_vmla(cc[4], aa[0], bb);
+        sb_vmla(cc[5], aa[1], bb);
+        sb_vmla(cc[6], aa[2], bb);
+        sb_vmla(cc[7], aa[3], bb);
+        sb_vload(bb, &b_mem[5 * 16]);
+        sb_vmla(cc[5], aa[0], bb);
+        sb_vmla(cc[6], aa[1], bb);
+        sb_vmla(cc[7], aa[2], bb);
+        sb_vload(bb, &b_mem[6 * 16]);
+        sb_vmla(cc[6], aa[0], bb);
+        sb_vmla(cc[7], aa[1], bb);
+        sb_vload(bb, &b_mem[7 * 16]);
+        sb_vmla(cc[7], aa[0], bb);
+        sb_transpose_8x8(cc);
+        sb_vstore(&c_mem[32 * 0], cc[0]);
+        sb_vstore(&c_mem[32 * 1], cc[1]);
+        sb_vstore(&c_mem[32 * 2], cc[2]);
+        sb_vstore(&c_mem[32 * 3], cc[3]);
+        sb_vstore(&c_mem[32 * 4], cc[4]);
+        sb_vstore(&c_mem[32 * 5], cc[5]);
+        sb_vstore(&c_mem[32 * 6], cc[6]);
+        sb_vstore(&c_mem[32 * 7], cc[7]);
+
+        // Coefficients 8 to 15
+        sb_vload(bb, &b_mem[0 * 16]);
+        sb_vmul(cc[0], aa[8], bb);
+        sb_vmul(cc[1], aa[9], bb);
+        sb_vmul(cc[2], aa[10], bb);
+        sb_vmul(cc[3], aa[11], bb);
+        sb_vmul(cc[4], aa[12], bb);
+        sb_vmul(cc[5], aa[13], bb);
+        sb_vmul(cc[6], aa[14], bb);
+        sb_vload(bb, &b_mem[1 * 16]);
+        sb_vmla(cc[0], aa[7], bb);
+        sb_vmla(cc[1], aa[8], bb);
+        sb_vmla(cc[2], aa[9], bb);
+        sb_vmla(cc[3], aa[10], bb);
+        sb_vmla(cc[4], aa[11], bb);
+        sb_vmla(cc[5], aa[12], bb);
+        sb_vmla(cc[6], aa[13], bb);
+        sb_vmul(cc[7], aa[14], bb);
+        sb_vload(bb, &b_mem[2 * 16]);
+        sb_vmla(cc[0], aa[6], bb);
+        sb_vmla(cc[1], aa[7], bb);
+        sb_vmla(cc[2], aa[8], bb);
+        sb_vmla(cc[3], aa[9], bb);
+        sb_vmla(cc[4], aa[10], bb);
+        sb_vmla(cc[5], aa[11], bb);
+        sb_vmla(cc[6], aa[12], bb);
+        sb_vmla(cc[7], aa[13], bb);
+        sb_vload(bb, &b_mem[3 * 16]);
+        sb_vmla(cc[0], aa[5], bb);
+        sb_vmla(cc[1], aa[6], bb);
+        sb_vmla(cc[2], aa[7], bb);
+        sb_vmla(cc[3], aa[8], bb);
+        sb_vmla(cc[4], aa[9], bb);
+        sb_vmla(cc[5], aa[10], bb);
+        sb_vmla(cc[6], aa[11], bb);
+        sb_vmla(cc[7], aa[12], bb);
+        sb_vload(bb, &b_mem[4 * 16]);
+        sb_vmla(cc[0], aa[4], bb);
+        sb_vmla(cc[1], aa[5], bb);
+        sb_vmla(cc[2], aa[6], bb);
+        sb_vmla(cc[3], aa[7], bb);
+        sb_vmla(cc[4], aa[8], bb);
+        sb_vmla(cc[5], aa[9], bb);
+        sb_vmla(cc[6], aa[10], bb);
+        sb_vmla(cc[7], aa[11], bb);
+        sb_vload(bb, &b_mem[5 * 16]);
+        sb_vmla(cc[0], aa[3], bb);
+        sb_vmla(cc[1], aa[4], bb);
+        sb_vmla(cc[2], aa[5], bb);
+        sb_vmla(cc[3], aa[6], bb);
+        sb_vmla(cc[4], aa[7], bb);
+        sb_vmla(cc[5], aa[8], bb);
+        sb_vmla(cc[6], aa[9], bb);
+        sb_vmla(cc[7], aa[10], bb);
+        sb_vload(bb, &b_mem[6 * 16]);
+        sb_vmla(cc[0], aa[2], bb);
+        sb_vmla(cc[1], aa[3], bb);
+        sb_vmla(cc[2], aa[4], bb);
+        sb_vmla(cc[3], aa[5], bb);
+        sb_vmla(cc[4], aa[6], bb);
+        sb_vmla(cc[5], aa[7], bb);
+        sb_vmla(cc[6], aa[8], bb);
+        sb_vmla(cc[7], aa[9], bb);
+        sb_vload(bb, &b_mem[7 * 16]);
+        sb_vmla(cc[0], aa[1], bb);
+        sb_vmla(cc[1], aa[2], bb);
+        sb_vmla(cc[2], aa[3], bb);
+        sb_vmla(cc[3], aa[4], bb);
+        sb_vmla(cc[4], aa[5], bb);
+        sb_vmla(cc[5], aa[6], bb);
+        sb_vmla(cc[6], aa[7], bb);
+        sb_vmla(cc[7], aa[8], bb);
+        sb_vload(bb, &b_mem[0 * 16 + 8]);
+        sb_vmla(cc[0], aa[0], bb);
+        sb_vmla(cc[1], aa[1], bb);
+        sb_vmla(cc[2], aa[2], bb);
+        sb_vmla(cc[3], aa[3], bb);
+        sb_vmla(cc[4], aa[4], bb);
+        sb_vmla(cc[5], aa[5], bb);
+        sb_vmla(cc[6], aa[6], bb);
+        sb_vmla(cc[7], aa[7], bb);
+        sb_vload(bb, &b_mem[1 * 16 + 8]);
+        sb_vmla(cc[1], aa[0], bb);
+        sb_vmla(cc[2], aa[1], bb);
+        sb_vmla(cc[3], aa[2], bb);
+        sb_vmla(cc[4], aa[3], bb);
+        sb_vmla(cc[5], aa[4], bb);
+        sb_vmla(cc[6], aa[5], bb);
+        sb_vmla(cc[7], aa[6], bb);
+        sb_vload(bb, &b_mem[2 * 16 + 8]);
+        sb_vmla(cc[2], aa[0], bb);
+        sb_vmla(cc[3], aa[1], bb);
+        sb_vmla(cc[4], aa[2], bb);
+        sb_vmla(cc[5], aa[3], bb);
+        sb_vmla(cc[6], aa[4], bb);
+        sb_vmla(cc[7], aa[5], bb);
+        sb_vload(bb, &b_mem[3 * 16 + 8]);
+        sb_vmla(cc[3], aa[0], bb);
+        sb_vmla(cc[4], aa[1], bb);
+        sb_vmla(cc[5], aa[2], bb);
+        sb_vmla(cc[6], aa[3], bb);
+        sb_vmla(cc[7], aa[4], bb);
+        sb_vload(bb, &b_mem[4 * 16 + 8]);
+        sb_vmla(cc[4], aa[0], bb);
+        sb_vmla(cc[5], aa[1], bb);
+        sb_vmla(cc[6], aa[2], bb);
+        sb_vmla(cc[7], aa[3], bb);
+        sb_vload(bb, &b_mem[5 * 16 + 8]);
+        sb_vmla(cc[5], aa[0], bb);
+        sb_vmla(cc[6], aa[1], bb);
+        sb_vmla(cc[7], aa[2], bb);
+        sb_vload(bb, &b_mem[6 * 16 + 8]);
+        sb_vmla(cc[6], aa[0], bb);
+        sb_vmla(cc[7], aa[1], bb);
+        sb_transpose_8x8(cc);
+        sb_vstore(&c_mem[32 * 0 + 8], cc[0]);
+        sb_vstore(&c_mem[32 * 1 + 8], cc[1]);
+        sb_vstore(&c_mem[32 * 2 + 8], cc[2]);
+        sb_vstore(&c_mem[32 * 3 + 8], cc[3]);
+        sb_vstore(&c_mem[32 * 4 + 8], cc[4]);
+        sb_vstore(&c_mem[32 * 5 + 8], cc[5]);
+        sb_vstore(&c_mem[32 * 6 + 8], cc[6]);
+        sb_vstore(&c_mem[32 * 7 + 8], cc[7]);
+
+        // Coefficients 16 to 23
+        sb_vload(bb, &b_mem[2 * 16]);
+        sb_vmul(cc[0], aa[14], bb);
+        sb_vload(bb, &b_mem[3 * 16]);
+        sb_vmla(cc[0], aa[13], bb);
+        sb_vmul(cc[1], aa[14], bb);
+        sb_vload(bb, &b_mem[4 * 16]);
+        sb_vmla(cc[0], aa[12], bb);
+        sb_vmla(cc[1], aa[13], bb);
+        sb_vmul(cc[2], aa[14], bb);
+        sb_vload(bb, &b_mem[5 * 16]);
+        sb_vmla(cc[0], aa[11], bb);
+        sb_vmla(cc[1], aa[12], bb);
+        sb_vmla(cc[2], aa[13], bb);
+        sb_vmul(cc[3], aa[14], bb);
+        sb_vload(bb, &b_mem[6 * 16]);
+        sb_vmla(cc[0], aa[10], bb);
+        sb_vmla(cc[1], aa[11], bb);
+        sb_vmla(cc[2], aa[12], bb);
+        sb_vmla(cc[3], aa[13], bb);
+        sb_vmul(cc[4], aa[14], bb);
+        sb_vload(bb, &b_mem[7 * 16]);
+        sb_vmla(cc[0], aa[9], bb);
+        sb_vmla(cc[1], aa[10], bb);
+        sb_vmla(cc[2], aa[11], bb);
+        sb_vmla(cc[3], aa[12], bb);
+        sb_vmla(cc[4], aa[13], bb);
+        sb_vmul(cc[5], aa[14], bb);
+        sb_vload(bb, &b_mem[0 * 16 + 8]);
+        sb_vmla(cc[0], aa[8], bb);
+        sb_vmla(cc[1], aa[9], bb);
+        sb_vmla(cc[2], aa[10], bb);
+        sb_vmla(cc[3], aa[11], bb);
+        sb_vmla(cc[4], aa[12], bb);
+        sb_vmla(cc[5], aa[13], bb);
+        sb_vmul(cc[6], aa[14], bb);
+        sb_vload(bb, &b_mem[1 * 16 + 8]);
+        sb_vmla(cc[0], aa[7], bb);
+        sb_vmla(cc[1], aa[8], bb);
+        sb_vmla(cc[2], aa[9], bb);
+        sb_vmla(cc[3], aa[10], bb);
+        sb_vmla(cc[4], aa[11], bb);
+        sb_vmla(cc[5], aa[12], bb);
+        sb_vmla(cc[6], aa[13], bb);
+        sb_vmul(cc[7], aa[14], bb);
+        sb_vload(bb, &b_mem[2 * 16 + 8]);
+        sb_vmla(cc[0], aa[6], bb);
+        sb_vmla(cc[1], aa[7], bb);
+        sb_vmla(cc[2], aa[8], bb);
+        sb_vmla(cc[3], aa[9], bb);
+        sb_vmla(cc[4], aa[10], bb);
+        sb_vmla(cc[5], aa[11], bb);
+        sb_vmla(cc[6], aa[12], bb);
+        sb_vmla(cc[7], aa[13], bb);
+        sb_vload(bb, &b_mem[3 * 16 + 8]);
+        sb_vmla(cc[0], aa[5], bb);
+        sb_vmla(cc[1], aa[6], bb);
+        sb_vmla(cc[2], aa[7], bb);
+        sb_vmla(cc[3], aa[8], bb);
+        sb_vmla(cc[4], aa[9], bb);
+        sb_vmla(cc[5], aa[10], bb);
+        sb_vmla(cc[6], aa[11], bb);
+        sb_vmla(cc[7], aa[12], bb);
+        sb_vload(bb, &b_mem[4 * 16 + 8]);
+        sb_vmla(cc[0], aa[4], bb);
+        sb_vmla(cc[1], aa[5], bb);
+        sb_vmla(cc[2], aa[6], bb);
+        sb_vmla(cc[3], aa[7], bb);
+        sb_vmla(cc[4], aa[8], bb);
+        sb_vmla(cc[5], aa[9], bb);
+        sb_vmla(cc[6], aa[10], bb);
+        sb_vmla(cc[7], aa[11], bb);
+        sb_vload(bb, &b_mem[5 * 16 + 8]);
+        sb_vmla(cc[0], aa[3], bb);
+        sb_vmla(cc[1], aa[4], bb);
+        sb_vmla(cc[2], aa[5], bb);
+        sb_vmla(cc[3], aa[6], bb);
+        sb_vmla(cc[4], aa[7], bb);
+        sb_vmla(cc[5], aa[8], bb);
+        sb_vmla(cc[6], aa[9], bb);
+        sb_vmla(cc[7], aa[10], bb);
+        sb_vload(bb, &b_mem[6 * 16 + 8]);
+        sb_vmla(cc[0], aa[2], bb);
+        sb_vmla(cc[1], aa[3], bb);
+        sb_vmla(cc[2], aa[4], bb);
+        sb_vmla(cc[3], aa[5], bb);
+        sb_vmla(cc[4], aa[6], bb);
+        sb_vmla(cc[5], aa[7], bb);
+        sb_vmla(cc[6], aa[8], bb);
+        sb_vmla(cc[7], aa[9], bb);
+        sb_transpose_8x8(cc);
+        sb_vstore(&c_mem[32 * 0 + 16], cc[0]);
+        sb_vstore(&c_mem[32 * 1 + 16], cc[1]);
+        sb_vstore(&c_mem[32 * 2 + 16], cc[2]);
+        sb_vstore(&c_mem[32 * 3 + 16], cc[3]);
+        sb_vstore(&c_mem[32 * 4 + 16], cc[4]);
+        sb_vstore(&c_mem[32 * 5 + 16], cc[5]);
+        sb_vstore(&c_mem[32 * 6 + 16], cc[6]);
+        sb_vstore(&c_mem[32 * 7 + 16], cc[7]);
 
-        sb_vmul(tmp, aa[0], bb[14]);
-        sb_vmla(tmp, aa[1], bb[13]);
-        sb_vmla(tmp, aa[2], bb[12]);
-        sb_vmla(tmp, aa[3], bb[11]);
-        sb_vmla(tmp, aa[4], bb[10]);
-        sb_vmla(tmp, aa[5], bb[9]);
-        sb_vmla(tmp, aa[6], bb[8]);
-        sb_vmla(tmp, aa[7], bb[7]);
-        sb_vmla(tmp, aa[8], bb[6]);
-        sb_vmla(tmp, aa[9], bb[5]);
-        sb_vmla(tmp, aa[10], bb[4]);
-        sb_vmla(tmp, aa[11], bb[3]);
-        sb_vmla(tmp, aa[12], bb[2]);
-        sb_vmla(tmp, aa[13], bb[1]);
-        sb_vmla(tmp, aa[14], bb[0]);
-        sb_vstore(&c_mem[32 * 6 + 8], tmp);
-        //----
-        //=======
-        // ci =  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15} 16
-        // ai =  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15} 16
-        // bi =  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15} 16
-        // ----------------PART 2----------------
-        sb_vmul(tmp, aa[1],  bb[14]);
-        sb_vmla(tmp, aa[2],  bb[13]);
-        sb_vmla(tmp, aa[3],  bb[12]);
-        sb_vmla(tmp, aa[4],  bb[11]);
-        sb_vmla(tmp, aa[5],  bb[10]);
-        sb_vmla(tmp, aa[6],  bb[9]);
-        sb_vmla(tmp, aa[7],  bb[8]);
-        sb_vmla(tmp, aa[8],  bb[7]);
-        sb_vmla(tmp, aa[9],  bb[6]);
-        sb_vmla(tmp, aa[10], bb[5]);
-        sb_vmla(tmp, aa[11], bb[4]);
-        sb_vmla(tmp, aa[12], bb[3]);
-        sb_vmla(tmp, aa[13], bb[2]);
-        sb_vmla(tmp, aa[14], bb[1]);
-        sb_vstore(&c_mem[32 * 7 + 8], tmp);
-        //-----
-        sb_vmul(tmp, aa[2],  bb[14]);
-        sb_vmla(tmp, aa[3],  bb[13]);
-        sb_vmla(tmp, aa[4],  bb[12]);
-        sb_vmla(tmp, aa[5],  bb[11]);
-        sb_vmla(tmp, aa[6],  bb[10]);
-        sb_vmla(tmp, aa[7],  bb[9]);
-        sb_vmla(tmp, aa[8],  bb[8]);
-        sb_vmla(tmp, aa[9],  bb[7]);
-        sb_vmla(tmp, aa[10], bb[6]);
-        sb_vmla(tmp, aa[11], bb[5]);
-        sb_vmla(tmp, aa[12], bb[4]);
-        sb_vmla(tmp, aa[13], bb[3]);
-        sb_vmla(tmp, aa[14], bb[2]);
-        sb_vstore(&c_mem[32 * 0 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[3], bb[14]);
-        sb_vmla(tmp, aa[4], bb[13]);
-        sb_vmla(tmp, aa[5], bb[12]);
-        sb_vmla(tmp, aa[6], bb[11]);
-        sb_vmla(tmp, aa[7], bb[10]);
-        sb_vmla(tmp, aa[8], bb[9]);
-        sb_vmla(tmp, aa[9], bb[8]);
-        sb_vmla(tmp, aa[10], bb[7]);
-        sb_vmla(tmp, aa[11], bb[6]);
-        sb_vmla(tmp, aa[12], bb[5]);
-        sb_vmla(tmp, aa[13], bb[4]);
-        sb_vmla(tmp, aa[14], bb[3]);
-        sb_vstore(&c_mem[32 * 1 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[4], bb[14]);
-        sb_vmla(tmp, aa[5], bb[13]);
-        sb_vmla(tmp, aa[6], bb[12]);
-        sb_vmla(tmp, aa[7], bb[11]);
-        sb_vmla(tmp, aa[8], bb[10]);
-        sb_vmla(tmp, aa[9], bb[9]);
-        sb_vmla(tmp, aa[10], bb[8]);
-        sb_vmla(tmp, aa[11], bb[7]);
-        sb_vmla(tmp, aa[12], bb[6]);
-        sb_vmla(tmp, aa[13], bb[5]);
-        sb_vmla(tmp, aa[14], bb[4]);
-        sb_vstore(&c_mem[32 * 2 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[5],  bb[14]);
-        sb_vmla(tmp, aa[6],  bb[13]);
-        sb_vmla(tmp, aa[7],  bb[12]);
-        sb_vmla(tmp, aa[8],  bb[11]);
-        sb_vmla(tmp, aa[9],  bb[10]);
-        sb_vmla(tmp, aa[10], bb[9]);
-        sb_vmla(tmp, aa[11], bb[8]);
-        sb_vmla(tmp, aa[12], bb[7]);
-        sb_vmla(tmp, aa[13], bb[6]);
-        sb_vmla(tmp, aa[14], bb[5]);
-        sb_vstore(&c_mem[32 * 3 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[6],  bb[14]);
-        sb_vmla(tmp, aa[7],  bb[13]);
-        sb_vmla(tmp, aa[8],  bb[12]);
-        sb_vmla(tmp, aa[9],  bb[11]);
-        sb_vmla(tmp, aa[10], bb[10]);
-        sb_vmla(tmp, aa[11], bb[9]);
-        sb_vmla(tmp, aa[12], bb[8]);
-        sb_vmla(tmp, aa[13], bb[7]);
-        sb_vmla(tmp, aa[14], bb[6]);
-        sb_vstore(&c_mem[32 * 4 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[7],  bb[14]);
-        sb_vmla(tmp, aa[8],  bb[13]);
-        sb_vmla(tmp, aa[9],  bb[12]);
-        sb_vmla(tmp, aa[10], bb[11]);
-        sb_vmla(tmp, aa[11], bb[10]);
-        sb_vmla(tmp, aa[12], bb[9]);
-        sb_vmla(tmp, aa[13], bb[8]);
-        sb_vmla(tmp, aa[14], bb[7]);
-        sb_vstore(&c_mem[32 * 5 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[8],  bb[14]);
-        sb_vmla(tmp, aa[9],  bb[13]);
-        sb_vmla(tmp, aa[10], bb[12]);
-        sb_vmla(tmp, aa[11], bb[11]);
-        sb_vmla(tmp, aa[12], bb[10]);
-        sb_vmla(tmp, aa[13], bb[9]);
-        sb_vmla(tmp, aa[14], bb[8]);
-        sb_vstore(&c_mem[32 * 6 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[9], bb[14]);
-        sb_vmla(tmp, aa[10], bb[13]);
-        sb_vmla(tmp, aa[11], bb[12]);
-        sb_vmla(tmp, aa[12], bb[11]);
-        sb_vmla(tmp, aa[13], bb[10]);
-        sb_vmla(tmp, aa[14], bb[9]);
-        sb_vstore(&c_mem[32 * 7 + 16], tmp);
-        //-----
-        sb_vmul(tmp, aa[10], bb[14]);
-        sb_vmla(tmp, aa[11], bb[13]);
-        sb_vmla(tmp, aa[12], bb[12]);
-        sb_vmla(tmp, aa[13], bb[11]);
-        sb_vmla(tmp, aa[14], bb[10]);
-        sb_vstore(&c_mem[32 * 0 + 24], tmp);
-        //-----
-        sb_vmul(tmp, aa[11], bb[14]);
-        sb_vmla(tmp, aa[12], bb[13]);
-        sb_vmla(tmp, aa[13], bb[12]);
-        sb_vmla(tmp, aa[14], bb[11]);
-        sb_vstore(&c_mem[32 * 1 + 24], tmp);
-        //-----
-        sb_vmul(tmp, aa[12], bb[14]);
-        sb_vmla(tmp, aa[13], bb[13]);
-        sb_vmla(tmp, aa[14], bb[12]);
-        sb_vstore(&c_mem[32 * 2 + 24], tmp);
-        //-----
-        sb_vmul(tmp, aa[13], bb[14]);
-        sb_vmla(tmp, aa[14], bb[13]);
-        sb_vstore(&c_mem[32 * 3 + 24], tmp);
-        //-----
-        sb_vmul(tmp, aa[14], bb[14]);
-        sb_vstore(&c_mem[32 * 4 + 24], tmp);
-        //-----
-        sb_vstore(&c_mem[32 * 5 + 24], zero);
-        //-----
-        sb_vstore(&c_mem[32 * 6 + 24], zero);
-        //-----
-        sb_vstore(&c_mem[32 * 7 + 24], zero);
+        // Coefficients 24 to 31
+        sb_vload(bb, &b_mem[2 * 16 + 8]);
+        sb_vmul(cc[0], aa[14], bb);
+        sb_vload(bb, &b_mem[3 * 16 + 8]);
+        sb_vmla(cc[0], aa[13], bb);
+        sb_vmul(cc[1], aa[14], bb);
+        sb_vload(bb, &b_mem[4 * 16 + 8]);
+        sb_vmla(cc[0], aa[12], bb);
+        sb_vmla(cc[1], aa[13], bb);
+        sb_vmul(cc[2], aa[14], bb);
+        sb_vload(bb, &b_mem[5 * 16 + 8]);
+        sb_vmla(cc[0], aa[11], bb);
+        sb_vmla(cc[1], aa[12], bb);
+        sb_vmla(cc[2], aa[13], bb);
+        sb_vmul(cc[3], aa[14], bb);
+        sb_vload(bb, &b_mem[6 * 16 + 8]);
+        sb_vmla(cc[0], aa[10], bb);
+        sb_vmla(cc[1], aa[11], bb);
+        sb_vmla(cc[2], aa[12], bb);
+        sb_vmla(cc[3], aa[13], bb);
+        sb_vmul(cc[4], aa[14], bb);
+        sb_dup(cc[5], 0);
+        sb_dup(cc[6], 0);
+        sb_dup(cc[7], 0);
+        sb_transpose_8x8(cc);
+        sb_vstore(&c_mem[32 * 0 + 24], cc[0]);
+        sb_vstore(&c_mem[32 * 1 + 24], cc[1]);
+        sb_vstore(&c_mem[32 * 2 + 24], cc[2]);
+        sb_vstore(&c_mem[32 * 3 + 24], cc[3]);
+        sb_vstore(&c_mem[32 * 4 + 24], cc[4]);
+        sb_vstore(&c_mem[32 * 5 + 24], cc[5]);
+        sb_vstore(&c_mem[32 * 6 + 24], cc[6]);
+        sb_vstore(&c_mem[32 * 7 + 24], cc[7]);
 
         a_mem += 128;
         b_mem += 128;
@@ -591,16 +591,55 @@ void tc3_interpolate_neon_SB0(uint16_t *restrict poly, uint16_t *w[5])
     }
 }
 
+// Evaluate B and transpose it for the batch multiplication
+// Size: 240 to 64x16
 static
-void neon_toom_cook_422_combine(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB)
+void neon_toom_cook_422_evaluate(uint16_t *restrict tmp_bb, uint16_t *restrict polyB)
 {
     // TC4
-    uint16_t *aw[7], *bw[7], *cw[7];
+    uint16_t *bw[7];
+    uint16_t tmp_w[7*SB1_PAD];
+    uint16x8x2_t zero;
+
+    bw[0] = &tmp_w[0*SB1_PAD];
+    bw[1] = &tmp_w[1*SB1_PAD];
+    bw[2] = &tmp_w[2*SB1_PAD];
+    bw[3] = &tmp_w[3*SB1_PAD];
+    bw[4] = &tmp_w[4*SB1_PAD];
+    bw[5] = &tmp_w[5*SB1_PAD];
+    bw[6] = &tmp_w[6*SB1_PAD];
+    // DONE TC4
+
+    // Evaluate B, No Copy
+    // Size: 256 to 64x7
+    tc4_evaluate_neon_SB1(bw, polyB);
+
+    karat_neon_evaluate_combine(&tmp_bb[0*9*SB3_PAD], bw[0]);
+    karat_neon_evaluate_combine(&tmp_bb[1*9*SB3_PAD], bw[1]);
+    karat_neon_evaluate_combine(&tmp_bb[2*9*SB3_PAD], bw[2]);
+    karat_neon_evaluate_combine(&tmp_bb[3*9*SB3_PAD], bw[3]);
+    karat_neon_evaluate_combine(&tmp_bb[4*9*SB3_PAD], bw[4]);
+    karat_neon_evaluate_combine(&tmp_bb[5*9*SB3_PAD], bw[5]);
+    karat_neon_evaluate_combine(&tmp_bb[6*9*SB3_PAD], bw[6]);
+
+    // The 64th point is padding, keep it deterministic since tmp_bb may be cached
+    zero.val[0] = vmovq_n_u16(0);
+    zero.val[1] = vmovq_n_u16(0);
+    vstore_x2(&tmp_bb[63*SB3_PAD], zero);
+
+    // Transpose 8x8x16
+    half_transpose_8x16(tmp_bb);
+}
+
+// C = A * B, B evaluated by neon_toom_cook_422_evaluate
+static
+void neon_toom_cook_422_multiply(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict tmp_bb)
+{
+    // TC4
+    uint16_t *aw[7], *cw[7];
     // TC4-2-2 Combine
-    // Total Memory: 16*128 + 32*64 = 4096 16-bit coefficients
-    uint16_t tmp_aabb[SB3_PAD*128], tmp_cc[SB3_RES_PAD*64];
-    uint16_t *tmp_aa = &tmp_aabb[SB3_PAD*0],
-             *tmp_bb = &tmp_aabb[SB3_PAD*64];
+    // Total Memory: 16*64 + 32*64 = 3072 16-bit coefficients
+    uint16_t tmp_aa[SB3_PAD*64], tmp_cc[SB3_RES_PAD*64];
     // Done
     uint16x8x4_t zero;
 
@@ -613,32 +652,19 @@ void neon_toom_cook_422_combine(uint16_t *restrict polyC, uint16_t *restrict pol
     aw[5] = &tmp_cc[5*SB1_PAD];
     aw[6] = &tmp_cc[6*SB1_PAD];
 
-    bw[0] = &tmp_cc[7*SB1_PAD];
-    bw[1] = &tmp_cc[8*SB1_PAD];
-    bw[2] = &tmp_cc[9*SB1_PAD];
-    bw[3] = &tmp_cc[10*SB1_PAD];
-    bw[4] = &tmp_cc[11*SB1_PAD];
-    bw[5] = &tmp_cc[12*SB1_PAD];
-    bw[6] = &tmp_cc[13*SB1_PAD];
-
-    cw[0] = &tmp_aabb[0*SB1_RES];
-    cw[1] = &tmp_aabb[1*SB1_RES];
-    cw[2] = &tmp_aabb[2*SB1_RES];
-    cw[3] = &tmp_aabb[3*SB1_RES];
-    cw[4] = &tmp_aabb[4*SB1_RES];
-    cw[5] = &tmp_aabb[5*SB1_RES];
-    cw[6] = &tmp_aabb[6*SB1_RES];
+    cw[0] = &tmp_aa[0*SB1_RES];
+    cw[1] = &tmp_aa[1*SB1_RES];
+    cw[2] = &tmp_aa[2*SB1_RES];
+    cw[3] = &tmp_aa[3*SB1_RES];
+    cw[4] = &tmp_aa[4*SB1_RES];
+    cw[5] = &tmp_aa[5*SB1_RES];
+    cw[6] = &tmp_aa[6*SB1_RES];
     // DONE TC4
 
-    
     // Evaluate A, No Copy
     // Size: 256 to 64x7
     tc4_evaluate_neon_SB1(aw, polyA);
 
-    // Evaluate B, No Copy
-    // Size: 256 to 64x7
-    tc4_evaluate_neon_SB1(bw, polyB);
-
     karat_neon_evaluate_combine(&tmp_aa[0*9*SB3_PAD], aw[0]);
     karat_neon_evaluate_combine(&tmp_aa[1*9*SB3_PAD], aw[1]);
     karat_neon_evaluate_combine(&tmp_aa[2*9*SB3_PAD], aw[2]);
@@ -647,26 +673,13 @@ void neon_toom_cook_422_combine(uint16_t *restrict polyC, uint16_t *restrict pol
     karat_neon_evaluate_combine(&tmp_aa[5*9*SB3_PAD], aw[5]);
     karat_neon_evaluate_combine(&tmp_aa[6*9*SB3_PAD], aw[6]);
 
-    karat_neon_evaluate_combine(&tmp_bb[0*9*SB3_PAD], bw[0]);
-    karat_neon_evaluate_combine(&tmp_bb[1*9*SB3_PAD], bw[1]);
-    karat_neon_evaluate_combine(&tmp_bb[2*9*SB3_PAD], bw[2]);
-    karat_neon_evaluate_combine(&tmp_bb[3*9*SB3_PAD], bw[3]);
-    karat_neon_evaluate_combine(&tmp_bb[4*9*SB3_PAD], bw[4]);
-    karat_neon_evaluate_combine(&tmp_bb[5*9*SB3_PAD], bw[5]);
-    karat_neon_evaluate_combine(&tmp_bb[6*9*SB3_PAD], bw[6]);
-
-    // Transpose 8x8x16
-    half_transpose_8x16(tmp_aa);
-    half_transpose_8x16(tmp_bb);
-    // Batch multiplication
-    schoolbook_half_8x_neon(tmp_cc, tmp_aa, tmp_bb);
-    // Transpose 8x8x32
-    half_transpose_8x32(tmp_cc);
+    // Batch multiplication, transposing A and C in registers
+    schoolbook_half_8x_neon(tmp_cc, tmp_aa, (uint16_t *)tmp_bb);
 
     vzero(zero, 0);
     for (uint16_t addr = 0; addr < SB1_RES*7; addr+=32)
     {
-        vstore(&tmp_aabb[addr], zero);
+        vstore(&tmp_aa[addr], zero);
     }
 
     karat_neon_interpolate_combine(cw[0], &tmp_cc[0*9*SB3_RES_PAD]);
@@ -682,6 +695,15 @@ void neon_toom_cook_422_combine(uint16_t *restrict polyC, uint16_t *restrict pol
     tc4_interpolate_neon_SB1(polyC, cw);
 }
 
+static
+void neon_toom_cook_422_combine(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB)
+{
+    uint16_t tmp_bb[SB3_PAD*64];
+
+    neon_toom_cook_422_evaluate(tmp_bb, polyB);
+    neon_toom_cook_422_multiply(polyC, polyA, tmp_bb);
+}
+
 static
 void poly_neon_reduction(uint16_t *poly, uint16_t *tmp)
 {
@@ -769,6 +791,87 @@ void poly_mul_neon(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t
 }
 
 
+// Toom-Cook evaluation of B, 5 parts of SB3_PAD*64 coefficients
+static
+void poly_neon_expand(uint16_t *restrict polyE, uint16_t *restrict polyB)
+{
+    uint16_t *kbw[5];
+    // tc4_evaluate_neon_SB1 loads one coefficient past its part
+    uint16_t tmp_b[SB0 * 5 + 16];
+    uint16x8x2_t zero;
+
+    kbw[0] = &tmp_b[0 * SB0];
+    kbw[1] = &tmp_b[1 * SB0];
+    kbw[2] = &tmp_b[2 * SB0];
+    kbw[3] = &tmp_b[3 * SB0];
+    kbw[4] = &tmp_b[4 * SB0];
+
+    zero.val[0] = vmovq_n_u16(0);
+    zero.val[1] = vmovq_n_u16(0);
+    vstore_x2(&tmp_b[5 * SB0], zero);
+
+    // Toom-Cook-3 Evaluate B
+    tc3_evaluate_neon_SB0(kbw, polyB);
+
+    // Toom Cook 4-way evaluate
+    neon_toom_cook_422_evaluate(&polyE[0*SB3_PAD*64], kbw[0]);
+    neon_toom_cook_422_evaluate(&polyE[1*SB3_PAD*64], kbw[1]);
+    neon_toom_cook_422_evaluate(&polyE[2*SB3_PAD*64], kbw[2]);
+    neon_toom_cook_422_evaluate(&polyE[3*SB3_PAD*64], kbw[3]);
+    neon_toom_cook_422_evaluate(&polyE[4*SB3_PAD*64], kbw[4]);
+}
+
+// poly_mul_neon with B already evaluated by poly_neon_expand
+static
+void poly_neon_mul_expanded(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict polyE)
+{
+    uint16x8x4_t zero;
+    uint16_t *kaw[5], *kcw[5];
+    uint16_t tmp_a[SB0_RES * 3];
+    uint16_t tmp_c[SB0_RES * 5];
+
+    kaw[0] = &tmp_a[0 * SB0];
+    kaw[1] = &tmp_a[1 * SB0];
+    kaw[2] = &tmp_a[2 * SB0];
+    kaw[3] = &tmp_a[3 * SB0];
+    kaw[4] = &tmp_a[4 * SB0];
+
+    kcw[0] = &tmp_c[0 * SB0_RES];
+    kcw[1] = &tmp_c[1 * SB0_RES];
+    kcw[2] = &tmp_c[2 * SB0_RES];
+    kcw[3] = &tmp_c[3 * SB0_RES];
+    kcw[4] = &tmp_c[4 * SB0_RES];
+
+    vzero(zero, 0);
+    for (uint16_t addr = 0; addr < SB0_RES * 5; addr += 32)
+    {
+        vstore(&tmp_c[addr], zero);
+    }
+
+    // Toom-Cook-3 Evaluate A
+    tc3_evaluate_neon_SB0(kaw, polyA);
+
+    // Toom Cook 4-way multiply
+    neon_toom_cook_422_multiply(kcw[0], kaw[0], &polyE[0*SB3_PAD*64]);
+    neon_toom_cook_422_multiply(kcw[1], kaw[1], &polyE[1*SB3_PAD*64]);
+    neon_toom_cook_422_multiply(kcw[2], kaw[2], &polyE[2*SB3_PAD*64]);
+    neon_toom_cook_422_multiply(kcw[3], kaw[3], &polyE[3*SB3_PAD*64]);
+    neon_toom_cook_422_multiply(kcw[4], kaw[4], &polyE[4*SB3_PAD*64]);
+
+    // Toom-Cook-3 Interpolate
+    // * Re-use tmp_a
+    for (uint16_t addr = 0; addr < SB0_RES * 3; addr += 32)
+    {
+        vstore(&tmp_a[addr], zero);
+    }
+    tc3_interpolate_neon_SB0(tmp_a, kcw);
+
+    // Ring reduction
+    // Reduce from 1440 -> 720
+    poly_neon_reduction(polyC, tmp_a);
+}
+
+
 // store c <= a
 #define polyrq_vstore_const(c, a) \
     vst1q_u16(c +  0, a);         \
@@ -810,3 +913,43 @@ void poly_Rq_mul(poly *r, poly *a, poly *b)
     poly_mul_neon(r->coeffs, a->coeffs, b->coeffs);
     
 }
+
+void poly_Rq_expand(poly_expanded *r, poly *b)
+{
+    // Must zero garbage data at the end
+
+    uint16x8_t last;
+    last = vdupq_n_u16(0);
+
+    // 677, 678, 679
+    b->coeffs[NTRU_N] = 0;
+    b->coeffs[NTRU_N+1] = 0;
+    b->coeffs[NTRU_N+2] = 0;
+
+    // 680 + 32 = 712
+    polyrq_vstore_const(&b->coeffs[NTRU_N + 3], last);
+    // 712 -> 720
+    polyrq_vstore_x1(&b->coeffs[NTRU_N + 35], last);
+
+    poly_neon_expand(r->coeffs, b->coeffs);
+}
+
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b)
+{
+    // Must zero garbage data at the end
+
+    uint16x8_t last;
+    last = vdupq_n_u16(0);
+
+    // 677, 678, 679
+    a->coeffs[NTRU_N] = 0;
+    a->coeffs[NTRU_N+1] = 0;
+    a->coeffs[NTRU_N+2] = 0;
+
+    // 680 + 32 = 712
+    polyrq_vstore_const(&a->coeffs[NTRU_N + 3], last);
+    // 712 -> 720
+    polyrq_vstore_x1(&a->coeffs[NTRU_N + 35], last);
+
+    poly_neon_mul_expanded(r->coeffs, a->coeffs, b->coeffs);
+}
@@ -0,0 +1,298 @@
+#include "poly.h"
+#include "neon_z3_bitsliced.h"
+
+#include <arm_neon.h>
+
+/* Bitsliced multiplication in S3. The trits of a and b are packed 64 to a word, in the lo and hi planes of       */
+/* neon_z3_bitsliced.h, and multiplied by Karatsuba down to products of single words. These run two at a time, one */
+/* in each lane of the NEON registers, by Horner's rule on the trits of b: 64 times, the 128-trit product so far  */
+/* is multiplied by x and the next trit of b times a is added to it. The product is then folded mod (x^n - 1) and  */
+/* reduced mod Phi_n. The sequence of operations only depends on n.                                                */
+
+#define S3_WORDS ((NTRU_N + 63) / 64)
+
+/* Karatsuba on n words takes fewer than n^2 products of single words, plus one to pair them up */
+#define S3_PRODUCTS (S3_WORDS * S3_WORDS + 1)
+
+typedef struct {
+    /* The operands of the products of single words, then the products, two words each */
+    uint64_t alo[S3_PRODUCTS], ahi[S3_PRODUCTS];
+    uint64_t blo[S3_PRODUCTS], bhi[S3_PRODUCTS];
+    uint64_t clo[2 * S3_PRODUCTS], chi[2 * S3_PRODUCTS];
+    size_t count;
+} s3_karatsuba;
+
+/* c = a + b on n words, c may alias a or b. a - b is a + b with the planes of b swapped */
+static void s3_add(uint64_t *clo, uint64_t *chi, uint64_t *alo, uint64_t *ahi, uint64_t *blo, uint64_t *bhi, size_t n) {
+    size_t i;
+
+    for(i = 0; i < n; i++){
+        add_Z3_bitsliced(clo + i, chi + i, alo + i, ahi + i, blo + i, bhi + i);
+    }
+}
+
+static void s3_karatsuba_push(s3_karatsuba *k, uint64_t alo, uint64_t ahi, uint64_t blo, uint64_t bhi) {
+    k->alo[k->count] = alo;
+    k->ahi[k->count] = ahi;
+    k->blo[k->count] = blo;
+    k->bhi[k->count] = bhi;
+    k->count++;
+}
+
+/* Queues the products of single words that a*b on n words takes */
+static void s3_karatsuba_evaluate(s3_karatsuba *k, uint64_t *alo, uint64_t *ahi, uint64_t *blo, uint64_t *bhi, size_t n) {
+    uint64_t slo[S3_WORDS], shi[S3_WORDS], tlo[S3_WORDS], thi[S3_WORDS];
+    size_t i, j, l, h;
+
+    if(n == 1){
+        s3_karatsuba_push(k, alo[0], ahi[0], blo[0], bhi[0]);
+        return;
+    }
+
+    if(n == 3){
+        /* Three-way: a_i b_i for each i, then (a_i + a_j)(b_i + b_j) for each i < j */
+        for(i = 0; i < 3; i++){
+            s3_karatsuba_push(k, alo[i], ahi[i], blo[i], bhi[i]);
+        }
+        for(i = 0; i < 2; i++){
+            for(j = i + 1; j < 3; j++){
+                add_Z3_bitsliced(slo, shi, alo + i, ahi + i, alo + j, ahi + j);
+                add_Z3_bitsliced(tlo, thi, blo + i, bhi + i, blo + j, bhi + j);
+                s3_karatsuba_push(k, slo[0], shi[0], tlo[0], thi[0]);
+            }
+        }
+        return;
+    }
+
+    /* a = a0 + x^(64l) a1, and the same for b, with a1 and b1 of h <= l words */
+    l = (n + 1) / 2;
+    h = n - l;
+
+    s3_karatsuba_evaluate(k, alo, ahi, blo, bhi, l);
+    s3_karatsuba_evaluate(k, alo + l, ahi + l, blo + l, bhi + l, h);
+
+    for(i = 0; i < l; i++){
+        slo[i] = alo[i];
+        shi[i] = ahi[i];
+        tlo[i] = blo[i];
+        thi[i] = bhi[i];
+    }
+    s3_add(slo, shi, slo, shi, alo + l, ahi + l, h);
+    s3_add(tlo, thi, tlo, thi, blo + l, bhi + l, h);
+    s3_karatsuba_evaluate(k, slo, shi, tlo, thi, l);
+}
+
+/* c = a*b on 2n words, from the products queued by s3_karatsuba_evaluate in the same order */
+static void s3_karatsuba_interpolate(s3_karatsuba *k, uint64_t *clo, uint64_t *chi, size_t n) {
+    uint64_t mlo[2 * S3_WORDS], mhi[2 * S3_WORDS];
+    uint64_t *plo, *phi;
+    size_t i, j, l, h;
+
+    if(n == 1){
+        for(i = 0; i < 2; i++){
+            clo[i] = k->clo[2 * k->count + i];
+            chi[i] = k->chi[2 * k->count + i];
+        }
+        k->count++;
+        return;
+    }
+
+    if(n == 3){
+        /* c = sum of a_i b_i x^(128i), plus ((a_i + a_j)(b_i + b_j) - a_i b_i - a_j b_j) x^(64(i+j)) for i < j */
+        plo = k->clo + 2 * k->count;
+        phi = k->chi + 2 * k->count;
+        for(i = 0; i < 6; i++){
+            clo[i] = plo[i];
+            chi[i] = phi[i];
+        }
+        plo += 6;
+        phi += 6;
+        for(i = 0; i < 2; i++){
+            for(j = i + 1; j < 3; j++){
+                s3_add(mlo, mhi, plo, phi, k->chi + 2 * (k->count + i), k->clo + 2 * (k->count + i), 2);
+                s3_add(mlo, mhi, mlo, mhi, k->chi + 2 * (k->count + j), k->clo + 2 * (k->count + j), 2);
+                s3_add(clo + i + j, chi + i + j, clo + i + j, chi + i + j, mlo, mhi, 2);
+                plo += 2;
+                phi += 2;
+            }
+        }
+        k->count += 6;
+        return;
+    }
+
+    l = (n + 1) / 2;
+    h = n - l;
+
+    s3_karatsuba_interpolate(k, clo, chi, l);
+    s3_karatsuba_interpolate(k, clo + 2 * l, chi + 2 * l, h);
+    s3_karatsuba_interpolate(k, mlo, mhi, l);
+
+    /* c += x^(64l) ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) */
+    s3_add(mlo, mhi, mlo, mhi, chi, clo, 2 * l);
+    s3_add(mlo, mhi, mlo, mhi, chi + 2 * l, clo + 2 * l, 2 * h);
+    s3_add(clo + l, chi + l, clo + l, chi + l, mlo, mhi, 2 * l);
+}
+
+/* (hi, lo) = x (hi, lo), for the 128 trits of each lane, lo holding their low word */
+static inline void s3_mul_x(uint8x16_t *hi, uint8x16_t *lo) {
+    uint64x2_t h = vreinterpretq_u64_u8(*hi);
+    uint64x2_t l = vreinterpretq_u64_u8(*lo);
+
+    *hi = vreinterpretq_u8_u64(vsliq_n_u64(vshrq_n_u64(l, 63), h, 1));
+    *lo = vreinterpretq_u8_u64(vshlq_n_u64(l, 1));
+}
+
+/* The products of words a[0] b[0] and a[1] b[1], into words c[0], c[1] and c[2], c[3] */
+static void s3_mul_word_pair(uint64_t clo[4], uint64_t chi[4], const uint64_t alo[2], const uint64_t ahi[2],
+    const uint64_t blo[2], const uint64_t bhi[2]) {
+
+    uint8x16_t xlo, xhi, signlo, signhi, tlo, thi;
+    uint8x16_t acclo0, acchi0, acclo1, acchi1;
+    uint64x2_t ylo, yhi, bit;
+    uint64x2x2_t c;
+    size_t j;
+
+    xlo = vreinterpretq_u8_u64(vld1q_u64(alo));
+    xhi = vreinterpretq_u8_u64(vld1q_u64(ahi));
+    ylo = vld1q_u64(blo);
+    yhi = vld1q_u64(bhi);
+
+    acclo0 = vdupq_n_u8(0);
+    acchi0 = vdupq_n_u8(0);
+    acclo1 = vdupq_n_u8(0);
+    acchi1 = vdupq_n_u8(0);
+    bit = vdupq_n_u64(1ULL << 63);
+
+    for(j = 0; j < 64; j++){
+        s3_mul_x(&acclo1, &acclo0);
+        s3_mul_x(&acchi1, &acchi0);
+
+        signlo = vreinterpretq_u8_u64(vtstq_u64(ylo, bit));
+        signhi = vreinterpretq_u8_u64(vtstq_u64(yhi, bit));
+        bit = vshrq_n_u64(bit, 1);
+
+        mul_Z3_bitsliced_uint8x16(&tlo, &thi, &signlo, &signhi, &xlo, &xhi);
+        add_Z3_bitsliced_uint8x16(&acclo0, &acchi0, &acclo0, &acchi0, &tlo, &thi);
+    }
+
+    c.val[0] = vreinterpretq_u64_u8(acclo0);
+    c.val[1] = vreinterpretq_u64_u8(acclo1);
+    vst2q_u64(clo, c);
+    c.val[0] = vreinterpretq_u64_u8(acchi0);
+    c.val[1] = vreinterpretq_u64_u8(acchi1);
+    vst2q_u64(chi, c);
+}
+
+/* Bit 0 of coefficients 4i + k of a word in lane i of c0.val[k] (i < 8) or c1.val[k] (i >= 8), packed in order */
+static uint64_t s3_pack_bits(uint16x8x4_t c0, uint16x8x4_t c1) {
+    uint16x8_t n0, n1;
+
+    n0 = vsliq_n_u16(c0.val[0], c0.val[1], 1);
+    n0 = vsliq_n_u16(n0, c0.val[2], 2);
+    n0 = vsliq_n_u16(n0, c0.val[3], 3);
+    n1 = vsliq_n_u16(c1.val[0], c1.val[1], 1);
+    n1 = vsliq_n_u16(n1, c1.val[2], 2);
+    n1 = vsliq_n_u16(n1, c1.val[3], 3);
+
+    /* Nibbles 2i and 2i + 1 into byte i */
+    n0 = vsliq_n_u16(vuzp1q_u16(n0, n1), vuzp2q_u16(n0, n1), 4);
+
+    return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(n0)), 0);
+}
+
+/* The trits of a, in {0, 1, 2}, into words */
+static void s3_pack(uint64_t lo[S3_WORDS], uint64_t hi[S3_WORDS], const poly *a) {
+    uint16x8x4_t c0, c1;
+    size_t i, k;
+
+    for(i = 0; i < S3_WORDS; i++){
+        c0 = vld4q_u16(a->coeffs + 64 * i);
+        c1 = vld4q_u16(a->coeffs + 64 * i + 32);
+        lo[i] = s3_pack_bits(c0, c1);
+        for(k = 0; k < 4; k++){
+            c0.val[k] = vshrq_n_u16(c0.val[k], 1);
+            c1.val[k] = vshrq_n_u16(c1.val[k], 1);
+        }
+        hi[i] = s3_pack_bits(c0, c1);
+    }
+    lo[S3_WORDS - 1] &= (1ULL << (NTRU_N % 64)) - 1;
+    hi[S3_WORDS - 1] &= (1ULL << (NTRU_N % 64)) - 1;
+}
+
+/* Nibble i of x in lane i of n0 (i < 8) or n1 (i >= 8) */
+static void s3_unpack_nibbles(uint16x8_t *n0, uint16x8_t *n1, uint64_t x) {
+    uint8x8_t b = vreinterpret_u8_u64(vcreate_u64(x));
+    uint8x8x2_t n = vzip_u8(vand_u8(b, vdup_n_u8(15)), vshr_n_u8(b, 4));
+
+    *n0 = vmovl_u8(n.val[0]);
+    *n1 = vmovl_u8(n.val[1]);
+}
+
+/* The words of r into its coefficients, in {0, 1, 2} */
+static void s3_unpack(poly *r, const uint64_t lo[S3_WORDS], const uint64_t hi[S3_WORDS]) {
+    uint16x8_t lo0, lo1, hi0, hi1, one = vdupq_n_u16(1);
+    uint16x8x4_t c0, c1;
+    size_t i;
+
+    for(i = 0; i < S3_WORDS; i++){
+        s3_unpack_nibbles(&lo0, &lo1, lo[i]);
+        s3_unpack_nibbles(&hi0, &hi1, hi[i]);
+
+        c0.val[0] = vsliq_n_u16(lo0, vandq_u16(hi0, one), 1);
+        c0.val[1] = vsliq_n_u16(vshrq_n_u16(lo0, 1), vandq_u16(vshrq_n_u16(hi0, 1), one), 1);
+        c0.val[2] = vsliq_n_u16(vshrq_n_u16(lo0, 2), vandq_u16(vshrq_n_u16(hi0, 2), one), 1);
+        c0.val[3] = vsliq_n_u16(vshrq_n_u16(lo0, 3), vshrq_n_u16(hi0, 3), 1);
+        c1.val[0] = vsliq_n_u16(lo1, vandq_u16(hi1, one), 1);
+        c1.val[1] = vsliq_n_u16(vshrq_n_u16(lo1, 1), vandq_u16(vshrq_n_u16(hi1, 1), one), 1);
+        c1.val[2] = vsliq_n_u16(vshrq_n_u16(lo1, 2), vandq_u16(vshrq_n_u16(hi1, 2), one), 1);
+        c1.val[3] = vsliq_n_u16(vshrq_n_u16(lo1, 3), vshrq_n_u16(hi1, 3), 1);
+
+        vst4q_u16(r->coeffs + 64 * i, c0);
+        vst4q_u16(r->coeffs + 64 * i + 32, c1);
+    }
+}
+
+void poly_S3_mul_bitsliced(poly *r, poly *a, poly *b) {
+
+    uint64_t alo[S3_WORDS], ahi[S3_WORDS], blo[S3_WORDS], bhi[S3_WORDS];
+    uint64_t clo[2 * S3_WORDS], chi[2 * S3_WORDS];
+    uint64_t signlo, signhi;
+    s3_karatsuba k;
+    size_t i;
+
+    s3_pack(alo, ahi, a);
+    s3_pack(blo, bhi, b);
+
+    k.count = 0;
+    s3_karatsuba_evaluate(&k, alo, ahi, blo, bhi, S3_WORDS);
+    if(k.count % 2){
+        s3_karatsuba_push(&k, 0, 0, 0, 0);
+    }
+
+    for(i = 0; i < k.count; i += 2){
+        s3_mul_word_pair(k.clo + 2 * i, k.chi + 2 * i, k.alo + i, k.ahi + i, k.blo + i, k.bhi + i);
+    }
+
+    k.count = 0;
+    s3_karatsuba_interpolate(&k, clo, chi, S3_WORDS);
+
+    /* Fold mod (x^n - 1): coefficient i of a*b goes to i - n from i = n on */
+    for(i = 0; i < S3_WORDS; i++){
+        alo[i] = (clo[NTRU_N / 64 + i] >> (NTRU_N % 64)) | (clo[NTRU_N / 64 + i + 1] << (64 - NTRU_N % 64));
+        ahi[i] = (chi[NTRU_N / 64 + i] >> (NTRU_N % 64)) | (chi[NTRU_N / 64 + i + 1] << (64 - NTRU_N % 64));
+    }
+    clo[S3_WORDS - 1] &= (1ULL << (NTRU_N % 64)) - 1;
+    chi[S3_WORDS - 1] &= (1ULL << (NTRU_N % 64)) - 1;
+    s3_add(clo, chi, clo, chi, alo, ahi, S3_WORDS);
+
+    /* Reduce mod Phi_n: subtract coefficient n - 1 from all of them */
+    signlo = -((clo[(NTRU_N - 1) / 64] >> ((NTRU_N - 1) % 64)) & 1);
+    signhi = -((chi[(NTRU_N - 1) / 64] >> ((NTRU_N - 1) % 64)) & 1);
+    for(i = 0; i < S3_WORDS; i++){
+        add_Z3_bitsliced(clo + i, chi + i, clo + i, chi + i, &signhi, &signlo);
+    }
+    clo[S3_WORDS - 1] &= (1ULL << (NTRU_N % 64)) - 1;
+    chi[S3_WORDS - 1] &= (1ULL << (NTRU_N % 64)) - 1;
+
+    s3_unpack(r, clo, chi);
+}
@@ -14,6 +14,14 @@ typedef struct{
   uint16_t coeffs[NTRU_N_PAD];
 } poly;
 
+// The multiplicand b of poly_Rq_mul in the evaluated and transposed form of the NEON multiplier
+// (5 Toom-Cook-3 parts of 64 Toom-Cook/Karatsuba points, 16 coefficients each)
+#define NTRU_N_EXPANDED 5120
+
+typedef struct{
+  uint16_t coeffs[NTRU_N_EXPANDED];
+} poly_expanded;
+
 #define poly_mod_3_Phi_n CRYPTO_NAMESPACE(poly_mod_3_Phi_n)
 #define poly_mod_q_Phi_n CRYPTO_NAMESPACE(poly_mod_q_Phi_n)
 void poly_mod_3_Phi_n(poly *r);
@@ -49,6 +57,19 @@ void poly_lift_add(poly *ct, const poly *a);
 void poly_lift_sub(poly *b, const poly *c, const poly *a);
 void poly_Rq_to_S3(poly *r, const poly *a);
 
+// The two engines behind poly_S3_mul: poly_Rq_mul followed by the reduction mod (3, Phi_n) (default), or Karatsuba
+// on bitsliced trits (S3_MUL_BITSLICED)
+#define poly_S3_mul_rq CRYPTO_NAMESPACE(poly_S3_mul_rq)
+#define poly_S3_mul_bitsliced CRYPTO_NAMESPACE(poly_S3_mul_bitsliced)
+void poly_S3_mul_rq(poly *r, poly *a, poly *b);
+void poly_S3_mul_bitsliced(poly *r, poly *a, poly *b);
+
+// poly_Rq_mul(r, a, b) in two steps, so that the evaluation of a fixed b is done once
+#define poly_Rq_expand CRYPTO_NAMESPACE(poly_Rq_expand)
+#define poly_Rq_mul_expanded CRYPTO_NAMESPACE(poly_Rq_mul_expanded)
+void poly_Rq_expand(poly_expanded *r, poly *b);
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b);
+
 #define poly_R2_inv CRYPTO_NAMESPACE(poly_R2_inv)
 #define poly_Rq_inv CRYPTO_NAMESPACE(poly_Rq_inv)
 #define poly_S3_inv CRYPTO_NAMESPACE(poly_S3_inv)
@@ -56,6 +77,23 @@ void poly_R2_inv(poly *r, const poly *a);
 void poly_Rq_inv(poly *r, const poly *a);
 void poly_S3_inv(poly *r, const poly *a);
 
+// The engines behind poly_R2_inv: divsteps on bit arrays (default), Itoh-Tsujii exponentiation with carry-less
+// multiplications (R2_INV_CLMUL), or divsteps in blocks of 63 applied as 2x2 matrices of carry-less products
+// (INV_JUMPDIVSTEP)
+#define poly_R2_inv_divstep CRYPTO_NAMESPACE(poly_R2_inv_divstep)
+#define poly_R2_inv_clmul CRYPTO_NAMESPACE(poly_R2_inv_clmul)
+#define poly_R2_inv_jumpdivstep CRYPTO_NAMESPACE(poly_R2_inv_jumpdivstep)
+void poly_R2_inv_divstep(poly *r, const poly *a);
+void poly_R2_inv_clmul(poly *r, const poly *a);
+void poly_R2_inv_jumpdivstep(poly *r, const poly *a);
+
+// The two engines behind poly_S3_inv: divsteps on bit arrays (default), or the same divsteps in blocks of 64
+// whose transitions are computed on the low words of f and g (INV_JUMPDIVSTEP)
+#define poly_S3_inv_divstep CRYPTO_NAMESPACE(poly_S3_inv_divstep)
+#define poly_S3_inv_jumpdivstep CRYPTO_NAMESPACE(poly_S3_inv_jumpdivstep)
+void poly_S3_inv_divstep(poly *r, const poly *a);
+void poly_S3_inv_jumpdivstep(poly *r, const poly *a);
+
 #define poly_Z3_to_Zq CRYPTO_NAMESPACE(poly_Z3_to_Zq)
 #define poly_trinary_Zq_to_Z3 CRYPTO_NAMESPACE(poly_trinary_Zq_to_Z3)
 void poly_Z3_to_Zq(poly *r);
@@ -12,7 +12,7 @@ static inline int16_t both_negative_mask(int16_t x, int16_t y) {
     return (x & y) >> 15;
 }
 
-void poly_R2_inv(poly *r, const poly *a) {
+void poly_R2_inv_divstep(poly *r, const poly *a) {
 
     uint64_t f[BITARRAY_SIZE];
     uint64_t g[BITARRAY_SIZE];
@@ -83,3 +83,360 @@ void poly_R2_inv(poly *r, const poly *a) {
     }
     r->coeffs[NTRU_N - 1] = 0;
 }
+
+/* Itoh-Tsujii inversion. Phi_n is irreducible mod 2, so R2 is the field with 2^(n-1) elements and       */
+/* 1/a = a^(2^(n-1)-2) = (a^(2^(n-2)-1))^2. The powers are computed mod (2, x^n-1), which only adds a     */
+/* factor GF(2) that the final reduction mod Phi_n drops, and where squaring is linear. The sequence of    */
+/* squarings and multiplications only depends on n.                                                        */
+
+#if NTRU_N % 64 == 0
+#error "r2_fold in poly_r2_inv.c assumes that 64 does not divide n"
+#endif
+
+#define R2_WORDS ((NTRU_N + 63) / 64)
+
+/* Above this many squarings (R2_WORDS PMULLs each), r2_pow2k moves the n coefficients one by one instead */
+#define R2_SQUARINGS_MAX 64
+
+/* r = t mod (x^n-1), for t of degree < 2n-1 */
+static void r2_fold(uint64_t r[R2_WORDS], const uint64_t t[2 * R2_WORDS]) {
+    size_t i;
+
+    for(i = 0; i < R2_WORDS; i++){
+        r[i] = t[i] ^ (t[NTRU_N / 64 + i] >> (NTRU_N % 64)) ^ (t[NTRU_N / 64 + i + 1] << (64 - NTRU_N % 64));
+    }
+    r[R2_WORDS - 1] ^= t[R2_WORDS - 1] & ~((1ULL << (NTRU_N % 64)) - 1);
+}
+
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+
+/* t = a*b, with 64x64-bit carry-less multiplications (PMULL) */
+static void r2_clmul(uint64_t t[2 * R2_WORDS], const uint64_t a[R2_WORDS], const uint64_t b[R2_WORDS]) {
+    uint64x2_t acc[2 * R2_WORDS - 1];
+    size_t i, j;
+
+    for(i = 0; i < 2 * R2_WORDS - 1; i++){
+        acc[i] = vdupq_n_u64(0);
+    }
+    for(i = 0; i < R2_WORDS; i++){
+        for(j = 0; j < R2_WORDS; j++){
+            acc[i + j] = veorq_u64(acc[i + j], vreinterpretq_u64_p128(vmull_p64((poly64_t)a[i], (poly64_t)b[j])));
+        }
+    }
+
+    t[0] = 0;
+    for(i = 0; i < 2 * R2_WORDS - 1; i++){
+        t[i] ^= vgetq_lane_u64(acc[i], 0);
+        t[i + 1] = vgetq_lane_u64(acc[i], 1);
+    }
+}
+
+/* t = a^2, the cross terms cancel out */
+static void r2_clsqr(uint64_t t[2 * R2_WORDS], const uint64_t a[R2_WORDS]) {
+    uint64x2_t sq;
+    size_t i;
+
+    for(i = 0; i < R2_WORDS; i++){
+        sq = vreinterpretq_u64_p128(vmull_p64((poly64_t)a[i], (poly64_t)a[i]));
+        t[2 * i] = vgetq_lane_u64(sq, 0);
+        t[2 * i + 1] = vgetq_lane_u64(sq, 1);
+    }
+}
+
+/* t = a*x + b*y, for x and y of len words and t of len + 1 */
+static void r2_lincomb(uint64_t *t, uint64_t a, const uint64_t *x, uint64_t b, const uint64_t *y, size_t len) {
+    uint64x2_t acc;
+    size_t i;
+
+    t[0] = 0;
+    for(i = 0; i < len; i++){
+        acc = veorq_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t)a, (poly64_t)x[i])),
+                        vreinterpretq_u64_p128(vmull_p64((poly64_t)b, (poly64_t)y[i])));
+        t[i] ^= vgetq_lane_u64(acc, 0);
+        t[i + 1] = vgetq_lane_u64(acc, 1);
+    }
+}
+
+#else
+
+/* Constant-time 64x64-bit carry-less multiplication for cores without PMULL */
+static void clmul64(uint64_t *lo, uint64_t *hi, uint64_t a, uint64_t b) {
+    uint64_t l = 0, h = 0, mask;
+    size_t i;
+
+    for(i = 0; i < 64; i++){
+        mask = -((b >> i) & 1);
+        l ^= (a << i) & mask;
+        h ^= ((a >> 1) >> (63 - i)) & mask;
+    }
+    *lo = l;
+    *hi = h;
+}
+
+/* t = a*b */
+static void r2_clmul(uint64_t t[2 * R2_WORDS], const uint64_t a[R2_WORDS], const uint64_t b[R2_WORDS]) {
+    uint64_t lo, hi;
+    size_t i, j;
+
+    for(i = 0; i < 2 * R2_WORDS; i++){
+        t[i] = 0;
+    }
+    for(i = 0; i < R2_WORDS; i++){
+        for(j = 0; j < R2_WORDS; j++){
+            clmul64(&lo, &hi, a[i], b[j]);
+            t[i + j] ^= lo;
+            t[i + j + 1] ^= hi;
+        }
+    }
+}
+
+/* t = a^2, the cross terms cancel out */
+static void r2_clsqr(uint64_t t[2 * R2_WORDS], const uint64_t a[R2_WORDS]) {
+    size_t i;
+
+    for(i = 0; i < R2_WORDS; i++){
+        clmul64(&t[2 * i], &t[2 * i + 1], a[i], a[i]);
+    }
+}
+
+/* t = a*x + b*y, for x and y of len words and t of len + 1 */
+static void r2_lincomb(uint64_t *t, uint64_t a, const uint64_t *x, uint64_t b, const uint64_t *y, size_t len) {
+    uint64_t lo, hi;
+    size_t i;
+
+    t[0] = 0;
+    for(i = 0; i < len; i++){
+        clmul64(&lo, &hi, a, x[i]);
+        t[i] ^= lo;
+        t[i + 1] = hi;
+        clmul64(&lo, &hi, b, y[i]);
+        t[i] ^= lo;
+        t[i + 1] ^= hi;
+    }
+}
+
+#endif
+
+/* r = a*b mod (2, x^n-1), r may alias a or b */
+static void r2_mul(uint64_t r[R2_WORDS], const uint64_t a[R2_WORDS], const uint64_t b[R2_WORDS]) {
+    uint64_t t[2 * R2_WORDS];
+
+    r2_clmul(t, a, b);
+    r2_fold(r, t);
+}
+
+/* r = a^2 mod (2, x^n-1), r may alias a */
+static void r2_sqr(uint64_t r[R2_WORDS], const uint64_t a[R2_WORDS]) {
+    uint64_t t[2 * R2_WORDS];
+
+    r2_clsqr(t, a);
+    r2_fold(r, t);
+}
+
+/* r = a^(2^k) mod (2, x^n-1), r and a distinct */
+static void r2_pow2k(uint64_t r[R2_WORDS], const uint64_t a[R2_WORDS], size_t k) {
+    size_t i, src, step;
+
+    if(k <= R2_SQUARINGS_MAX){
+        r2_sqr(r, a);
+        for(i = 1; i < k; i++){
+            r2_sqr(r, r);
+        }
+        return;
+    }
+
+    /* Otherwise x^i -> x^(i*2^k mod n): coefficient i of r is coefficient i*2^(-k) mod n of a */
+    step = 1;
+    for(i = 0; i < k; i++){
+        step = step * ((NTRU_N + 1) / 2) % NTRU_N;
+    }
+
+    for(i = 0; i < R2_WORDS; i++){
+        r[i] = 0;
+    }
+    src = 0;
+    for(i = 0; i < NTRU_N; i++){
+        r[i / 64] |= ((a[src / 64] >> (src % 64)) & 1) << (i % 64);
+        src += step;
+        if(src >= NTRU_N){
+            src -= NTRU_N;
+        }
+    }
+}
+
+void poly_R2_inv_clmul(poly *r, const poly *a) {
+
+    uint64_t x[R2_WORDS];
+    uint64_t b[R2_WORDS];
+    uint64_t t[R2_WORDS];
+    size_t i, m;
+    int bit;
+
+    for(i = 0; i < R2_WORDS; i++){
+        x[i] = 0;
+    }
+    for(i = 0; i < NTRU_N; i++){
+        x[i / 64] |= ((uint64_t)(a->coeffs[i] & 1)) << (i % 64);
+    }
+
+    /* b = x^(2^m-1), with m running through the leading bits of n-2: */
+    /* x^(2^2m-1) = (x^(2^m-1))^(2^m) * x^(2^m-1) and x^(2^(m+1)-1) = (x^(2^m-1))^2 * x */
+    for(bit = 0; (NTRU_N - 2) >> (bit + 1); bit++);
+
+    for(i = 0; i < R2_WORDS; i++){
+        b[i] = x[i];
+    }
+    m = 1;
+
+    while(bit-- > 0){
+        r2_pow2k(t, b, m);
+        r2_mul(b, t, b);
+        m *= 2;
+
+        if(((NTRU_N - 2) >> bit) & 1){
+            r2_sqr(t, b);
+            r2_mul(b, t, x);
+            m += 1;
+        }
+    }
+
+    r2_sqr(t, b);
+
+    /* Reduce mod Phi_n */
+    for(i = 0; i < NTRU_N - 1; i++){
+        r->coeffs[i] = ((t[i / 64] >> (i % 64)) ^ (t[(NTRU_N - 1) / 64] >> ((NTRU_N - 1) % 64))) & 1;
+    }
+    r->coeffs[NTRU_N - 1] = 0;
+}
+
+/* Jump divsteps. The decisions of the next 63 divsteps only depend on delta and on the 64 low bits of f and g, so */
+/* the block is first run on these words alone, which gives the 2x2 matrices p and q of polynomials of degree at   */
+/* most 63 with (f, g) = p (f, g) / x^63 and (v, w) = q (v, w) at the end of the block. Applying them takes one    */
+/* carry-less multiplication per entry and word. f and g only need as many bits as there are divsteps left, and v  */
+/* and w have degree at most the number of divsteps done, so the products skip the words out of these bounds. The  */
+/* bounds only depend on n.                                                                                         */
+
+#define R2_JUMP_STEPS 63
+#define R2_JUMP_WORDS(bits) ((bits) + 63 < 64 * BITARRAY_SIZE ? ((bits) + 63) / 64 : BITARRAY_SIZE)
+
+/* The matrices of the next steps divsteps, from the low words of f and g. The rows of p and q are {p[0], p[1]} */
+/* and {p[2], p[3]}                                                                                            */
+static void r2_jump_matrices(uint64_t p[4], uint64_t q[4], int16_t *delta, uint64_t f, uint64_t g, size_t steps) {
+
+    uint64_t signx64, swapx64, tx64;
+    size_t i, s;
+    int16_t swap;
+
+    p[0] = 1;
+    p[1] = 0;
+    p[2] = 0;
+    p[3] = 1;
+    q[0] = 1;
+    q[1] = 0;
+    q[2] = 0;
+    q[3] = 1;
+
+    for(s = 0; s < steps; s++){
+        q[0] <<= 1;
+        q[1] <<= 1;
+
+        swap = both_negative_mask(-*delta, -(int16_t) (g & 1));
+        *delta ^= swap & (*delta ^ -*delta);
+        *delta += 1;
+
+        signx64 = -(g & f & 1);
+        swapx64 = (uint64_t)((int64_t)swap);
+
+        tx64 = swapx64 & (f ^ g);
+        f ^= tx64;
+        g ^= tx64;
+        g ^= signx64 & f;
+        g >>= 1;
+
+        for(i = 0; i < 2; i++){
+            tx64 = swapx64 & (p[i] ^ p[i + 2]);
+            p[i] ^= tx64;
+            p[i + 2] ^= tx64;
+            p[i + 2] ^= signx64 & p[i];
+            p[i] <<= 1;
+
+            tx64 = swapx64 & (q[i] ^ q[i + 2]);
+            q[i] ^= tx64;
+            q[i + 2] ^= tx64;
+            q[i + 2] ^= signx64 & q[i];
+        }
+    }
+}
+
+void poly_R2_inv_jumpdivstep(poly *r, const poly *a) {
+
+    uint64_t f[BITARRAY_SIZE];
+    uint64_t g[BITARRAY_SIZE];
+    uint64_t v[BITARRAY_SIZE];
+    uint64_t w[BITARRAY_SIZE];
+    uint64_t t0[BITARRAY_SIZE + 1], t1[BITARRAY_SIZE + 1];
+    uint64_t p[4], q[4];
+    size_t i, loop, steps, words;
+    int16_t delta;
+
+    for(i = 0; i < BITARRAY_SIZE; i++){
+        v[i] = 0;
+    }
+    for(i = 1; i < BITARRAY_SIZE; i++){
+        w[i] = 0;
+    }
+    w[0] = 1;
+    for(i = 0; i < BITARRAY_SIZE - 1; i++){
+        f[i] = 0xffffffffffffffff;
+    }
+    f[BITARRAY_SIZE - 1] = (1UL << (NTRU_N % 64)) - 1;
+    for(i = 0; i < BITARRAY_SIZE; i++){
+        g[i] = 0;
+    }
+    for(i = 0; i < NTRU_N - 1; i++){
+        g[(NTRU_N - 2 - i) / 64] |= ((uint64_t)( (a->coeffs[i] ^ a->coeffs[NTRU_N - 1]) & 1)) << ((NTRU_N - 2 - i) % 64);
+    }
+
+    delta = 1;
+
+    for(loop = 0; loop < 2 * (NTRU_N - 1) - 1; loop += steps){
+
+        steps = 2 * (NTRU_N - 1) - 1 - loop;
+        if(steps > R2_JUMP_STEPS){
+            steps = R2_JUMP_STEPS;
+        }
+
+        r2_jump_matrices(p, q, &delta, f[0], g[0], steps);
+
+        words = R2_JUMP_WORDS(2 * (NTRU_N - 1) - loop);
+        r2_lincomb(t0, p[0], f, p[1], g, words);
+        r2_lincomb(t1, p[2], f, p[3], g, words);
+        for(i = 0; i < words; i++){
+            f[i] = (t0[i] >> steps) | (t0[i + 1] << (64 - steps));
+            g[i] = (t1[i] >> steps) | (t1[i + 1] << (64 - steps));
+        }
+
+        words = R2_JUMP_WORDS(loop + steps + 1);
+        r2_lincomb(t0, q[0], v, q[1], w, words);
+        r2_lincomb(t1, q[2], v, q[3], w, words);
+        for(i = 0; i < words; i++){
+            v[i] = t0[i];
+            w[i] = t1[i];
+        }
+    }
+
+    for (i = 0; i < NTRU_N - 1; ++i) {
+        r->coeffs[i] = (v[(NTRU_N - 2 - i) / 64] >> ((NTRU_N - 2 - i) % 64) ) & 1;
+    }
+    r->coeffs[NTRU_N - 1] = 0;
+}
+
+void poly_R2_inv(poly *r, const poly *a) {
+#if defined(R2_INV_CLMUL)
+    poly_R2_inv_clmul(r, a);
+#elif defined(INV_JUMPDIVSTEP)
+    poly_R2_inv_jumpdivstep(r, a);
+#else
+    poly_R2_inv_divstep(r, a);
+#endif
+}
@@ -22,7 +22,6 @@ limitations under the License.
 
 #include <stdint.h>
 
-void half_transpose_8x32(uint16_t *matrix);
 void half_transpose_8x16(uint16_t *matrix);
 
 #endif 
@@ -0,0 +1,97 @@
+#ifndef NEON_Z3_BITSLICED_H
+#define NEON_Z3_BITSLICED_H
+
+#include <arm_neon.h>
+
+#include <stdint.h>
+
+/* Bitsliced arithmetic in Z3, shared by the S3 inversion and multiplication. A trit is held in two bits, lo (the */
+/* trit is 1) and hi (the trit is 2), which are never both set. Negation swaps lo and hi                         */
+
+// unsigned Z3
+static inline void mul_Z3_bitsliced(uint64_t *ptr_clo, uint64_t *ptr_chi,
+    uint64_t *ptr_alo, uint64_t *ptr_ahi, uint64_t *ptr_blo, uint64_t *ptr_bhi){
+
+    uint64_t alo, ahi;
+    uint64_t blo, bhi;
+    uint64_t nonzero;
+    uint64_t t;
+
+    alo = *ptr_alo;
+    ahi = *ptr_ahi;
+    blo = *ptr_blo;
+    bhi = *ptr_bhi;
+
+    nonzero = blo | bhi;
+    t = bhi & (alo ^ ahi);
+    alo ^= t;
+    ahi ^= t;
+
+    *ptr_clo = alo & nonzero;
+    *ptr_chi = ahi & nonzero;
+
+}
+
+static inline void mul_Z3_bitsliced_uint8x16(uint8x16_t *ptr_clo, uint8x16_t *ptr_chi,
+    uint8x16_t *ptr_alo, uint8x16_t *ptr_ahi, uint8x16_t *ptr_blo, uint8x16_t *ptr_bhi){
+
+    uint8x16_t alo, ahi;
+    uint8x16_t blo, bhi;
+    uint8x16_t nonzero;
+    uint8x16_t t;
+
+    alo = *ptr_alo;
+    ahi = *ptr_ahi;
+    blo = *ptr_blo;
+    bhi = *ptr_bhi;
+
+    nonzero = blo | bhi;
+    t = bhi & (alo ^ ahi);
+    alo ^= t;
+    ahi ^= t;
+
+    *ptr_clo = alo & nonzero;
+    *ptr_chi = ahi & nonzero;
+
+}
+
+// unsigned Z3, in six operations, for a and b that never have lo and hi both set
+static inline void add_Z3_bitsliced(uint64_t *ptr_clo, uint64_t *ptr_chi,
+    uint64_t *ptr_alo, uint64_t *ptr_ahi, uint64_t *ptr_blo, uint64_t *ptr_bhi){
+
+    uint64_t alo, ahi;
+    uint64_t blo, bhi;
+    uint64_t t;
+
+    alo = *ptr_alo;
+    ahi = *ptr_ahi;
+    blo = *ptr_blo;
+    bhi = *ptr_bhi;
+
+    t = (ahi | blo) ^ (alo | bhi);
+
+    *ptr_clo = (ahi | bhi) ^ t;
+    *ptr_chi = (alo | blo) ^ t;
+
+}
+
+static inline void add_Z3_bitsliced_uint8x16(uint8x16_t *ptr_clo, uint8x16_t *ptr_chi,
+    uint8x16_t *ptr_alo, uint8x16_t *ptr_ahi, uint8x16_t *ptr_blo, uint8x16_t *ptr_bhi){
+
+    uint8x16_t alo, ahi;
+    uint8x16_t blo, bhi;
+    uint8x16_t t;
+
+    alo = *ptr_alo;
+    ahi = *ptr_ahi;
+    blo = *ptr_blo;
+    bhi = *ptr_bhi;
+
+    t = (ahi | blo) ^ (alo | bhi);
+
+    *ptr_clo = (ahi | bhi) ^ t;
+    *ptr_chi = (alo | blo) ^ t;
+
+}
+
+#endif
@@ -537,15 +537,53 @@ void tc3_interpolate_neon_SB1(uint16_t *restrict poly, uint16_t *restrict w)
 }
 
 
-void neon_toom_cook_333_combine(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB)
+// Evaluate B and transpose it for the batch multiplication
+// Size: 352 to 128x16
+void neon_toom_cook_333_evaluate(uint16_t *restrict tmp_bb, uint16_t *restrict polyB)
+{
+    // TC3
+    uint16_t *bw[5];
+    uint16_t tmp_w[5*SB1_PAD];
+    uint16x8_t zero;
+
+    bw[0] = &tmp_w[0*SB1_PAD];
+    bw[1] = &tmp_w[1*SB1_PAD];
+    bw[2] = &tmp_w[2*SB1_PAD];
+    bw[3] = &tmp_w[3*SB1_PAD];
+    bw[4] = &tmp_w[4*SB1_PAD];
+    // DONE TC3
+
+    // Evaluate B, Copy
+    // Size: 432 to 144x5
+    tc3_evaluate_neon_SB1(bw, polyB);
+
+    tc3_evaluate_neon_combine(&tmp_bb[0*25*SB3_PAD], bw[0]);
+    tc3_evaluate_neon_combine(&tmp_bb[1*25*SB3_PAD], bw[1]);
+    tc3_evaluate_neon_combine(&tmp_bb[2*25*SB3_PAD], bw[2]);
+    tc3_evaluate_neon_combine(&tmp_bb[3*25*SB3_PAD], bw[3]);
+    tc3_evaluate_neon_combine(&tmp_bb[4*25*SB3_PAD], bw[4]);
+
+    // The last 3 points are padding, keep them deterministic since tmp_bb may be cached
+    zero = vdupq_n_u16(0);
+    for (uint16_t addr = 125*SB3_PAD; addr < 128*SB3_PAD; addr+=8)
+    {
+        vstore_x1(&tmp_bb[addr], zero);
+    }
+
+    // Transpose 8x8x16
+    half_transpose_8x16(tmp_bb);
+}
+
+// C = A * B, B evaluated by neon_toom_cook_333_evaluate
+void neon_toom_cook_333_multiply(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict tmp_bb)
 {
     // TC3-3-3 Combine
-    uint16_t *aw[5], *bw[5];
+    uint16_t *aw[5];
 
+    // tmp_aabb holds tmp_aa, then the 25 SB2 products
     // Total memory: 16*256 + 32*128 = 8192 16-bit coefficients
     uint16_t tmp_aabb[SB3_PAD*256], tmp_cc[SB3_RES_PAD*128];
-    uint16_t *tmp_aa = &tmp_aabb[SB3_PAD*0],
-             *tmp_bb = &tmp_aabb[SB3_PAD*128];
+    uint16_t *tmp_aa = &tmp_aabb[SB3_PAD*0];
     // Done
     uint16x8x4_t zero;
 
@@ -556,12 +594,6 @@ void neon_toom_cook_333_combine(uint16_t *restrict polyC, uint16_t *restrict pol
     aw[2] = &tmp_cc[2*SB1_PAD];
     aw[3] = &tmp_cc[3*SB1_PAD];
     aw[4] = &tmp_cc[4*SB1_PAD];
-
-    bw[0] = &tmp_cc[5*SB1_PAD];
-    bw[1] = &tmp_cc[6*SB1_PAD];
-    bw[2] = &tmp_cc[7*SB1_PAD];
-    bw[3] = &tmp_cc[8*SB1_PAD];
-    bw[4] = &tmp_cc[9*SB1_PAD];
     // DONE TC3
 
 
@@ -569,29 +601,14 @@ void neon_toom_cook_333_combine(uint16_t *restrict polyC, uint16_t *restrict pol
     // Size: 432 to 144x5
     tc3_evaluate_neon_SB1(aw, polyA);
 
-    // Evaluate B, Copy
-    // Size: 432 to 144x5
-    tc3_evaluate_neon_SB1(bw, polyB);
-
     tc3_evaluate_neon_combine(&tmp_aa[0*25*SB3_PAD], aw[0]);
     tc3_evaluate_neon_combine(&tmp_aa[1*25*SB3_PAD], aw[1]);
     tc3_evaluate_neon_combine(&tmp_aa[2*25*SB3_PAD], aw[2]);
     tc3_evaluate_neon_combine(&tmp_aa[3*25*SB3_PAD], aw[3]);
     tc3_evaluate_neon_combine(&tmp_aa[4*25*SB3_PAD], aw[4]);
 
-    tc3_evaluate_neon_combine(&tmp_bb[0*25*SB3_PAD], bw[0]);
-    tc3_evaluate_neon_combine(&tmp_bb[1*25*SB3_PAD], bw[1]);
-    tc3_evaluate_neon_combine(&tmp_bb[2*25*SB3_PAD], bw[2]);
-    tc3_evaluate_neon_combine(&tmp_bb[3*25*SB3_PAD], bw[3]);
-    tc3_evaluate_neon_combine(&tmp_bb[4*25*SB3_PAD], bw[4]);
-
-    // Transpose 8x8x16
-    half_transpose_8x16(tmp_aa);
-    half_transpose_8x16(tmp_bb);
-    // Batch multiplication
-    schoolbook_half_8x_neon(tmp_cc, tmp_aa, tmp_bb);
-    // Transpose 8x8x32
-    half_transpose_8x32(tmp_cc);
+    // Batch multiplication, transposing A and C in registers
+    schoolbook_half_8x_neon(tmp_cc, tmp_aa, (uint16_t *)tmp_bb);
 
     vzero(zero, 0);
     for (uint16_t addr = 0; addr < SB2_RES_PAD*25; addr+=32)
@@ -646,6 +663,14 @@ void neon_toom_cook_333_combine(uint16_t *restrict polyC, uint16_t *restrict pol
     tc3_interpolate_neon_SB1(polyC, tmp_cc);
 }
 
+void neon_toom_cook_333_combine(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB)
+{
+    uint16_t tmp_bb[SB3_PAD*128];
+
+    neon_toom_cook_333_evaluate(tmp_bb, polyB);
+    neon_toom_cook_333_multiply(polyC, polyA, tmp_bb);
+}
+
 void poly_neon_reduction(uint16_t *poly, uint16_t *tmp)
 {
     uint16x8x4_t res, tmp1, tmp2;
@@ -770,6 +795,73 @@ void poly_mul_neon(uint16_t *restrict polyC,
     poly_neon_reduction(polyC, tmp_ab);
 }
 
+// Karatsuba and Toom-Cook evaluation of B, 3 parts of SB3_PAD*128 coefficients
+void poly_neon_expand(uint16_t *restrict polyE, uint16_t *restrict polyB)
+{
+    uint16_t *kbw[3];
+    // tc3_evaluate_neon_SB1 reads the last part out of bound by 2
+    uint16_t tmp_b[SB0_PAD * 3 + 8];
+    uint16x8_t last;
+
+    kbw[0] = &tmp_b[0 * SB0_PAD];
+    kbw[1] = &tmp_b[1 * SB0_PAD];
+    kbw[2] = &tmp_b[2 * SB0_PAD];
+
+    last = vdupq_n_u16(0);
+    vstore_x1(&tmp_b[SB0_PAD * 3], last);
+
+    // Karatsuba Evaluate B
+    karat_neon_evaluate_SB0(kbw, polyB);
+
+    // Toom Cook 333-way evaluate
+    neon_toom_cook_333_evaluate(&polyE[0*SB3_PAD*128], kbw[0]);
+    neon_toom_cook_333_evaluate(&polyE[1*SB3_PAD*128], kbw[1]);
+    neon_toom_cook_333_evaluate(&polyE[2*SB3_PAD*128], kbw[2]);
+}
+
+// poly_mul_neon with B already evaluated by poly_neon_expand
+void poly_neon_mul_expanded(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict polyE)
+{
+    uint16x8x4_t zero;
+    uint16_t *kaw[3], *kcw[3];
+    uint16_t tmp_a[SB0_PAD * 3 * 2 + 8]; // Avoid reading out of bound by 2
+    uint16_t tmp_c[SB0_RES_PAD * 3];
+
+    kaw[0] = &tmp_a[0 * SB0_PAD];
+    kaw[1] = &tmp_a[1 * SB0_PAD];
+    kaw[2] = &tmp_a[2 * SB0_PAD];
+
+    kcw[0] = &tmp_c[0 * SB0_RES_PAD];
+    kcw[1] = &tmp_c[1 * SB0_RES_PAD];
+    kcw[2] = &tmp_c[2 * SB0_RES_PAD];
+
+    vzero(zero, 0);
+    for (uint16_t addr = 0; addr < SB0_RES_PAD * 3; addr += 32)
+    {
+        vstore(&tmp_c[addr], zero);
+    }
+
+    // Karatsuba Evaluate A
+    karat_neon_evaluate_SB0(kaw, polyA);
+
+    // Toom Cook 333-way multiply
+    neon_toom_cook_333_multiply(kcw[0], kaw[0], &polyE[0*SB3_PAD*128]);
+    neon_toom_cook_333_multiply(kcw[1], kaw[1], &polyE[1*SB3_PAD*128]);
+    neon_toom_cook_333_multiply(kcw[2], kaw[2], &polyE[2*SB3_PAD*128]);
+
+    // Karatsuba Interpolate
+    // * Re-use tmp_a
+    for (uint16_t addr = 0; addr < SB0_RES_PAD * 3; addr += 32)
+    {
+        vstore(&tmp_a[addr], zero);
+    }
+    karat_neon_interpolate_SB0(tmp_a, kcw);
+
+    // Ring reduction
+    // Reduce from 1408 -> 704
+    poly_neon_reduction(polyC, tmp_a);
+}
+
 // void neon_poly_Rq_mul(poly *r, const poly *a, const poly *b)
 void poly_Rq_mul(poly *r, poly *a, poly *b)
 {
@@ -787,3 +879,25 @@ void poly_Rq_mul(poly *r, poly *a, poly *b)
     poly_mul_neon(r->coeffs, a->coeffs, b->coeffs);
     
 }
+
+void poly_Rq_expand(poly_expanded *r, poly *b)
+{
+    // Must zero garbage data at the end
+    // 701, 702, 703
+    b->coeffs[NTRU_N] = 0;
+    b->coeffs[NTRU_N+1] = 0;
+    b->coeffs[NTRU_N+2] = 0;
+
+    poly_neon_expand(r->coeffs, b->coeffs);
+}
+
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b)
+{
+    // Must zero garbage data at the end
+    // 701, 702, 703
+    a->coeffs[NTRU_N] = 0;
+    a->coeffs[NTRU_N+1] = 0;
+    a->coeffs[NTRU_N+2] = 0;
+
+    poly_neon_mul_expanded(r->coeffs, a->coeffs, b->coeffs);
+}
@@ -90,6 +90,159 @@ void owcpa_keypair(unsigned char *pk,
   poly_Rq_sum_zero_tobytes(pk, h);
 }
 
+void owcpa_keypair_batch_add(poly *prod3,
+                             poly *prodq,
+                             size_t i,
+                             unsigned char *pk,
+                             unsigned char *sk,
+                             const unsigned char seed[NTRU_SAMPLE_FG_BYTES])
+{
+  int j;
+  poly x1, x2, x3, x4;
+
+  poly *f=&x1, *g=&x2, *Gf=&x3, *tmp=&x4;
+
+  sample_fg(f,g,seed);
+
+  /* g stays in pk until owcpa_keypair_batch_finish replaces it with h */
+  poly_S3_tobytes(sk, f);
+  poly_S3_tobytes(pk, g);
+
+  /* The running products of the previous keys wait where invf_mod3 and invh will go */
+  if(i == 0)
+  {
+    *prod3 = *f;
+  }
+  else
+  {
+    poly_S3_tobytes(sk+NTRU_PACK_TRINARY_BYTES, prod3);
+    poly_Sq_tobytes(sk+2*NTRU_PACK_TRINARY_BYTES, prodq);
+
+    poly_S3_mul(tmp, prod3, f);
+    *prod3 = *tmp;
+  }
+
+  /* Lift coeffs of f and g from Z_p to Z_q */
+  poly_Z3_to_Zq(f);
+  poly_Z3_to_Zq(g);
+
+#ifdef NTRU_HRSS
+  /* g = 3*(x-1)*g */
+  for(j=NTRU_N-1; j>0; j--)
+    g->coeffs[j] = 3*(g->coeffs[j-1] - g->coeffs[j]);
+  g->coeffs[0] = -(3*g->coeffs[0]);
+#endif
+
+#ifdef NTRU_HPS
+  /* g = 3*g */
+  for(j=0; j<NTRU_N; j++)
+    g->coeffs[j] = 3 * g->coeffs[j];
+#endif
+
+  poly_Rq_mul(Gf, g, f);
+
+  if(i == 0)
+  {
+    *prodq = *Gf;
+    poly_mod_q_Phi_n(prodq);
+  }
+  else
+  {
+    poly_Sq_mul(tmp, prodq, Gf);
+    *prodq = *tmp;
+  }
+}
+
+void owcpa_keypair_batch_finish(poly *prod3,
+                                poly *prodq,
+                                size_t n,
+                                unsigned char *pk,
+                                size_t pkstride,
+                                unsigned char *sk,
+                                size_t skstride)
+{
+  size_t i;
+  int j;
+  poly x1, x2, x3, x4, x5, x6, x7;
+
+  poly *f=&x1, *g=&x2, *invf_mod3=&x3;
+  poly *Gf=&x3, *invGf=&x4, *tmp=&x5;
+  poly *invh=&x3, *h=&x3;
+  poly *inv3=&x6, *invq=&x7;
+
+  /* The only two inversions of the batch */
+  poly_S3_inv(inv3, prod3);
+  poly_Rq_inv(invq, prodq);
+
+  pk += n*pkstride;
+  sk += n*skstride;
+
+  for(i=n; i-- > 0;)
+  {
+    pk -= pkstride;
+    sk -= skstride;
+
+    poly_S3_frombytes(f, sk);
+    poly_S3_frombytes(g, pk);
+
+    /* inv3 inverts f_0...f_i, the stashed f_0...f_{i-1} turns it into the inverse of f_i */
+    if(i == 0)
+    {
+      *invf_mod3 = *inv3;
+    }
+    else
+    {
+      poly_S3_frombytes(tmp, sk+NTRU_PACK_TRINARY_BYTES);
+      poly_S3_mul(invf_mod3, inv3, tmp);
+
+      poly_S3_mul(tmp, inv3, f);
+      *inv3 = *tmp;
+    }
+    poly_S3_tobytes(sk+NTRU_PACK_TRINARY_BYTES, invf_mod3);
+
+    /* Lift coeffs of f and g from Z_p to Z_q */
+    poly_Z3_to_Zq(f);
+    poly_Z3_to_Zq(g);
+
+#ifdef NTRU_HRSS
+    /* g = 3*(x-1)*g */
+    for(j=NTRU_N-1; j>0; j--)
+      g->coeffs[j] = 3*(g->coeffs[j-1] - g->coeffs[j]);
+    g->coeffs[0] = -(3*g->coeffs[0]);
+#endif
+
+#ifdef NTRU_HPS
+    /* g = 3*g */
+    for(j=0; j<NTRU_N; j++)
+      g->coeffs[j] = 3 * g->coeffs[j];
+#endif
+
+    poly_Rq_mul(Gf, g, f);
+
+    /* Likewise for invq and gf_0...gf_{i-1} */
+    if(i == 0)
+    {
+      *invGf = *invq;
+    }
+    else
+    {
+      poly_Sq_frombytes(tmp, sk+2*NTRU_PACK_TRINARY_BYTES);
+      poly_Sq_mul(invGf, invq, tmp);
+
+      poly_Sq_mul(tmp, invq, Gf);
+      *invq = *tmp;
+    }
+
+    poly_Rq_mul(tmp, invGf, f);
+    poly_Sq_mul(invh, tmp, f);
+    poly_Sq_tobytes(sk+2*NTRU_PACK_TRINARY_BYTES, invh);
+
+    poly_Rq_mul(tmp, invGf, g);
+    poly_Rq_mul(h, tmp, g);
+    poly_Rq_sum_zero_tobytes(pk, h);
+  }
+}
+
 
 void owcpa_enc(unsigned char *c,
                poly *r,
@@ -112,6 +265,35 @@ void owcpa_enc(unsigned char *c,
   poly_Rq_sum_zero_tobytes(c, ct);
 }
 
+void owcpa_pk_expand(poly_expanded *h,
+                     const unsigned char *pk)
+{
+  poly x1;
+  poly *b = &x1;
+
+  poly_Rq_sum_zero_frombytes(b, pk);
+  poly_Rq_expand(h, b);
+}
+
+void owcpa_enc_expanded(unsigned char *c,
+                        poly *r,
+                        const poly *m,
+                        const poly_expanded *h)
+{
+  int i;
+  poly x1, x2;
+  poly *liftm = &x1;
+  poly *ct = &x2;
+
+  poly_Rq_mul_expanded(ct, r, h);
+
+  poly_lift(liftm, m);
+  for(i=0; i<NTRU_N; i++)
+    ct->coeffs[i] = ct->coeffs[i] + liftm->coeffs[i];
+
+  poly_Rq_sum_zero_tobytes(c, ct);
+}
+
 int owcpa_dec(unsigned char *rm,
               const unsigned char *ciphertext,
               const unsigned char *secretkey)
@@ -172,3 +354,79 @@ int owcpa_dec(unsigned char *rm,
 
   return fail;
 }
+
+void owcpa_sk_expand(poly_expanded sk[3],
+                     const unsigned char *secretkey)
+{
+  poly x1;
+  poly *f = &x1, *finv3 = &x1, *invh = &x1;
+
+  poly_S3_frombytes(f, secretkey);
+  poly_Z3_to_Zq(f);
+  poly_Rq_expand(&sk[0], f);
+
+  poly_S3_frombytes(finv3, secretkey+NTRU_PACK_TRINARY_BYTES);
+  poly_Rq_expand(&sk[1], finv3);
+
+  poly_Sq_frombytes(invh, secretkey+2*NTRU_PACK_TRINARY_BYTES);
+  poly_Rq_expand(&sk[2], invh);
+}
+
+int owcpa_dec_expanded(unsigned char *rm,
+                       const unsigned char *ciphertext,
+                       const poly_expanded sk[3])
+{
+  int i;
+  int fail;
+  poly x1, x2, x3, x4;
+
+  poly *c = &x1, *cf = &x3;
+  poly *mf = &x2, *m = &x4;
+  poly *liftm = &x2, *r = &x4;
+  poly *b = &x1;
+
+  poly_Rq_sum_zero_frombytes(c, ciphertext);
+
+  poly_Rq_mul_expanded(cf, c, &sk[0]);
+  poly_Rq_to_S3(mf, cf);
+
+  poly_Rq_mul_expanded(m, mf, &sk[1]);
+  poly_mod_3_Phi_n(m);
+  poly_S3_tobytes(rm+NTRU_PACK_TRINARY_BYTES, m);
+
+  /* NOTE: For the IND-CCA2 KEM we must ensure that c = Enc(h, (r,m)).       */
+  /* We can avoid re-computing r*h + Lift(m) as long as we check that        */
+  /* r (defined as b/h mod (q, Phi_n)) and m are in the message space.       */
+  /* (m can take any value in S3 in NTRU_HRSS) */
+  fail = 0;
+#ifdef NTRU_HPS
+  fail |= owcpa_check_m(m);
+#endif
+
+  /* b = c - Lift(m) mod (q, x^n - 1) */
+  poly_lift(liftm, m);
+  for(i=0; i<NTRU_N; i++)
+    b->coeffs[i] = c->coeffs[i] - liftm->coeffs[i];
+
+  /* r = b / h mod (q, Phi_n) */
+  poly_Rq_mul_expanded(r, b, &sk[2]);
+  poly_mod_q_Phi_n(r);
+
+  /* NOTE: Our definition of r as b/h mod (q, Phi_n) follows Figure 4 of     */
+  /*   [Sch18] https://eprint.iacr.org/2018/1174/20181203:032458.            */
+  /* This differs from Figure 10 of Saito--Xagawa--Yamakawa                  */
+  /*   [SXY17] https://eprint.iacr.org/2017/1005/20180516:055500             */
+  /* where r gets a final reduction modulo p.                                */
+  /* We need this change to use Proposition 1 of [Sch18].                    */
+
+  /* Proposition 1 of [Sch18] shows that re-encryption with (r,m) yields c.  */
+  /* if and only if fail==0 after the following call to owcpa_check_r        */
+  /* The procedure given in Fig. 8 of [Sch18] can be skipped because we have */
+  /* c(1) = 0 due to the use of poly_Rq_sum_zero_{to,from}bytes.             */
+  fail |= owcpa_check_r(r);
+
+  poly_trinary_Zq_to_Z3(r);
+  poly_S3_tobytes(rm, r);
+
+  return fail;
+}
@@ -7,15 +7,60 @@
 void owcpa_samplemsg(unsigned char msg[NTRU_OWCPA_MSGBYTES],
                      const unsigned char seed[NTRU_SEEDBYTES]);
 
+#define owcpa_keypair CRYPTO_NAMESPACE(owcpa_keypair)
 void owcpa_keypair(unsigned char *pk,
                    unsigned char *sk,
                    const unsigned char seed[NTRU_SEEDBYTES]);
 
+// owcpa_keypair for n keys with one S3 and one Rq inversion between them (Montgomery's trick): call
+// owcpa_keypair_batch_add for i = 0, ..., n-1, which keeps the running products of f and gf in prod3 and
+// prodq, then owcpa_keypair_batch_finish on the same prod3/prodq with the n keys pkstride/skstride bytes apart
+#define owcpa_keypair_batch_add CRYPTO_NAMESPACE(owcpa_keypair_batch_add)
+void owcpa_keypair_batch_add(poly *prod3,
+                             poly *prodq,
+                             size_t i,
+                             unsigned char *pk,
+                             unsigned char *sk,
+                             const unsigned char seed[NTRU_SAMPLE_FG_BYTES]);
+
+#define owcpa_keypair_batch_finish CRYPTO_NAMESPACE(owcpa_keypair_batch_finish)
+void owcpa_keypair_batch_finish(poly *prod3,
+                                poly *prodq,
+                                size_t n,
+                                unsigned char *pk,
+                                size_t pkstride,
+                                unsigned char *sk,
+                                size_t skstride);
+
+#define owcpa_enc CRYPTO_NAMESPACE(owcpa_enc)
 void owcpa_enc(unsigned char *c,
                poly *r,
                const poly *m,
                const unsigned char *pk);
 
+// owcpa_enc split into the unpacking and evaluation of h, and the encryption with the result
+#define owcpa_pk_expand CRYPTO_NAMESPACE(owcpa_pk_expand)
+void owcpa_pk_expand(poly_expanded *h,
+                     const unsigned char *pk);
+
+#define owcpa_enc_expanded CRYPTO_NAMESPACE(owcpa_enc_expanded)
+void owcpa_enc_expanded(unsigned char *c,
+                        poly *r,
+                        const poly *m,
+                        const poly_expanded *h);
+
+// owcpa_dec split into the unpacking and evaluation of f, finv3 and invh (in this order in sk), and the
+// decryption with the results
+#define owcpa_sk_expand CRYPTO_NAMESPACE(owcpa_sk_expand)
+void owcpa_sk_expand(poly_expanded sk[3],
+                     const unsigned char *secretkey);
+
+#define owcpa_dec_expanded CRYPTO_NAMESPACE(owcpa_dec_expanded)
+int owcpa_dec_expanded(unsigned char *rm,
+                       const unsigned char *ciphertext,
+                       const poly_expanded sk[3]);
+
+#define owcpa_dec CRYPTO_NAMESPACE(owcpa_dec)
 int owcpa_dec(unsigned char *rm,
               const unsigned char *c,
               const unsigned char *sk);
@@ -6,7 +6,7 @@ void poly_Sq_mul(poly *r, poly *a, poly *b)
   poly_mod_q_Phi_n(r);
 }
 
-void poly_S3_mul(poly *r, poly *a, poly *b)
+void poly_S3_mul_rq(poly *r, poly *a, poly *b)
 {
   /* Our S3 multiplications do not overflow mod q,    */
   /* so we can re-purpose poly_Rq_mul, as long as we  */
@@ -15,6 +15,15 @@ void poly_S3_mul(poly *r, poly *a, poly *b)
   poly_mod_3_Phi_n(r);
 }
 
+void poly_S3_mul(poly *r, poly *a, poly *b)
+{
+#ifdef S3_MUL_BITSLICED
+  poly_S3_mul_bitsliced(r, a, b);
+#else
+  poly_S3_mul_rq(r, a, b);
+#endif
+}
+
 static void poly_R2_inv_to_Rq_inv(poly *r, const poly *ai, const poly *a)
 {
 #if NTRU_Q <= 256 || NTRU_Q >= 65536
@@ -3,4 +3,16 @@
 
 void randombytes(unsigned char *x,unsigned long long xlen);
 
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+// Added in NTRU-sampling, see rng_opt/rng.h
+void randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen);
+int randombytes_stream_begin(randombytes_ctx_t *ctx, unsigned long long xlen);
+int randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset,
+                            unsigned long long len);
+int randombytes_stream_end(randombytes_ctx_t *ctx);
+
 #endif
@@ -8,3 +8,13 @@ void poly_Rq_mul(poly *r, poly *a, poly *b) {
     amx_poly_mul_mod_65536_mod_x_d_minus_1_u16_32nx32n_coeffs(r->coeffs, a->coeffs, b->coeffs, NTRU_N,
                                                               (NTRU_N + 31) / 32);
 }
+
+// The AMX multiplier has no evaluation step to cache, the expanded form only holds the polynomial itself
+void poly_Rq_expand(poly_expanded *r, poly *b) {
+    memcpy(r->coeffs, b->coeffs, sizeof(poly));
+}
+
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b) {
+    amx_poly_mul_mod_65536_mod_x_d_minus_1_u16_32nx32n_coeffs(r->coeffs, a->coeffs, (uint16_t *)b->coeffs, NTRU_N,
+                                                              (NTRU_N + 31) / 32);
+}
@@ -11,8 +11,8 @@
 #include <openssl/evp.h>
 #include <openssl/err.h>
 
-// Modified in NTRU-sampling to prevent multiple definitions
-static AES256_CTR_DRBG_struct  DRBG_ctx;
+// Modified in NTRU-sampling to prevent multiple definitions, and to give each thread its own DRBG state
+static __thread randombytes_ctx_t  default_ctx;
 
 void    AES256_ECB(unsigned char *key, unsigned char *ctr, unsigned char *buffer);
 
@@ -141,35 +141,54 @@ randombytes_init(unsigned char *entropy_input,
                  unsigned char *personalization_string,
                  int security_strength)
 {
+    randombytes_ctx_init(&default_ctx, entropy_input, personalization_string, security_strength);
+}
+
+int
+randombytes(unsigned char *x, unsigned long long xlen)
+{
+    return randombytes_ctx(&default_ctx, x, xlen);
+}
+
+// Modified in NTRU-sampling to operate on a caller-provided state
+void
+randombytes_ctx_init(randombytes_ctx_t *ctx,
+                     unsigned char *entropy_input,
+                     unsigned char *personalization_string,
+                     int security_strength)
+{
+    AES256_CTR_DRBG_struct *DRBG_ctx = &(ctx != NULL ? ctx : &default_ctx)->drbg;
     unsigned char   seed_material[48];
 
     memcpy(seed_material, entropy_input, 48);
     if (personalization_string)
         for (int i=0; i<48; i++)
             seed_material[i] ^= personalization_string[i];
-    memset(DRBG_ctx.Key, 0x00, 32);
-    memset(DRBG_ctx.V, 0x00, 16);
-    AES256_CTR_DRBG_Update(seed_material, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter = 1;
+    memset(DRBG_ctx->Key, 0x00, 32);
+    memset(DRBG_ctx->V, 0x00, 16);
+    AES256_CTR_DRBG_Update(seed_material, DRBG_ctx->Key, DRBG_ctx->V);
+    DRBG_ctx->reseed_counter = 1;
 }
 
+// Modified in NTRU-sampling to operate on a caller-provided state
 int
-randombytes(unsigned char *x, unsigned long long xlen)
+randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen)
 {
+    AES256_CTR_DRBG_struct *DRBG_ctx = &(ctx != NULL ? ctx : &default_ctx)->drbg;
     unsigned char   block[16];
     int             i = 0;
 
     while ( xlen > 0 ) {
         //increment V
         for (int j=15; j>=0; j--) {
-            if ( DRBG_ctx.V[j] == 0xff )
-                DRBG_ctx.V[j] = 0x00;
+            if ( DRBG_ctx->V[j] == 0xff )
+                DRBG_ctx->V[j] = 0x00;
             else {
-                DRBG_ctx.V[j]++;
+                DRBG_ctx->V[j]++;
                 break;
             }
         }
-        AES256_ECB(DRBG_ctx.Key, DRBG_ctx.V, block);
+        AES256_ECB(DRBG_ctx->Key, DRBG_ctx->V, block);
         if ( xlen > 15 ) {
             memcpy(x+i, block, 16);
             i += 16;
@@ -180,8 +199,94 @@ randombytes(unsigned char *x, unsigned long long xlen)
             xlen = 0;
         }
     }
-    AES256_CTR_DRBG_Update(NULL, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter++;
+    AES256_CTR_DRBG_Update(NULL, DRBG_ctx->Key, DRBG_ctx->V);
+    DRBG_ctx->reseed_counter++;
+
+    return RNG_SUCCESS;
+}
+
+// Added in NTRU-sampling: V += n, V being a 128-bit big-endian counter
+static void
+add_to_V(unsigned char V[16], unsigned long long n)
+{
+    unsigned int carry = 0;
+
+    for (int j=15; j>=0; j--) {
+        unsigned int t = V[j] + (unsigned int)(n & 0xff) + carry;
+
+        V[j] = (unsigned char)t;
+        carry = t >> 8;
+        n >>= 8;
+    }
+}
+
+// Clears secret data with volatile stores, which the compiler cannot drop as dead stores
+static void
+rng_wipe(void *p, size_t len)
+{
+    volatile unsigned char *v = (volatile unsigned char *)p;
+
+    while ( len-- )
+        *v++ = 0;
+}
+
+// Added in NTRU-sampling, see rng.h. Block i of the request is encrypted from the counter stream.V + i
+int
+randombytes_stream_begin(randombytes_ctx_t *ctx, unsigned long long xlen)
+{
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
+
+    memcpy(c->stream.V, c->drbg.V, 16);
+    add_to_V(c->stream.V, 1);
+    c->stream.xlen = xlen;
+    c->stream.cached_block = 0;
+
+    return RNG_SUCCESS;
+}
+
+int
+randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset, unsigned long long len)
+{
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
+    unsigned char   ctr[16];
+
+    while ( len > 0 ) {
+        unsigned long long  block = offset / 16;
+        unsigned long long  n = 16 - offset % 16;
+
+        if ( n > len )
+            n = len;
+
+        if ( c->stream.cached_block != block + 1 ) {
+            memcpy(ctr, c->stream.V, 16);
+            add_to_V(ctr, block);
+            AES256_ECB(c->drbg.Key, ctr, c->stream.cache);
+            c->stream.cached_block = block + 1;
+        }
+
+        memcpy(out, c->stream.cache + offset % 16, n);
+        out += n;
+        offset += n;
+        len -= n;
+    }
+
+    return RNG_SUCCESS;
+}
+
+int
+randombytes_stream_end(randombytes_ctx_t *ctx)
+{
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
+
+    // randombytes_ctx increments V once per (possibly partial) block
+    add_to_V(c->drbg.V, (c->stream.xlen + 15) / 16);
+
+    AES256_CTR_DRBG_Update(NULL, c->drbg.Key, c->drbg.V);
+    c->drbg.reseed_counter++;
+
+    // The cached keystream block would otherwise stay in the context for as long as it lives
+    rng_wipe(c->stream.cache, sizeof(c->stream.cache));
+    c->stream.cached_block = 0;
 
     return RNG_SUCCESS;
 }
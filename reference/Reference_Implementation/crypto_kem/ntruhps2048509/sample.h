@@ -19,6 +19,28 @@ void sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]
 #ifdef NTRU_HPS /* hps needs sample_fixed_type */
 #define sample_fixed_type CRYPTO_NAMESPACE(sample_fixed_type)
 void sample_fixed_type(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES]);
+
+/* Samples n fixed-type polynomials r[i] from uniformbytes[i]; each r[i] is  */
+/* identical to the output of sample_fixed_type(r[i], uniformbytes[i]).       */
+#define sample_fixed_type_xN CRYPTO_NAMESPACE(sample_fixed_type_xN)
+void sample_fixed_type_xN(poly *r[], const unsigned char *uniformbytes[], size_t n);
+
+/* Streaming forms of sample_iid, sample_fixed_type and sample_rm. The       */
+/* uniform bytes are read with randombytes_stream_read(ctx, ...), starting   */
+/* offset bytes into the current request (sample_rm_stream reads all of it), */
+/* rather than from a buffer; the outputs are the same as those of the       */
+/* buffered forms. Only provided by the shuffling sampler.                   */
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+#define sample_iid_stream CRYPTO_NAMESPACE(sample_iid_stream)
+void sample_iid_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+#define sample_fixed_type_stream CRYPTO_NAMESPACE(sample_fixed_type_stream)
+void sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+#define sample_rm_stream CRYPTO_NAMESPACE(sample_rm_stream)
+void sample_rm_stream(poly *r, poly *m, randombytes_ctx_t *ctx);
 #endif
 
 #ifdef NTRU_HRSS /* hrss needs sample_iid_plus */
@@ -1,3 +1,5 @@
+#include <stddef.h>
+
 #include "api.h"
 #include "cmov.h"
 #include "crypto_hash_sha3256.h"
@@ -8,27 +10,40 @@
 #include "sample.h"
 
 // API FUNCTIONS 
-int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+int crypto_kem_keypair_ctx(randombytes_ctx_t *ctx, unsigned char *pk, unsigned char *sk)
 {
   unsigned char seed[NTRU_SAMPLE_FG_BYTES];
 
-  randombytes(seed, NTRU_SAMPLE_FG_BYTES);
+  randombytes_ctx(ctx, seed, NTRU_SAMPLE_FG_BYTES);
   owcpa_keypair(pk, sk, seed);
 
-  randombytes(sk+NTRU_OWCPA_SECRETKEYBYTES, NTRU_PRFKEYBYTES);
+  randombytes_ctx(ctx, sk+NTRU_OWCPA_SECRETKEYBYTES, NTRU_PRFKEYBYTES);
 
   return 0;
 }
 
-int crypto_kem_enc(unsigned char *c, unsigned char *k, const unsigned char *pk)
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+  return crypto_kem_keypair_ctx(NULL, pk, sk);
+}
+
+int crypto_kem_enc_ctx(randombytes_ctx_t *ctx, unsigned char *c, unsigned char *k, const unsigned char *pk)
 {
   poly r, m;
   unsigned char rm[NTRU_OWCPA_MSGBYTES];
+
+#ifdef SAMPLE_STREAM
+  // The samplers consume the random bytes as they are generated, see randombytes_stream_begin
+  randombytes_stream_begin(ctx, NTRU_SAMPLE_RM_BYTES);
+  sample_rm_stream(&r, &m, ctx);
+  randombytes_stream_end(ctx);
+#else
   unsigned char rm_seed[NTRU_SAMPLE_RM_BYTES];
 
-  randombytes(rm_seed, NTRU_SAMPLE_RM_BYTES);
+  randombytes_ctx(ctx, rm_seed, NTRU_SAMPLE_RM_BYTES);
 
   sample_rm(&r, &m, rm_seed);
+#endif
 
   poly_S3_tobytes(rm, &r);
   poly_S3_tobytes(rm+NTRU_PACK_TRINARY_BYTES, &m);
@@ -40,6 +55,11 @@ int crypto_kem_enc(unsigned char *c, unsigned char *k, const unsigned char *pk)
   return 0;
 }
 
+int crypto_kem_enc(unsigned char *c, unsigned char *k, const unsigned char *pk)
+{
+  return crypto_kem_enc_ctx(NULL, c, k, pk);
+}
+
 int crypto_kem_dec(unsigned char *k, const unsigned char *c, const unsigned char *sk)
 {
   int i, fail;
@@ -17,4 +17,17 @@ int crypto_kem_enc(unsigned char *c, unsigned char *k, const unsigned char *pk);
 #define crypto_kem_dec CRYPTO_NAMESPACE(dec)
 int crypto_kem_dec(unsigned char *k, const unsigned char *c, const unsigned char *sk);
 
+// Variants of crypto_kem_keypair and crypto_kem_enc that draw random bytes from a caller-owned RNG state (see
+// randombytes_ctx); a NULL ctx selects the calling thread's default state. Decapsulation uses no randomness.
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+#define crypto_kem_keypair_ctx CRYPTO_NAMESPACE(keypair_ctx)
+int crypto_kem_keypair_ctx(randombytes_ctx_t *ctx, unsigned char *pk, unsigned char *sk);
+
+#define crypto_kem_enc_ctx CRYPTO_NAMESPACE(enc_ctx)
+int crypto_kem_enc_ctx(randombytes_ctx_t *ctx, unsigned char *c, unsigned char *k, const unsigned char *pk);
+
 #endif
@@ -0,0 +1,230 @@
+//
+//  aes256_ctr.h
+//
+//  Added in NTRU-sampling: bulk AES-256-CTR keystream for the DRBG in rng.c and rng_inline_asm.c, interleaving 4, 8 or
+//  12 blocks depending on the core. The 128-bit big-endian counter V is kept in a vector register as its integer value
+//  {low 64 bits, high 64 bits}, and converted to big-endian bytes with REV64+EXT, so no scalar byte swapping is needed.
+//
+
+#ifndef AES256_CTR_H
+#define AES256_CTR_H
+
+#include <arm_neon.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/auxv.h>
+
+#ifndef HWCAP_CPUID
+#define HWCAP_CPUID (1 << 11)
+#endif
+#endif
+
+// Environment variable overriding the number of interleaved blocks chosen for the running core (1, 4, 8 or 12)
+#define AES256_CTR_WAYS_ENV "NTRU_RNG_AES_WAYS"
+
+// Used for cores that are not in aes256_ctr_core_ways
+#define AES256_CTR_DEFAULT_WAYS 8
+
+// Big-endian bytes <-> {low 64 bits, high 64 bits}. The conversion is its own inverse
+static inline uint8x16_t ctr_swap(uint8x16_t v) {
+    v = vrev64q_u8(v);
+
+    return vextq_u8(v, v, 8);
+}
+
+static inline uint64x2_t ctr_load(const unsigned char V[16]) {
+    return vreinterpretq_u64_u8(ctr_swap(vld1q_u8(V)));
+}
+
+static inline uint8x16_t ctr_to_bytes(uint64x2_t ctr) {
+    return ctr_swap(vreinterpretq_u8_u64(ctr));
+}
+
+// ctr + incr modulo 2^128. The carry out of the low half is an all-ones mask, moved to the high lane and subtracted
+static inline uint64x2_t ctr_add(uint64x2_t ctr, uint64x2_t incr) {
+    uint64x2_t sum = vaddq_u64(ctr, incr);
+    uint64x2_t carry = vextq_u64(vdupq_n_u64(0), vcltq_u64(sum, ctr), 1);
+
+    return vsubq_u64(sum, carry);
+}
+
+static inline uint64x2_t ctr_add_n(uint64x2_t ctr, uint64_t n) {
+    return ctr_add(ctr, vcombine_u64(vcreate_u64(n), vcreate_u64(0)));
+}
+
+// Encrypts the counters ctr, ctr + 1, ... into out, ways blocks at a time, until fewer than ways blocks are left.
+// Returns the first unused counter. The counter arithmetic stays in vector registers, where it overlaps with the AES
+// rounds of the previous iteration
+#define DEFINE_AES256_CTR_XWAYS(ways)                                                                                 \
+    static uint64x2_t aes256_ctr_x##ways(const uint8x16_t vsubkeys[15], uint64x2_t ctr, unsigned char *out,         \
+                                         size_t nblocks) {                                                           \
+        const uint64x2_t one = vcombine_u64(vcreate_u64(1), vcreate_u64(0));                                        \
+        uint8x16_t state[ways];                                                                                     \
+                                                                                                                     \
+        for (; nblocks >= ways; nblocks -= ways, out += ways * 16) {                                                \
+            for (int j = 0; j < ways; j++) {                                                                        \
+                state[j] = ctr_to_bytes(ctr);                                                                       \
+                ctr = ctr_add(ctr, one);                                                                            \
+            }                                                                                                       \
+                                                                                                                     \
+            for (int i = 0; i < 13; i++) {                                                                          \
+                for (int j = 0; j < ways; j++) {                                                                    \
+                    state[j] = vaeseq_u8(state[j], vsubkeys[i]);                                                    \
+                    state[j] = vaesmcq_u8(state[j]);                                                                \
+                }                                                                                                   \
+            }                                                                                                       \
+                                                                                                                     \
+            for (int j = 0; j < ways; j++) {                                                                        \
+                state[j] = vaeseq_u8(state[j], vsubkeys[13]);                                                       \
+                state[j] = veorq_u8(state[j], vsubkeys[14]);                                                        \
+                vst1q_u8(out + j * 16, state[j]);                                                                   \
+            }                                                                                                       \
+        }                                                                                                           \
+                                                                                                                     \
+        return ctr;                                                                                                 \
+    }
+
+DEFINE_AES256_CTR_XWAYS(1)
+DEFINE_AES256_CTR_XWAYS(4)
+DEFINE_AES256_CTR_XWAYS(8)
+DEFINE_AES256_CTR_XWAYS(12)
+
+typedef uint64x2_t (*aes256_ctr_fn)(const uint8x16_t vsubkeys[15], uint64x2_t ctr, unsigned char *out,
+                                    size_t nblocks);
+
+// Widest first; the blocks left over by the selected width are handled by the narrower ones
+static const struct {
+    unsigned ways;
+    aes256_ctr_fn fn;
+} aes256_ctr_impls[] = {
+    {12, aes256_ctr_x12},
+    {8, aes256_ctr_x8},
+    {4, aes256_ctr_x4},
+    {1, aes256_ctr_x1},
+};
+
+#define AES256_CTR_NUM_IMPLS (sizeof(aes256_ctr_impls) / sizeof(aes256_ctr_impls[0]))
+
+// Number of interleaved blocks that keeps the AESE/AESMC pipelines of each core busy, indexed by the implementer and
+// part number fields of MIDR_EL1
+static const struct {
+    uint32_t implementer, part;
+    unsigned ways;
+} aes256_ctr_core_ways[] = {
+    {0x41, 0xd03, 4},   // Cortex-A53
+    {0x41, 0xd05, 4},   // Cortex-A55
+    {0x41, 0xd08, 8},   // Cortex-A72
+    {0x41, 0xd09, 8},   // Cortex-A73
+    {0x41, 0xd0b, 8},   // Cortex-A76
+    {0x41, 0xd0c, 8},   // Neoverse N1
+    {0x41, 0xd0d, 8},   // Cortex-A77
+    {0x41, 0xd40, 12},  // Neoverse V1
+    {0x41, 0xd41, 8},   // Cortex-A78
+    {0x41, 0xd44, 12},  // Cortex-X1
+    {0x41, 0xd48, 12},  // Cortex-X2
+    {0x41, 0xd49, 8},   // Neoverse N2
+    {0x41, 0xd4f, 12},  // Neoverse V2
+};
+
+static unsigned aes256_ctr_detect_ways(void) {
+#if defined(__APPLE__)
+    // M-series performance cores have four AES pipelines
+    return 12;
+#elif defined(__linux__)
+    uint64_t midr;
+
+    if (!(getauxval(AT_HWCAP) & HWCAP_CPUID)) {
+        return AES256_CTR_DEFAULT_WAYS;
+    }
+
+    // Trapped and emulated by the kernel when HWCAP_CPUID is set
+    __asm__ volatile("mrs %0, midr_el1" : "=r"(midr));
+
+    uint32_t implementer = (midr >> 24) & 0xff, part = (midr >> 4) & 0xfff;
+
+    // Apple cores under Linux
+    if (implementer == 0x61) {
+        return 12;
+    }
+
+    for (size_t i = 0; i < sizeof(aes256_ctr_core_ways) / sizeof(aes256_ctr_core_ways[0]); i++) {
+        if (aes256_ctr_core_ways[i].implementer == implementer && aes256_ctr_core_ways[i].part == part) {
+            return aes256_ctr_core_ways[i].ways;
+        }
+    }
+
+    return AES256_CTR_DEFAULT_WAYS;
+#else
+    return AES256_CTR_DEFAULT_WAYS;
+#endif
+}
+
+// Index into aes256_ctr_impls of the width used by this process, -1 until aes256_ctr_select runs
+static int aes256_ctr_selected = -1;
+
+// Chooses the width from AES256_CTR_WAYS_ENV, or from the core when it is not set. Called whenever a DRBG is seeded, so
+// that a change of the variable takes effect from the next randombytes_init or randombytes_ctx_init. All widths give
+// the same keystream, so a call racing with a generation in another thread is harmless
+static unsigned aes256_ctr_select(void) {
+    const char *env = getenv(AES256_CTR_WAYS_ENV);
+    unsigned ways = env != NULL ? (unsigned)strtoul(env, NULL, 10) : aes256_ctr_detect_ways();
+    int i = 0;
+
+    // Unsupported widths fall back to 1 way
+    while (i < (int)AES256_CTR_NUM_IMPLS - 1 && aes256_ctr_impls[i].ways != ways) {
+        i++;
+    }
+
+    __atomic_store_n(&aes256_ctr_selected, i, __ATOMIC_RELAXED);
+
+    return (unsigned)i;
+}
+
+static unsigned aes256_ctr_impl(void) {
+    int i = __atomic_load_n(&aes256_ctr_selected, __ATOMIC_RELAXED);
+
+    return i < 0 ? aes256_ctr_select() : (unsigned)i;
+}
+
+static inline unsigned aes256_ctr_ways(void) {
+    return aes256_ctr_impls[aes256_ctr_impl()].ways;
+}
+
+// Encrypts the counters ctr, ..., ctr + nblocks - 1 into out with the width selected for this process, and returns the
+// first unused counter
+static uint64x2_t aes256_ctr_blocks(const uint8x16_t vsubkeys[15], uint64x2_t ctr, unsigned char *out,
+                                    size_t nblocks) {
+    for (unsigned i = aes256_ctr_impl(); i < AES256_CTR_NUM_IMPLS; i++) {
+        size_t n = nblocks - nblocks % aes256_ctr_impls[i].ways;
+
+        ctr = aes256_ctr_impls[i].fn(vsubkeys, ctr, out, n);
+        out += n * 16;
+        nblocks -= n;
+    }
+
+    return ctr;
+}
+
+// Writes xlen keystream bytes to x, encrypting the counters V, V + 1, ..., and leaves the last used counter in V (V - 1
+// if xlen == 0), as expected by AES256_CTR_DRBG_Update
+static void aes256_ctr_generate(const uint8x16_t vsubkeys[15], unsigned char V[16], unsigned char *x,
+                                unsigned long long xlen) {
+    const uint64x2_t minus_one = vdupq_n_u64(UINT64_MAX);
+    uint64x2_t ctr = aes256_ctr_blocks(vsubkeys, ctr_load(V), x, xlen / 16);
+    unsigned char block[16];
+
+    x += xlen - xlen % 16;
+
+    if (xlen % 16 != 0) {
+        ctr = aes256_ctr_x1(vsubkeys, ctr, block, 1);
+        memcpy(x, block, xlen % 16);
+    }
+
+    vst1q_u8(V, ctr_to_bytes(ctr_add(ctr, minus_one)));
+}
+
+#endif /* AES256_CTR_H */
@@ -10,7 +10,19 @@
 #include <arm_neon.h>
 #include <string.h>
 
-static AES256_CTR_DRBG_struct DRBG_ctx;
+#include "aes256_ctr.h"
+
+// Default state used by randombytes_init/randombytes. Thread-local, so that each thread has its own DRBG state
+static __thread randombytes_ctx_t default_ctx;
+
+// Clears secret data with volatile stores, which the compiler cannot drop as dead stores
+static void rng_wipe(void *p, size_t len) {
+    volatile unsigned char *v = (volatile unsigned char *)p;
+
+    while (len--) {
+        *v++ = 0;
+    }
+}
 
 static inline uint32_t AES_sbox_x4(uint32_t in) {
     uint8x16_t sbox_val = vreinterpretq_u8_u32(vdupq_n_u32(in));
@@ -84,13 +96,6 @@ static void AES256_key_schedule(uint8_t subkeys[15][16], const uint8_t *key) {
     }                                                        \
     while (0);
 
-//    subkeys - subkeys for AES-256
-//    ctr - a 128-bit plaintext value
-//    buffer - a 128-bit ciphertext value
-static void AES256_ECB(uint8x16_t vsubkeys[15], uint8x16_t ctr, unsigned char *buffer) {
-    AES256_ECB_XWAYS(1, vsubkeys, (&ctr), buffer);
-}
-
 // vsubkeys - subkeys for AES-256
 // ctr - an array of 3 x 128-bit plaintext value
 // buffer - an array of 3 x 128-bit ciphertext value
@@ -122,7 +127,7 @@ static void AES256_CTR_DRBG_Update(unsigned char *provided_data, uint8x16_t vsub
     __uint128_t V128, t;
     uint64x2_t vV[3];
 
-    memcpy(&V128, DRBG_ctx.V, sizeof(V128));
+    memcpy(&V128, V, sizeof(V128));
 
     bswap128(&V128);
 
@@ -140,12 +145,26 @@ static void AES256_CTR_DRBG_Update(unsigned char *provided_data, uint8x16_t vsub
     memcpy(Key, temp, 32);
     memcpy(V, temp + 32, 16);
 
-    add_to_V(DRBG_ctx.V, 1);
+    add_to_V(V, 1);
 }
 
 void randombytes_init(unsigned char *entropy_input, unsigned char *personalization_string, int security_strength) {
+    randombytes_ctx_init(&default_ctx, entropy_input, personalization_string, security_strength);
+}
+
+int randombytes(unsigned char *x, unsigned long long xlen) {
+    return randombytes_ctx(&default_ctx, x, xlen);
+}
+
+void randombytes_ctx_init(randombytes_ctx_t *ctx, unsigned char *entropy_input, unsigned char *personalization_string,
+                          int security_strength) {
+    AES256_CTR_DRBG_struct *DRBG_ctx = &(ctx != NULL ? ctx : &default_ctx)->drbg;
+
     (void)security_strength;
 
+    // Picks up a change of AES256_CTR_WAYS_ENV, see aes256_ctr_select
+    aes256_ctr_select();
+
     unsigned char seed_material[48];
     uint8_t subkeys[15][16];
     uint8x16_t vsubkeys[15];
@@ -153,107 +172,107 @@ void randombytes_init(unsigned char *entropy_input, unsigned char *personalizati
     memcpy(seed_material, entropy_input, 48);
     if (personalization_string)
         for (int i = 0; i < 48; i++) seed_material[i] ^= personalization_string[i];
-    memset(DRBG_ctx.Key, 0x00, 32);
-    memset(DRBG_ctx.V, 0x00, 16);
+    memset(DRBG_ctx->Key, 0x00, 32);
+    memset(DRBG_ctx->V, 0x00, 16);
 
-    AES256_key_schedule(subkeys, DRBG_ctx.Key);
+    AES256_key_schedule(subkeys, DRBG_ctx->Key);
     for (int i = 0; i < 15; i++) {
         vsubkeys[i] = vld1q_u8(subkeys[i]);
     }
 
-    AES256_CTR_DRBG_Update(seed_material, vsubkeys, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter = 1;
+    AES256_CTR_DRBG_Update(seed_material, vsubkeys, DRBG_ctx->Key, DRBG_ctx->V);
+    DRBG_ctx->reseed_counter = 1;
 }
 
-#define WAYS 4
-
-int randombytes(unsigned char *x, unsigned long long xlen) {
+int randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen) {
+    AES256_CTR_DRBG_struct *DRBG_ctx = &(ctx != NULL ? ctx : &default_ctx)->drbg;
     uint8_t subkeys[15][16];
-    unsigned char block[16];
-    __uint128_t V[WAYS], Vle[WAYS];
-    uint8x16x4_t vV;
     uint8x16_t vsubkeys[15];
 
-    AES256_key_schedule(subkeys, DRBG_ctx.Key);
+    AES256_key_schedule(subkeys, DRBG_ctx->Key);
 
     for (int j = 0; j < 15; j++) {
         vsubkeys[j] = vld1q_u8(subkeys[j]);
     }
 
-    memcpy(&Vle[0], DRBG_ctx.V, sizeof(Vle[0]));
-    V[0] = Vle[0];
-    vV.val[0] = vld1q_u8((uint8_t *)&V[0]);
-    bswap128(&Vle[0]);
-    for (int j = 1; j < WAYS; j++) {
-        Vle[j] = Vle[j - 1] + 1;
-        V[j] = Vle[j];
-        bswap128(&V[j]);
-        vV.val[j] = vld1q_u8((uint8_t *)&V[j]);
-    }
+    aes256_ctr_generate(vsubkeys, DRBG_ctx->V, x, xlen);
 
-    int entered_fast_path = (xlen >= WAYS * 16) ? 1 : 0;
+    AES256_CTR_DRBG_Update(NULL, vsubkeys, DRBG_ctx->Key, DRBG_ctx->V);
+    DRBG_ctx->reseed_counter++;
 
-    while (xlen >= WAYS * 16) {
-        for (int j = 0; j < WAYS; j++) {
-            Vle[j] += 4;
-        }
-
-        for (int j = 0; j < WAYS; j++) {
-            vV.val[j] = vaeseq_u8(vV.val[j], vsubkeys[0]);
-            vV.val[j] = vaesmcq_u8(vV.val[j]);
-        }
-
-        for (int i = 1; i < 13; i++) {
-            for (int j = 0; j < WAYS; j++) {
-                vV.val[j] = vaeseq_u8(vV.val[j], vsubkeys[i]);
-                vV.val[j] = vaesmcq_u8(vV.val[j]);
-            }
-        }
+    return RNG_SUCCESS;
+}
 
-        for (int j = 0; j < WAYS; j++) {
-            vV.val[j] = vaeseq_u8(vV.val[j], vsubkeys[13]);
-            vV.val[j] = veorq_u8(vV.val[j], vsubkeys[14]);
-            vst1q_u8(x + j * 16, vV.val[j]);
-        }
+// Added in NTRU-sampling, see rng.h. Block i of the request is encrypted from the counter stream.V + i; the key
+// schedule is computed once, in randombytes_stream_begin
+int randombytes_stream_begin(randombytes_ctx_t *ctx, unsigned long long xlen) {
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
 
-        for (int j = 0; j < WAYS; j++) {
-            V[j] = Vle[j];
-            bswap128(&V[j]);
-        }
+    memcpy(c->stream.V, c->drbg.V, 16);
+    AES256_key_schedule(c->stream.subkeys, c->drbg.Key);
+    c->stream.xlen = xlen;
+    c->stream.cached_block = 0;
 
-        vV = vld1q_u8_x4((uint8_t *)V);
+    return RNG_SUCCESS;
+}
 
-        x += WAYS * 16;
-        xlen -= WAYS * 16;
-    }
+int randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset,
+                            unsigned long long len) {
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
+    uint64x2_t ctr = ctr_load(c->stream.V);
+    uint8x16_t vsubkeys[15];
 
-    if (entered_fast_path && xlen == 0) {
-        asm volatile("" : "+r,m"(Vle[3]) : : "memory");
-        V[0] = Vle[3] - 4;
-        bswap128(&V[0]);
+    for (int j = 0; j < 15; j++) {
+        vsubkeys[j] = vld1q_u8(c->stream.subkeys[j]);
     }
 
-    while (xlen > 0) {
-        if (xlen > 16) {
-            AES256_ECB(vsubkeys, vld1q_u8((uint8_t *)&V[0]), x);
-            x += 16;
-            xlen -= 16;
+    // Whole blocks are encrypted directly into out; partial blocks at either end go through the one-block cache
+    while (len > 0) {
+        unsigned long long block = offset / 16, n;
 
-            Vle[0]++;
-            V[0] = Vle[0];
-            bswap128(&V[0]);
+        if (offset % 16 == 0 && len >= 16) {
+            n = len - len % 16;
+            aes256_ctr_blocks(vsubkeys, ctr_add_n(ctr, block), out, n / 16);
         }
         else {
-            AES256_ECB(vsubkeys, vld1q_u8((uint8_t *)&V[0]), block);
-            memcpy(x, block, xlen);
-            xlen = 0;
+            n = 16 - offset % 16 < len ? 16 - offset % 16 : len;
+
+            if (c->stream.cached_block != block + 1) {
+                aes256_ctr_x1(vsubkeys, ctr_add_n(ctr, block), c->stream.cache, 1);
+                c->stream.cached_block = block + 1;
+            }
+
+            memcpy(out, c->stream.cache + offset % 16, n);
         }
+
+        out += n;
+        offset += n;
+        len -= n;
     }
 
-    memcpy(DRBG_ctx.V, &V[0], sizeof(V[0]));
+    return RNG_SUCCESS;
+}
+
+int randombytes_stream_end(randombytes_ctx_t *ctx) {
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
+    const uint64x2_t minus_one = vdupq_n_u64(UINT64_MAX);
+    uint64x2_t ctr = ctr_add_n(ctr_load(c->stream.V), (c->stream.xlen + 15) / 16);
+    uint8x16_t vsubkeys[15];
+
+    for (int j = 0; j < 15; j++) {
+        vsubkeys[j] = vld1q_u8(c->stream.subkeys[j]);
+    }
+
+    // Same state as left by aes256_ctr_generate: the last used counter
+    vst1q_u8(c->drbg.V, ctr_to_bytes(ctr_add(ctr, minus_one)));
+
+    AES256_CTR_DRBG_Update(NULL, vsubkeys, c->drbg.Key, c->drbg.V);
+    c->drbg.reseed_counter++;
 
-    AES256_CTR_DRBG_Update(NULL, vsubkeys, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter++;
+    // The key schedule and the cached keystream block would otherwise stay in the context for as long as it lives
+    rng_wipe(c->stream.subkeys, sizeof(c->stream.subkeys));
+    rng_wipe(c->stream.cache, sizeof(c->stream.cache));
+    c->stream.cached_block = 0;
 
     return RNG_SUCCESS;
 }
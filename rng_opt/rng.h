@@ -37,4 +37,49 @@ randombytes_init(unsigned char *entropy_input,
 int
 randombytes(unsigned char *x, unsigned long long xlen);
 
+// Added in NTRU-sampling: caller-owned RNG state, so that several threads (or independent streams in a single thread)
+// can draw random bytes without sharing the state behind randombytes_init/randombytes. A NULL ctx selects the calling
+// thread's default state, i.e. the one used by randombytes_init/randombytes.
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+// Request in progress on a context, see randombytes_stream_begin
+typedef struct {
+    unsigned char       V[16];              // counter of the first block of the request
+    unsigned long long  xlen;
+    unsigned long long  cached_block;       // index of the block in cache, plus one (0 if the cache is empty)
+    unsigned char       cache[16];
+    unsigned char       subkeys[15][16];    // key schedule, cached by the optimized implementation
+} randombytes_stream_struct;
+
+struct randombytes_ctx_s {
+    AES256_CTR_DRBG_struct drbg;
+    randombytes_stream_struct stream;
+};
+
+void
+randombytes_ctx_init(randombytes_ctx_t *ctx,
+                     unsigned char *entropy_input,
+                     unsigned char *personalization_string,
+                     int security_strength);
+
+int
+randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen);
+
+// Added in NTRU-sampling: streaming form of randombytes_ctx(ctx, x, xlen), which lets the samplers consume random
+// bytes as they are generated rather than from a buffer holding all of x. randombytes_stream_begin starts the request;
+// randombytes_stream_read then writes x[offset], ..., x[offset + len - 1] to out, in any order and as many times as
+// needed; randombytes_stream_end updates the DRBG state exactly as randombytes_ctx would have, so the output of a
+// begin/read/end sequence is the same as that of randombytes_ctx. No other call may be made on ctx in between.
+int
+randombytes_stream_begin(randombytes_ctx_t *ctx, unsigned long long xlen);
+
+int
+randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset, unsigned long long len);
+
+int
+randombytes_stream_end(randombytes_ctx_t *ctx);
+
 #endif /* rng_h */
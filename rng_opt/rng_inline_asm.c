@@ -10,13 +10,25 @@
 
 #include "rng.h"
 
+#include "aes256_ctr.h"
+
 typedef union {
     uint8_t u8[16];
     uint64_t u64[2];
     __uint128_t u128;
 } u128_t;
 
-static AES256_CTR_DRBG_struct DRBG_ctx;
+// Default state used by randombytes_init/randombytes. Thread-local, so that each thread has its own DRBG state
+static __thread randombytes_ctx_t default_ctx;
+
+// Clears secret data with volatile stores, which the compiler cannot drop as dead stores
+static void rng_wipe(void *p, size_t len) {
+    volatile unsigned char *v = (volatile unsigned char *)p;
+
+    while (len--) {
+        *v++ = 0;
+    }
+}
 
 static inline uint32_t AES_sbox_x4(uint32_t in) {
     uint8x16_t sbox_val = vreinterpretq_u8_u32(vdupq_n_u32(in));
@@ -121,13 +133,11 @@ static void incr_V(u128_t *V) {
 
 static void AES256_CTR_DRBG_Update(unsigned char *provided_data, uint8x16_t vsubkeys[15], unsigned char *Key,
                                    unsigned char *V) {
-    (void)V;
-
     unsigned char temp[48];
     u128_t V128, t;
     uint64x2_t vV[3];
 
-    memcpy(&V128, DRBG_ctx.V, sizeof(V128));
+    memcpy(&V128, V, sizeof(V128));
 
     bswap128(&V128);
 
@@ -147,12 +157,26 @@ static void AES256_CTR_DRBG_Update(unsigned char *provided_data, uint8x16_t vsub
 
     incr_V(&V128);
 
-    memcpy(DRBG_ctx.V, V128.u8, 16);
+    memcpy(V, V128.u8, 16);
 }
 
 void randombytes_init(unsigned char *entropy_input, unsigned char *personalization_string, int security_strength) {
+    randombytes_ctx_init(&default_ctx, entropy_input, personalization_string, security_strength);
+}
+
+int randombytes(unsigned char *x, unsigned long long xlen) {
+    return randombytes_ctx(&default_ctx, x, xlen);
+}
+
+void randombytes_ctx_init(randombytes_ctx_t *ctx, unsigned char *entropy_input, unsigned char *personalization_string,
+                          int security_strength) {
+    AES256_CTR_DRBG_struct *DRBG_ctx = &(ctx != NULL ? ctx : &default_ctx)->drbg;
+
     (void)security_strength;
 
+    // Picks up a change of AES256_CTR_WAYS_ENV, see aes256_ctr_select
+    aes256_ctr_select();
+
     unsigned char seed_material[48];
     uint8_t subkeys[15][16];
     uint8x16_t vsubkeys[15];
@@ -160,240 +184,322 @@ void randombytes_init(unsigned char *entropy_input, unsigned char *personalizati
     memcpy(seed_material, entropy_input, 48);
     if (personalization_string)
         for (int i = 0; i < 48; i++) seed_material[i] ^= personalization_string[i];
-    memset(DRBG_ctx.Key, 0x00, 32);
-    memset(DRBG_ctx.V, 0x00, 16);
+    memset(DRBG_ctx->Key, 0x00, 32);
+    memset(DRBG_ctx->V, 0x00, 16);
 
-    AES256_key_schedule(subkeys, DRBG_ctx.Key);
+    AES256_key_schedule(subkeys, DRBG_ctx->Key);
     for (int i = 0; i < 15; i++) {
         vsubkeys[i] = vld1q_u8(subkeys[i]);
     }
 
-    AES256_CTR_DRBG_Update(seed_material, vsubkeys, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter = 1;
+    AES256_CTR_DRBG_Update(seed_material, vsubkeys, DRBG_ctx->Key, DRBG_ctx->V);
+    DRBG_ctx->reseed_counter = 1;
 }
 
 #define WAYS 4
 
-int randombytes(unsigned char *x, unsigned long long xlen) {
+int randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen) {
+    AES256_CTR_DRBG_struct *DRBG_ctx = &(ctx != NULL ? ctx : &default_ctx)->drbg;
     uint8_t subkeys[15][16];
     unsigned char block[16];
     u128_t V[WAYS], Vle[WAYS];
     uint8x16x4_t vV;
     uint8x16_t vsubkeys[15];
 
-    AES256_key_schedule(subkeys, DRBG_ctx.Key);
+    AES256_key_schedule(subkeys, DRBG_ctx->Key);
 
     for (int j = 0; j < 15; j++) {
         vsubkeys[j] = vld1q_u8(subkeys[j]);
     }
 
+    // The hand-scheduled loop below is used when 4 ways are selected for this core; other widths, and requests shorter
+    // than 4 blocks, use the intrinsics in aes256_ctr.h
+    if (aes256_ctr_ways() != WAYS || xlen < WAYS * 16) {
+        aes256_ctr_generate(vsubkeys, DRBG_ctx->V, x, xlen);
+    }
+    else {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Woverlength-strings"
-    asm("ldp         %[V0l],     %[V0h],  %[DRBG_ctx_V]     \n\t"
-        "stp         %[V0l],     %[V0h],    [%[V]     ]     \n\t"
-        "rev       %[Vle0h],     %[V0l]                     \n\t"
-        "rev       %[Vle0l],     %[V0h]                     \n\t"
-        "adds      %[Vle1l],   %[Vle0l],             #1     \n\t"
-        "adc       %[Vle1h],   %[Vle0h],            xzr     \n\t"
-        "rev         %[V1h],   %[Vle1l]                     \n\t"
-        "rev         %[V1l],   %[Vle1h]                     \n\t"
-        "stp         %[V1l],     %[V1h],    [%[V], #16]     \n\t"
-        "adds      %[Vle2l],   %[Vle0l],             #2     \n\t"
-        "adc       %[Vle2h],   %[Vle0h],            xzr     \n\t"
-        "rev         %[V2h],   %[Vle2l]                     \n\t"
-        "rev         %[V2l],   %[Vle2h]                     \n\t"
-        "stp         %[V2l],     %[V2h],    [%[V], #32]     \n\t"
-        "adds      %[Vle3l],   %[Vle0l],             #3     \n\t"
-        "adc       %[Vle3h],   %[Vle0h],            xzr     \n\t"
-        "rev         %[V3h],   %[Vle3l]                     \n\t"
-        "rev         %[V3l],   %[Vle3h]                     \n\t"
-        "stp         %[V3l],     %[V3h],    [%[V], #48]     \n\t"
-        "ld1       { %[vV0].16b, %[vV1].16b, %[vV2].16b, %[vV3].16b }, [%[V]]\n\t"
-        "cmp        %[xlen],          #64                   \n\t"
-        "b.lo            2f                                 \n\t"
-        ".p2align         6                                 \n\t"
-        "1:                                                 \n\t"
-        "aese    %[vV0].16b,  %[vsk0].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk0].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk0].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk0].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b,  %[vsk1].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk1].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk1].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk1].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "adds      %[Vle0l],     %[Vle0l],           #4     \n\t"
-        "adc       %[Vle0h],     %[Vle0h],          xzr     \n\t"
-        "adds      %[Vle1l],     %[Vle1l],           #4     \n\t"
-        "adc       %[Vle1h],     %[Vle1h],          xzr     \n\t"
-        "adds      %[Vle2l],     %[Vle2l],           #4     \n\t"
-        "adc       %[Vle2h],     %[Vle2h],          xzr     \n\t"
-        "adds      %[Vle3l],     %[Vle3l],           #4     \n\t"
-        "adc       %[Vle3h],     %[Vle3h],          xzr     \n\t"
-        "aese    %[vV0].16b,  %[vsk2].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk2].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk2].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk2].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b,  %[vsk3].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk3].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk3].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk3].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "rev         %[V0h],     %[Vle0l]                   \n\t"
-        "rev         %[V0l],     %[Vle0h]                   \n\t"
-        "rev         %[V1h],     %[Vle1l]                   \n\t"
-        "rev         %[V1l],     %[Vle1h]                   \n\t"
-        "rev         %[V2h],     %[Vle2l]                   \n\t"
-        "rev         %[V2l],     %[Vle2h]                   \n\t"
-        "rev         %[V3h],     %[Vle3l]                   \n\t"
-        "rev         %[V3l],     %[Vle3h]                   \n\t"
-        "aese    %[vV0].16b,  %[vsk4].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk4].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk4].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk4].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b,  %[vsk5].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk5].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk5].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk5].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b,  %[vsk6].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk6].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk6].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk6].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b,  %[vsk7].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk7].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk7].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk7].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b,  %[vsk8].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk8].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk8].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk8].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b,  %[vsk9].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b,  %[vsk9].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b,  %[vsk9].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b,  %[vsk9].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "stp         %[V0l],       %[V0h],  [%[V]]          \n\t"
-        "stp         %[V1l],       %[V1h],  [%[V], #16]     \n\t"
-        "stp         %[V2l],       %[V2h],  [%[V], #32]     \n\t"
-        "stp         %[V3l],       %[V3h],  [%[V], #48]     \n\t"
-        "aese    %[vV0].16b, %[vsk10].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b, %[vsk10].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b, %[vsk10].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b, %[vsk10].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b, %[vsk11].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b, %[vsk11].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b, %[vsk11].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b, %[vsk11].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b, %[vsk12].16b                   \n\t"
-        "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
-        "aese    %[vV1].16b, %[vsk12].16b                   \n\t"
-        "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
-        "aese    %[vV2].16b, %[vsk12].16b                   \n\t"
-        "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
-        "aese    %[vV3].16b, %[vsk12].16b                   \n\t"
-        "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
-        "aese    %[vV0].16b, %[vsk13].16b                   \n\t"
-        "eor     %[vV0].16b,   %[vV0].16b, %[vsk14].16b     \n\t"
-        "aese    %[vV1].16b, %[vsk13].16b                   \n\t"
-        "eor     %[vV1].16b,   %[vV1].16b, %[vsk14].16b     \n\t"
-        "stp        %q[vV0],      %q[vV1],       [%[x]], #32\n\t"
-        "aese    %[vV2].16b, %[vsk13].16b                   \n\t"
-        "eor     %[vV2].16b,   %[vV2].16b, %[vsk14].16b     \n\t"
-        "aese    %[vV3].16b, %[vsk13].16b                   \n\t"
-        "eor     %[vV3].16b,   %[vV3].16b, %[vsk14].16b     \n\t"
-        "stp        %q[vV2],      %q[vV3],       [%[x]], #32\n\t"
-        "sub        %[xlen],      %[xlen],          #64     \n\t"
-        "ld1       { %[vV0].16b, %[vV1].16b, %[vV2].16b, %[vV3].16b }, [%[V]]\n\t"
-        "cmp        %[xlen],          #64                   \n\t"
-        "b.hs            1b                                 \n\t"
-        "cbnz       %[xlen],           2f                   \n\t"
-        "subs        %[V0h],     %[Vle3l],           #4     \n\t"
-        "sbc         %[V0l],     %[Vle3h],          xzr     \n\t"
-        "rev         %[V0h],       %[V0h]                   \n\t"
-        "rev         %[V0l],       %[V0l]                   \n\t"
-        "stp         %[V0l],       %[V0h],       [%[V]]     \n\t"
-        "2:                                                 \n\t"
-        : [vV0] "=&w"(vV.val[0]), [vV1] "=&w"(vV.val[1]), [vV2] "=&w"(vV.val[2]), [vV3] "=&w"(vV.val[3]),
-          [Vle0l] "=&r"(Vle[0].u64[0]), [Vle0h] "=&r"(Vle[0].u64[1]), [Vle1l] "=&r"(Vle[1].u64[0]),
-          [Vle1h] "=&r"(Vle[1].u64[1]), [Vle2l] "=&r"(Vle[2].u64[0]), [Vle2h] "=&r"(Vle[2].u64[1]),
-          [Vle3l] "=&r"(Vle[3].u64[0]), [Vle3h] "=&r"(Vle[3].u64[1]), [x] "+r"(x), [xlen] "+r"(xlen),
-          [V0l] "=&r"(V[0].u64[0]), [V0h] "=&r"(V[0].u64[1]), [V1l] "=&r"(V[1].u64[0]), [V1h] "=&r"(V[1].u64[1]),
-          [V2l] "=&r"(V[2].u64[0]), [V2h] "=&r"(V[2].u64[1]), [V3l] "=&r"(V[3].u64[0]), [V3h] "=&r"(V[3].u64[1]),
-          "=m"(*(unsigned char(*)[64])x), "=m"(*(unsigned char(*)[64])V)
-        : [vsk0] "w"(vsubkeys[0]), [vsk1] "w"(vsubkeys[1]), [vsk2] "w"(vsubkeys[2]), [vsk3] "w"(vsubkeys[3]),
-          [vsk4] "w"(vsubkeys[4]), [vsk5] "w"(vsubkeys[5]), [vsk6] "w"(vsubkeys[6]), [vsk7] "w"(vsubkeys[7]),
-          [vsk8] "w"(vsubkeys[8]), [vsk9] "w"(vsubkeys[9]), [vsk10] "w"(vsubkeys[10]), [vsk11] "w"(vsubkeys[11]),
-          [vsk12] "w"(vsubkeys[12]), [vsk13] "w"(vsubkeys[13]), [vsk14] "w"(vsubkeys[14]), [V] "r"(V),
-          [DRBG_ctx_V] "m"(DRBG_ctx.V)
-        : "cc");
+        asm("ldp         %[V0l],     %[V0h],  %[DRBG_ctx_V]     \n\t"
+            "stp         %[V0l],     %[V0h],    [%[V]     ]     \n\t"
+            "rev       %[Vle0h],     %[V0l]                     \n\t"
+            "rev       %[Vle0l],     %[V0h]                     \n\t"
+            "adds      %[Vle1l],   %[Vle0l],             #1     \n\t"
+            "adc       %[Vle1h],   %[Vle0h],            xzr     \n\t"
+            "rev         %[V1h],   %[Vle1l]                     \n\t"
+            "rev         %[V1l],   %[Vle1h]                     \n\t"
+            "stp         %[V1l],     %[V1h],    [%[V], #16]     \n\t"
+            "adds      %[Vle2l],   %[Vle0l],             #2     \n\t"
+            "adc       %[Vle2h],   %[Vle0h],            xzr     \n\t"
+            "rev         %[V2h],   %[Vle2l]                     \n\t"
+            "rev         %[V2l],   %[Vle2h]                     \n\t"
+            "stp         %[V2l],     %[V2h],    [%[V], #32]     \n\t"
+            "adds      %[Vle3l],   %[Vle0l],             #3     \n\t"
+            "adc       %[Vle3h],   %[Vle0h],            xzr     \n\t"
+            "rev         %[V3h],   %[Vle3l]                     \n\t"
+            "rev         %[V3l],   %[Vle3h]                     \n\t"
+            "stp         %[V3l],     %[V3h],    [%[V], #48]     \n\t"
+            "ld1       { %[vV0].16b, %[vV1].16b, %[vV2].16b, %[vV3].16b }, [%[V]]\n\t"
+            "cmp        %[xlen],          #64                   \n\t"
+            "b.lo            2f                                 \n\t"
+            ".p2align         6                                 \n\t"
+            "1:                                                 \n\t"
+            "aese    %[vV0].16b,  %[vsk0].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk0].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk0].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk0].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b,  %[vsk1].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk1].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk1].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk1].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "adds      %[Vle0l],     %[Vle0l],           #4     \n\t"
+            "adc       %[Vle0h],     %[Vle0h],          xzr     \n\t"
+            "adds      %[Vle1l],     %[Vle1l],           #4     \n\t"
+            "adc       %[Vle1h],     %[Vle1h],          xzr     \n\t"
+            "adds      %[Vle2l],     %[Vle2l],           #4     \n\t"
+            "adc       %[Vle2h],     %[Vle2h],          xzr     \n\t"
+            "adds      %[Vle3l],     %[Vle3l],           #4     \n\t"
+            "adc       %[Vle3h],     %[Vle3h],          xzr     \n\t"
+            "aese    %[vV0].16b,  %[vsk2].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk2].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk2].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk2].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b,  %[vsk3].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk3].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk3].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk3].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "rev         %[V0h],     %[Vle0l]                   \n\t"
+            "rev         %[V0l],     %[Vle0h]                   \n\t"
+            "rev         %[V1h],     %[Vle1l]                   \n\t"
+            "rev         %[V1l],     %[Vle1h]                   \n\t"
+            "rev         %[V2h],     %[Vle2l]                   \n\t"
+            "rev         %[V2l],     %[Vle2h]                   \n\t"
+            "rev         %[V3h],     %[Vle3l]                   \n\t"
+            "rev         %[V3l],     %[Vle3h]                   \n\t"
+            "aese    %[vV0].16b,  %[vsk4].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk4].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk4].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk4].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b,  %[vsk5].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk5].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk5].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk5].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b,  %[vsk6].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk6].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk6].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk6].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b,  %[vsk7].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk7].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk7].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk7].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b,  %[vsk8].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk8].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk8].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk8].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b,  %[vsk9].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b,  %[vsk9].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b,  %[vsk9].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b,  %[vsk9].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "stp         %[V0l],       %[V0h],  [%[V]]          \n\t"
+            "stp         %[V1l],       %[V1h],  [%[V], #16]     \n\t"
+            "stp         %[V2l],       %[V2h],  [%[V], #32]     \n\t"
+            "stp         %[V3l],       %[V3h],  [%[V], #48]     \n\t"
+            "aese    %[vV0].16b, %[vsk10].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b, %[vsk10].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b, %[vsk10].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b, %[vsk10].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b, %[vsk11].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b, %[vsk11].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b, %[vsk11].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b, %[vsk11].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b, %[vsk12].16b                   \n\t"
+            "aesmc   %[vV0].16b,   %[vV0].16b                   \n\t"
+            "aese    %[vV1].16b, %[vsk12].16b                   \n\t"
+            "aesmc   %[vV1].16b,   %[vV1].16b                   \n\t"
+            "aese    %[vV2].16b, %[vsk12].16b                   \n\t"
+            "aesmc   %[vV2].16b,   %[vV2].16b                   \n\t"
+            "aese    %[vV3].16b, %[vsk12].16b                   \n\t"
+            "aesmc   %[vV3].16b,   %[vV3].16b                   \n\t"
+            "aese    %[vV0].16b, %[vsk13].16b                   \n\t"
+            "eor     %[vV0].16b,   %[vV0].16b, %[vsk14].16b     \n\t"
+            "aese    %[vV1].16b, %[vsk13].16b                   \n\t"
+            "eor     %[vV1].16b,   %[vV1].16b, %[vsk14].16b     \n\t"
+            "stp        %q[vV0],      %q[vV1],       [%[x]], #32\n\t"
+            "aese    %[vV2].16b, %[vsk13].16b                   \n\t"
+            "eor     %[vV2].16b,   %[vV2].16b, %[vsk14].16b     \n\t"
+            "aese    %[vV3].16b, %[vsk13].16b                   \n\t"
+            "eor     %[vV3].16b,   %[vV3].16b, %[vsk14].16b     \n\t"
+            "stp        %q[vV2],      %q[vV3],       [%[x]], #32\n\t"
+            "sub        %[xlen],      %[xlen],          #64     \n\t"
+            "ld1       { %[vV0].16b, %[vV1].16b, %[vV2].16b, %[vV3].16b }, [%[V]]\n\t"
+            "cmp        %[xlen],          #64                   \n\t"
+            "b.hs            1b                                 \n\t"
+            "cbnz       %[xlen],           2f                   \n\t"
+            "subs        %[V0h],     %[Vle3l],           #4     \n\t"
+            "sbc         %[V0l],     %[Vle3h],          xzr     \n\t"
+            "rev         %[V0h],       %[V0h]                   \n\t"
+            "rev         %[V0l],       %[V0l]                   \n\t"
+            "stp         %[V0l],       %[V0h],       [%[V]]     \n\t"
+            "2:                                                 \n\t"
+            : [vV0] "=&w"(vV.val[0]), [vV1] "=&w"(vV.val[1]), [vV2] "=&w"(vV.val[2]), [vV3] "=&w"(vV.val[3]),
+              [Vle0l] "=&r"(Vle[0].u64[0]), [Vle0h] "=&r"(Vle[0].u64[1]), [Vle1l] "=&r"(Vle[1].u64[0]),
+              [Vle1h] "=&r"(Vle[1].u64[1]), [Vle2l] "=&r"(Vle[2].u64[0]), [Vle2h] "=&r"(Vle[2].u64[1]),
+              [Vle3l] "=&r"(Vle[3].u64[0]), [Vle3h] "=&r"(Vle[3].u64[1]), [x] "+r"(x), [xlen] "+r"(xlen),
+              [V0l] "=&r"(V[0].u64[0]), [V0h] "=&r"(V[0].u64[1]), [V1l] "=&r"(V[1].u64[0]), [V1h] "=&r"(V[1].u64[1]),
+              [V2l] "=&r"(V[2].u64[0]), [V2h] "=&r"(V[2].u64[1]), [V3l] "=&r"(V[3].u64[0]), [V3h] "=&r"(V[3].u64[1]),
+              "=m"(*(unsigned char(*)[64])x), "=m"(*(unsigned char(*)[64])V)
+            : [vsk0] "w"(vsubkeys[0]), [vsk1] "w"(vsubkeys[1]), [vsk2] "w"(vsubkeys[2]), [vsk3] "w"(vsubkeys[3]),
+              [vsk4] "w"(vsubkeys[4]), [vsk5] "w"(vsubkeys[5]), [vsk6] "w"(vsubkeys[6]), [vsk7] "w"(vsubkeys[7]),
+              [vsk8] "w"(vsubkeys[8]), [vsk9] "w"(vsubkeys[9]), [vsk10] "w"(vsubkeys[10]), [vsk11] "w"(vsubkeys[11]),
+              [vsk12] "w"(vsubkeys[12]), [vsk13] "w"(vsubkeys[13]), [vsk14] "w"(vsubkeys[14]), [V] "r"(V),
+              [DRBG_ctx_V] "m"(DRBG_ctx->V)
+            : "cc");
 #pragma GCC diagnostic pop
 
-    while (xlen > 0) {
-        if (xlen > 16) {
-            AES256_ECB(vsubkeys, vld1q_u8((uint8_t *)&V[0]), x);
-            x += 16;
-            xlen -= 16;
+        while (xlen > 0) {
+            if (xlen > 16) {
+                AES256_ECB(vsubkeys, vld1q_u8((uint8_t *)&V[0]), x);
+                x += 16;
+                xlen -= 16;
+
+                Vle[0].u128++;
+                V[0] = Vle[0];
+                bswap128(&V[0]);
+            }
+            else {
+                AES256_ECB(vsubkeys, vld1q_u8((uint8_t *)&V[0]), block);
+                memcpy(x, block, xlen);
+                xlen = 0;
+            }
+        }
+
+        memcpy(DRBG_ctx->V, &V[0], sizeof(V[0]));
+    }
+
+    AES256_CTR_DRBG_Update(NULL, vsubkeys, DRBG_ctx->Key, DRBG_ctx->V);
+    DRBG_ctx->reseed_counter++;
+
+    return RNG_SUCCESS;
+}
+
+// Added in NTRU-sampling, see rng.h. Block i of the request is encrypted from the counter stream.V + i; the key
+// schedule is computed once, in randombytes_stream_begin
+int randombytes_stream_begin(randombytes_ctx_t *ctx, unsigned long long xlen) {
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
 
-            Vle[0].u128++;
-            V[0] = Vle[0];
-            bswap128(&V[0]);
+    memcpy(c->stream.V, c->drbg.V, 16);
+    AES256_key_schedule(c->stream.subkeys, c->drbg.Key);
+    c->stream.xlen = xlen;
+    c->stream.cached_block = 0;
+
+    return RNG_SUCCESS;
+}
+
+int randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset,
+                            unsigned long long len) {
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
+    uint64x2_t ctr = ctr_load(c->stream.V);
+    uint8x16_t vsubkeys[15];
+
+    for (int j = 0; j < 15; j++) {
+        vsubkeys[j] = vld1q_u8(c->stream.subkeys[j]);
+    }
+
+    // Whole blocks are encrypted directly into out; partial blocks at either end go through the one-block cache
+    while (len > 0) {
+        unsigned long long block = offset / 16, n;
+
+        if (offset % 16 == 0 && len >= 16) {
+            n = len - len % 16;
+            aes256_ctr_blocks(vsubkeys, ctr_add_n(ctr, block), out, n / 16);
         }
         else {
-            AES256_ECB(vsubkeys, vld1q_u8((uint8_t *)&V[0]), block);
-            memcpy(x, block, xlen);
-            xlen = 0;
+            n = 16 - offset % 16 < len ? 16 - offset % 16 : len;
+
+            if (c->stream.cached_block != block + 1) {
+                aes256_ctr_x1(vsubkeys, ctr_add_n(ctr, block), c->stream.cache, 1);
+                c->stream.cached_block = block + 1;
+            }
+
+            memcpy(out, c->stream.cache + offset % 16, n);
         }
+
+        out += n;
+        offset += n;
+        len -= n;
     }
 
-    memcpy(DRBG_ctx.V, &V[0], sizeof(V[0]));
+    return RNG_SUCCESS;
+}
+
+int randombytes_stream_end(randombytes_ctx_t *ctx) {
+    randombytes_ctx_t *c = ctx != NULL ? ctx : &default_ctx;
+    const uint64x2_t minus_one = vdupq_n_u64(UINT64_MAX);
+    uint64x2_t ctr = ctr_add_n(ctr_load(c->stream.V), (c->stream.xlen + 15) / 16);
+    uint8x16_t vsubkeys[15];
+
+    for (int j = 0; j < 15; j++) {
+        vsubkeys[j] = vld1q_u8(c->stream.subkeys[j]);
+    }
+
+    // Same state as left by aes256_ctr_generate: the last used counter
+    vst1q_u8(c->drbg.V, ctr_to_bytes(ctr_add(ctr, minus_one)));
+
+    AES256_CTR_DRBG_Update(NULL, vsubkeys, c->drbg.Key, c->drbg.V);
+    c->drbg.reseed_counter++;
 
-    AES256_CTR_DRBG_Update(NULL, vsubkeys, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter++;
+    // The key schedule and the cached keystream block would otherwise stay in the context for as long as it lives
+    rng_wipe(c->stream.subkeys, sizeof(c->stream.subkeys));
+    rng_wipe(c->stream.cache, sizeof(c->stream.cache));
+    c->stream.cached_block = 0;
 
     return RNG_SUCCESS;
 }
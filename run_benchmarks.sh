@@ -130,7 +130,7 @@ do
                 then
                     IMPLS="CCHY23"
                 else
-                    IMPLS="NG21"
+                    IMPLS="NG21 CCHY23"
                 fi
 
                 for IMPL in $IMPLS
@@ -173,8 +173,8 @@ do
                         # run
                         ./speed > /dev/null
                         ./speed > /dev/null
-                        # Actual run
-                        ./speed > ${OUTPUT_FILE}
+                        # Actual run; the statistics of every operation go to the JSON and CSV files
+                        ./speed --json "${OUTPUT_FILE%.txt}.json" --csv "${OUTPUT_FILE%.txt}.csv" > ${OUTPUT_FILE}
 
                         echo Waiting for the system to cool down for ${COOLDOWN_MIDDLE} seconds...
                         sleep ${COOLDOWN_MIDDLE}
@@ -184,6 +184,7 @@ do
                 if [ "$PARAMETER_SET" != "hrss701" ]
                 then
                     SPEED_EXEC=speed_sample_fixed_type_${PARAMETER_SET}_${SAMPLING}
+                    OUTPUT_FILE="../${PATHNAME}/sample_fixed_type:${PARAMETER_SET}:${SAMPLING}:$(basename ${CC}:DIT_${FEAT_DIT}).txt"
                     echo "Benchmarking ${SPEED_EXEC}"
                     
                     # https://stackoverflow.com/questions/77711672/performance-of-cpu-only-code-varies-with-executable-file-name
@@ -192,8 +193,8 @@ do
                     # Run twice to warm up; e.g. macOS needs to verify the code signature and is slower on the first run
                     ./speed > /dev/null
                     ./speed > /dev/null
-                    # Actual run
-                    ./speed > "../${PATHNAME}/sample_fixed_type:${PARAMETER_SET}:${SAMPLING}:$(basename ${CC}:DIT_${FEAT_DIT}).txt"
+                    # Actual run; the statistics of every operation go to the JSON and CSV files
+                    ./speed --json "${OUTPUT_FILE%.txt}.json" --csv "${OUTPUT_FILE%.txt}.csv" > ${OUTPUT_FILE}
 
                     echo Waiting for the system to cool down for ${COOLDOWN_MIDDLE} seconds...
                     sleep ${COOLDOWN_MIDDLE}
@@ -201,6 +202,60 @@ do
             done
         done
 
+        # The polynomial arithmetic and the kernels of the multipliers of every library, in a single table. It does not
+        # depend on the sampling, so only the sorting libraries are run
+        POLYMUL_FILE="../${PATHNAME}/polymul:$(basename ${CC}:DIT_${FEAT_DIT}).csv"
+        rm -f ${POLYMUL_FILE}
+
+        for PARAMETER_SET in hps2048509 hps2048677 hps4096821 hrss701
+        do
+            if [ "$PARAMETER_SET" == "hrss701" ]
+            then
+                LIBRARIES="NG21_neon CCHY23_tmvp dispatch"
+                SUFFIX=""
+            else
+                LIBRARIES="NG21_neon CCHY23_tc CCHY23_tmvp dispatch"
+                SUFFIX="_sorting"
+            fi
+
+            if [[ "$OS" == "macOS" ]]
+            then
+                LIBRARIES="NG21_amx $LIBRARIES"
+
+                if [ "$PARAMETER_SET" == "hps2048677" ] || [ "$PARAMETER_SET" == "hrss701" ]
+                then
+                    LIBRARIES="CCHY23_amx $LIBRARIES"
+                fi
+            fi
+
+            for LIBRARY in $LIBRARIES
+            do
+                IMPL=${LIBRARY%%_*}
+                VARIANT=${LIBRARY#*_}
+                SPEED_EXEC=speed_polymul_ntru${PARAMETER_SET}_${LIBRARY}${SUFFIX}
+                echo "Benchmarking ${SPEED_EXEC}"
+
+                # https://stackoverflow.com/questions/77711672/performance-of-cpu-only-code-varies-with-executable-file-name
+                cp ${SPEED_EXEC} speed
+
+                # Run twice to warm up; e.g. macOS needs to verify the code signature and is slower on the first run
+                ./speed > /dev/null
+                ./speed > /dev/null
+                # Actual run; the rows of its CSV file go to the table, after the library
+                ./speed --csv speed.csv > /dev/null
+
+                if [ ! -f ${POLYMUL_FILE} ]
+                then
+                    head -n 1 speed.csv | sed -e 's/^/parameter_set,impl,variant,/' > ${POLYMUL_FILE}
+                fi
+
+                tail -n +2 speed.csv | sed -e "s/^/${PARAMETER_SET},${IMPL},${VARIANT},/" >> ${POLYMUL_FILE}
+
+                echo Waiting for the system to cool down for ${COOLDOWN_MIDDLE} seconds...
+                sleep ${COOLDOWN_MIDDLE}
+            done
+        done
+
         cd ..
     done
 done
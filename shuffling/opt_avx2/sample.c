@@ -0,0 +1,275 @@
+// clang-format off
+
+#include <immintrin.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+#include "sample.h"
+#include "sampling_tables.h"
+
+void sample_fg(poly *f, poly *g, const unsigned char uniformbytes[NTRU_SAMPLE_FG_BYTES])
+{
+#ifdef NTRU_HRSS
+  sample_iid_plus(f,uniformbytes);
+  sample_iid_plus(g,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+
+#ifdef NTRU_HPS
+  sample_iid(f,uniformbytes);
+  sample_fixed_type(g,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+}
+
+void sample_rm(poly *r, poly *m, const unsigned char uniformbytes[NTRU_SAMPLE_RM_BYTES])
+{
+#ifdef NTRU_HRSS
+  sample_iid(r,uniformbytes);
+  sample_iid(m,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+
+#ifdef NTRU_HPS
+  sample_iid(r,uniformbytes);
+  sample_fixed_type(m,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+}
+
+#ifdef NTRU_HRSS
+void sample_iid_plus(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES])
+{
+  /* Sample r using sample_iid then conditionally flip    */
+  /* signs of even index coefficients so that <x*r, r> >= 0.      */
+
+  int i;
+  uint16_t s = 0;
+
+  sample_iid(r, uniformbytes);
+
+  /* Map {0,1,2} -> {0, 1, 2^16 - 1} */
+  for(i=0; i<NTRU_N-1; i++)
+    r->coeffs[i] = r->coeffs[i] | (-(r->coeffs[i]>>1));
+
+  /* s = <x*r, r>.  (r[n-1] = 0) */
+  for(i=0; i<NTRU_N-1; i++)
+    s += (uint16_t)((uint32_t)r->coeffs[i + 1] * (uint32_t)r->coeffs[i]);
+
+  /* Extract sign of s (sign(0) = 1) */
+  s = 1 | (-(s>>15));
+
+  for(i=0; i<NTRU_N; i+=2)
+    r->coeffs[i] = (uint16_t)((uint32_t)s * (uint32_t)r->coeffs[i]);
+
+  /* Map {0,1,2^16-1} -> {0, 1, 2} */
+  for(i=0; i<NTRU_N; i++)
+    r->coeffs[i] = 3 & (r->coeffs[i] ^ (r->coeffs[i]>>15));
+}
+#endif
+
+#ifdef NTRU_HPS
+// Length of shuffle_indices, padded to a multiple of the vector length
+#define SHUFFLE_INDICES_LEN ((NTRU_N - 1 + 15) & ~15)
+
+// Vector part of the rejection sampling: computes the 16 candidate shuffle indices starting at position i from
+// u[0], ..., u[15], and returns a bitmask (2 bits per lane) of the lanes that must be resampled
+static inline uint32_t simd_rejsamplingmod_lanes(int i, int16_t shuffle_indices[], __m256i *vs, const uint16_t u[]) {
+  const __m256i vs_delta = _mm256_set1_epi16(16);
+  __m256i vrnd, vthr, vl, vh;
+
+  vrnd = _mm256_loadu_si256((const __m256i *)u);
+  vthr = _mm256_load_si256((const __m256i *)&vt[i]);
+
+  vl = _mm256_mullo_epi16(vrnd, *vs);
+  vh = _mm256_mulhi_epu16(vrnd, *vs);
+  *vs = _mm256_sub_epi16(*vs, vs_delta);
+
+  _mm256_storeu_si256((__m256i *)&shuffle_indices[i], vh);
+
+  // There is no unsigned 16-bit compare in AVX2, so l < t is computed as max(l, t) != l (2 mask bits per lane)
+  return ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_max_epu16(vl, vthr), vl));
+}
+
+// Computes all candidate shuffle indices, 16 at a time, then resamples the rejected lanes in increasing order of
+// position. Rejected lanes consume random numbers from u[NTRU_N - 1] onwards in the same order as rejsamplingmod in
+// shuffling/ref/sample.c, so the outputs of both versions are identical.
+static void simd_rejsamplingmod(int16_t shuffle_indices[], const uint16_t u[]) {
+  __m256i vs = _mm256_load_si256((const __m256i *)d);
+  uint32_t res;
+  int i, j = NTRU_N - 1, k;
+
+  for (i = 0; i < NTRU_N - 1; i += 16) {
+    res = simd_rejsamplingmod_lanes(i, shuffle_indices, &vs, &u[i]);
+
+    while (res != 0) {
+      uint32_t m;
+      uint16_t s, t, l;
+
+      k = __builtin_ctz(res) / 2;
+
+      s = NTRU_N - 1 - (i + k);
+      t = vt[i + k];
+      do {
+        m = (uint32_t)u[j++] * s;
+        l = m;
+      }
+      while (l < t);
+      shuffle_indices[i + k] = m >> 16;
+
+      res &= res - 1;
+      res &= res - 1;
+    }
+  }
+}
+
+// Branchless counter update, as in the ISOCHRONOUS_SAMPLING branch of shuffling/ref/sample.c
+static void shuffle_indices_to_coeffs(poly *r, const int16_t shuffle_indices[]) {
+  int i, c0 = NTRU_N - 1 - NTRU_WEIGHT, c01 = NTRU_N - 1 - NTRU_WEIGHT / 2;
+
+  for (i = 0; i < NTRU_N - 1; i++) {
+    int t0, t1;
+    int p = shuffle_indices[i];
+
+    t0 = (p - c0) >> 31;
+    t1 = (p - c01) >> 31;
+
+    c0 += t0;
+    c01 += t1;
+
+    r->coeffs[i] = 2 + t0 + t1;
+  }
+
+  r->coeffs[NTRU_N - 1] = 0;
+}
+
+void sample_fixed_type(poly *r, const unsigned char u[NTRU_SAMPLE_FT_BYTES]) {
+  int16_t shuffle_indices[SHUFFLE_INDICES_LEN];
+
+  simd_rejsamplingmod(shuffle_indices, (const uint16_t*)u);
+  shuffle_indices_to_coeffs(r, shuffle_indices);
+}
+
+void sample_fixed_type_xN(poly *r[], const unsigned char *u[], size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    sample_fixed_type(r[i], u[i]);
+  }
+}
+
+// Number of random bytes read at a time by the streaming samplers
+#define SAMPLE_STREAM_CHUNK 64
+
+// Window over the random numbers u[] of a fixed-type sample, read with randombytes_stream_read from offset bytes into
+// the request. buf holds u[start], ..., u[end - 1]
+typedef struct {
+  randombytes_ctx_t *ctx;
+  unsigned long long offset;
+  int start, end;
+  uint16_t buf[SAMPLE_STREAM_CHUNK / 2];
+} u_stream_t;
+
+static void u_stream_init(u_stream_t *s, randombytes_ctx_t *ctx, unsigned long long offset) {
+  s->ctx = ctx;
+  s->offset = offset;
+  s->start = 0;
+  s->end = 0;
+}
+
+// Moves the window to u[j] onwards, without reading past the end of the sample. The fixups only run out of random
+// numbers with negligible probability (as in sample_fixed_type, which would read past the end of u[]); if they do, the
+// sampler aborts rather than request a length of zero or less
+static void u_stream_fill(u_stream_t *s, int j) {
+  int n = NTRU_SAMPLE_FT_BYTES / 2 - j;
+
+  if (n < 1) {
+    fprintf(stderr, "sample_fixed_type_stream: the fixups ran out of random numbers\n");
+    abort();
+  }
+
+  if (n > SAMPLE_STREAM_CHUNK / 2) {
+    n = SAMPLE_STREAM_CHUNK / 2;
+  }
+
+  randombytes_stream_read(s->ctx, (unsigned char *)s->buf, s->offset + 2 * j, 2 * n);
+  s->start = j;
+  s->end = j + n;
+}
+
+// u[j], for increasing values of j
+static inline uint16_t u_stream_get(u_stream_t *s, int j) {
+  if (j >= s->end) {
+    u_stream_fill(s, j);
+  }
+
+  return s->buf[j - s->start];
+}
+
+void sample_iid_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset) {
+  unsigned char buf[SAMPLE_STREAM_CHUNK];
+  int i, j, n;
+
+  for (i = 0; i < NTRU_N - 1; i += n) {
+    n = NTRU_N - 1 - i < SAMPLE_STREAM_CHUNK ? NTRU_N - 1 - i : SAMPLE_STREAM_CHUNK;
+
+    randombytes_stream_read(ctx, buf, offset + i, n);
+
+    // Same reduction as mod3 in sample_iid.c, on 8-bit inputs; vectorized by the compiler
+    for (j = 0; j < n; j++) {
+      uint16_t x = buf[j];
+
+      x = (x >> 4) + (x & 0xf);
+      x = (x >> 2) + (x & 0x3);
+      x = (x >> 2) + (x & 0x3);
+
+      r->coeffs[i + j] = x >= 3 ? x - 3 : x;
+    }
+  }
+
+  r->coeffs[NTRU_N - 1] = 0;
+}
+
+// Same as sample_fixed_type, with the vector part of the rejection sampling and the fixups reading from two windows
+// over u[]. The window of the vector part is aligned to SAMPLE_STREAM_CHUNK bytes, so 16 lanes never straddle two reads
+void sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset) {
+  int16_t shuffle_indices[SHUFFLE_INDICES_LEN];
+  __m256i vs = _mm256_load_si256((const __m256i *)d);
+  u_stream_t u, u_fixup;
+  uint32_t res;
+  int i, j = NTRU_N - 1, k;
+
+  u_stream_init(&u, ctx, offset);
+  u_stream_init(&u_fixup, ctx, offset);
+
+  for (i = 0; i < NTRU_N - 1; i += 16) {
+    if (i % (SAMPLE_STREAM_CHUNK / 2) == 0) {
+      u_stream_fill(&u, i);
+    }
+
+    res = simd_rejsamplingmod_lanes(i, shuffle_indices, &vs, &u.buf[i - u.start]);
+
+    while (res != 0) {
+      uint32_t m;
+      uint16_t s, t, l;
+
+      k = __builtin_ctz(res) / 2;
+
+      s = NTRU_N - 1 - (i + k);
+      t = vt[i + k];
+      do {
+        m = (uint32_t)u_stream_get(&u_fixup, j++) * s;
+        l = m;
+      }
+      while (l < t);
+      shuffle_indices[i + k] = m >> 16;
+
+      res &= res - 1;
+      res &= res - 1;
+    }
+  }
+
+  shuffle_indices_to_coeffs(r, shuffle_indices);
+}
+
+void sample_rm_stream(poly *r, poly *m, randombytes_ctx_t *ctx) {
+  sample_iid_stream(r, ctx, 0);
+  sample_fixed_type_stream(m, ctx, NTRU_SAMPLE_IID_BYTES);
+}
+
+#endif
+// clang-format on
@@ -0,0 +1,51 @@
+// clang-format off
+
+#include <immintrin.h>
+#include <string.h>
+#include "sample.h"
+
+// Coefficients per call of sample_iid_x32. The last (NTRU_N - 1) % 32 are sampled from a zero-padded copy of the
+// uniform bytes, so that no byte past uniformbytes[NTRU_N - 2] is read and no coefficient past r[NTRU_N - 2] written
+#define SAMPLE_IID_BLOCK 32
+#define SAMPLE_IID_TAIL ((NTRU_N - 1) % SAMPLE_IID_BLOCK)
+
+// Same reduction as mod3 in sample_iid.c, on 8-bit lanes: see neon_sample_iid.c. AVX2 has no 8-bit shifts, so the
+// 16-bit shifts are masked to drop the bits coming from the neighbouring byte
+static inline __m256i mod3_x32(__m256i a) {
+  const __m256i hex_0x03 = _mm256_set1_epi8(0x03), hex_0x0f = _mm256_set1_epi8(0x0f), hex_0x3f = _mm256_set1_epi8(0x3f);
+
+  a = _mm256_add_epi8(_mm256_and_si256(_mm256_srli_epi16(a, 4), hex_0x0f), _mm256_and_si256(a, hex_0x0f));
+  a = _mm256_add_epi8(_mm256_and_si256(_mm256_srli_epi16(a, 2), hex_0x3f), _mm256_and_si256(a, hex_0x03));
+  a = _mm256_add_epi8(_mm256_and_si256(_mm256_srli_epi16(a, 2), hex_0x3f), _mm256_and_si256(a, hex_0x03));
+
+  return _mm256_min_epu8(a, _mm256_sub_epi8(a, hex_0x03));
+}
+
+static inline void sample_iid_x32(uint16_t *r, const uint8_t *uniformbytes) {
+  __m256i a = mod3_x32(_mm256_loadu_si256((const __m256i *)uniformbytes));
+
+  _mm256_storeu_si256((__m256i *)r, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(a)));
+  _mm256_storeu_si256((__m256i *)(r + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1)));
+}
+
+void sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]) {
+  int i;
+
+  /* {0,1,...,255} -> {0,1,2}; Pr[0] = 86/256, Pr[1] = Pr[-1] = 85/256 */
+  for (i = 0; i + SAMPLE_IID_BLOCK <= NTRU_N - 1; i += SAMPLE_IID_BLOCK) {
+    sample_iid_x32(&r->coeffs[i], &uniformbytes[i]);
+  }
+
+#if SAMPLE_IID_TAIL != 0
+  uint8_t tail_bytes[SAMPLE_IID_BLOCK] = {0};
+  uint16_t tail_coeffs[SAMPLE_IID_BLOCK];
+
+  memcpy(tail_bytes, &uniformbytes[i], SAMPLE_IID_TAIL);
+  sample_iid_x32(tail_coeffs, tail_bytes);
+  memcpy(&r->coeffs[i], tail_coeffs, SAMPLE_IID_TAIL * sizeof(uint16_t));
+#endif
+
+  r->coeffs[NTRU_N - 1] = 0;
+}
+
+// clang-format on
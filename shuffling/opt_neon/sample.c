@@ -0,0 +1,465 @@
+// clang-format off
+
+#include <arm_acle.h>
+#include <arm_neon.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rng.h"
+#include "sample.h"
+#include "sampling_tables.h"
+
+void sample_fg(poly *f, poly *g, const unsigned char uniformbytes[NTRU_SAMPLE_FG_BYTES])
+{
+#ifdef NTRU_HRSS
+  sample_iid_plus(f,uniformbytes);
+  sample_iid_plus(g,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+
+#ifdef NTRU_HPS
+  sample_iid(f,uniformbytes);
+  sample_fixed_type(g,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+}
+
+void sample_rm(poly *r, poly *m, const unsigned char uniformbytes[NTRU_SAMPLE_RM_BYTES])
+{
+#ifdef NTRU_HRSS
+  sample_iid(r,uniformbytes);
+  sample_iid(m,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+
+#ifdef NTRU_HPS
+  sample_iid(r,uniformbytes);
+  sample_fixed_type(m,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+}
+
+#ifdef NTRU_HRSS
+void sample_iid_plus(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES])
+{
+  /* Sample r using sample_iid then conditionally flip    */
+  /* signs of even index coefficients so that <x*r, r> >= 0.      */
+
+  int i;
+  uint16_t s = 0;
+
+  sample_iid(r, uniformbytes);
+
+  /* Map {0,1,2} -> {0, 1, 2^16 - 1} */
+  for(i=0; i<NTRU_N-1; i++)
+    r->coeffs[i] = r->coeffs[i] | (-(r->coeffs[i]>>1));
+
+  /* s = <x*r, r>.  (r[n-1] = 0) */
+  for(i=0; i<NTRU_N-1; i++)
+    s += (uint16_t)((uint32_t)r->coeffs[i + 1] * (uint32_t)r->coeffs[i]);
+
+  /* Extract sign of s (sign(0) = 1) */
+  s = 1 | (-(s>>15));
+
+  for(i=0; i<NTRU_N; i+=2)
+    r->coeffs[i] = (uint16_t)((uint32_t)s * (uint32_t)r->coeffs[i]);
+
+  /* Map {0,1,2^16-1} -> {0, 1, 2} */
+  for(i=0; i<NTRU_N; i++)
+    r->coeffs[i] = 3 & (r->coeffs[i] ^ (r->coeffs[i]>>15));
+}
+#endif
+
+#ifdef NTRU_HPS
+// Maximum number of independent shuffles interleaved by sample_fixed_type_xN
+#define SAMPLE_FIXED_TYPE_MAX_WAYS 8
+
+// Branchless counter update of the isochronous sampling procedure, see the ISOCHRONOUS_SAMPLING branch of
+// shuffling/ref/sample.c
+#define UPDATE_COUNTERS(coeff, idx, cnt0, cnt01, tmp)                                 \
+  asm("subs   %w[t],  %w[c0], %w[p]         \n"                                       \
+      "cinc  %w[c0],  %w[c0],    lt         \n"                                       \
+      "add  %w[r_i], %w[two], %w[t], asr #31\n"                                       \
+      "subs   %w[t],  %w[c1], %w[p]         \n"                                       \
+      "cinc  %w[c1],  %w[c1],    lt         \n"                                       \
+      "add  %w[r_i], %w[r_i], %w[t], asr #31\n"                                       \
+      : [c0] "+&r"(cnt0), [c1] "+&r"(cnt01), [r_i] "=&r"(coeff), [t] "=&r"(tmp)        \
+      : [p] "r"(idx), [two] "r"(2)                                                    \
+      : "cc")
+
+// Vector part of the rejection sampling: computes the 16 candidate shuffle indices starting at position i from u[0], ...,
+// u[15], and returns a bitmask (4 bits per lane) of the lanes that must be resampled by rejsamplingmod_fixup
+static inline uint64_t simd_rejsamplingmod_lanes(int i, uint16x8_t vsi[], uint16x8_t *vsq, const uint16_t u[]) {
+  const uint16x8_t vsq_delta = {8, 8, 8, 8, 8, 8, 8, 8};
+  uint32x4_t vm1q, vm2q;
+  uint16x8_t vrndq, vlq, vcmpq, vcmp2q, vtq;
+  uint8x16_t vtmpq;
+  uint8x8_t vres;
+
+  vrndq = vld1q_u16(u);
+  vtq = vld1q_u16(&vt[i]);
+
+  vm1q = vmull_u16(vget_low_u16(vrndq), vget_low_u16(*vsq));
+  vm2q = vmull_high_u16(vrndq, *vsq);
+  *vsq = vsubq_u16(*vsq, vsq_delta);
+
+  vlq = vuzp1q_u16(vreinterpretq_u16_u32(vm1q), vreinterpretq_u16_u32(vm2q));
+  vsi[0] = vuzp2q_u16(vreinterpretq_u16_u32(vm1q), vreinterpretq_u16_u32(vm2q));
+
+  vsi[0] = vreinterpretq_u16_s16(vnegq_s16(vreinterpretq_s16_u16(vsi[0])));
+
+  vcmpq = vcltq_u16(vlq, vtq);
+
+  vrndq = vld1q_u16(u + 8);
+  vtq = vld1q_u16(&vt[i + 8]);
+
+  vm1q = vmull_u16(vget_low_u16(vrndq), vget_low_u16(*vsq));
+  vm2q = vmull_high_u16(vrndq, *vsq);
+  *vsq = vsubq_u16(*vsq, vsq_delta);
+
+  vlq = vuzp1q_u16(vreinterpretq_u16_u32(vm1q), vreinterpretq_u16_u32(vm2q));
+  vsi[1] = vuzp2q_u16(vreinterpretq_u16_u32(vm1q), vreinterpretq_u16_u32(vm2q));
+
+  vsi[1] = vreinterpretq_u16_s16(vnegq_s16(vreinterpretq_s16_u16(vsi[1])));
+
+  vcmp2q = vcltq_u16(vlq, vtq);
+
+  vtmpq = vuzp1q_u8(vreinterpretq_u8_u16(vcmpq), vreinterpretq_u8_u16(vcmp2q));
+  vres = vshrn_n_u16(vreinterpretq_u16_u8(vtmpq), 4);
+
+  return vget_lane_u64(vreinterpret_u64_u8(vres), 0);
+}
+
+// Scalar part of the rejection sampling: resamples the lanes flagged in res, consuming random numbers from u[*j]
+// onwards
+static inline void rejsamplingmod_fixup(int i, int *j, uint16x8_t vsi[], uint64_t res, const uint16_t u[]) {
+  int k;
+
+  if (res != 0) {
+    uint32_t m;
+    uint16_t s, t, l;
+
+    res = __rbitll(res);
+
+    do {
+      k = __builtin_clzl(res) / 4;
+
+      s = NTRU_N - 1 - (i + k);
+      t = vt[i + k];
+      do {
+        m = (uint32_t)u[(*j)++] * s;
+        l = m;
+      }
+      while (l < t);
+      vsi[k / 8][k % 8] = -(m >> 16);
+
+      res &= ~(0xFUL << (4 * (15 - k)));
+    }
+    while (res != 0);
+  }
+}
+
+static inline uint16x8_t simd_rejsamplingmod(int i, int *j, uint16x8_t vsi[], uint16x8_t vsq, const uint16_t u[]) {
+  uint64_t res = simd_rejsamplingmod_lanes(i, vsi, &vsq, &u[i]);
+
+  rejsamplingmod_fixup(i, j, vsi, res, u);
+
+  return vsq;
+}
+
+void sample_fixed_type(poly *r, const unsigned char u[NTRU_SAMPLE_FT_BYTES]) {
+  volatile int16_t shuffle_indices[16];  // Avoids slow move from SIMD to scalar register file
+  uint16x8_t vsi[2], vsq = vld1q_u16(d);
+  int i, j = NTRU_N - 1, l, t, p;
+  int n_unroll = NTRU_N - (NTRU_N % 16);
+  int c0 = -(NTRU_N - 1 - NTRU_WEIGHT), c01 = -(NTRU_N - 1 - NTRU_WEIGHT / 2);
+
+  vsq = simd_rejsamplingmod(0, &j, vsi, vsq, (const uint16_t*)u);
+
+  vst1q_s16((int16_t *)&shuffle_indices[0], vreinterpretq_s16_u16(vsi[0]));
+  vst1q_s16((int16_t *)&shuffle_indices[8], vreinterpretq_s16_u16(vsi[1]));
+
+  for (i = 0; i < n_unroll; i += 16) {
+    vsq = simd_rejsamplingmod(i + 16, &j, vsi, vsq, (const uint16_t*)u);
+
+    for (l = 0; l < 16; l++) {
+      p = shuffle_indices[l];
+
+      UPDATE_COUNTERS(r->coeffs[i + l], p, c0, c01, t);
+    }
+
+    vst1q_s16((int16_t *)&shuffle_indices[0], vreinterpretq_s16_u16(vsi[0]));
+    vst1q_s16((int16_t *)&shuffle_indices[8], vreinterpretq_s16_u16(vsi[1]));
+  }
+
+  for (; i < NTRU_N; i++) {
+    p = shuffle_indices[i - n_unroll];
+
+    UPDATE_COUNTERS(r->coeffs[i], p, c0, c01, t);
+  }
+
+  r->coeffs[NTRU_N - 1] = 0;
+}
+
+// Runs `ways` independent shuffles in lockstep. For each block of 16 coefficients, the vector part of the rejection
+// sampling is issued for every polynomial before any of the (data-dependent) scalar fixups, and the counter updates
+// for the previous block are placed between the two, so that a rejected lane in one polynomial is hidden behind the
+// work on the others. The random numbers consumed by each polynomial, and hence its output, are exactly the same as in
+// sample_fixed_type.
+static inline __attribute__((always_inline)) void sample_fixed_type_ways(poly *r[], const unsigned char *u[],
+                                                                         const int ways) {
+  volatile int16_t shuffle_indices[SAMPLE_FIXED_TYPE_MAX_WAYS][16];
+  uint16x8_t vsi[SAMPLE_FIXED_TYPE_MAX_WAYS][2], vsq[SAMPLE_FIXED_TYPE_MAX_WAYS];
+  uint64_t res[SAMPLE_FIXED_TYPE_MAX_WAYS];
+  int j[SAMPLE_FIXED_TYPE_MAX_WAYS], c0[SAMPLE_FIXED_TYPE_MAX_WAYS], c01[SAMPLE_FIXED_TYPE_MAX_WAYS];
+  int i, l, t, p, w;
+  int n_unroll = NTRU_N - (NTRU_N % 16);
+
+  for (w = 0; w < ways; w++) {
+    vsq[w] = vld1q_u16(d);
+    j[w] = NTRU_N - 1;
+    c0[w] = -(NTRU_N - 1 - NTRU_WEIGHT);
+    c01[w] = -(NTRU_N - 1 - NTRU_WEIGHT / 2);
+  }
+
+  for (w = 0; w < ways; w++) {
+    res[w] = simd_rejsamplingmod_lanes(0, vsi[w], &vsq[w], (const uint16_t *)u[w]);
+  }
+
+  for (w = 0; w < ways; w++) {
+    rejsamplingmod_fixup(0, &j[w], vsi[w], res[w], (const uint16_t *)u[w]);
+
+    vst1q_s16((int16_t *)&shuffle_indices[w][0], vreinterpretq_s16_u16(vsi[w][0]));
+    vst1q_s16((int16_t *)&shuffle_indices[w][8], vreinterpretq_s16_u16(vsi[w][1]));
+  }
+
+  for (i = 0; i < n_unroll; i += 16) {
+    for (w = 0; w < ways; w++) {
+      res[w] = simd_rejsamplingmod_lanes(i + 16, vsi[w], &vsq[w], (const uint16_t *)u[w] + i + 16);
+    }
+
+    for (w = 0; w < ways; w++) {
+      for (l = 0; l < 16; l++) {
+        p = shuffle_indices[w][l];
+
+        UPDATE_COUNTERS(r[w]->coeffs[i + l], p, c0[w], c01[w], t);
+      }
+    }
+
+    for (w = 0; w < ways; w++) {
+      rejsamplingmod_fixup(i + 16, &j[w], vsi[w], res[w], (const uint16_t *)u[w]);
+
+      vst1q_s16((int16_t *)&shuffle_indices[w][0], vreinterpretq_s16_u16(vsi[w][0]));
+      vst1q_s16((int16_t *)&shuffle_indices[w][8], vreinterpretq_s16_u16(vsi[w][1]));
+    }
+  }
+
+  for (w = 0; w < ways; w++) {
+    for (l = i; l < NTRU_N; l++) {
+      p = shuffle_indices[w][l - n_unroll];
+
+      UPDATE_COUNTERS(r[w]->coeffs[l], p, c0[w], c01[w], t);
+    }
+
+    r[w]->coeffs[NTRU_N - 1] = 0;
+  }
+}
+
+void sample_fixed_type_xN(poly *r[], const unsigned char *u[], size_t n) {
+  size_t i = 0;
+
+  for (; n - i >= 8; i += 8) {
+    sample_fixed_type_ways(&r[i], &u[i], 8);
+  }
+
+  if (n - i >= 4) {
+    sample_fixed_type_ways(&r[i], &u[i], 4);
+    i += 4;
+  }
+
+  if (n - i >= 2) {
+    sample_fixed_type_ways(&r[i], &u[i], 2);
+    i += 2;
+  }
+
+  if (n - i == 1) {
+    sample_fixed_type(r[i], u[i]);
+  }
+}
+
+// Number of random bytes read at a time by the streaming samplers
+#define SAMPLE_STREAM_CHUNK 64
+
+// Window over the random numbers u[] of a fixed-type sample, read with randombytes_stream_read from offset bytes into
+// the request. buf holds u[start], ..., u[end - 1]
+typedef struct {
+  randombytes_ctx_t *ctx;
+  unsigned long long offset;
+  int start, end;
+  uint16_t buf[SAMPLE_STREAM_CHUNK / 2];
+} u_stream_t;
+
+static void u_stream_init(u_stream_t *s, randombytes_ctx_t *ctx, unsigned long long offset) {
+  s->ctx = ctx;
+  s->offset = offset;
+  s->start = 0;
+  s->end = 0;
+}
+
+// Moves the window to u[j] onwards, without reading past the end of the sample. The fixups only run out of random
+// numbers with negligible probability (as in sample_fixed_type, which would read past the end of u[]); if they do, the
+// sampler aborts rather than request a length of zero or less
+static void u_stream_fill(u_stream_t *s, int j) {
+  int n = NTRU_SAMPLE_FT_BYTES / 2 - j;
+
+  if (n < 1) {
+    fprintf(stderr, "sample_fixed_type_stream: the fixups ran out of random numbers\n");
+    abort();
+  }
+
+  if (n > SAMPLE_STREAM_CHUNK / 2) {
+    n = SAMPLE_STREAM_CHUNK / 2;
+  }
+
+  randombytes_stream_read(s->ctx, (unsigned char *)s->buf, s->offset + 2 * j, 2 * n);
+  s->start = j;
+  s->end = j + n;
+}
+
+// u[j], for increasing values of j
+static inline uint16_t u_stream_get(u_stream_t *s, int j) {
+  if (j >= s->end) {
+    u_stream_fill(s, j);
+  }
+
+  return s->buf[j - s->start];
+}
+
+// Same as rejsamplingmod_fixup, reading the random numbers from a window over u[]
+static inline void rejsamplingmod_fixup_stream(int i, int *j, uint16x8_t vsi[], uint64_t res, u_stream_t *u) {
+  int k;
+
+  if (res != 0) {
+    uint32_t m;
+    uint16_t s, t, l;
+
+    res = __rbitll(res);
+
+    do {
+      k = __builtin_clzl(res) / 4;
+
+      s = NTRU_N - 1 - (i + k);
+      t = vt[i + k];
+      do {
+        m = (uint32_t)u_stream_get(u, (*j)++) * s;
+        l = m;
+      }
+      while (l < t);
+      vsi[k / 8][k % 8] = -(m >> 16);
+
+      res &= ~(0xFUL << (4 * (15 - k)));
+    }
+    while (res != 0);
+  }
+}
+
+// Vector part of the rejection sampling at position i, reading u[i], ..., u[i + 15] from a window over u[] that is
+// aligned to SAMPLE_STREAM_CHUNK bytes, so that the 16 lanes never straddle two reads
+static inline uint64_t simd_rejsamplingmod_lanes_stream(int i, uint16x8_t vsi[], uint16x8_t *vsq, u_stream_t *u) {
+  if (i % (SAMPLE_STREAM_CHUNK / 2) == 0) {
+    u_stream_fill(u, i);
+  }
+
+  return simd_rejsamplingmod_lanes(i, vsi, vsq, &u->buf[i - u->start]);
+}
+
+// Reduces 16 bytes mod 3 with the same steps as mod3 in sample_iid.c, starting from the 4-bit fold since the inputs fit
+// in 8 bits
+static inline uint8x16_t mod3_x16(uint8x16_t a) {
+  const uint8x16_t hex_0x03 = vdupq_n_u8(0x03), hex_0x0f = vdupq_n_u8(0x0f);
+  uint8x16_t r;
+
+  r = vaddq_u8(vshrq_n_u8(a, 4), vandq_u8(a, hex_0x0f));
+  r = vaddq_u8(vshrq_n_u8(r, 2), vandq_u8(r, hex_0x03));
+  r = vaddq_u8(vshrq_n_u8(r, 2), vandq_u8(r, hex_0x03));
+
+  // r - 3 wraps around when r < 3
+  return vminq_u8(r, vsubq_u8(r, hex_0x03));
+}
+
+void sample_iid_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset) {
+  uint8_t buf[SAMPLE_STREAM_CHUNK] = {0};
+  uint16_t last[SAMPLE_STREAM_CHUNK];
+  uint16_t *out;
+  int i, k, n;
+
+  for (i = 0; i < NTRU_N - 1; i += n) {
+    n = NTRU_N - 1 - i < SAMPLE_STREAM_CHUNK ? NTRU_N - 1 - i : SAMPLE_STREAM_CHUNK;
+
+    randombytes_stream_read(ctx, buf, offset + i, n);
+
+    // The last, partial chunk goes through a local array, to leave r->coeffs[NTRU_N - 1] onwards untouched
+    out = n == SAMPLE_STREAM_CHUNK ? &r->coeffs[i] : last;
+
+    for (k = 0; k < SAMPLE_STREAM_CHUNK; k += 16) {
+      uint8x16_t x = mod3_x16(vld1q_u8(&buf[k]));
+
+      vst1q_u16(&out[k], vmovl_u8(vget_low_u8(x)));
+      vst1q_u16(&out[k + 8], vmovl_high_u8(x));
+    }
+
+    if (out == last) {
+      memcpy(&r->coeffs[i], last, n * sizeof(uint16_t));
+    }
+  }
+
+  r->coeffs[NTRU_N - 1] = 0;
+}
+
+// Same as sample_fixed_type, with the vector part of the rejection sampling and the fixups reading from two windows
+// over u[]
+void sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset) {
+  volatile int16_t shuffle_indices[16];  // Avoids slow move from SIMD to scalar register file
+  uint16x8_t vsi[2], vsq = vld1q_u16(d);
+  u_stream_t u, u_fixup;
+  uint64_t res;
+  int i, j = NTRU_N - 1, l, t, p;
+  int n_unroll = NTRU_N - (NTRU_N % 16);
+  int c0 = -(NTRU_N - 1 - NTRU_WEIGHT), c01 = -(NTRU_N - 1 - NTRU_WEIGHT / 2);
+
+  u_stream_init(&u, ctx, offset);
+  u_stream_init(&u_fixup, ctx, offset);
+
+  res = simd_rejsamplingmod_lanes_stream(0, vsi, &vsq, &u);
+  rejsamplingmod_fixup_stream(0, &j, vsi, res, &u_fixup);
+
+  vst1q_s16((int16_t *)&shuffle_indices[0], vreinterpretq_s16_u16(vsi[0]));
+  vst1q_s16((int16_t *)&shuffle_indices[8], vreinterpretq_s16_u16(vsi[1]));
+
+  for (i = 0; i < n_unroll; i += 16) {
+    res = simd_rejsamplingmod_lanes_stream(i + 16, vsi, &vsq, &u);
+
+    for (l = 0; l < 16; l++) {
+      p = shuffle_indices[l];
+
+      UPDATE_COUNTERS(r->coeffs[i + l], p, c0, c01, t);
+    }
+
+    rejsamplingmod_fixup_stream(i + 16, &j, vsi, res, &u_fixup);
+
+    vst1q_s16((int16_t *)&shuffle_indices[0], vreinterpretq_s16_u16(vsi[0]));
+    vst1q_s16((int16_t *)&shuffle_indices[8], vreinterpretq_s16_u16(vsi[1]));
+  }
+
+  for (; i < NTRU_N; i++) {
+    p = shuffle_indices[i - n_unroll];
+
+    UPDATE_COUNTERS(r->coeffs[i], p, c0, c01, t);
+  }
+
+  r->coeffs[NTRU_N - 1] = 0;
+}
+
+void sample_rm_stream(poly *r, poly *m, randombytes_ctx_t *ctx) {
+  sample_iid_stream(r, ctx, 0);
+  sample_fixed_type_stream(m, ctx, NTRU_SAMPLE_IID_BYTES);
+}
+
+#endif
+// clang-format on
@@ -0,0 +1,281 @@
+// clang-format off
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+#include "sample.h"
+
+#define ISOCHRONOUS_SAMPLING
+
+void sample_fg(poly *f, poly *g, const unsigned char uniformbytes[NTRU_SAMPLE_FG_BYTES])
+{
+#ifdef NTRU_HRSS
+  sample_iid_plus(f,uniformbytes);
+  sample_iid_plus(g,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+
+#ifdef NTRU_HPS
+  sample_iid(f,uniformbytes);
+  sample_fixed_type(g,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+}
+
+void sample_rm(poly *r, poly *m, const unsigned char uniformbytes[NTRU_SAMPLE_RM_BYTES])
+{
+#ifdef NTRU_HRSS
+  sample_iid(r,uniformbytes);
+  sample_iid(m,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+
+#ifdef NTRU_HPS
+  sample_iid(r,uniformbytes);
+  sample_fixed_type(m,uniformbytes+NTRU_SAMPLE_IID_BYTES);
+#endif
+}
+
+#ifdef NTRU_HRSS
+void sample_iid_plus(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES])
+{
+  /* Sample r using sample_iid then conditionally flip    */
+  /* signs of even index coefficients so that <x*r, r> >= 0.      */
+
+  int i;
+  uint16_t s = 0;
+
+  sample_iid(r, uniformbytes);
+
+  /* Map {0,1,2} -> {0, 1, 2^16 - 1} */
+  for(i=0; i<NTRU_N-1; i++)
+    r->coeffs[i] = r->coeffs[i] | (-(r->coeffs[i]>>1));
+
+  /* s = <x*r, r>.  (r[n-1] = 0) */
+  for(i=0; i<NTRU_N-1; i++)
+    s += (uint16_t)((uint32_t)r->coeffs[i + 1] * (uint32_t)r->coeffs[i]);
+
+  /* Extract sign of s (sign(0) = 1) */
+  s = 1 | (-(s>>15));
+
+  for(i=0; i<NTRU_N; i+=2)
+    r->coeffs[i] = (uint16_t)((uint32_t)s * (uint32_t)r->coeffs[i]);
+
+  /* Map {0,1,2^16-1} -> {0, 1, 2} */
+  for(i=0; i<NTRU_N; i++)
+    r->coeffs[i] = 3 & (r->coeffs[i] ^ (r->coeffs[i]>>15));
+}
+#endif
+
+#ifdef NTRU_HPS
+// Unlike Algorithm 5 in the paper, we use the batch random number generation idea, discussed in Section 4. Moreover,
+// although not required in non-SIMD versions, we use disjoint ranges in the random number array for the initial
+// sampling and the rejection sampling fixup procedure, as discussed in "SIMD implementation of Algorithm 5" in
+// Section 4, to ensure interoperability of KATs between the scalar and SIMD versions.
+void rejsamplingmod(int16_t shuffle_indices[], const uint16_t u[NTRU_SAMPLE_FT_BYTES / 2]) {
+  int i, j = NTRU_N - 1;
+
+  for (i = 0; i < NTRU_N - 1; i++)
+  {
+    uint32_t m;
+    uint16_t s, t, l;
+
+    s = NTRU_N - 1 - i;
+    t = 65536 % s;
+
+    m = (uint32_t)u[i] * s;
+    l = m;
+
+    while (l < t)
+    {
+      m = (uint32_t)u[j++] * s;
+      l = m;
+    }
+
+    shuffle_indices[i] = m >> 16;
+  }
+}
+
+// Turns the shuffle indices into the coefficients of r, except for r->coeffs[NTRU_N - 1]
+static void shuffle_indices_to_coeffs(poly *r, const int16_t shuffle_indices[]) {
+#ifdef ISOCHRONOUS_SAMPLING
+  int c0 = NTRU_N - 1 - NTRU_WEIGHT, c01 = NTRU_N - 1 - NTRU_WEIGHT / 2;
+
+  for (int i = 0; i < NTRU_N - 1; i++)
+  {
+    int t0, t1;
+    int p = shuffle_indices[i];
+
+    t0 = (p - c0) >> 31;
+    t1 = (p - c01) >> 31;
+
+    c0 += t0;
+    c01 += t1;
+
+    r->coeffs[i] = 2 + t0 + t1;
+  }
+#else
+  int c0 = NTRU_N - 1 - NTRU_WEIGHT, c1 = NTRU_WEIGHT / 2;
+
+  for (int i = 0; i < NTRU_N - 1; i++)
+  {
+    int16_t p = shuffle_indices[i];
+    if (p < c0)
+    {
+      r->coeffs[i] = 0;
+      c0--;
+    }
+    else if (p < c0 + c1)
+    {
+      r->coeffs[i] = 1;
+      c1--;
+    }
+    else
+    {
+      r->coeffs[i] = 2;
+    }
+  }
+#endif
+}
+
+void sample_fixed_type(poly *r, const unsigned char u[NTRU_SAMPLE_FT_BYTES]) {
+  int16_t shuffle_indices[NTRU_N - 1];
+
+  rejsamplingmod(shuffle_indices, (const uint16_t*)u);
+  shuffle_indices_to_coeffs(r, shuffle_indices);
+
+  r->coeffs[NTRU_N-1] = 0;
+}
+
+void sample_fixed_type_xN(poly *r[], const unsigned char *u[], size_t n) {
+  for (size_t i = 0; i < n; i++)
+  {
+    sample_fixed_type(r[i], u[i]);
+  }
+}
+
+// Number of random bytes read at a time by the streaming samplers
+#define SAMPLE_STREAM_CHUNK 64
+
+// Window over the random numbers u[] of a fixed-type sample, read with randombytes_stream_read from offset bytes into
+// the request. buf holds u[start], ..., u[end - 1]
+typedef struct {
+  randombytes_ctx_t *ctx;
+  unsigned long long offset;
+  int start, end;
+  uint16_t buf[SAMPLE_STREAM_CHUNK / 2];
+} u_stream_t;
+
+static void u_stream_init(u_stream_t *s, randombytes_ctx_t *ctx, unsigned long long offset)
+{
+  s->ctx = ctx;
+  s->offset = offset;
+  s->start = 0;
+  s->end = 0;
+}
+
+// Moves the window to u[j] onwards, without reading past the end of the sample. The fixups only run out of random
+// numbers with negligible probability (as in sample_fixed_type, which would read past the end of u[]); if they do, the
+// sampler aborts rather than request a length of zero or less
+static void u_stream_fill(u_stream_t *s, int j)
+{
+  int n = NTRU_SAMPLE_FT_BYTES / 2 - j;
+
+  if (n < 1)
+  {
+    fprintf(stderr, "sample_fixed_type_stream: the fixups ran out of random numbers\n");
+    abort();
+  }
+
+  if (n > SAMPLE_STREAM_CHUNK / 2)
+    n = SAMPLE_STREAM_CHUNK / 2;
+
+  randombytes_stream_read(s->ctx, (unsigned char *)s->buf, s->offset + 2 * j, 2 * n);
+  s->start = j;
+  s->end = j + n;
+}
+
+// u[j], for increasing values of j
+static uint16_t u_stream_get(u_stream_t *s, int j)
+{
+  if (j >= s->end)
+    u_stream_fill(s, j);
+
+  return s->buf[j - s->start];
+}
+
+// Same as mod3 in sample_iid.c
+static uint16_t stream_mod3(uint16_t a)
+{
+  uint16_t r;
+  int16_t t, c;
+
+  r = (a >> 8) + (a & 0xff); // r mod 255 == a mod 255
+  r = (r >> 4) + (r & 0xf); // r' mod 15 == r mod 15
+  r = (r >> 2) + (r & 0x3); // r' mod 3 == r mod 3
+  r = (r >> 2) + (r & 0x3); // r' mod 3 == r mod 3
+
+  t = r - 3;
+  c = t >> 15;
+
+  return (c&r) ^ (~c&t);
+}
+
+void sample_iid_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset)
+{
+  unsigned char buf[SAMPLE_STREAM_CHUNK];
+  int i, j, n;
+
+  for (i = 0; i < NTRU_N - 1; i += n)
+  {
+    n = NTRU_N - 1 - i;
+    if (n > SAMPLE_STREAM_CHUNK)
+      n = SAMPLE_STREAM_CHUNK;
+
+    randombytes_stream_read(ctx, buf, offset + i, n);
+
+    for (j = 0; j < n; j++)
+      r->coeffs[i + j] = stream_mod3(buf[j]);
+  }
+
+  r->coeffs[NTRU_N-1] = 0;
+}
+
+// Same as rejsamplingmod, with the initial sampling and the fixups reading from two windows over u[]
+void sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset) {
+  int16_t shuffle_indices[NTRU_N - 1];
+  u_stream_t u, u_fixup;
+  int i, j = NTRU_N - 1;
+
+  u_stream_init(&u, ctx, offset);
+  u_stream_init(&u_fixup, ctx, offset);
+
+  for (i = 0; i < NTRU_N - 1; i++)
+  {
+    uint32_t m;
+    uint16_t s, t, l;
+
+    s = NTRU_N - 1 - i;
+    t = 65536 % s;
+
+    m = (uint32_t)u_stream_get(&u, i) * s;
+    l = m;
+
+    while (l < t)
+    {
+      m = (uint32_t)u_stream_get(&u_fixup, j++) * s;
+      l = m;
+    }
+
+    shuffle_indices[i] = m >> 16;
+  }
+
+  shuffle_indices_to_coeffs(r, shuffle_indices);
+
+  r->coeffs[NTRU_N-1] = 0;
+}
+
+void sample_rm_stream(poly *r, poly *m, randombytes_ctx_t *ctx)
+{
+  sample_iid_stream(r, ctx, 0);
+  sample_fixed_type_stream(m, ctx, NTRU_SAMPLE_IID_BYTES);
+}
+#endif
+// clang-format on
@@ -0,0 +1,252 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+size_t bench_warmup = 1, bench_iterations;
+uint64_t *bench_samples;
+
+// Median of the differences between two consecutive readings of the time
+static uint64_t timer_overhead;
+
+static FILE *json_file, *csv_file;
+static int json_first = 1;
+
+static const char *name_current;
+
+#ifndef __APPLE__
+static uint64_t counters0[HAL_MAX_COUNTERS], counters1[HAL_MAX_COUNTERS];
+#endif
+
+static int cmp_uint64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--warmup <calls>] [--iterations <calls>] [--json <file>] [--csv <file>]\n", argv0);
+    exit(1);
+}
+
+static size_t parse_count(const char *argv0, const char *arg, size_t min) {
+    char *end;
+    unsigned long long count = strtoull(arg, &end, 10);
+
+    if (*arg == '\0' || *end != '\0' || count < min) {
+        usage(argv0);
+    }
+
+    return (size_t)count;
+}
+
+static FILE *open_output(const char *path) {
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL) {
+        perror(path);
+        exit(1);
+    }
+
+    return f;
+}
+
+// Names are printed as JSON strings and CSV fields, which only need quotes and backslashes escaped
+static void print_escaped(FILE *f, const char *s, char quote_escape) {
+    fputc('"', f);
+
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc(*s == '"' ? quote_escape : '\\', f);
+        }
+
+        fputc(*s, f);
+    }
+
+    fputc('"', f);
+}
+
+static const char *backend_name(void) {
+#ifdef __APPLE__
+    return "kperf";
+#else
+    return hal_backend();
+#endif
+}
+
+static void bench_finish(void) {
+    if (json_file != NULL) {
+        fprintf(json_file, "\n  ]\n}\n");
+        fclose(json_file);
+    }
+
+    if (csv_file != NULL) {
+        fclose(csv_file);
+    }
+
+    free(bench_samples);
+}
+
+void bench_init(int argc, char **argv, size_t iterations) {
+    bench_iterations = iterations;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 == argc) {
+            usage(argv[0]);
+        } else if (strcmp(argv[i], "--warmup") == 0) {
+            bench_warmup = parse_count(argv[0], argv[++i], 0);
+        } else if (strcmp(argv[i], "--iterations") == 0) {
+            bench_iterations = parse_count(argv[0], argv[++i], 1);
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json_file = open_output(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv_file = open_output(argv[++i]);
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    bench_samples = malloc(bench_iterations * sizeof(uint64_t));
+
+    if (bench_samples == NULL) {
+        perror("bench_init");
+        exit(1);
+    }
+
+#ifdef __APPLE__
+    setup_rdtsc();
+#endif
+
+    for (size_t i = 0; i < bench_iterations; i++) {
+        uint64_t t0 = BENCH_TIME();
+        bench_samples[i] = BENCH_TIME() - t0;
+    }
+
+    qsort(bench_samples, bench_iterations, sizeof(uint64_t), cmp_uint64);
+    timer_overhead = bench_samples[(bench_iterations - 1) / 2];
+
+    if (json_file != NULL) {
+        fprintf(json_file, "{\n  \"backend\": \"%s\",\n  \"timer_overhead\": %llu,\n", backend_name(),
+                (unsigned long long)timer_overhead);
+        fprintf(json_file, "  \"warmup\": %zu,\n  \"iterations\": %zu,\n  \"results\": [", bench_warmup,
+                bench_iterations);
+    }
+
+    if (csv_file != NULL) {
+        fprintf(csv_file, "name,iterations,mean,stddev,min,median,p90,p99,max");
+#ifndef __APPLE__
+        for (size_t c = 0; c < hal_num_counters(); c++) {
+            fprintf(csv_file, ",%s", hal_counter_name(c));
+        }
+#endif
+        fprintf(csv_file, "\n");
+    }
+
+    atexit(bench_finish);
+}
+
+void bench_begin(const char *name) {
+    name_current = name;
+#ifndef __APPLE__
+    hal_get_counters(counters0);
+#endif
+}
+
+// Nearest-rank percentile of the sorted samples
+static uint64_t percentile(unsigned p) {
+    size_t rank = (p * bench_iterations + 99) / 100;
+    return bench_samples[rank > 0 ? rank - 1 : 0];
+}
+
+void bench_end(void) {
+    size_t n = bench_iterations;
+    double mean = 0, variance = 0;
+
+#ifndef __APPLE__
+    hal_get_counters(counters1);
+#endif
+
+    for (size_t i = 0; i < n; i++) {
+        bench_samples[i] = bench_samples[i] > timer_overhead ? bench_samples[i] - timer_overhead : 0;
+        mean += (double)bench_samples[i];
+    }
+
+    mean /= (double)n;
+
+    for (size_t i = 0; i < n; i++) {
+        variance += ((double)bench_samples[i] - mean) * ((double)bench_samples[i] - mean);
+    }
+
+    variance = n > 1 ? variance / (double)(n - 1) : 0;
+
+    qsort(bench_samples, n, sizeof(uint64_t), cmp_uint64);
+
+    printf("%s: %lld\n", name_current, (long long)(mean + 0.5));
+
+#ifndef __APPLE__
+    for (size_t c = 0; c < hal_num_counters(); c++) {
+        printf("    %s: %lld\n", hal_counter_name(c), (long long)((counters1[c] - counters0[c]) / n));
+    }
+#endif
+
+    if (json_file != NULL) {
+        fprintf(json_file, "%s\n    {\"name\": ", json_first ? "" : ",");
+        print_escaped(json_file, name_current, '\\');
+        fprintf(json_file, ", \"iterations\": %zu, \"mean\": %.1f, \"stddev\": %.1f", n, mean, sqrt(variance));
+        fprintf(json_file, ", \"min\": %llu, \"median\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu",
+                (unsigned long long)bench_samples[0], (unsigned long long)percentile(50),
+                (unsigned long long)percentile(90), (unsigned long long)percentile(99),
+                (unsigned long long)bench_samples[n - 1]);
+#ifndef __APPLE__
+        if (hal_num_counters() > 0) {
+            fprintf(json_file, ", \"counters\": {");
+            for (size_t c = 0; c < hal_num_counters(); c++) {
+                fprintf(json_file, "%s\"%s\": %llu", c == 0 ? "" : ", ", hal_counter_name(c),
+                        (unsigned long long)((counters1[c] - counters0[c]) / n));
+            }
+            fprintf(json_file, "}");
+        }
+#endif
+        fprintf(json_file, "}");
+        json_first = 0;
+    }
+
+    if (csv_file != NULL) {
+        print_escaped(csv_file, name_current, '"');
+        fprintf(csv_file, ",%zu,%.1f,%.1f,%llu,%llu,%llu,%llu,%llu", n, mean, sqrt(variance),
+                (unsigned long long)bench_samples[0], (unsigned long long)percentile(50),
+                (unsigned long long)percentile(90), (unsigned long long)percentile(99),
+                (unsigned long long)bench_samples[n - 1]);
+#ifndef __APPLE__
+        for (size_t c = 0; c < hal_num_counters(); c++) {
+            fprintf(csv_file, ",%llu", (unsigned long long)((counters1[c] - counters0[c]) / n));
+        }
+#endif
+        fprintf(csv_file, "\n");
+    }
+
+    fflush(stdout);
+}
+
+void bench_report(const char *name, uint64_t value) {
+    printf("%s: %lld\n", name, (long long)value);
+
+    if (json_file != NULL) {
+        fprintf(json_file, "%s\n    {\"name\": ", json_first ? "" : ",");
+        print_escaped(json_file, name, '\\');
+        fprintf(json_file, ", \"mean\": %llu}", (unsigned long long)value);
+        json_first = 0;
+    }
+
+    if (csv_file != NULL) {
+        print_escaped(csv_file, name, '"');
+        fprintf(csv_file, ",,%llu,,,,,,", (unsigned long long)value);
+#ifndef __APPLE__
+        for (size_t c = 0; c < hal_num_counters(); c++) {
+            fprintf(csv_file, ",");
+        }
+#endif
+        fprintf(csv_file, "\n");
+    }
+}
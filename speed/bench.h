@@ -0,0 +1,48 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __APPLE__
+#include "m1cycles.h"
+#define BENCH_TIME() rdtsc()
+#else
+#include "hal.h"
+#define BENCH_TIME() hal_get_time()
+#endif
+
+// Benchmarks of the speed_* binaries: every call of func is timed, and bench_end prints the mean as
+// "<name>: <cycles>" on stdout, as the binaries always did, and writes the mean, standard deviation, minimum,
+// median, 90th and 99th percentiles and maximum to the JSON and CSV files given on the command line:
+//
+//   speed_<...> [--warmup <calls>] [--iterations <calls>] [--json <file>] [--csv <file>]
+//
+// The cost of reading the time, measured by bench_init, is subtracted from every sample
+#define BENCH(name, func)                                                    \
+    {                                                                        \
+        for (size_t bench_i = 0; bench_i < bench_warmup; bench_i++) {        \
+            func;                                                            \
+        }                                                                    \
+        bench_begin(name);                                                   \
+        for (size_t bench_i = 0; bench_i < bench_iterations; bench_i++) {    \
+            uint64_t bench_t0 = BENCH_TIME();                                \
+            func;                                                            \
+            bench_samples[bench_i] = BENCH_TIME() - bench_t0;                \
+        }                                                                    \
+        bench_end();                                                         \
+    }
+
+// Untimed calls before each benchmark (1 by default) and timed calls (the iterations given to bench_init by default)
+extern size_t bench_warmup, bench_iterations;
+extern uint64_t *bench_samples;
+
+// Parses the command line, exits with a usage message if it is not valid
+void bench_init(int argc, char **argv, size_t iterations);
+void bench_begin(const char *name);
+void bench_end(void);
+// A value that is not timed by BENCH, such as the cycles accumulated by the timing hooks of the SHA3 code, reported
+// as the mean of a benchmark without samples
+void bench_report(const char *name, uint64_t value);
+
+#endif
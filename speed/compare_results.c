@@ -0,0 +1,406 @@
+#include <dirent.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Compares two speed_results_* folders, as written by run_benchmarks.sh:
+//
+//   compare_results [--threshold <percent>] [--ignore-compiler] <baseline> <current>
+//
+// Files are matched by name, i.e. by benchmark, parameter set, implementation, variant, sampling, compiler and DIT
+// setting (with --ignore-compiler, by all but the compiler, to compare two compilers), and operations by name within
+// them. The CSV files of the harness in bench.h are read when present, and the text files otherwise. The difference of
+// the means is given with its 95% confidence interval when both sides have a standard deviation, and an operation
+// regresses when it is slower by more than the threshold (2% by default) and, if there is an interval, when the
+// interval is above 0. The exit status is 1 if any operation regresses, 2 on errors and 0 otherwise
+
+#define DEFAULT_THRESHOLD 2.0
+// Two-sided 95% quantile of the normal distribution; the binaries time 1024 calls by default
+#define Z_95 1.96
+
+#define MAX_LINE 1024
+
+struct result {
+    char *name;
+    double mean, stddev;
+    // 0 when only the mean is known: text files, and values that are not timed by BENCH
+    size_t n;
+};
+
+struct entry {
+    // File name without extension, and without the compiler with --ignore-compiler
+    char *key;
+    char *path;
+    int is_csv;
+    struct result *results;
+    size_t num_results;
+};
+
+struct tree {
+    struct entry *entries;
+    size_t num_entries;
+};
+
+static int ignore_compiler;
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--threshold <percent>] [--ignore-compiler] <baseline> <current>\n", argv0);
+    exit(2);
+}
+
+static void *xrealloc(void *p, size_t size) {
+    p = realloc(p, size);
+
+    if (p == NULL) {
+        perror("compare_results");
+        exit(2);
+    }
+
+    return p;
+}
+
+static char *xstrdup(const char *s) {
+    return strcpy(xrealloc(NULL, strlen(s) + 1), s);
+}
+
+static void add_result(struct entry *e, const char *name, double mean, double stddev, size_t n) {
+    e->results = xrealloc(e->results, (e->num_results + 1) * sizeof(struct result));
+    e->results[e->num_results].name = xstrdup(name);
+    e->results[e->num_results].mean = mean;
+    e->results[e->num_results].stddev = stddev;
+    e->results[e->num_results].n = n;
+    e->num_results++;
+}
+
+// The whole string is a number
+static int parse_number(const char *s, double *value) {
+    char *end;
+
+    *value = strtod(s, &end);
+
+    return end != s && *end == '\0';
+}
+
+static void strip_newline(char *line) {
+    line[strcspn(line, "\r\n")] = '\0';
+}
+
+// Lines of the form "<name>: <value>". The extra counters (indented) and lines without a number, such as the engine
+// selected by the dispatch libraries, are skipped
+static void read_txt(struct entry *e, FILE *f) {
+    char line[MAX_LINE], *colon;
+    double mean;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        strip_newline(line);
+
+        if (line[0] == ' ' || (colon = strrchr(line, ':')) == NULL || colon[1] != ' ') {
+            continue;
+        }
+
+        *colon = '\0';
+
+        if (parse_number(colon + 2, &mean)) {
+            add_result(e, line, mean, 0, 0);
+        }
+    }
+}
+
+// Splits a CSV line in place; quoted fields may contain commas and doubled quotes
+static size_t split_csv(char *line, char **fields, size_t max_fields) {
+    size_t num_fields = 0;
+    char *in = line, *out = line;
+
+    while (num_fields < max_fields) {
+        fields[num_fields++] = out;
+
+        if (*in == '"') {
+            for (in++; *in != '\0' && !(in[0] == '"' && in[1] != '"'); in++) {
+                *out++ = *in;
+                in += in[0] == '"';
+            }
+            in += *in == '"';
+        }
+
+        while (*in != '\0' && *in != ',') {
+            *out++ = *in++;
+        }
+
+        // out never passes in, so the terminator may overwrite the comma
+        if (*in == '\0') {
+            *out = '\0';
+            break;
+        }
+
+        in++;
+        *out++ = '\0';
+    }
+
+    return num_fields;
+}
+
+#define MAX_FIELDS 32
+
+// The columns of bench.c, after those that run_benchmarks.sh prepends to the polymul table, which become part of the
+// name
+static void read_csv(struct entry *e, FILE *f) {
+    char line[MAX_LINE], name[MAX_LINE], *fields[MAX_FIELDS];
+    size_t num_fields, col_name = MAX_FIELDS, col_iterations = MAX_FIELDS, col_mean = MAX_FIELDS,
+                       col_stddev = MAX_FIELDS;
+
+    if (fgets(line, sizeof(line), f) == NULL) {
+        return;
+    }
+
+    strip_newline(line);
+    num_fields = split_csv(line, fields, MAX_FIELDS);
+
+    for (size_t i = 0; i < num_fields; i++) {
+        if (strcmp(fields[i], "name") == 0) {
+            col_name = i;
+        } else if (strcmp(fields[i], "iterations") == 0) {
+            col_iterations = i;
+        } else if (strcmp(fields[i], "mean") == 0) {
+            col_mean = i;
+        } else if (strcmp(fields[i], "stddev") == 0) {
+            col_stddev = i;
+        }
+    }
+
+    if (col_name == MAX_FIELDS || col_iterations == MAX_FIELDS || col_mean == MAX_FIELDS || col_stddev == MAX_FIELDS) {
+        fprintf(stderr, "%s: not a CSV file of the speed binaries\n", e->path);
+        exit(2);
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        double mean, stddev, iterations;
+
+        strip_newline(line);
+        num_fields = split_csv(line, fields, MAX_FIELDS);
+
+        if (num_fields <= col_name || num_fields <= col_iterations || num_fields <= col_mean ||
+            num_fields <= col_stddev || !parse_number(fields[col_mean], &mean)) {
+            continue;
+        }
+
+        name[0] = '\0';
+        for (size_t i = 0; i < col_name; i++) {
+            strcat(strcat(name, fields[i]), ":");
+        }
+        strcat(name, fields[col_name]);
+
+        if (parse_number(fields[col_iterations], &iterations) && parse_number(fields[col_stddev], &stddev)) {
+            add_result(e, name, mean, stddev, (size_t)iterations);
+        } else {
+            add_result(e, name, mean, 0, 0);
+        }
+    }
+}
+
+// Removes the compiler, the second to last field of "<benchmark>:...:<compiler>:DIT_<ON|OFF>"
+static void remove_compiler(char *key) {
+    char *dit = strrchr(key, ':'), *compiler;
+
+    if (dit == NULL) {
+        return;
+    }
+
+    *dit = '\0';
+    compiler = strrchr(key, ':');
+    *dit = ':';
+
+    if (compiler != NULL) {
+        memmove(compiler, dit, strlen(dit) + 1);
+    }
+}
+
+static int cmp_entry(const void *a, const void *b) {
+    return strcmp(((const struct entry *)a)->key, ((const struct entry *)b)->key);
+}
+
+static struct entry *find_entry(const struct tree *t, const char *key) {
+    struct entry e = {.key = (char *)key};
+
+    return bsearch(&e, t->entries, t->num_entries, sizeof(struct entry), cmp_entry);
+}
+
+// The JSON files have the same statistics as the CSV files, so only the latter are read, in place of the text files
+// of the same name
+static void read_tree(struct tree *t, const char *dir_path) {
+    DIR *dir = opendir(dir_path);
+    struct dirent *d;
+
+    if (dir == NULL) {
+        perror(dir_path);
+        exit(2);
+    }
+
+    while ((d = readdir(dir)) != NULL) {
+        const char *ext = strrchr(d->d_name, '.');
+        char *key;
+        int is_csv;
+        size_t i;
+
+        if (ext == NULL || (strcmp(ext, ".txt") != 0 && strcmp(ext, ".csv") != 0)) {
+            continue;
+        }
+
+        is_csv = strcmp(ext, ".csv") == 0;
+        key = xstrdup(d->d_name);
+        key[ext - d->d_name] = '\0';
+
+        if (ignore_compiler) {
+            remove_compiler(key);
+        }
+
+        for (i = 0; i < t->num_entries && strcmp(t->entries[i].key, key) != 0; i++) {
+        }
+
+        if (i == t->num_entries) {
+            t->entries = xrealloc(t->entries, (t->num_entries + 1) * sizeof(struct entry));
+            memset(&t->entries[i], 0, sizeof(struct entry));
+            t->entries[i].key = key;
+            t->num_entries++;
+        } else if (t->entries[i].is_csv == is_csv) {
+            fprintf(stderr, "%s: several results for %s, e.g. from several compilers\n", dir_path, key);
+            exit(2);
+        } else {
+            free(key);
+
+            if (!is_csv) {
+                continue;
+            }
+
+            free(t->entries[i].path);
+        }
+
+        t->entries[i].path = xrealloc(NULL, strlen(dir_path) + strlen(d->d_name) + 2);
+        sprintf(t->entries[i].path, "%s/%s", dir_path, d->d_name);
+        t->entries[i].is_csv = is_csv;
+    }
+
+    closedir(dir);
+
+    for (size_t i = 0; i < t->num_entries; i++) {
+        FILE *f = fopen(t->entries[i].path, "r");
+
+        if (f == NULL) {
+            perror(t->entries[i].path);
+            exit(2);
+        }
+
+        if (t->entries[i].is_csv) {
+            read_csv(&t->entries[i], f);
+        } else {
+            read_txt(&t->entries[i], f);
+        }
+
+        fclose(f);
+    }
+
+    qsort(t->entries, t->num_entries, sizeof(struct entry), cmp_entry);
+}
+
+static void free_tree(struct tree *t) {
+    for (size_t i = 0; i < t->num_entries; i++) {
+        for (size_t j = 0; j < t->entries[i].num_results; j++) {
+            free(t->entries[i].results[j].name);
+        }
+
+        free(t->entries[i].results);
+        free(t->entries[i].key);
+        free(t->entries[i].path);
+    }
+
+    free(t->entries);
+}
+
+// Prints the comparison of one operation, and returns whether it regresses
+static int compare(const struct result *base, const struct result *cur, double threshold) {
+    double delta = (cur->mean - base->mean) / base->mean * 100;
+    int regression = delta > threshold;
+
+    printf("  %-56s %12.0f %12.0f %+8.2f%%", base->name, base->mean, cur->mean, delta);
+
+    if (base->n > 1 && cur->n > 1) {
+        // Welch's interval for the difference of the means, relative to the baseline
+        double se = sqrt(base->stddev * base->stddev / (double)base->n + cur->stddev * cur->stddev / (double)cur->n);
+        double low = delta - Z_95 * se / base->mean * 100, high = delta + Z_95 * se / base->mean * 100;
+
+        printf(" [%+.2f%%, %+.2f%%]", low, high);
+        regression = regression && low > 0;
+    }
+
+    printf("%s\n", regression ? "  REGRESSION" : "");
+
+    return regression;
+}
+
+int main(int argc, char **argv) {
+    struct tree base = {0}, cur = {0};
+    const char *paths[2];
+    size_t num_paths = 0, num_regressions = 0, num_compared = 0;
+    double threshold = DEFAULT_THRESHOLD;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            if (!parse_number(argv[++i], &threshold) || threshold < 0) {
+                usage(argv[0]);
+            }
+        } else if (strcmp(argv[i], "--ignore-compiler") == 0) {
+            ignore_compiler = 1;
+        } else if (argv[i][0] != '-' && num_paths < 2) {
+            paths[num_paths++] = argv[i];
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    if (num_paths != 2) {
+        usage(argv[0]);
+    }
+
+    read_tree(&base, paths[0]);
+    read_tree(&cur, paths[1]);
+
+    printf("  %-56s %12s %12s %9s [95%% confidence interval]\n", "", "baseline", "current", "delta");
+
+    for (size_t i = 0; i < base.num_entries; i++) {
+        const struct entry *b = &base.entries[i], *c = find_entry(&cur, b->key);
+
+        if (c == NULL) {
+            printf("%s: only in %s\n", b->key, paths[0]);
+            continue;
+        }
+
+        printf("%s\n", b->key);
+
+        for (size_t j = 0; j < b->num_results; j++) {
+            size_t k;
+
+            for (k = 0; k < c->num_results && strcmp(b->results[j].name, c->results[k].name) != 0; k++) {
+            }
+
+            if (k == c->num_results) {
+                printf("  %s: only in %s\n", b->results[j].name, paths[0]);
+            } else if (b->results[j].mean > 0) {
+                num_regressions += compare(&b->results[j], &c->results[k], threshold);
+                num_compared++;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < cur.num_entries; i++) {
+        if (find_entry(&base, cur.entries[i].key) == NULL) {
+            printf("%s: only in %s\n", cur.entries[i].key, paths[1]);
+        }
+    }
+
+    printf("\n%zu of %zu operations slower by more than %.2f%%\n", num_regressions, num_compared, threshold);
+
+    free_tree(&base);
+    free_tree(&cur);
+
+    return num_regressions > 0;
+}
@@ -0,0 +1,128 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "feat_dit.h"
+#include "rng.h"
+
+// Interleaves encapsulations and decapsulations of several parameter sets linked into one binary, as a server
+// supporting all of them would, so that each call starts with the caches holding the code of the other parameter
+// sets. The libraries are listed in speed_kem_mixed_libraries.h, generated by CMake as KEM(<library>) lines
+#ifndef NTESTS
+#define NTESTS 1024
+#endif
+
+// Large enough for the keys and ciphertexts of every parameter set
+#define MAX_BYTES 2048
+
+#define KEM(lib)                                                                    \
+    int lib##_keypair(unsigned char *pk, unsigned char *sk);                        \
+    int lib##_enc(unsigned char *c, unsigned char *k, const unsigned char *pk);     \
+    int lib##_dec(unsigned char *k, const unsigned char *c, const unsigned char *sk);
+#include "speed_kem_mixed_libraries.h"
+#undef KEM
+
+typedef struct {
+    const char *name;
+    int (*keypair)(unsigned char *pk, unsigned char *sk);
+    int (*enc)(unsigned char *c, unsigned char *k, const unsigned char *pk);
+    int (*dec)(unsigned char *k, const unsigned char *c, const unsigned char *sk);
+} kem_t;
+
+static const kem_t kems[] = {
+#define KEM(lib) {#lib, lib##_keypair, lib##_enc, lib##_dec},
+#include "speed_kem_mixed_libraries.h"
+#undef KEM
+};
+
+#define NKEMS (sizeof(kems) / sizeof(kems[0]))
+
+#ifdef __APPLE__
+
+#include "m1cycles.h"
+#define SETUP_COUNTER() {setup_rdtsc();}
+#define CYCLE_TYPE "%lld"
+#define GET_TIME rdtsc()
+
+#else
+
+#include "hal.h"
+#define SETUP_COUNTER() {}
+#define CYCLE_TYPE "%ld"
+#define GET_TIME hal_get_time()
+
+#endif
+
+static unsigned char pk[NKEMS][MAX_BYTES], sk[NKEMS][MAX_BYTES], ct[NKEMS][MAX_BYTES];
+static uint64_t enc_cycles[NKEMS], dec_cycles[NKEMS];
+
+// Runs one encapsulation and one decapsulation of every parameter set, returns 0 if all shared keys match
+static int round_robin(int record) {
+    unsigned char key_a[32], key_b[32];
+    uint64_t time0, time1, time2;
+    int ret = 0;
+
+    for (size_t j = 0; j < NKEMS; j++) {
+        time0 = GET_TIME;
+        kems[j].enc(ct[j], key_b, pk[j]);
+        time1 = GET_TIME;
+        kems[j].dec(key_a, ct[j], sk[j]);
+        time2 = GET_TIME;
+
+        if (record) {
+            enc_cycles[j] += time1 - time0;
+            dec_cycles[j] += time2 - time1;
+        }
+
+        ret |= memcmp(key_a, key_b, sizeof(key_a));
+    }
+
+    return ret;
+}
+
+int main()
+{
+    unsigned char entropy_input[48] = {0};
+    uint64_t time0, time1;
+
+#ifdef USE_FEAT_DIT
+    set_dit_bit();
+#endif
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    SETUP_COUNTER();
+
+    for (size_t j = 0; j < NKEMS; j++) {
+        kems[j].keypair(pk[j], sk[j]);
+    }
+
+    // warmup
+    if (round_robin(0)) {
+        fprintf(stderr, "shared keys do not match\n");
+        return 1;
+    }
+
+    time0 = GET_TIME;
+    for (size_t i = 0; i < NTESTS; i++) {
+        if (round_robin(1)) {
+            fprintf(stderr, "shared keys do not match\n");
+            return 1;
+        }
+    }
+    time1 = GET_TIME;
+
+    for (size_t j = 0; j < NKEMS; j++) {
+        printf("%s crypto_kem_enc: " CYCLE_TYPE "\n", kems[j].name, enc_cycles[j] / NTESTS);
+        printf("%s crypto_kem_dec: " CYCLE_TYPE "\n", kems[j].name, dec_cycles[j] / NTESTS);
+    }
+
+    printf("round of all parameter sets: " CYCLE_TYPE "\n", (time1 - time0) / NTESTS);
+
+    return 0;
+}
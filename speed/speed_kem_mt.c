@@ -0,0 +1,299 @@
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#define CPU_SETSIZE_MAX CPU_SETSIZE
+#else
+#define CPU_SETSIZE_MAX 1024
+#endif
+
+#include "api.h"
+#include "feat_dit.h"
+#include "rng.h"
+
+// Number of calls to each operation per thread. Unlike speed_stack.c and speed_mmap.c, latencies are measured in
+// nanoseconds using a monotonic clock, since the cycle counters of different cores are not synchronized
+#ifndef NTESTS
+#define NTESTS 256
+#endif
+
+enum { OP_KEYPAIR, OP_ENC, OP_DEC, NUM_OPS };
+
+static const char *op_names[NUM_OPS] = {"crypto_kem_keypair", "crypto_kem_enc", "crypto_kem_dec"};
+
+// pthread_barrier_t is not available in macOS
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int count, waiting, phase;
+} barrier_t;
+
+typedef struct {
+    int id, cpu;
+    barrier_t *barrier;
+    uint64_t start[NUM_OPS], end[NUM_OPS];
+    uint64_t latency[NUM_OPS][NTESTS];
+} worker_t;
+
+typedef struct {
+    double ops_per_sec;
+    uint64_t p50, p99;
+} result_t;
+
+static void barrier_init(barrier_t *b, int count) {
+    pthread_mutex_init(&b->mutex, NULL);
+    pthread_cond_init(&b->cond, NULL);
+    b->count = count;
+    b->waiting = 0;
+    b->phase = 0;
+}
+
+static void barrier_destroy(barrier_t *b) {
+    pthread_mutex_destroy(&b->mutex);
+    pthread_cond_destroy(&b->cond);
+}
+
+static void barrier_wait(barrier_t *b) {
+    pthread_mutex_lock(&b->mutex);
+
+    int phase = b->phase;
+
+    if (++b->waiting == b->count) {
+        b->waiting = 0;
+        b->phase++;
+        pthread_cond_broadcast(&b->cond);
+    } else {
+        while (phase == b->phase) {
+            pthread_cond_wait(&b->cond, &b->mutex);
+        }
+    }
+
+    pthread_mutex_unlock(&b->mutex);
+}
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// The CPUs the process may run on, in increasing order; thread t is pinned to cpus[t % num_cpus]. Under a cpuset, or
+// with CPUs offline, these are not 0, ..., num_cpus - 1
+static int cpus[CPU_SETSIZE_MAX], num_cpus;
+
+static void get_cpus(void) {
+#ifdef __linux__
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        num_cpus = 0;
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus[num_cpus++] = cpu;
+            }
+        }
+
+        if (num_cpus > 0) {
+            return;
+        }
+    }
+
+    fprintf(stderr, "warning: could not read the CPU affinity of the process\n");
+#endif
+
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    num_cpus = n < 1 ? 1 : n > CPU_SETSIZE_MAX ? CPU_SETSIZE_MAX : (int)n;
+
+    for (int cpu = 0; cpu < num_cpus; cpu++) {
+        cpus[cpu] = cpu;
+    }
+}
+
+static void pin_to_cpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        fprintf(stderr, "warning: could not pin thread to CPU %d\n", cpu);
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+#define TIME_OP(w, op, func)                                 \
+    {                                                        \
+        barrier_wait((w)->barrier);                          \
+        (w)->start[op] = get_time_ns();                      \
+        for (size_t i = 0; i < NTESTS; i++) {                \
+            uint64_t t0 = get_time_ns();                     \
+            func;                                            \
+            (w)->latency[op][i] = get_time_ns() - t0;        \
+        }                                                    \
+        (w)->end[op] = get_time_ns();                        \
+    }
+
+static void *worker_main(void *arg) {
+    worker_t *w = (worker_t *)arg;
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char key_a[CRYPTO_BYTES] = {0};
+    unsigned char key_b[CRYPTO_BYTES] = {0};
+    unsigned char entropy_input[48];
+    randombytes_ctx_t ctx;
+
+    pin_to_cpu(w->cpu);
+
+#ifdef USE_FEAT_DIT
+    set_dit_bit();
+#endif
+
+    // Each thread owns its RNG state; give each one a distinct seed, with all bits of the thread id
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+    for (int i = 0; i < 4; i++) {
+        entropy_input[44 + i] ^= (unsigned char)((uint32_t)w->id >> (8 * i));
+    }
+
+    randombytes_ctx_init(&ctx, entropy_input, NULL, 256);
+
+    /* warmup */
+    crypto_kem_keypair_ctx(&ctx, pk, sk);
+    crypto_kem_enc_ctx(&ctx, ct, key_b, pk);
+    crypto_kem_dec(key_a, ct, sk);
+
+    TIME_OP(w, OP_KEYPAIR, crypto_kem_keypair_ctx(&ctx, pk, sk));
+    TIME_OP(w, OP_ENC, crypto_kem_enc_ctx(&ctx, ct, key_b, pk));
+    TIME_OP(w, OP_DEC, crypto_kem_dec(key_a, ct, sk));
+
+    return NULL;
+}
+
+static int cmp_uint64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void run(int nthreads, result_t results[NUM_OPS]) {
+    worker_t *workers = calloc(nthreads, sizeof(worker_t));
+    pthread_t *threads = calloc(nthreads, sizeof(pthread_t));
+    uint64_t *latencies = calloc((size_t)nthreads * NTESTS, sizeof(uint64_t));
+    barrier_t barrier;
+
+    if (workers == NULL || threads == NULL || latencies == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    barrier_init(&barrier, nthreads);
+
+    for (int t = 0; t < nthreads; t++) {
+        workers[t].id = t;
+        workers[t].cpu = cpus[t % num_cpus];
+        workers[t].barrier = &barrier;
+
+        if (pthread_create(&threads[t], NULL, worker_main, &workers[t]) != 0) {
+            fprintf(stderr, "error: could not create thread %d\n", t);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for (int op = 0; op < NUM_OPS; op++) {
+        uint64_t start = workers[0].start[op], end = workers[0].end[op];
+
+        for (int t = 0; t < nthreads; t++) {
+            if (workers[t].start[op] < start) {
+                start = workers[t].start[op];
+            }
+            if (workers[t].end[op] > end) {
+                end = workers[t].end[op];
+            }
+
+            memcpy(&latencies[(size_t)t * NTESTS], workers[t].latency[op], NTESTS * sizeof(uint64_t));
+        }
+
+        qsort(latencies, (size_t)nthreads * NTESTS, sizeof(uint64_t), cmp_uint64);
+
+        results[op].ops_per_sec = (double)nthreads * NTESTS * 1e9 / (double)(end - start);
+        results[op].p50 = latencies[(size_t)nthreads * NTESTS / 2];
+        results[op].p99 = latencies[(size_t)nthreads * NTESTS * 99 / 100];
+    }
+
+    barrier_destroy(&barrier);
+    free(latencies);
+    free(threads);
+    free(workers);
+}
+
+// 1, 2, 4, ..., followed by max_threads itself if it is not a power of 2
+static int next_thread_count(int nthreads, int max_threads) {
+    if (nthreads < max_threads && 2 * nthreads > max_threads) {
+        return max_threads;
+    }
+
+    return 2 * nthreads;
+}
+
+// Usage: speed_kem_mt [max_threads]. Runs 1, 2, 4, ... threads up to max_threads (default: number of CPUs the process
+// may run on), thread t pinned to the t-th of those CPUs, and reports throughput, latency percentiles and scaling
+// efficiency relative to 1 thread.
+int main(int argc, char *argv[]) {
+    result_t single[NUM_OPS], results[NUM_OPS];
+    long max_threads;
+    int nthreads;
+
+    get_cpus();
+    max_threads = num_cpus;
+
+    if (argc > 1) {
+        max_threads = strtol(argv[1], NULL, 10);
+    }
+
+    if (max_threads < 1) {
+        fprintf(stderr, "error: invalid number of threads\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%-8s %-20s %14s %12s %12s %11s\n", "threads", "operation", "ops/s", "p50 (ns)", "p99 (ns)", "efficiency");
+
+    for (nthreads = 1; nthreads <= max_threads; nthreads = next_thread_count(nthreads, max_threads)) {
+        run(nthreads, results);
+
+        if (nthreads == 1) {
+            memcpy(single, results, sizeof(single));
+        }
+
+        for (int op = 0; op < NUM_OPS; op++) {
+            printf("%-8d %-20s %14.1f %12llu %12llu %10.1f%%\n", nthreads, op_names[op], results[op].ops_per_sec,
+                   (unsigned long long)results[op].p50, (unsigned long long)results[op].p99,
+                   100.0 * results[op].ops_per_sec / (nthreads * single[op].ops_per_sec));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "api.h"
+#include "feat_dit.h"
+#include "rng.h"
+
+// Cycles per key of crypto_kem_keypair_batch for batch sizes 1 to MAX_BATCH, next to those of crypto_kem_keypair.
+// The batch shares one S3 and one Rq inversion between all its keys, at the price of three extra multiplications per
+// key in each ring, so the cost per key drops with the batch size until the multiplications dominate
+#ifndef NTESTS
+#define NTESTS 16
+#endif
+
+#define MAX_BATCH 64
+
+#ifdef __APPLE__
+
+#include "m1cycles.h"
+#define SETUP_COUNTER() {setup_rdtsc();}
+#define CYCLE_TYPE "%lld"
+#define GET_TIME rdtsc()
+
+#else
+
+#include "hal.h"
+#define SETUP_COUNTER() {}
+#define CYCLE_TYPE "%ld"
+#define GET_TIME hal_get_time()
+
+#endif
+
+static unsigned char pk[MAX_BATCH][CRYPTO_PUBLICKEYBYTES], sk[MAX_BATCH][CRYPTO_SECRETKEYBYTES];
+
+// Returns 0 if the first n keys encapsulate and decapsulate to the same shared key
+static int check_keys(size_t n) {
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES], key_a[CRYPTO_BYTES], key_b[CRYPTO_BYTES];
+    int ret = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        crypto_kem_enc(ct, key_b, pk[i]);
+        crypto_kem_dec(key_a, ct, sk[i]);
+        ret |= memcmp(key_a, key_b, sizeof(key_a));
+    }
+
+    return ret;
+}
+
+int main()
+{
+    unsigned char entropy_input[48] = {0};
+    uint64_t time0, time1;
+
+#ifdef USE_FEAT_DIT
+    set_dit_bit();
+#endif
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    SETUP_COUNTER();
+
+    // warmup
+    crypto_kem_keypair(pk[0], sk[0]);
+
+    time0 = GET_TIME;
+    for (size_t i = 0; i < NTESTS; i++) {
+        crypto_kem_keypair(pk[0], sk[0]);
+    }
+    time1 = GET_TIME;
+
+    printf("crypto_kem_keypair: " CYCLE_TYPE "\n", (time1 - time0) / NTESTS);
+
+    for (size_t n = 1; n <= MAX_BATCH; n++) {
+        // warmup
+        crypto_kem_keypair_batch(n, pk[0], sk[0]);
+
+        if (check_keys(n)) {
+            fprintf(stderr, "shared keys do not match for a batch of %zu\n", n);
+            return 1;
+        }
+
+        time0 = GET_TIME;
+        for (size_t i = 0; i < NTESTS; i++) {
+            crypto_kem_keypair_batch(n, pk[0], sk[0]);
+        }
+        time1 = GET_TIME;
+
+        printf("crypto_kem_keypair_batch n=%zu: " CYCLE_TYPE " per key\n", n, (time1 - time0) / (NTESTS * n));
+    }
+
+    return 0;
+}
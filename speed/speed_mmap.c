@@ -4,6 +4,7 @@
 #include <stdio.h>
 
 #include "api.h"
+#include "bench.h"
 #include "feat_dit.h"
 #include "params.h"
 #include "owcpa.h"
@@ -13,82 +14,20 @@
 #define NTESTS 1024
 #endif
 
-uint64_t time0, time1;
-uint64_t cycles[NTESTS];
-
-#ifdef __APPLE__
-
-#include "m1cycles.h"
-#define SETUP_COUNTER() {(void)cycles; setup_rdtsc();}
-#define CYCLE_TYPE "%lld"
-#define GET_TIME rdtsc()
+// Number of operations per call of the batched API, when the implementation provides one
+#define NBATCH 8
 
+#ifdef BENCH_HASH
+// Accumulated by the timing hooks of fips202.c and fips202x.c
+uint64_t fips202_cycles;
+#define HASH_INIT() { fips202_cycles = 0; }
+// BENCH runs func bench_warmup + bench_iterations times
+#define HASH_TAIL(name) { bench_report(name, fips202_cycles / (bench_warmup + bench_iterations)); }
 #else
-
-#include "hal.h"
-#define SETUP_COUNTER() {}
-#define CYCLE_TYPE "%ld"
-#define GET_TIME hal_get_time()
-
+#define HASH_INIT() {}
+#define HASH_TAIL(name) {}
 #endif
-
-#undef __MEDIAN__
-#define __AVERAGE__
-
-#ifdef __AVERAGE__
-
-#define LOOP_INIT(__clock0, __clock1) \
-    {                                 \
-        __clock0 = GET_TIME;          \
-    }
-#define LOOP_TAIL(__f_string, records, __clock0, __clock1)  \
-    {                                                       \
-        __clock1 = GET_TIME;                                \
-        printf(__f_string, (__clock1 - __clock0) / NTESTS); \
-    }
-#define BODY_INIT(__clock0, __clock1) \
-    {}
-#define BODY_TAIL(records, __clock0, __clock1) \
-    {}
-
-#elif defined(__MEDIAN__)
-
-static int cmp_uint64(const void *a, const void *b) {
-    return ((*((const uint64_t *)a)) - ((*((const uint64_t *)b))));
-}
-
-#define LOOP_INIT(__clock0, __clock1) \
-    {}
-#define LOOP_TAIL(__f_string, records, __clock0, __clock1)    \
-    {                                                         \
-        qsort(records, NTESTS, sizeof(uint64_t), cmp_uint64); \
-        printf(__f_string, records[NTESTS >> 1]);             \
-    }
-#define BODY_INIT(__clock0, __clock1) \
-    {                                 \
-        __clock0 = GET_TIME;          \
-    }
-#define BODY_TAIL(records, __clock0, __clock1) \
-    {                                          \
-        __clock1 = GET_TIME;                   \
-        records[i] = __clock1 - __clock0;      \
-    }
-
-#endif
-
-#define WRAP_FUNC(__f_string, records, __clock0, __clock1, func) \
-    {                                                            \
-        /* warmup */                                             \
-        func;                                                    \
-        LOOP_INIT(__clock0, __clock1);                           \
-        for (size_t i = 0; i < NTESTS; i++) {                    \
-            BODY_INIT(__clock0, __clock1);                       \
-            func;                                                \
-            BODY_TAIL(records, __clock0, __clock1);              \
-        }                                                        \
-        LOOP_TAIL(__f_string, records, __clock0, __clock1);      \
-    }
-int main()
+int main(int argc, char **argv)
 {
     unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
     unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
@@ -99,6 +38,17 @@ int main()
     uint8_t rm[NTRU_OWCPA_MSGBYTES];
     poly r, m;
     unsigned char entropy_input[48] = {0};
+#ifdef crypto_kem_enc_batch
+    static unsigned char pk_batch[NBATCH][CRYPTO_PUBLICKEYBYTES], sk_batch[NBATCH][CRYPTO_SECRETKEYBYTES];
+    static unsigned char ct_batch[NBATCH][CRYPTO_CIPHERTEXTBYTES];
+    static unsigned char key_batch[NBATCH][CRYPTO_BYTES];
+#endif
+#ifdef crypto_kem_enc_expanded
+    static uint16_t pk_expanded[CRYPTO_PUBLICKEYEXPANDEDBYTES / 2];
+#endif
+#ifdef crypto_kem_dec_expanded
+    static uint16_t sk_expanded[CRYPTO_SECRETKEYEXPANDEDBYTES / 2];
+#endif
 
 #ifdef USE_FEAT_DIT
     set_dit_bit();
@@ -111,27 +61,79 @@ int main()
     randombytes_init(entropy_input, NULL, 256);
     randombytes(seed, NTRU_SAMPLE_FG_BYTES);
 
-    SETUP_COUNTER();
+    bench_init(argc, argv, NTESTS);
 
-    WRAP_FUNC("crypto_kem_keypair: " CYCLE_TYPE "\n",
-            cycles, time0, time1,
+    BENCH("crypto_kem_keypair",
             crypto_kem_keypair(pk, sk));
-    WRAP_FUNC("crypto_kem_enc: " CYCLE_TYPE "\n",
-            cycles, time0, time1,
+    HASH_INIT();
+    BENCH("crypto_kem_enc",
             crypto_kem_enc(ct, key_b, pk));
-    WRAP_FUNC("crypto_kem_dec: " CYCLE_TYPE "\n",
-            cycles, time0, time1,
+    HASH_TAIL("crypto_kem_enc, SHA3 only");
+    HASH_INIT();
+    BENCH("crypto_kem_dec",
             crypto_kem_dec(key_a, ct, sk));
+    HASH_TAIL("crypto_kem_dec, SHA3 only");
+
+#ifdef crypto_kem_enc_expanded
+    BENCH("crypto_kem_pk_expand",
+            crypto_kem_pk_expand((unsigned char *)pk_expanded, pk));
+    BENCH("crypto_kem_enc_expanded",
+            crypto_kem_enc_expanded(ct, key_b, (unsigned char *)pk_expanded));
+#endif
 
-    WRAP_FUNC("owcpa_keypair: " CYCLE_TYPE "\n",
-            cycles, time0, time1,
+#ifdef crypto_kem_dec_expanded
+    BENCH("crypto_kem_sk_expand",
+            crypto_kem_sk_expand((unsigned char *)sk_expanded, sk));
+    HASH_INIT();
+    BENCH("crypto_kem_dec_expanded",
+            crypto_kem_dec_expanded(key_a, ct, (unsigned char *)sk_expanded));
+    HASH_TAIL("crypto_kem_dec_expanded, SHA3 only");
+#endif
+
+#ifdef crypto_kem_enc_batch
+    BENCH("crypto_kem_keypair_batch (8 ops)",
+            crypto_kem_keypair_batch(NBATCH, pk_batch[0], sk_batch[0]));
+    HASH_INIT();
+    BENCH("crypto_kem_enc_batch (8 ops)",
+            crypto_kem_enc_batch(NBATCH, ct_batch[0], key_batch[0], pk_batch[0]));
+    HASH_TAIL("crypto_kem_enc_batch (8 ops), SHA3 only");
+    HASH_INIT();
+    BENCH("crypto_kem_dec_batch (8 ops)",
+            crypto_kem_dec_batch(NBATCH, key_batch[0], ct_batch[0], sk_batch[0]));
+    HASH_TAIL("crypto_kem_dec_batch (8 ops), SHA3 only");
+#endif
+
+    BENCH("owcpa_keypair",
             owcpa_keypair(pk, sk, seed));
-    WRAP_FUNC("owcpa_enc: " CYCLE_TYPE "\n",
-            cycles, time0, time1,
+    BENCH("owcpa_enc",
             owcpa_enc(ct, &r, &m, pk));
-    WRAP_FUNC("owcpa_dec: " CYCLE_TYPE "\n",
-            cycles, time0, time1,
+    BENCH("owcpa_dec",
             owcpa_dec(rm, ct, sk));
 
+#ifdef poly_R2_inv_clmul
+    // All engines of poly_R2_inv and poly_S3_inv, whichever R2_INV_CLMUL and INV_JUMPDIVSTEP select, on the f of
+    // the last keypair
+    poly_S3_frombytes(&m, sk);
+    BENCH("poly_R2_inv_divstep",
+            poly_R2_inv_divstep(&r, &m));
+    BENCH("poly_R2_inv_clmul",
+            poly_R2_inv_clmul(&r, &m));
+    BENCH("poly_R2_inv_jumpdivstep",
+            poly_R2_inv_jumpdivstep(&r, &m));
+    BENCH("poly_S3_inv_divstep",
+            poly_S3_inv_divstep(&r, &m));
+    BENCH("poly_S3_inv_jumpdivstep",
+            poly_S3_inv_jumpdivstep(&r, &m));
+#endif
+
+#ifdef poly_S3_mul_bitsliced
+    // Both engines of poly_S3_mul, whichever S3_MUL_BITSLICED selects, squaring the f of the last keypair
+    poly_S3_frombytes(&m, sk);
+    BENCH("poly_S3_mul_rq",
+            poly_S3_mul_rq(&r, &m, &m));
+    BENCH("poly_S3_mul_bitsliced",
+            poly_S3_mul_bitsliced(&r, &m, &m));
+#endif
+
   return 0;
 }
@@ -0,0 +1,74 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "api.h"
+#include "bench.h"
+#include "feat_dit.h"
+#include "params.h"
+#include "poly.h"
+#include "rng.h"
+
+#ifndef NTESTS
+#define NTESTS 1024
+#endif
+
+// Every line is "<operation>: <cycles>", with the same operation names for every implementation and parameter set, so
+// that the outputs of all speed_polymul binaries can be put in one table (see run_benchmarks.sh). The AMX multipliers
+// have no NEON kernels to time separately
+int main(int argc, char **argv)
+{
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char entropy_input[48] = {0};
+    static poly r, f, h;
+#ifdef poly_Rq_mul_expanded
+    static poly_expanded h_expanded;
+#endif
+
+#ifdef USE_FEAT_DIT
+    set_dit_bit();
+#endif
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    bench_init(argc, argv, NTESTS);
+
+    // The operands are the public key h and the f of a keypair, as in the KEM
+    crypto_kem_keypair(pk, sk);
+    poly_Sq_frombytes(&h, pk);
+    poly_S3_frombytes(&f, sk);
+
+    BENCH("poly_S3_mul",
+            poly_S3_mul(&r, &f, &f));
+    BENCH("poly_S3_inv",
+            poly_S3_inv(&r, &f));
+    BENCH("poly_R2_inv",
+            poly_R2_inv(&r, &h));
+    BENCH("poly_Rq_inv",
+            poly_Rq_inv(&r, &h));
+
+    poly_Z3_to_Zq(&f);
+
+    BENCH("poly_Rq_mul",
+            poly_Rq_mul(&r, &h, &f));
+
+#ifdef poly_Sq_mul
+    BENCH("poly_Sq_mul",
+            poly_Sq_mul(&r, &h, &f));
+#endif
+
+#ifdef poly_Rq_mul_expanded
+    BENCH("poly_Rq_expand",
+            poly_Rq_expand(&h_expanded, &h));
+    BENCH("poly_Rq_mul_expanded",
+            poly_Rq_mul_expanded(&r, &f, &h_expanded));
+#endif
+
+  return 0;
+}
@@ -0,0 +1,182 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "api.h"
+#include "bench.h"
+#include "feat_dit.h"
+#include "params.h"
+#include "poly.h"
+#include "rng.h"
+
+// The kernels of the multiplier of the implementation, when it has them: the batch multiplication and transposition
+// of NG21, the stages of the CCHY23 TC and TMVP multipliers. The dispatch library only links the engines, whose
+// kernels are in their own namespaces
+#ifndef POLY_RQ_MUL_DISPATCH
+
+#if __has_include("neon_batch_multiplication.h")
+#include "neon_batch_multiplication.h"
+#include "neon_matrix_transpose.h"
+#endif
+
+#if __has_include("tc.h")
+#include "tc.h"
+#endif
+
+#if __has_include("tmvp.h")
+#include "tmvp.h"
+#endif
+
+#endif
+
+#ifndef NTESTS
+#define NTESTS 1024
+#endif
+
+// Large enough for the operands and results of the batch multiplication of every NG21 parameter set
+#define BATCH_BUFFER 4096
+
+// Every line is "<operation>: <cycles>", with the same operation names for every implementation and parameter set, so
+// that the outputs of all speed_polymul binaries can be put in one table (see run_benchmarks.sh)
+int main(int argc, char **argv)
+{
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char entropy_input[48] = {0};
+    static poly r, f, h;
+#ifdef poly_Rq_mul_expanded
+    static poly_expanded h_expanded;
+#endif
+#ifdef NEON_BATCH_MULTIPLICATION_H
+    static uint16_t batch_a[BATCH_BUFFER], batch_b[BATCH_BUFFER], batch_c[BATCH_BUFFER];
+#endif
+#ifdef TC_H
+    static uint16_t tc_ab[2 * TC_WAYS * SB0], tc_c[TC_WAYS * SB0_RES];
+    uint16_t *kaw[TC_WAYS], *kbw[TC_WAYS], *kcw[TC_WAYS];
+#endif
+#ifdef TMVP_H
+    static uint16_t coeffs_L[SIZE_L], coeffs_R[SIZE_R];
+#ifndef NTRU_HRSS
+    static uint16_t coeffs_I[SIZE_I];
+#endif
+#endif
+#ifdef POLY_RQ_MUL_DISPATCH
+    const char *engine, *engine_selected;
+    char name[64];
+#endif
+
+#ifdef USE_FEAT_DIT
+    set_dit_bit();
+#endif
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    bench_init(argc, argv, NTESTS);
+
+    // The operands are the public key h and the f of a keypair, as in the KEM
+    crypto_kem_keypair(pk, sk);
+    poly_Sq_frombytes(&h, pk);
+    poly_S3_frombytes(&f, sk);
+
+#ifdef POLY_RQ_MUL_DISPATCH
+    engine_selected = poly_Rq_mul_engine();
+    printf("poly_Rq_mul engine selected for this core: %s\n", engine_selected);
+#endif
+
+    BENCH("poly_S3_mul",
+            poly_S3_mul(&r, &f, &f));
+    BENCH("poly_S3_inv",
+            poly_S3_inv(&r, &f));
+    BENCH("poly_R2_inv",
+            poly_R2_inv(&r, &h));
+    BENCH("poly_Rq_inv",
+            poly_Rq_inv(&r, &h));
+
+    poly_Z3_to_Zq(&f);
+
+    BENCH("poly_Rq_mul",
+            poly_Rq_mul(&r, &h, &f));
+
+#ifdef poly_Sq_mul
+    BENCH("poly_Sq_mul",
+            poly_Sq_mul(&r, &h, &f));
+#endif
+
+#ifdef poly_Rq_mul_expanded
+    BENCH("poly_Rq_expand",
+            poly_Rq_expand(&h_expanded, &h));
+    BENCH("poly_Rq_mul_expanded",
+            poly_Rq_mul_expanded(&r, &f, &h_expanded));
+#endif
+
+#ifdef NEON_BATCH_MULTIPLICATION_H
+    // The batched schoolbook multiplications at the bottom of poly_Rq_mul, and the transposition of their operands
+#if NTRU_N == 509
+    BENCH("batch schoolbook (schoolbook_neon)",
+            schoolbook_neon(batch_c, batch_a, batch_b));
+    BENCH("batch transpose (transpose_8x16)",
+            transpose_8x16(batch_b));
+#else
+    BENCH("batch schoolbook (schoolbook_half_8x_neon)",
+            schoolbook_half_8x_neon(batch_c, batch_a, batch_b));
+    BENCH("batch transpose (half_transpose_8x16)",
+            half_transpose_8x16(batch_b));
+#endif
+#endif
+
+#ifdef TC_H
+    // The stages of poly_Rq_mul (see F_EVAL and F_INTERP in tc.h)
+    for (int i = 0; i < TC_WAYS; i++) {
+        kaw[i] = &tc_ab[(2 * i) * SB0];
+        kbw[i] = &tc_ab[(2 * i + 1) * SB0];
+        kcw[i] = &tc_c[i * SB0_RES];
+    }
+
+    F_EVAL(kbw, f.coeffs);
+
+    BENCH("tc evaluation (F_EVAL)",
+            F_EVAL(kaw, h.coeffs));
+    BENCH("tc products (tc33_mul)",
+            tc33_mul(kcw, kaw, kbw));
+    BENCH("tc interpolation (F_INTERP)",
+            F_INTERP(tc_ab, kcw));
+#endif
+
+#ifdef TMVP_H
+    // The stages of poly_Rq_mul (see F_L, F_R, F_MUL and F_I in tmvp.h)
+    BENCH("tmvp Toeplitz matrix of a (F_L)",
+            F_L(coeffs_L, h.coeffs));
+    BENCH("tmvp evaluation of b (F_R)",
+            F_R(coeffs_R, f.coeffs));
+#ifdef NTRU_HRSS
+    // The products overwrite the evaluation of b
+    BENCH("tmvp products (F_MUL)",
+            F_MUL(coeffs_R, coeffs_L));
+    BENCH("tmvp interpolation (F_I)",
+            F_I(r.coeffs, coeffs_R));
+#else
+    BENCH("tmvp products (F_MUL)",
+            F_MUL(coeffs_I, coeffs_L, coeffs_R));
+    BENCH("tmvp interpolation (F_I)",
+            F_I(r.coeffs, coeffs_I));
+#endif
+#endif
+
+#ifdef POLY_RQ_MUL_DISPATCH
+    // poly_Rq_mul with each engine linked into the dispatch library
+    for (size_t e = 0; (engine = poly_Rq_mul_engine_name(e)) != NULL; e++) {
+        poly_Rq_mul_set_engine(engine);
+        snprintf(name, sizeof(name), "poly_Rq_mul, %s engine", engine);
+        BENCH(name,
+                poly_Rq_mul(&r, &h, &f));
+    }
+    poly_Rq_mul_set_engine(engine_selected);
+#endif
+
+  return 0;
+}
@@ -4,83 +4,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#define NTESTS 1000
-
-uint64_t time0, time1;
-uint64_t cycles[NTESTS];
-
-#ifdef __APPLE__
-
-#include "m1cycles.h"
-#define SETUP_COUNTER() {(void)cycles; setup_rdtsc();}
-#define CYCLE_TYPE "%lld"
-#define GET_TIME rdtsc()
-
-#else
-
-#include "hal.h"
-#define SETUP_COUNTER() {}
-#define CYCLE_TYPE "%ld"
-#define GET_TIME hal_get_time()
-
-#endif
-
-#undef __MEDIAN__
-#define __AVERAGE__
+#include "bench.h"
 
-#ifdef __AVERAGE__
-
-#define LOOP_INIT(__clock0, __clock1) \
-    {                                 \
-        __clock0 = GET_TIME;          \
-    }
-#define LOOP_TAIL(__f_string, records, __clock0, __clock1)  \
-    {                                                       \
-        __clock1 = GET_TIME;                                \
-        printf(__f_string, (__clock1 - __clock0) / NTESTS); \
-    }
-#define BODY_INIT(__clock0, __clock1) \
-    {}
-#define BODY_TAIL(records, __clock0, __clock1) \
-    {}
-
-#elif defined(__MEDIAN__)
-
-static int cmp_uint64(const void *a, const void *b) {
-    return ((*((const uint64_t *)a)) - ((*((const uint64_t *)b))));
-}
-
-#define LOOP_INIT(__clock0, __clock1) \
-    {}
-#define LOOP_TAIL(__f_string, records, __clock0, __clock1)    \
-    {                                                         \
-        qsort(records, NTESTS, sizeof(uint64_t), cmp_uint64); \
-        printf(__f_string, records[NTESTS >> 1]);             \
-    }
-#define BODY_INIT(__clock0, __clock1) \
-    {                                 \
-        __clock0 = GET_TIME;          \
-    }
-#define BODY_TAIL(records, __clock0, __clock1) \
-    {                                          \
-        __clock1 = GET_TIME;                   \
-        records[i] = __clock1 - __clock0;      \
-    }
-
-#endif
-
-#define WRAP_FUNC(__f_string, records, __clock0, __clock1, func) \
-    {                                                            \
-        /* warmup */                                             \
-        func;                                                    \
-        LOOP_INIT(__clock0, __clock1);                           \
-        for (size_t i = 0; i < NTESTS; i++) {                    \
-            BODY_INIT(__clock0, __clock1);                       \
-            func;                                                \
-            BODY_TAIL(records, __clock0, __clock1);              \
-        }                                                        \
-        LOOP_TAIL(__f_string, records, __clock0, __clock1);      \
-    }
+#define NTESTS 1000
 
 void nist_randombytes_init(unsigned char *entropy_input, unsigned char *personalization_string, int security_strength);
 int nist_randombytes(unsigned char *x, unsigned long long xlen);
@@ -89,7 +15,7 @@ void opt_randombytes_init(unsigned char *entropy_input, unsigned char *personali
 int opt_randombytes(unsigned char *x, unsigned long long xlen);
 
 #define BENCHMARK(func, name, size) \
-    WRAP_FUNC(#func " " name ": " CYCLE_TYPE "\n", cycles, time0, time1, func(buf, size))
+    BENCH(#func " " name, func(buf, size))
 
 #define BENCHMARKS(name, size)                       \
     do {                                             \
@@ -99,7 +25,35 @@ int opt_randombytes(unsigned char *x, unsigned long long xlen);
     }                                                \
     while (0)
 
-int main() {
+// Bytes-per-cycle sweep over request sizes, from SWEEP_MIN_BYTES to SWEEP_MAX_BYTES in powers of 2. Every size gets
+// the same number of calls, so only SWEEP_NTESTS (rather than NTESTS) calls are made to keep the reference RNG fast. The
+// throughput is only printed, it is not part of the JSON and CSV output of BENCH
+#define SWEEP_MIN_BYTES 16
+#define SWEEP_MAX_BYTES 65536
+#define SWEEP_NTESTS 100
+
+static unsigned char sweep_buf[SWEEP_MAX_BYTES];
+
+static void sweep(const char *name, int (*func)(unsigned char *x, unsigned long long xlen)) {
+    for (size_t size = SWEEP_MIN_BYTES; size <= SWEEP_MAX_BYTES; size *= 2) {
+        uint64_t time0, time1;
+
+        /* warmup */
+        func(sweep_buf, size);
+
+        time0 = BENCH_TIME();
+        for (size_t i = 0; i < SWEEP_NTESTS; i++) {
+            func(sweep_buf, size);
+        }
+        time1 = BENCH_TIME();
+
+        printf("%s %zu bytes: %.3f bytes/cycle\n", name, size, (double)size * SWEEP_NTESTS / (double)(time1 - time0));
+    }
+
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
     unsigned char buf[(30 * 820 + 7) / 8];
     uint8_t entropy_input[48] = {0};
 
@@ -110,12 +64,15 @@ int main() {
     nist_randombytes_init(entropy_input, NULL, 256);
     opt_randombytes_init(entropy_input, NULL, 256);
 
-    SETUP_COUNTER();
+    bench_init(argc, argv, NTESTS);
 
     BENCHMARKS("hps2048509", (30 * 508 + 7) / 8);
     BENCHMARKS("hps2048677", (30 * 676 + 7) / 8);
     BENCHMARKS("hps4096821", (30 * 820 + 7) / 8);
     BENCHMARKS("hrss701", (30 * 700 + 7) / 8);
 
+    sweep("nist_randombytes", nist_randombytes);
+    sweep("opt_randombytes", opt_randombytes);
+
     return 0;
 }
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "bench.h"
 #include "feat_dit.h"
 #include "params.h"
 #include "rng.h"
@@ -13,82 +14,6 @@
 #define NTESTS 1024
 #endif
 
-uint64_t time0, time1;
-uint64_t cycles[NTESTS];
-
-#ifdef __APPLE__
-
-#include "m1cycles.h"
-#define SETUP_COUNTER() {(void)cycles; setup_rdtsc();}
-#define CYCLE_TYPE "%lld"
-#define GET_TIME rdtsc()
-
-#else
-
-#include "hal.h"
-#define SETUP_COUNTER() {}
-#define CYCLE_TYPE "%ld"
-#define GET_TIME hal_get_time()
-
-#endif
-
-#undef __MEDIAN__
-#define __AVERAGE__
-
-#ifdef __AVERAGE__
-
-#define LOOP_INIT(__clock0, __clock1) \
-    {                                 \
-        __clock0 = GET_TIME;          \
-    }
-#define LOOP_TAIL(__f_string, records, __clock0, __clock1)  \
-    {                                                       \
-        __clock1 = GET_TIME;                                \
-        printf(__f_string, (__clock1 - __clock0) / NTESTS); \
-    }
-#define BODY_INIT(__clock0, __clock1) \
-    {}
-#define BODY_TAIL(records, __clock0, __clock1) \
-    {}
-
-#elif defined(__MEDIAN__)
-
-static int cmp_uint64(const void *a, const void *b) {
-    return ((*((const uint64_t *)a)) - ((*((const uint64_t *)b))));
-}
-
-#define LOOP_INIT(__clock0, __clock1) \
-    {}
-#define LOOP_TAIL(__f_string, records, __clock0, __clock1)    \
-    {                                                         \
-        qsort(records, NTESTS, sizeof(uint64_t), cmp_uint64); \
-        printf(__f_string, records[NTESTS >> 1]);             \
-    }
-#define BODY_INIT(__clock0, __clock1) \
-    {                                 \
-        __clock0 = GET_TIME;          \
-    }
-#define BODY_TAIL(records, __clock0, __clock1) \
-    {                                          \
-        __clock1 = GET_TIME;                   \
-        records[i] = __clock1 - __clock0;      \
-    }
-
-#endif
-
-#define WRAP_FUNC(__f_string, records, __clock0, __clock1, func) \
-    {                                                            \
-        /* warmup */                                             \
-        func;                                                    \
-        LOOP_INIT(__clock0, __clock1);                           \
-        for (size_t i = 0; i < NTESTS; i++) {                    \
-            BODY_INIT(__clock0, __clock1);                       \
-            func;                                                \
-            BODY_TAIL(records, __clock0, __clock1);              \
-        }                                                        \
-        LOOP_TAIL(__f_string, records, __clock0, __clock1);      \
-    }
-
 // Required to avoid linker errors, not used in benchmark
 void sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]) {
     (void)r;
@@ -100,9 +25,25 @@ static inline void randombytes_sample_fixed_type(poly *r, unsigned char uniformb
     SAMPLE_FIXED_TYPE(r, uniformbytes);
 }
 
-int main() {
+#ifdef SHUFFLING
+#define XN_BATCH 8
+
+// The random bytes are consumed as they are generated, instead of going through uniformbytes
+static inline void randombytes_stream_sample_fixed_type(poly *r) {
+    randombytes_stream_begin(NULL, NTRU_SAMPLE_FT_BYTES);
+    sample_fixed_type_stream(r, NULL, 0);
+    randombytes_stream_end(NULL);
+}
+#endif
+
+int main(int argc, char **argv) {
     poly r;
     unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES];
+#ifdef SHUFFLING
+    poly r_xN[XN_BATCH], *r_xN_ptrs[XN_BATCH];
+    unsigned char uniformbytes_xN[XN_BATCH][NTRU_SAMPLE_FT_BYTES];
+    const unsigned char *uniformbytes_xN_ptrs[XN_BATCH];
+#endif
     uint8_t entropy_input[48] = {0};
 
 #ifdef USE_FEAT_DIT
@@ -115,12 +56,25 @@ int main() {
 
     randombytes_init(entropy_input, NULL, 256);
 
-    SETUP_COUNTER();
+#ifdef SHUFFLING
+    randombytes(&uniformbytes_xN[0][0], sizeof(uniformbytes_xN));
+
+    for (int i = 0; i < XN_BATCH; i++) {
+        r_xN_ptrs[i] = &r_xN[i];
+        uniformbytes_xN_ptrs[i] = uniformbytes_xN[i];
+    }
+#endif
+
+    bench_init(argc, argv, NTESTS);
 
-    WRAP_FUNC("randombytes + sample_fixed_type: " CYCLE_TYPE "\n",
-        cycles, time0, time1, randombytes_sample_fixed_type(&r, uniformbytes));
-    WRAP_FUNC("sample_fixed_type only: " CYCLE_TYPE "\n",
-        cycles, time0, time1, SAMPLE_FIXED_TYPE(&r, uniformbytes));
+    BENCH("randombytes + sample_fixed_type", randombytes_sample_fixed_type(&r, uniformbytes));
+#ifdef SHUFFLING
+    BENCH("randombytes_stream + sample_fixed_type_stream", randombytes_stream_sample_fixed_type(&r));
+#endif
+    BENCH("sample_fixed_type only", SAMPLE_FIXED_TYPE(&r, uniformbytes));
+#ifdef SHUFFLING
+    BENCH("sample_fixed_type_xN (8 polynomials)", sample_fixed_type_xN(r_xN_ptrs, uniformbytes_xN_ptrs, XN_BATCH));
+#endif
 
     return 0;
 }
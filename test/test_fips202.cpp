@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "test.h"
+
+extern "C" {
+#include "fips202.h"
+#include "fips202x.h"
+}
+
+// Message lengths around the SHA3-256 rate (136 bytes) and its multiples, plus the decapsulation inputs of the
+// smallest and largest parameter sets: rm (2*102 and 2*164 bytes) and PRF key || ciphertext (32+699 and 32+1230 bytes)
+static const size_t lengths[] = {0, 1, 31, 32, 135, 136, 137, 204, 271, 272, 273, 328, 731, 1262};
+
+class fips202x : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (size_t j = 0; j < 4; j++) {
+            for (size_t i = 0; i < sizeof(in[j]); i++) {
+                in[j][i] = static_cast<uint8_t>(rand());
+            }
+        }
+    }
+
+    uint8_t in[4][1262];
+};
+
+TEST_F(fips202x, sha3_256_x2_matches_sha3_256) {
+    uint8_t h[2][32], h_x2[2][32];
+
+    for (size_t inlen0 : lengths) {
+        for (size_t inlen1 : lengths) {
+            sha3_256(h[0], in[0], inlen0);
+            sha3_256(h[1], in[1], inlen1);
+
+            sha3_256_x2(h_x2[0], h_x2[1], in[0], inlen0, in[1], inlen1);
+
+            ASSERT_TRUE(ArraysMatch(h[0], h_x2[0])) << "inlen0 = " << inlen0 << ", inlen1 = " << inlen1;
+            ASSERT_TRUE(ArraysMatch(h[1], h_x2[1])) << "inlen0 = " << inlen0 << ", inlen1 = " << inlen1;
+        }
+    }
+}
+
+TEST_F(fips202x, sha3_256_x4_matches_sha3_256) {
+    uint8_t h[4][32], h_x4[4][32];
+
+    for (size_t inlen : lengths) {
+        for (size_t j = 0; j < 4; j++) {
+            sha3_256(h[j], in[j], inlen);
+        }
+
+        sha3_256_x4(h_x4[0], h_x4[1], h_x4[2], h_x4[3], in[0], in[1], in[2], in[3], inlen);
+
+        for (size_t j = 0; j < 4; j++) {
+            ASSERT_TRUE(ArraysMatch(h[j], h_x4[j])) << "inlen = " << inlen << ", lane " << j;
+        }
+    }
+}
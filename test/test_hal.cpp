@@ -0,0 +1,75 @@
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "hal.h"
+}
+
+class hal : public ::testing::TestWithParam<std::string> {
+   protected:
+    // Every test leaves the backend hal.c chose before main in place
+    void SetUp() override { initial_backend = hal_backend(); }
+    void TearDown() override { ASSERT_EQ(hal_set_backend(initial_backend), 0); }
+
+    const char *initial_backend;
+};
+
+TEST_P(hal, time_does_not_go_back) {
+    if (hal_set_backend(GetParam().c_str()) != 0) {
+        GTEST_SKIP() << "backend " << GetParam() << " is not available";
+    }
+
+    EXPECT_STREQ(hal_backend(), GetParam().c_str());
+
+    uint64_t t0 = hal_get_time();
+
+    for (int i = 0; i < 1000; i++) {
+        uint64_t t1 = hal_get_time();
+        ASSERT_GE(t1, t0);
+        t0 = t1;
+    }
+}
+
+TEST_P(hal, time_advances) {
+    if (hal_set_backend(GetParam().c_str()) != 0) {
+        GTEST_SKIP() << "backend " << GetParam() << " is not available";
+    }
+
+    uint64_t t0 = hal_get_time();
+
+    for (volatile int i = 0; i < 1000000; i++) {
+    }
+
+    EXPECT_GT(hal_get_time(), t0);
+}
+
+INSTANTIATE_TEST_SUITE_P(backends, hal, ::testing::Values("pmccntr", "perf", "rdtsc", "rdpmc", "clock"),
+                         [](const ::testing::TestParamInfo<std::string> &info) { return info.param; });
+
+TEST(hal, clock_is_always_available) {
+    const char *initial_backend = hal_backend();
+
+    EXPECT_EQ(hal_set_backend("clock"), 0);
+    EXPECT_EQ(hal_set_backend(initial_backend), 0);
+}
+
+TEST(hal, unknown_backend) {
+    const char *initial_backend = hal_backend();
+
+    EXPECT_EQ(hal_set_backend("sundial"), -1);
+    EXPECT_STREQ(hal_backend(), initial_backend);
+}
+
+TEST(hal, counters) {
+    uint64_t values[HAL_MAX_COUNTERS] = {0};
+
+    ASSERT_LE(hal_num_counters(), (size_t)HAL_MAX_COUNTERS);
+
+    for (size_t i = 0; i < hal_num_counters(); i++) {
+        EXPECT_NE(hal_counter_name(i), nullptr);
+    }
+
+    hal_get_counters(values);
+}
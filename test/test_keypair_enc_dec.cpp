@@ -3,6 +3,7 @@
 
 extern "C" {
 #include "api.h"
+#include "params.h"
 #include "rng.h"
 }
 
@@ -12,6 +13,10 @@ extern "C" int CRYPTO_NAMESPACE_SHUFFLING(keypair)(unsigned char *pk, unsigned c
 extern "C" int CRYPTO_NAMESPACE_SORTING(enc)(unsigned char *c, unsigned char *k, const unsigned char *pk);
 extern "C" int CRYPTO_NAMESPACE_SHUFFLING(enc)(unsigned char *c, unsigned char *k, const unsigned char *pk);
 
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(keypair_ctx)(randombytes_ctx_t *ctx, unsigned char *pk, unsigned char *sk);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(enc_ctx)(randombytes_ctx_t *ctx, unsigned char *c, unsigned char *k,
+                                                   const unsigned char *pk);
+
 extern "C" int CRYPTO_NAMESPACE_SORTING(dec)(unsigned char *k, const unsigned char *c, const unsigned char *sk);
 extern "C" int CRYPTO_NAMESPACE_SHUFFLING(dec)(unsigned char *k, const unsigned char *c, const unsigned char *sk);
 
@@ -89,3 +94,362 @@ TEST(TEST_NAME, sorting_enc_dec__shuffling_keypair) {
         }
     }
 }
+
+// The ChaCha20 benchmark RNG (NORAND) has a single thread-local state and ignores the context
+#ifndef NORAND
+TEST(TEST_NAME, shuffling_ctx_matches_default) {
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES], sk[CRYPTO_SECRETKEYBYTES], c[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char pk_ctx[CRYPTO_PUBLICKEYBYTES], sk_ctx[CRYPTO_SECRETKEYBYTES], c_ctx[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char k_enc[CRYPTO_BYTES], k_enc_ctx[CRYPTO_BYTES], k_dec[CRYPTO_BYTES];
+    unsigned char entropy_input[48] = {0};
+    randombytes_ctx_t ctx;
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx, entropy_input, NULL, 256);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        CRYPTO_NAMESPACE_SHUFFLING(keypair)(pk, sk);
+        CRYPTO_NAMESPACE_SHUFFLING(keypair_ctx)(&ctx, pk_ctx, sk_ctx);
+
+        ASSERT_TRUE(ArraysMatch(pk, pk_ctx));
+        ASSERT_TRUE(ArraysMatch(sk, sk_ctx));
+
+        for (int j = 0; j < ENC_DEC_REPETITIONS; j++) {
+            CRYPTO_NAMESPACE_SHUFFLING(enc)(c, k_enc, pk);
+            CRYPTO_NAMESPACE_SHUFFLING(enc_ctx)(&ctx, c_ctx, k_enc_ctx, pk_ctx);
+
+            ASSERT_TRUE(ArraysMatch(c, c_ctx));
+            ASSERT_TRUE(ArraysMatch(k_enc, k_enc_ctx));
+
+            CRYPTO_NAMESPACE_SHUFFLING(dec)(k_dec, c_ctx, sk_ctx);
+
+            ASSERT_TRUE(ArraysMatch(k_enc_ctx, k_dec));
+        }
+    }
+}
+
+// Only some implementations provide the expanded public key API, api.h then defines the namespacing macros
+#ifdef crypto_kem_enc_expanded_ctx
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(pk_expand)(unsigned char *pk_expanded, const unsigned char *pk);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(enc_expanded_ctx)(randombytes_ctx_t *ctx, unsigned char *c,
+                                                            unsigned char *k, const unsigned char *pk_expanded);
+
+TEST(TEST_NAME, shuffling_enc_expanded_ctx_matches_enc_ctx) {
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES], sk[CRYPTO_SECRETKEYBYTES];
+    unsigned char c[CRYPTO_CIPHERTEXTBYTES], c_expanded[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char k_enc[CRYPTO_BYTES], k_enc_expanded[CRYPTO_BYTES], k_dec[CRYPTO_BYTES];
+    unsigned char entropy_input[48] = {0};
+    randombytes_ctx_t ctx, ctx_expanded;
+    // Read as 16-bit coefficients
+    static uint16_t pk_expanded[CRYPTO_PUBLICKEYEXPANDEDBYTES / 2];
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_ctx_init(&ctx, entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx_expanded, entropy_input, NULL, 256);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        CRYPTO_NAMESPACE_SHUFFLING(keypair_ctx)(&ctx, pk, sk);
+        CRYPTO_NAMESPACE_SHUFFLING(keypair_ctx)(&ctx_expanded, pk, sk);
+        CRYPTO_NAMESPACE_SHUFFLING(pk_expand)((unsigned char *)pk_expanded, pk);
+
+        for (int j = 0; j < ENC_DEC_REPETITIONS; j++) {
+            CRYPTO_NAMESPACE_SHUFFLING(enc_ctx)(&ctx, c, k_enc, pk);
+            CRYPTO_NAMESPACE_SHUFFLING(enc_expanded_ctx)(&ctx_expanded, c_expanded, k_enc_expanded,
+                                                         (unsigned char *)pk_expanded);
+
+            ASSERT_TRUE(ArraysMatch(c, c_expanded));
+            ASSERT_TRUE(ArraysMatch(k_enc, k_enc_expanded));
+
+            CRYPTO_NAMESPACE_SHUFFLING(dec)(k_dec, c_expanded, sk);
+
+            ASSERT_TRUE(ArraysMatch(k_enc_expanded, k_dec));
+        }
+    }
+}
+#endif
+#endif
+
+// Only some implementations provide the batched API, api.h then defines the namespacing macros
+#ifdef crypto_kem_enc_batch
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(keypair_batch)(size_t n, unsigned char *pk, unsigned char *sk);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(enc_batch)(size_t n, unsigned char *c, unsigned char *k,
+                                                     const unsigned char *pk);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(dec_batch)(size_t n, unsigned char *k, const unsigned char *c,
+                                                     const unsigned char *sk);
+
+// Not a multiple of the number of lanes, so that the last group of a batch is partial
+#define BATCH_SIZE 19
+
+TEST(TEST_NAME, shuffling_batch_matches_scalar) {
+    static unsigned char pk[BATCH_SIZE][CRYPTO_PUBLICKEYBYTES], sk[BATCH_SIZE][CRYPTO_SECRETKEYBYTES];
+    static unsigned char c[BATCH_SIZE][CRYPTO_CIPHERTEXTBYTES];
+    unsigned char k_enc[BATCH_SIZE][CRYPTO_BYTES], k_dec[BATCH_SIZE][CRYPTO_BYTES], k[CRYPTO_BYTES];
+    unsigned char entropy_input[48] = {0};
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    CRYPTO_NAMESPACE_SHUFFLING(keypair_batch)(BATCH_SIZE, pk[0], sk[0]);
+    CRYPTO_NAMESPACE_SHUFFLING(enc_batch)(BATCH_SIZE, c[0], k_enc[0], pk[0]);
+
+    // Corrupt one ciphertext, its shared secret must then come from the implicit rejection path
+    c[BATCH_SIZE / 2][0] ^= 1;
+
+    CRYPTO_NAMESPACE_SHUFFLING(dec_batch)(BATCH_SIZE, k_dec[0], c[0], sk[0]);
+
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        CRYPTO_NAMESPACE_SHUFFLING(dec)(k, c[i], sk[i]);
+
+        ASSERT_TRUE(ArraysMatch(k, k_dec[i]));
+
+        if (i == BATCH_SIZE / 2) {
+            ASSERT_FALSE(ArraysMatch(k_enc[i], k_dec[i]));
+        } else {
+            ASSERT_TRUE(ArraysMatch(k_enc[i], k_dec[i]));
+        }
+    }
+}
+
+// The ChaCha20 benchmark RNG (NORAND) has a single thread-local state and ignores the context
+#ifndef NORAND
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(keypair_batch_ctx)(randombytes_ctx_t *ctx, size_t n, unsigned char *pk,
+                                                             unsigned char *sk);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(enc_batch_ctx)(randombytes_ctx_t *ctx, size_t n, unsigned char *c,
+                                                         unsigned char *k, const unsigned char *pk);
+
+TEST(TEST_NAME, shuffling_batch_ctx_matches_default) {
+    static unsigned char pk[BATCH_SIZE][CRYPTO_PUBLICKEYBYTES], sk[BATCH_SIZE][CRYPTO_SECRETKEYBYTES];
+    static unsigned char pk_ctx[BATCH_SIZE][CRYPTO_PUBLICKEYBYTES], sk_ctx[BATCH_SIZE][CRYPTO_SECRETKEYBYTES];
+    static unsigned char c[BATCH_SIZE][CRYPTO_CIPHERTEXTBYTES], c_ctx[BATCH_SIZE][CRYPTO_CIPHERTEXTBYTES];
+    unsigned char k_enc[BATCH_SIZE][CRYPTO_BYTES], k_enc_ctx[BATCH_SIZE][CRYPTO_BYTES];
+    unsigned char c_single[CRYPTO_CIPHERTEXTBYTES], k_single[CRYPTO_BYTES];
+    unsigned char entropy_input[48] = {0};
+    randombytes_ctx_t ctx;
+    const size_t sizes[] = {1, 2, 8, BATCH_SIZE};
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx, entropy_input, NULL, 256);
+
+    for (size_t n : sizes) {
+        CRYPTO_NAMESPACE_SHUFFLING(keypair_batch)(n, pk[0], sk[0]);
+        CRYPTO_NAMESPACE_SHUFFLING(keypair_batch_ctx)(&ctx, n, pk_ctx[0], sk_ctx[0]);
+
+        ASSERT_TRUE(ArraysMatch(pk[0], pk_ctx[0], n * CRYPTO_PUBLICKEYBYTES));
+        ASSERT_TRUE(ArraysMatch(sk[0], sk_ctx[0], n * CRYPTO_SECRETKEYBYTES));
+
+        CRYPTO_NAMESPACE_SHUFFLING(enc_batch)(n, c[0], k_enc[0], pk[0]);
+        CRYPTO_NAMESPACE_SHUFFLING(enc_batch_ctx)(&ctx, n, c_ctx[0], k_enc_ctx[0], pk_ctx[0]);
+
+        ASSERT_TRUE(ArraysMatch(c[0], c_ctx[0], n * CRYPTO_CIPHERTEXTBYTES));
+        ASSERT_TRUE(ArraysMatch(k_enc[0], k_enc_ctx[0], n * CRYPTO_BYTES));
+    }
+
+    // A group of one draws its random bytes with a single request, as crypto_kem_enc does
+    CRYPTO_NAMESPACE_SHUFFLING(enc_batch)(1, c[0], k_enc[0], pk[0]);
+    CRYPTO_NAMESPACE_SHUFFLING(enc_ctx)(&ctx, c_single, k_single, pk[0]);
+
+    ASSERT_TRUE(ArraysMatch(c[0], c_single));
+    ASSERT_TRUE(ArraysMatch(k_enc[0], k_single));
+}
+
+extern "C" void CRYPTO_NAMESPACE_SHUFFLING(owcpa_keypair)(unsigned char *pk, unsigned char *sk,
+                                                          const unsigned char seed[NTRU_SAMPLE_FG_BYTES]);
+
+// Operations per group of the batched API, see KEM_BATCH_LANES in kem.c
+#define BATCH_LANES 8
+
+TEST(TEST_NAME, shuffling_keypair_batch_matches_owcpa_keypair) {
+    static unsigned char pk[BATCH_SIZE][CRYPTO_PUBLICKEYBYTES], sk[BATCH_SIZE][CRYPTO_SECRETKEYBYTES];
+    unsigned char pk_single[CRYPTO_PUBLICKEYBYTES], sk_single[CRYPTO_SECRETKEYBYTES];
+    static unsigned char seeds[BATCH_LANES][NTRU_SAMPLE_FG_BYTES + NTRU_PRFKEYBYTES];
+    unsigned char entropy_input[48] = {0};
+    randombytes_ctx_t ctx, ctx_seeds;
+    // Single keys, pairs, odd sizes, and sizes around the number of lanes
+    const size_t sizes[] = {1, 2, 3, 5, 7, 8, 9, 16, BATCH_SIZE};
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    // The batch draws the seeds of each group with a single request, ctx_seeds draws the same ones
+    randombytes_ctx_init(&ctx, entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx_seeds, entropy_input, NULL, 256);
+
+    for (size_t n : sizes) {
+        CRYPTO_NAMESPACE_SHUFFLING(keypair_batch_ctx)(&ctx, n, pk[0], sk[0]);
+
+        for (size_t i = 0, lanes; i < n; i += lanes) {
+            lanes = n - i < BATCH_LANES ? n - i : BATCH_LANES;
+
+            randombytes_ctx(&ctx_seeds, seeds[0], lanes * sizeof(seeds[0]));
+
+            for (size_t j = 0; j < lanes; j++) {
+                CRYPTO_NAMESPACE_SHUFFLING(owcpa_keypair)(pk_single, sk_single, seeds[j]);
+
+                for (int k = 0; k < NTRU_PRFKEYBYTES; k++) {
+                    sk_single[NTRU_OWCPA_SECRETKEYBYTES + k] = seeds[j][NTRU_SAMPLE_FG_BYTES + k];
+                }
+
+                ASSERT_TRUE(ArraysMatch(pk_single, pk[i + j])) << "batch size " << n << ", key " << i + j;
+                ASSERT_TRUE(ArraysMatch(sk_single, sk[i + j])) << "batch size " << n << ", key " << i + j;
+            }
+        }
+    }
+}
+#endif
+#endif
+
+// Only some implementations provide the expanded public key API, api.h then defines the namespacing macros. Both
+// encapsulations restart the default RNG from the same seed, which the ChaCha20 benchmark RNG (NORAND) does not support
+#if defined(crypto_kem_enc_expanded) && !defined(NORAND)
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(pk_expand)(unsigned char *pk_expanded, const unsigned char *pk);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(enc_expanded)(unsigned char *c, unsigned char *k,
+                                                        const unsigned char *pk_expanded);
+
+TEST(TEST_NAME, shuffling_enc_expanded_matches_enc) {
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES], sk[CRYPTO_SECRETKEYBYTES];
+    unsigned char c[CRYPTO_CIPHERTEXTBYTES], c_expanded[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char k_enc[CRYPTO_BYTES], k_enc_expanded[CRYPTO_BYTES], k_dec[CRYPTO_BYTES];
+    unsigned char entropy_input[48] = {0};
+    // Read as 16-bit coefficients
+    static uint16_t pk_expanded[CRYPTO_PUBLICKEYEXPANDEDBYTES / 2];
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        entropy_input[0] = i;
+        randombytes_init(entropy_input, NULL, 256);
+
+        CRYPTO_NAMESPACE_SHUFFLING(keypair)(pk, sk);
+        CRYPTO_NAMESPACE_SHUFFLING(pk_expand)((unsigned char *)pk_expanded, pk);
+
+        for (int j = 0; j < ENC_DEC_REPETITIONS; j++) {
+            entropy_input[1] = j;
+
+            randombytes_init(entropy_input, NULL, 256);
+            CRYPTO_NAMESPACE_SHUFFLING(enc)(c, k_enc, pk);
+
+            randombytes_init(entropy_input, NULL, 256);
+            CRYPTO_NAMESPACE_SHUFFLING(enc_expanded)(c_expanded, k_enc_expanded, (unsigned char *)pk_expanded);
+
+            ASSERT_TRUE(ArraysMatch(c, c_expanded));
+            ASSERT_TRUE(ArraysMatch(k_enc, k_enc_expanded));
+
+            CRYPTO_NAMESPACE_SHUFFLING(dec)(k_dec, c_expanded, sk);
+
+            ASSERT_TRUE(ArraysMatch(k_enc_expanded, k_dec));
+        }
+    }
+}
+#endif
+
+// Only some implementations provide the expanded secret key API, api.h then defines the namespacing macros
+#ifdef crypto_kem_dec_expanded
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(sk_expand)(unsigned char *sk_expanded, const unsigned char *sk);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(dec_expanded)(unsigned char *k, const unsigned char *c,
+                                                        const unsigned char *sk_expanded);
+
+TEST(TEST_NAME, shuffling_dec_expanded_matches_dec) {
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES], sk[CRYPTO_SECRETKEYBYTES], c[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char k_enc[CRYPTO_BYTES], k_dec[CRYPTO_BYTES], k_dec_expanded[CRYPTO_BYTES];
+    unsigned char entropy_input[48] = {0};
+    // Read as 16-bit coefficients
+    static uint16_t sk_expanded[CRYPTO_SECRETKEYEXPANDEDBYTES / 2];
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        CRYPTO_NAMESPACE_SHUFFLING(keypair)(pk, sk);
+        CRYPTO_NAMESPACE_SHUFFLING(sk_expand)((unsigned char *)sk_expanded, sk);
+
+        for (int j = 0; j < ENC_DEC_REPETITIONS; j++) {
+            CRYPTO_NAMESPACE_SHUFFLING(enc)(c, k_enc, pk);
+
+            // Corrupt every other ciphertext, both must then take the implicit rejection path
+            if (j % 2) {
+                c[j] ^= 1;
+            }
+
+            CRYPTO_NAMESPACE_SHUFFLING(dec)(k_dec, c, sk);
+            CRYPTO_NAMESPACE_SHUFFLING(dec_expanded)(k_dec_expanded, c, (unsigned char *)sk_expanded);
+
+            ASSERT_TRUE(ArraysMatch(k_dec, k_dec_expanded));
+
+            if (j % 2) {
+                ASSERT_FALSE(ArraysMatch(k_enc, k_dec_expanded));
+            } else {
+                ASSERT_TRUE(ArraysMatch(k_enc, k_dec_expanded));
+            }
+        }
+    }
+}
+#endif
+
+// Only the dispatch libraries can change the poly_Rq_mul engine. Each engine restarts the default RNG from the same
+// seed, which the ChaCha20 benchmark RNG (NORAND) does not support
+#if defined(POLY_RQ_MUL_DISPATCH) && !defined(NORAND)
+extern "C" const char *CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_engine)(void);
+extern "C" const char *CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_engine_name)(size_t i);
+extern "C" int CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_set_engine)(const char *name);
+
+TEST(TEST_NAME, shuffling_engines_match_selected) {
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES], sk[CRYPTO_SECRETKEYBYTES], c[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char pk_engine[CRYPTO_PUBLICKEYBYTES], sk_engine[CRYPTO_SECRETKEYBYTES];
+    unsigned char c_engine[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char k_enc[CRYPTO_BYTES], k_enc_engine[CRYPTO_BYTES], k_dec[CRYPTO_BYTES];
+    unsigned char entropy_input[48] = {0};
+    const char *selected = CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_engine)();
+    const char *engine;
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    ASSERT_NE(CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_set_engine)("no such engine"), 0);
+
+    for (size_t e = 0; (engine = CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_engine_name)(e)) != NULL; e++) {
+        for (int i = 0; i < TEST_ITERATIONS; i++) {
+            entropy_input[0] = i;
+
+            CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_set_engine)(selected);
+            randombytes_init(entropy_input, NULL, 256);
+            CRYPTO_NAMESPACE_SHUFFLING(keypair)(pk, sk);
+            CRYPTO_NAMESPACE_SHUFFLING(enc)(c, k_enc, pk);
+
+            ASSERT_EQ(CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_set_engine)(engine), 0);
+            randombytes_init(entropy_input, NULL, 256);
+            CRYPTO_NAMESPACE_SHUFFLING(keypair)(pk_engine, sk_engine);
+            CRYPTO_NAMESPACE_SHUFFLING(enc)(c_engine, k_enc_engine, pk_engine);
+            CRYPTO_NAMESPACE_SHUFFLING(dec)(k_dec, c, sk_engine);
+
+            CRYPTO_NAMESPACE_SHUFFLING(poly_Rq_mul_set_engine)(selected);
+
+            ASSERT_TRUE(ArraysMatch(pk, pk_engine));
+            ASSERT_TRUE(ArraysMatch(sk, sk_engine));
+            ASSERT_TRUE(ArraysMatch(c, c_engine));
+            ASSERT_TRUE(ArraysMatch(k_enc, k_enc_engine));
+            ASSERT_TRUE(ArraysMatch(k_enc, k_dec));
+        }
+    }
+}
+#endif
@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include "test.h"
+
+extern "C" {
+#include "poly.h"
+#include "rng.h"
+}
+
+// Checks the alternative engines of the NEON polynomial arithmetic (see poly.h) against the default ones and against a
+// schoolbook product. The engines are all compiled in, whichever one the build options select
+
+#define TEST_ITERATIONS 300
+
+static void init_rng(void) {
+    unsigned char entropy_input[48] = {0};
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+}
+
+// The i-th test input: a few edge cases, then polynomials with uniform coefficients in [0, modulus). The padding is zero
+static void test_poly(poly *r, int i, uint16_t modulus) {
+    unsigned char bytes[NTRU_N];
+
+    memset(r, 0, sizeof(*r));
+
+    switch (i) {
+        case 0:  // 1
+            r->coeffs[0] = 1;
+            break;
+        case 1:  // x
+            r->coeffs[1] = 1;
+            break;
+        case 2:  // x^(n-1), the coefficient that the reductions mod Phi_n fold into the others
+            r->coeffs[NTRU_N - 1] = 1;
+            break;
+        case 3:  // All coefficients at their largest value but the constant one
+            for (int j = 1; j < NTRU_N; j++) {
+                r->coeffs[j] = modulus - 1;
+            }
+            break;
+        default:
+            randombytes(bytes, sizeof(bytes));
+
+            for (int j = 0; j < NTRU_N; j++) {
+                r->coeffs[j] = bytes[j] % modulus;
+            }
+    }
+}
+
+// a * b mod (x^n - 1, modulus), then mod Phi_n, so that coefficient n - 1 is zero. modulus is 2 or 3
+static void schoolbook_mod_Phi_n(uint16_t r[NTRU_N], const poly *a, const poly *b, uint32_t modulus) {
+    uint32_t c[NTRU_N] = {0};
+
+    for (int i = 0; i < NTRU_N; i++) {
+        for (int j = 0; j < NTRU_N; j++) {
+            c[(i + j) % NTRU_N] += (uint32_t)(a->coeffs[i] % modulus) * (b->coeffs[j] % modulus);
+        }
+    }
+
+    for (int i = 0; i < NTRU_N; i++) {
+        r[i] = (c[i] + (modulus - 1) * (c[NTRU_N - 1] % modulus)) % modulus;
+    }
+}
+
+// The constant polynomial 1 mod Phi_n
+static void one_mod_Phi_n(uint16_t r[NTRU_N]) {
+    memset(r, 0, NTRU_N * sizeof(r[0]));
+    r[0] = 1;
+}
+
+TEST(TEST_NAME, R2_inv_clmul_matches_divstep) {
+    poly a, r_divstep, r_clmul;
+    uint16_t product[NTRU_N], one[NTRU_N];
+
+    init_rng();
+    one_mod_Phi_n(one);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        test_poly(&a, i, 2);
+
+        poly_R2_inv_divstep(&r_divstep, &a);
+        poly_R2_inv_clmul(&r_clmul, &a);
+
+        ASSERT_TRUE(ArraysMatch(r_divstep.coeffs, r_clmul.coeffs, NTRU_N)) << "Iteration " << i;
+
+        // Phi_n is irreducible mod 2, so every a that is nonzero mod Phi_n is invertible
+        schoolbook_mod_Phi_n(product, &a, &r_clmul, 2);
+
+        ASSERT_TRUE(ArraysMatch(one, product, NTRU_N)) << "Iteration " << i;
+    }
+}
+
+TEST(TEST_NAME, R2_inv_jumpdivstep_matches_divstep) {
+    poly a, r_divstep, r_jumpdivstep;
+    uint16_t product[NTRU_N], one[NTRU_N];
+
+    init_rng();
+    one_mod_Phi_n(one);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        test_poly(&a, i, 2);
+
+        poly_R2_inv_divstep(&r_divstep, &a);
+        poly_R2_inv_jumpdivstep(&r_jumpdivstep, &a);
+
+        ASSERT_TRUE(ArraysMatch(r_divstep.coeffs, r_jumpdivstep.coeffs, NTRU_N)) << "Iteration " << i;
+
+        schoolbook_mod_Phi_n(product, &a, &r_jumpdivstep, 2);
+
+        ASSERT_TRUE(ArraysMatch(one, product, NTRU_N)) << "Iteration " << i;
+    }
+}
+
+TEST(TEST_NAME, S3_inv_jumpdivstep_matches_divstep) {
+    poly a, r_divstep, r_jumpdivstep;
+    uint16_t product[NTRU_N], one[NTRU_N];
+
+    init_rng();
+    one_mod_Phi_n(one);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        test_poly(&a, i, 3);
+
+        poly_S3_inv_divstep(&r_divstep, &a);
+        poly_S3_inv_jumpdivstep(&r_jumpdivstep, &a);
+
+        ASSERT_TRUE(ArraysMatch(r_divstep.coeffs, r_jumpdivstep.coeffs, NTRU_N)) << "Iteration " << i;
+
+        // Phi_n is also irreducible mod 3
+        schoolbook_mod_Phi_n(product, &a, &r_jumpdivstep, 3);
+
+        ASSERT_TRUE(ArraysMatch(one, product, NTRU_N)) << "Iteration " << i;
+    }
+}
+
+TEST(TEST_NAME, S3_mul_bitsliced_matches_rq) {
+    poly a, b, r_rq, r_bitsliced;
+    uint16_t r_schoolbook[NTRU_N];
+
+    init_rng();
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        test_poly(&a, i, 3);
+        test_poly(&b, TEST_ITERATIONS - 1 - i, 3);
+
+        poly_S3_mul_rq(&r_rq, &a, &b);
+        poly_S3_mul_bitsliced(&r_bitsliced, &a, &b);
+        schoolbook_mod_Phi_n(r_schoolbook, &a, &b, 3);
+
+        ASSERT_TRUE(ArraysMatch(r_schoolbook, r_rq.coeffs, NTRU_N)) << "Iteration " << i;
+        ASSERT_TRUE(ArraysMatch(r_schoolbook, r_bitsliced.coeffs, NTRU_N)) << "Iteration " << i;
+    }
+}
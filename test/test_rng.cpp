@@ -8,6 +8,17 @@ extern "C" void opt_randombytes_init(unsigned char *entropy_input, unsigned char
                                      int security_strength);
 extern "C" int opt_randombytes(unsigned char *x, unsigned long long xlen);
 
+extern "C" {
+#include "rng.h"
+}
+
+extern "C" void nist_randombytes_ctx_init(randombytes_ctx_t *ctx, unsigned char *entropy_input,
+                                          unsigned char *personalization_string, int security_strength);
+extern "C" int nist_randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen);
+extern "C" void opt_randombytes_ctx_init(randombytes_ctx_t *ctx, unsigned char *entropy_input,
+                                         unsigned char *personalization_string, int security_strength);
+extern "C" int opt_randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen);
+
 // https://stackoverflow.com/a/48733150/523079
 template <typename T>
 class rng : public ::testing::Test {};
@@ -69,3 +80,81 @@ TYPED_TEST(rng, ref_matches_opt_2calls) {
 
     ASSERT_TRUE(ArraysMatch(xref, xopt));
 }
+
+TYPED_TEST(rng, ref_matches_opt_ctx_interleaved) {
+    static constexpr std::size_t len = TypeParam::value;
+    unsigned char entropy_input_a[48] = {0}, entropy_input_b[48] = {0};
+    // Static, since four 2 MiB buffers for the largest length would overflow the default stack
+    static unsigned char xref_a[2 * len], xref_b[2 * len], xopt_a[2 * len], xopt_b[2 * len];
+    randombytes_ctx_t ref_a, ref_b, opt_a, opt_b;
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input_a[i] = i;
+        entropy_input_b[i] = 48 + i;
+    }
+
+    // Two contexts advanced in lockstep must not disturb each other, nor the default state
+    nist_randombytes_init(entropy_input_b, NULL, 256);
+    opt_randombytes_init(entropy_input_b, NULL, 256);
+
+    nist_randombytes_ctx_init(&ref_a, entropy_input_a, NULL, 256);
+    nist_randombytes_ctx_init(&ref_b, entropy_input_b, NULL, 256);
+    opt_randombytes_ctx_init(&opt_a, entropy_input_a, NULL, 256);
+    opt_randombytes_ctx_init(&opt_b, entropy_input_b, NULL, 256);
+
+    nist_randombytes_ctx(&ref_a, xref_a, len);
+    nist_randombytes_ctx(&ref_b, xref_b, len);
+    nist_randombytes_ctx(&ref_a, &xref_a[len], len);
+    nist_randombytes_ctx(&ref_b, &xref_b[len], len);
+    opt_randombytes_ctx(&opt_b, xopt_b, len);
+    opt_randombytes_ctx(&opt_a, xopt_a, len);
+    opt_randombytes_ctx(&opt_b, &xopt_b[len], len);
+    opt_randombytes_ctx(&opt_a, &xopt_a[len], len);
+
+    ASSERT_TRUE(ArraysMatch(xref_a, xopt_a));
+    ASSERT_TRUE(ArraysMatch(xref_b, xopt_b));
+
+    nist_randombytes(xref_a, len);
+    nist_randombytes(&xref_a[len], len);
+    opt_randombytes(xopt_a, len);
+    opt_randombytes(&xopt_a[len], len);
+
+    ASSERT_TRUE(ArraysMatch(xref_a, xref_b));
+    ASSERT_TRUE(ArraysMatch(xopt_a, xopt_b));
+}
+
+// Every width of the optimized keystream (see rng_opt/aes256_ctr.h), forced through the NTRU_RNG_AES_WAYS override,
+// which is read again when a DRBG is seeded
+class rng_ways : public ::testing::TestWithParam<unsigned> {};
+
+TEST_P(rng_ways, ref_matches_opt_ctx) {
+    // Zero-length requests (which must still update the state), partial blocks, and a request whose 23 whole blocks
+    // leave some to every width below the selected one: 375 = 16 * (12 + 8 + 3) + 7
+    static const unsigned long long lens[] = {0, 7, 16, 0, 100, 375, 65539, 0, 1};
+    static unsigned char xref[65539], xopt[65539];
+    unsigned char entropy_input[48] = {0};
+    randombytes_ctx_t ref, opt;
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    ASSERT_EQ(setenv("NTRU_RNG_AES_WAYS", std::to_string(GetParam()).c_str(), 1), 0);
+
+    nist_randombytes_ctx_init(&ref, entropy_input, NULL, 256);
+    opt_randombytes_ctx_init(&opt, entropy_input, NULL, 256);
+
+    unsetenv("NTRU_RNG_AES_WAYS");
+
+    for (unsigned long long len : lens) {
+        ASSERT_EQ(nist_randombytes_ctx(&ref, xref, len), RNG_SUCCESS);
+        ASSERT_EQ(opt_randombytes_ctx(&opt, xopt, len), RNG_SUCCESS);
+
+        ASSERT_TRUE(ArraysMatch(xref, xopt, len)) << "after a request of " << len << " bytes";
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(rng, rng_ways, ::testing::Values(1u, 4u, 8u, 12u),
+                         [](const ::testing::TestParamInfo<unsigned> &info) {
+                             return std::to_string(info.param) + "_ways";
+                         });
@@ -6,21 +6,19 @@ extern "C" {
 #include "rng.h"
 }
 
-// Required to avoid linker errors, not used in tests
-extern "C" void ntru_ref_shuffling_sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]) {
-    (void)r;
-    (void)uniformbytes;
-}
-
-extern "C" void ntru_opt_shuffling_sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]) {
-    (void)r;
-    (void)uniformbytes;
-}
-
 extern "C" void ntru_ref_shuffling_sample_fixed_type(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES]);
 extern "C" void ntru_opt_shuffling_sample_fixed_type(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES]);
+extern "C" void ntru_opt_shuffling_sample_fixed_type_xN(poly *r[], const unsigned char *uniformbytes[], size_t n);
+extern "C" void ntru_ref_shuffling_sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]);
+extern "C" void ntru_opt_shuffling_sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]);
+extern "C" void ntru_ref_shuffling_sample_rm(poly *r, poly *m, const unsigned char uniformbytes[NTRU_SAMPLE_RM_BYTES]);
+extern "C" void ntru_ref_shuffling_sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+extern "C" void ntru_opt_shuffling_sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+extern "C" void ntru_ref_shuffling_sample_rm_stream(poly *r, poly *m, randombytes_ctx_t *ctx);
+extern "C" void ntru_opt_shuffling_sample_rm_stream(poly *r, poly *m, randombytes_ctx_t *ctx);
 
 #define TEST_ITERATIONS 10000
+#define TEST_MAX_BATCH 16
 
 TEST(TEST_NAME, ref_weights_match_expected) {
     poly r;
@@ -70,3 +68,121 @@ TEST(TEST_NAME, ref_matches_opt) {
         ASSERT_TRUE(ArraysMatch(r_ref.coeffs, r_opt.coeffs));
     }
 }
+
+TEST(TEST_NAME, ref_matches_opt_xN) {
+    poly r_ref, r_opt[TEST_MAX_BATCH], *r_opt_ptrs[TEST_MAX_BATCH];
+    unsigned char uniformbytes[TEST_MAX_BATCH][NTRU_SAMPLE_FT_BYTES], entropy_input[48] = {0};
+    const unsigned char *uniformbytes_ptrs[TEST_MAX_BATCH];
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    for (int j = 0; j < TEST_MAX_BATCH; j++) {
+        r_opt_ptrs[j] = &r_opt[j];
+        uniformbytes_ptrs[j] = uniformbytes[j];
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    for (int i = 0; i < TEST_ITERATIONS / TEST_MAX_BATCH; i++) {
+        // Cycle through all batch sizes, so that every combination of interleaving widths is exercised
+        size_t n = 1 + i % TEST_MAX_BATCH;
+
+        randombytes(&uniformbytes[0][0], n * NTRU_SAMPLE_FT_BYTES);
+
+        ntru_opt_shuffling_sample_fixed_type_xN(r_opt_ptrs, uniformbytes_ptrs, n);
+
+        for (size_t j = 0; j < n; j++) {
+            ntru_ref_shuffling_sample_fixed_type(&r_ref, uniformbytes[j]);
+
+            ASSERT_TRUE(ArraysMatch(r_ref.coeffs, r_opt[j].coeffs)) << "Iteration " << i << ", polynomial " << j;
+        }
+    }
+}
+
+TEST(TEST_NAME, ref_sample_iid_matches_opt) {
+    poly r_ref, r_opt;
+    unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES], entropy_input[48] = {0};
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_init(entropy_input, NULL, 256);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        randombytes(uniformbytes, sizeof(uniformbytes));
+
+        ntru_ref_shuffling_sample_iid(&r_ref, uniformbytes);
+        ntru_opt_shuffling_sample_iid(&r_opt, uniformbytes);
+
+        ASSERT_TRUE(ArraysMatch(r_ref.coeffs, r_opt.coeffs)) << "Iteration " << i;
+    }
+}
+
+// The ChaCha20 benchmark RNG (NORAND) has a single thread-local state and ignores the context
+#ifndef NORAND
+// The streaming samplers read the same bytes as randombytes_ctx would have returned, and leave the RNG in the same state
+TEST(TEST_NAME, stream_matches_buffered) {
+    poly r, r_ref, r_opt;
+    unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES], entropy_input[48] = {0};
+    randombytes_ctx_t ctx, ctx_ref, ctx_opt;
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_ctx_init(&ctx, entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx_ref, entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx_opt, entropy_input, NULL, 256);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        randombytes_ctx(&ctx, uniformbytes, sizeof(uniformbytes));
+        ntru_ref_shuffling_sample_fixed_type(&r, uniformbytes);
+
+        randombytes_stream_begin(&ctx_ref, sizeof(uniformbytes));
+        ntru_ref_shuffling_sample_fixed_type_stream(&r_ref, &ctx_ref, 0);
+        randombytes_stream_end(&ctx_ref);
+
+        randombytes_stream_begin(&ctx_opt, sizeof(uniformbytes));
+        ntru_opt_shuffling_sample_fixed_type_stream(&r_opt, &ctx_opt, 0);
+        randombytes_stream_end(&ctx_opt);
+
+        ASSERT_TRUE(ArraysMatch(r.coeffs, r_ref.coeffs)) << "Iteration " << i;
+        ASSERT_TRUE(ArraysMatch(r.coeffs, r_opt.coeffs)) << "Iteration " << i;
+    }
+}
+
+TEST(TEST_NAME, sample_rm_stream_matches_sample_rm) {
+    poly r, m, r_ref, m_ref, r_opt, m_opt;
+    unsigned char uniformbytes[NTRU_SAMPLE_RM_BYTES], entropy_input[48] = {0};
+    randombytes_ctx_t ctx, ctx_ref, ctx_opt;
+
+    for (int i = 0; i < 48; i++) {
+        entropy_input[i] = i;
+    }
+
+    randombytes_ctx_init(&ctx, entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx_ref, entropy_input, NULL, 256);
+    randombytes_ctx_init(&ctx_opt, entropy_input, NULL, 256);
+
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        randombytes_ctx(&ctx, uniformbytes, sizeof(uniformbytes));
+        ntru_ref_shuffling_sample_rm(&r, &m, uniformbytes);
+
+        randombytes_stream_begin(&ctx_ref, sizeof(uniformbytes));
+        ntru_ref_shuffling_sample_rm_stream(&r_ref, &m_ref, &ctx_ref);
+        randombytes_stream_end(&ctx_ref);
+
+        randombytes_stream_begin(&ctx_opt, sizeof(uniformbytes));
+        ntru_opt_shuffling_sample_rm_stream(&r_opt, &m_opt, &ctx_opt);
+        randombytes_stream_end(&ctx_opt);
+
+        ASSERT_TRUE(ArraysMatch(r.coeffs, r_ref.coeffs)) << "Iteration " << i;
+        ASSERT_TRUE(ArraysMatch(m.coeffs, m_ref.coeffs)) << "Iteration " << i;
+        ASSERT_TRUE(ArraysMatch(r.coeffs, r_opt.coeffs)) << "Iteration " << i;
+        ASSERT_TRUE(ArraysMatch(m.coeffs, m_opt.coeffs)) << "Iteration " << i;
+    }
+}
+#endif
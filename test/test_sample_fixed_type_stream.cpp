@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include "test.h"
+
+extern "C" {
+#include "poly.h"
+#include "rng.h"
+}
+
+extern "C" void ntru_ref_shuffling_sample_fixed_type(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES]);
+extern "C" void ntru_ref_shuffling_sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+extern "C" void ntru_opt_shuffling_sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+
+// The streaming samplers on crafted random numbers: this binary is not linked with an RNG, and the samplers read
+// uniformbytes through the randombytes_stream_read below
+static unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES];
+static unsigned long long max_read_end;
+
+extern "C" int randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset,
+                                       unsigned long long len) {
+    (void)ctx;
+
+    if (offset + len > max_read_end) {
+        max_read_end = offset + len;
+    }
+
+    if (len == 0 || offset + len > sizeof(uniformbytes)) {
+        // Let the test fail on max_read_end rather than write past out
+        max_read_end = ~0ULL;
+        return 0;
+    }
+
+    memcpy(out, uniformbytes + offset, len);
+
+    return 0;
+}
+
+static void set_u(int j, uint16_t value) {
+    uniformbytes[2 * j] = value & 0xff;
+    uniformbytes[2 * j + 1] = value >> 8;
+}
+
+// u[0] is rejected and so are all random numbers of the fixups but the last one, so that the fixup index reaches the
+// end of u[]. 0 is rejected at every position where 65536 mod s != 0, which holds for s = NTRU_N - 1, and 0xffff is
+// accepted everywhere
+static void fixups_up_to_last_u(void) {
+    memset(uniformbytes, 0, sizeof(uniformbytes));
+
+    for (int j = 1; j < NTRU_N - 1; j++) {
+        set_u(j, 0xffff);
+    }
+
+    set_u(NTRU_SAMPLE_FT_BYTES / 2 - 1, 0xffff);
+}
+
+TEST(TEST_NAME, fixups_reach_end_of_sample) {
+    poly r, r_ref, r_opt;
+
+    ASSERT_NE(0, 65536 % (NTRU_N - 1));
+
+    fixups_up_to_last_u();
+    ntru_ref_shuffling_sample_fixed_type(&r, uniformbytes);
+
+    max_read_end = 0;
+    ntru_ref_shuffling_sample_fixed_type_stream(&r_ref, NULL, 0);
+    EXPECT_EQ(2ULL * (NTRU_SAMPLE_FT_BYTES / 2), max_read_end);
+
+    max_read_end = 0;
+    ntru_opt_shuffling_sample_fixed_type_stream(&r_opt, NULL, 0);
+    EXPECT_EQ(2ULL * (NTRU_SAMPLE_FT_BYTES / 2), max_read_end);
+
+    ASSERT_TRUE(ArraysMatch(r.coeffs, r_ref.coeffs));
+    ASSERT_TRUE(ArraysMatch(r.coeffs, r_opt.coeffs));
+}
+
+// With u[] all zero, the fixups of the first position never succeed
+TEST(TEST_NAME, fixups_past_end_of_sample_abort) {
+    poly r;
+
+    memset(uniformbytes, 0, sizeof(uniformbytes));
+
+    EXPECT_DEATH(ntru_ref_shuffling_sample_fixed_type_stream(&r, NULL, 0), "ran out of random numbers");
+    EXPECT_DEATH(ntru_opt_shuffling_sample_fixed_type_stream(&r, NULL, 0), "ran out of random numbers");
+}
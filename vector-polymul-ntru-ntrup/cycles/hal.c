@@ -1,17 +1,369 @@
+#define _GNU_SOURCE
+
+#include <setjmp.h>
+#include <signal.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "hal.h"
 
-void hal_setup(const enum clock_mode clock)
-{
-  (void) clock;
-  //TODO figure out if we need to do someting here
+// Override the HAL_BACKEND and HAL_COUNTERS build options, e.g. NTRU_HAL_BACKEND=perf and
+// NTRU_HAL_COUNTERS=instructions,branch-misses
+#define HAL_BACKEND_ENV "NTRU_HAL_BACKEND"
+#define HAL_COUNTERS_ENV "NTRU_HAL_COUNTERS"
+
+#ifndef HAL_BACKEND
+#define HAL_BACKEND "auto"
+#endif
+
+#ifndef HAL_COUNTERS
+#define HAL_COUNTERS ""
+#endif
+
+#if defined(__aarch64__)
+static uint64_t pmccntr_get_time(void) {
+    uint64_t t;
+    __asm__ volatile("mrs %0, PMCCNTR_EL0" : "=r"(t));
+    return t;
+}
+
+static sigjmp_buf pmccntr_probe_env;
+
+static void pmccntr_probe_handler(int sig) {
+    (void)sig;
+    siglongjmp(pmccntr_probe_env, 1);
+}
+
+// Without the kernel module that enables userspace access, reading PMCCNTR_EL0 raises SIGILL; with it, the counter
+// may still be stopped
+static int pmccntr_init(void) {
+    struct sigaction action, old_action;
+    volatile int available = 0;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = pmccntr_probe_handler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGILL, &action, &old_action);
+
+    if (!sigsetjmp(pmccntr_probe_env, 1)) {
+        uint64_t t0 = pmccntr_get_time();
+        for (volatile int i = 0; i < 1000; i++) {
+        }
+        available = pmccntr_get_time() != t0;
+    }
+
+    sigaction(SIGILL, &old_action, NULL);
+
+    return available;
+}
+#endif
+
+#if defined(__x86_64__)
+static uint64_t rdtsc_get_time(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static int rdtsc_init(void) {
+    return 1;
+}
+#endif
+
+#ifdef __linux__
+static int perf_open(uint32_t type, uint64_t config, int group_fd, uint64_t read_format) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = read_format;
+    // Allowed with the default perf_event_paranoid of 2, and what the other backends count as well
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static int perf_cycles_fd = -1;
+
+static uint64_t perf_get_time(void) {
+    uint64_t t = 0;
+
+    if (read(perf_cycles_fd, &t, sizeof(t)) != sizeof(t)) {
+        return 0;
+    }
+
+    return t;
+}
+
+static int perf_init(void) {
+    if (perf_cycles_fd < 0) {
+        perf_cycles_fd = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1, 0);
+    }
+
+    return perf_cycles_fd >= 0;
+}
+
+#if defined(__x86_64__)
+// The page the kernel maps for the cycles event, from which the event can be read with rdpmc without a system call
+static struct perf_event_mmap_page *rdpmc_page;
+
+static uint64_t rdpmc_get_time(void) {
+    const volatile struct perf_event_mmap_page *page = rdpmc_page;
+    uint32_t seq, index, lo, hi;
+    uint64_t t;
+    int shift;
+
+    // The kernel updates index and offset under the seqlock when the event is rescheduled
+    do {
+        seq = page->lock;
+        __asm__ volatile("" ::: "memory");
+        index = page->index;
+        t = page->offset;
+
+        if (index != 0) {
+            __asm__ volatile("rdpmc" : "=a"(lo), "=d"(hi) : "c"(index - 1));
+            shift = 64 - page->pmc_width;
+            t += (uint64_t)((int64_t)((((uint64_t)hi << 32) | lo) << shift) >> shift);
+        }
+
+        __asm__ volatile("" ::: "memory");
+    } while (page->lock != seq);
+
+    return t;
+}
+
+static int rdpmc_init(void) {
+    void *page;
+
+    if (rdpmc_page != NULL) {
+        return 1;
+    }
+
+    if (!perf_init()) {
+        return 0;
+    }
+
+    page = mmap(NULL, (size_t)sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED, perf_cycles_fd, 0);
+
+    if (page == MAP_FAILED) {
+        return 0;
+    }
+
+    if (!((struct perf_event_mmap_page *)page)->cap_user_rdpmc) {
+        munmap(page, (size_t)sysconf(_SC_PAGESIZE));
+        return 0;
+    }
+
+    rdpmc_page = page;
+
+    return 1;
+}
+#endif
+#endif
+
+static uint64_t clock_get_time(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000 + (uint64_t)t.tv_nsec;
 }
 
-uint64_t hal_get_time()
-{
-  uint64_t t;
-  __asm__ volatile("mrs %0, PMCCNTR_EL0":"=r"(t));
-  return t;
+static int clock_init(void) {
+    return 1;
 }
 
+// In the order tried when the requested backend is not available
+static const struct {
+    const char *name;
+    int (*init)(void);
+    uint64_t (*get_time)(void);
+} backends[] = {
+#if defined(__aarch64__)
+    {"pmccntr", pmccntr_init, pmccntr_get_time},
+#endif
+#if defined(__x86_64__)
+    {"rdtsc", rdtsc_init, rdtsc_get_time},
+#endif
+#ifdef __linux__
+    {"perf", perf_init, perf_get_time},
+#if defined(__x86_64__)
+    {"rdpmc", rdpmc_init, rdpmc_get_time},
+#endif
+#endif
+    {"clock", clock_init, clock_get_time},
+};
 
+#define NUM_BACKENDS (sizeof(backends) / sizeof(backends[0]))
+
+static const struct {
+    const char *name;
+    uint64_t config;
+} counter_events[] = {
+#ifdef __linux__
+    {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache-misses", PERF_COUNT_HW_CACHE_MISSES},
+    {"branch-misses", PERF_COUNT_HW_BRANCH_MISSES},
+#endif
+};
+
+#define NUM_COUNTER_EVENTS (sizeof(counter_events) / sizeof(counter_events[0]))
+
+static uint64_t init_get_time(void);
+
+// Index into backends of the backend used by hal_get_time
+static size_t backend;
+static uint64_t (*get_time)(void) = init_get_time;
+
+static size_t num_counters;
+static const char *counter_names[HAL_MAX_COUNTERS];
+#ifdef __linux__
+// The counters form a group, read at once from the first one
+static int counters_fd = -1;
+#endif
+
+int hal_set_backend(const char *name) {
+    for (size_t i = 0; i < NUM_BACKENDS; i++) {
+        if (strcmp(backends[i].name, name) == 0) {
+            if (!backends[i].init()) {
+                return -1;
+            }
+
+            backend = i;
+            get_time = backends[i].get_time;
+
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+const char *hal_backend(void) {
+    if (get_time == init_get_time) {
+        hal_setup(CLOCK_BENCHMARK);
+    }
+
+    return backends[backend].name;
+}
+
+static void setup_backend(void) {
+    const char *requested = getenv(HAL_BACKEND_ENV);
+
+    if (requested == NULL || requested[0] == '\0') {
+        requested = HAL_BACKEND;
+    }
+
+    if (strcmp(requested, "auto") != 0) {
+        if (hal_set_backend(requested) == 0) {
+            return;
+        }
+
+        fprintf(stderr, "hal: backend %s is not available\n", requested);
+    }
+
+    for (size_t i = 0; i < NUM_BACKENDS; i++) {
+        if (hal_set_backend(backends[i].name) == 0) {
+            break;
+        }
+    }
+
+    if (strcmp(requested, "auto") != 0) {
+        fprintf(stderr, "hal: using backend %s instead\n", backends[backend].name);
+    }
+}
+
+static void setup_counters(void) {
+    const char *requested = getenv(HAL_COUNTERS_ENV);
+    char list[256], *name, *state;
+
+    if (requested == NULL) {
+        requested = HAL_COUNTERS;
+    }
+
+    snprintf(list, sizeof(list), "%s", requested);
+
+    for (name = strtok_r(list, ",", &state); name != NULL; name = strtok_r(NULL, ",", &state)) {
+        size_t i;
+
+        for (i = 0; i < NUM_COUNTER_EVENTS && strcmp(counter_events[i].name, name) != 0; i++) {
+        }
+
+        if (i == NUM_COUNTER_EVENTS || num_counters == HAL_MAX_COUNTERS) {
+            fprintf(stderr, "hal: counter %s is not available\n", name);
+            continue;
+        }
+
+#ifdef __linux__
+        int fd = perf_open(PERF_TYPE_HARDWARE, counter_events[i].config, counters_fd, PERF_FORMAT_GROUP);
+
+        if (fd < 0) {
+            fprintf(stderr, "hal: counter %s is not available\n", name);
+            continue;
+        }
+
+        if (counters_fd < 0) {
+            counters_fd = fd;
+        }
+
+        counter_names[num_counters++] = counter_events[i].name;
+#endif
+    }
+}
+
+void hal_setup(const enum clock_mode clock) {
+    (void)clock;
+
+    if (get_time == init_get_time) {
+        setup_backend();
+        setup_counters();
+    }
+}
+
+// Before main, so that the probes of the backends are not timed
+__attribute__((constructor)) static void hal_init(void) {
+    hal_setup(CLOCK_BENCHMARK);
+}
+
+// In case hal_get_time is called by another constructor before hal_init
+static uint64_t init_get_time(void) {
+    hal_setup(CLOCK_BENCHMARK);
+    return get_time();
+}
+
+uint64_t hal_get_time(void) {
+    return get_time();
+}
+
+size_t hal_num_counters(void) {
+    return num_counters;
+}
+
+const char *hal_counter_name(size_t i) {
+    return counter_names[i];
+}
+
+void hal_get_counters(uint64_t values[HAL_MAX_COUNTERS]) {
+#ifdef __linux__
+    // The number of counters followed by their values
+    uint64_t group[1 + HAL_MAX_COUNTERS];
+
+    if (num_counters == 0 || read(counters_fd, group, (1 + num_counters) * sizeof(uint64_t)) <= 0) {
+        return;
+    }
+
+    memcpy(values, &group[1], num_counters * sizeof(uint64_t));
+#else
+    (void)values;
+#endif
+}
@@ -9,9 +9,26 @@ enum clock_mode {
     CLOCK_BENCHMARK
 };
 
+// The maximum number of extra counters (see hal_get_counters)
+#define HAL_MAX_COUNTERS 3
+
 void hal_setup(const enum clock_mode clock);
 uint64_t hal_get_time(void);
 
-#endif
+// The backend of hal_get_time: pmccntr (aarch64, needs userspace access to PMCCNTR_EL0), perf (Linux
+// perf_event_open, read with a system call), rdtsc and rdpmc (x86-64; rdpmc also needs perf_event_open), or clock
+// (clock_gettime, in nanoseconds instead of cycles). It is chosen before main from the HAL_BACKEND build option, or
+// the NTRU_HAL_BACKEND environment variable when set, and falls back to the first available one otherwise
+const char *hal_backend(void);
+// Returns 0 if the backend is available and now used by hal_get_time, -1 otherwise
+int hal_set_backend(const char *name);
 
+// Extra hardware counters read with perf_event_open on Linux, independently of the backend: a comma-separated list
+// of instructions, cache-misses and branch-misses, from the HAL_COUNTERS build option or the NTRU_HAL_COUNTERS
+// environment variable. Counters that cannot be opened are left out
+size_t hal_num_counters(void);
+const char *hal_counter_name(size_t i);
+void hal_get_counters(uint64_t values[HAL_MAX_COUNTERS]);
+
+#endif
 
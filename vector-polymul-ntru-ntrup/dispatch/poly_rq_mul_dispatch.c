@@ -0,0 +1,155 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__) && defined(__aarch64__)
+#include <sys/auxv.h>
+
+#ifndef HWCAP_CPUID
+#define HWCAP_CPUID (1 << 11)
+#endif
+#endif
+
+#include "poly.h"
+
+// poly_Rq_mul of a dispatch library: the KEM code is the CCHY23 TMVP one, whose polynomials have room for the
+// operands and products of all the multipliers of the parameter set, and each product is computed by the
+// poly_Rq_mul of one of the NG21 and CCHY23 libraries linked in, the engines. The engine is chosen before main from
+// the core the process starts on. poly_Rq_expand and poly_Rq_mul_expanded keep the CCHY23 TMVP multiplier, so that
+// the layout of the expanded keys does not depend on the core
+
+// Overrides the choice of the engine, e.g. NTRU_POLY_RQ_MUL_ENGINE=CCHY23_tc
+#define POLY_RQ_MUL_ENGINE_ENV "NTRU_POLY_RQ_MUL_ENGINE"
+
+// poly_rq_mul_engines.h is generated by CMake, with one ENGINE(name, library) line per engine
+#define ENGINE(name, library) void library##_poly_Rq_mul(poly *r, poly *a, poly *b);
+#include "poly_rq_mul_engines.h"
+#undef ENGINE
+
+static const struct {
+    const char *name;
+    void (*mul)(poly *r, poly *a, poly *b);
+} engines[] = {
+#define ENGINE(name, library) {#name, library##_poly_Rq_mul},
+#include "poly_rq_mul_engines.h"
+#undef ENGINE
+};
+
+#define NUM_ENGINES (sizeof(engines) / sizeof(engines[0]))
+
+enum core {
+    CORE_GENERIC,
+    CORE_A53,
+    CORE_A57,
+    CORE_A72,
+    CORE_APPLE,
+    NUM_CORES
+};
+
+#if defined(__linux__) && defined(__aarch64__)
+// Implementer and part number fields of MIDR_EL1 of the Cortex-A cores in speed_results_*
+static const struct {
+    uint32_t implementer, part;
+    enum core core;
+} core_midrs[] = {
+    {0x41, 0xd03, CORE_A53},
+    {0x41, 0xd07, CORE_A57},
+    {0x41, 0xd08, CORE_A72},
+};
+#endif
+
+// Engines from the fastest, after the KEM timings in speed_results_*. On the Cortex-A cores these are NG21 for
+// ntruhps2048509 and ntruhps4096821 and CCHY23 TMVP for ntruhps2048677 and ntruhrss701, on Apple cores the AMX
+// multipliers. Engines that are not linked in (AMX outside macOS, CCHY23 TC for ntruhrss701) are skipped
+#if NTRU_N == 677 || NTRU_N == 701
+#define NEON_ENGINES "CCHY23_tmvp", "NG21_neon", "CCHY23_tc"
+#define AMX_ENGINES "CCHY23_amx", "NG21_amx"
+#else
+#define NEON_ENGINES "NG21_neon", "CCHY23_tmvp", "CCHY23_tc"
+#define AMX_ENGINES "NG21_amx"
+#endif
+
+#define MAX_PREFERENCES 6
+
+static const char *const core_preferences[NUM_CORES][MAX_PREFERENCES] = {
+    [CORE_GENERIC] = {NEON_ENGINES},
+    [CORE_A53] = {NEON_ENGINES},
+    [CORE_A57] = {NEON_ENGINES},
+    [CORE_A72] = {NEON_ENGINES},
+    [CORE_APPLE] = {AMX_ENGINES, NEON_ENGINES},
+};
+
+// Index into engines of the engine used by poly_Rq_mul
+static size_t engine;
+
+static enum core detect_core(void) {
+#if defined(__APPLE__)
+    return CORE_APPLE;
+#elif defined(__linux__) && defined(__aarch64__)
+    uint64_t midr;
+
+    if (!(getauxval(AT_HWCAP) & HWCAP_CPUID)) {
+        return CORE_GENERIC;
+    }
+
+    // Trapped and emulated by the kernel when HWCAP_CPUID is set. On big.LITTLE systems this is the core the
+    // constructor happens to run on
+    __asm__ volatile("mrs %0, midr_el1" : "=r"(midr));
+
+    uint32_t implementer = (midr >> 24) & 0xff, part = (midr >> 4) & 0xfff;
+
+    // Apple cores under Linux
+    if (implementer == 0x61) {
+        return CORE_APPLE;
+    }
+
+    for (size_t i = 0; i < sizeof(core_midrs) / sizeof(core_midrs[0]); i++) {
+        if (core_midrs[i].implementer == implementer && core_midrs[i].part == part) {
+            return core_midrs[i].core;
+        }
+    }
+
+    return CORE_GENERIC;
+#else
+    return CORE_GENERIC;
+#endif
+}
+
+const char *poly_Rq_mul_engine(void) {
+    return engines[engine].name;
+}
+
+const char *poly_Rq_mul_engine_name(size_t i) {
+    return i < NUM_ENGINES ? engines[i].name : NULL;
+}
+
+int poly_Rq_mul_set_engine(const char *name) {
+    for (size_t i = 0; i < NUM_ENGINES; i++) {
+        if (strcmp(engines[i].name, name) == 0) {
+            engine = i;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+// Runs before main (and before any thread can multiply), so the engine is never changed concurrently with a call
+__attribute__((constructor)) static void poly_Rq_mul_select(void) {
+    const char *env = getenv(POLY_RQ_MUL_ENGINE_ENV);
+    const char *const *preferences = core_preferences[detect_core()];
+
+    if (env != NULL && poly_Rq_mul_set_engine(env) == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < MAX_PREFERENCES && preferences[i] != NULL; i++) {
+        if (poly_Rq_mul_set_engine(preferences[i]) == 0) {
+            return;
+        }
+    }
+}
+
+void poly_Rq_mul(poly *r, poly *a, poly *b) {
+    engines[engine].mul(r, a, b);
+}
@@ -0,0 +1,458 @@
+/* Lane-parallel SHA3-256, see fips202.c for the scalar version. The Keccak states of 2 (or 4) messages are kept in
+ * 128-bit (or 256-bit) vectors, one lane per message, using the GCC/Clang vector extensions.
+ *
+ * A 2-way permutation only beats two scalar ones with a 3-input XOR and a fused rotate-XOR, so it is used on Armv8.2-A
+ * cores with the SHA3 extension (EOR3, RAX1, XAR and BCAX) and on x86-64 with AVX2. The 4-way permutation is used with
+ * AVX2; on Arm sha3_256_x4 runs two 2-way permutations. Elsewhere both functions fall back to scalar sha3_256.
+ *
+ * When the compiler targets a baseline without these extensions, the vector kernels are still built (with a target
+ * attribute) and selected at load time if the CPU supports them, so that a single build of ntru_common serves all
+ * cores. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "fips202.h"
+#include "fips202x.h"
+
+#if defined(__ARM_NEON) && defined(__ARM_FEATURE_SHA3)
+#include <arm_neon.h>
+#define KECCAK_X2
+#elif defined(__aarch64__) && defined(__linux__) && \
+    ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 10) || (defined(__clang__) && __clang_major__ >= 16))
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#define KECCAK_X2
+#define KECCAK_DISPATCH
+#ifdef __clang__
+#define KECCAK_TARGET __attribute__((target("sha3")))
+#else
+#define KECCAK_TARGET __attribute__((target("arch=armv8.2-a+sha3")))
+#endif
+#ifndef HWCAP_SHA3
+#define HWCAP_SHA3 (1 << 17)
+#endif
+#define KECCAK_SUPPORTED() ((getauxval(AT_HWCAP) & HWCAP_SHA3) != 0)
+#elif defined(__AVX2__)
+#define KECCAK_X2
+#define KECCAK_X4
+#elif defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define KECCAK_X2
+#define KECCAK_X4
+#define KECCAK_DISPATCH
+#define KECCAK_TARGET __attribute__((target("avx2")))
+/* __builtin_cpu_init must be called explicitly from constructors */
+#define KECCAK_SUPPORTED() (__builtin_cpu_init(), __builtin_cpu_supports("avx2"))
+#endif
+
+#ifndef KECCAK_TARGET
+#define KECCAK_TARGET
+#endif
+
+#ifdef BENCH_HASH
+#define ACC fips202_cycles
+
+#define TIME0 fips202x_time0
+#define TIME1 fips202x_time1
+
+extern uint64_t ACC;
+uint64_t TIME0, TIME1;
+
+
+#ifdef __APPLE__
+#include "m1cycles.h"
+#define GET_TIME rdtsc()
+#else
+#include "hal.h"
+#define GET_TIME hal_get_time()
+#endif
+
+#define BENCH_INIT() { TIME0 = GET_TIME;}
+#define BENCH_TAIL() { TIME1 = GET_TIME; ACC += TIME1 - TIME0;}
+
+#else
+
+#define BENCH_INIT() {}
+#define BENCH_TAIL() {}
+
+#endif
+
+#if defined(KECCAK_X2)
+
+#define NROUNDS 24
+
+#ifdef __ARM_NEON
+typedef uint64x2_t keccakx2_t;
+#else
+typedef uint64_t keccakx2_t __attribute__((vector_size(16)));
+#endif
+
+#ifdef KECCAK_X4
+typedef uint64_t keccakx4_t __attribute__((vector_size(32)));
+#endif
+
+/* Keccak round constants */
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+  (uint64_t)0x0000000000000001ULL,
+  (uint64_t)0x0000000000008082ULL,
+  (uint64_t)0x800000000000808aULL,
+  (uint64_t)0x8000000080008000ULL,
+  (uint64_t)0x000000000000808bULL,
+  (uint64_t)0x0000000080000001ULL,
+  (uint64_t)0x8000000080008081ULL,
+  (uint64_t)0x8000000000008009ULL,
+  (uint64_t)0x000000000000008aULL,
+  (uint64_t)0x0000000000000088ULL,
+  (uint64_t)0x0000000080008009ULL,
+  (uint64_t)0x000000008000000aULL,
+  (uint64_t)0x000000008000808bULL,
+  (uint64_t)0x800000000000008bULL,
+  (uint64_t)0x8000000000008089ULL,
+  (uint64_t)0x8000000000008003ULL,
+  (uint64_t)0x8000000000008002ULL,
+  (uint64_t)0x8000000000000080ULL,
+  (uint64_t)0x000000000000800aULL,
+  (uint64_t)0x800000008000000aULL,
+  (uint64_t)0x8000000080008081ULL,
+  (uint64_t)0x8000000000008080ULL,
+  (uint64_t)0x0000000080000001ULL,
+  (uint64_t)0x8000000080008008ULL
+};
+
+/*************************************************
+* Name:        KECCAKF1600_STATEPERMUTE_X
+*
+* Description: Defines NAME, the Keccak F1600 permutation on a state of vectors of type T,
+*              in terms of the operations
+*                VXOR3(a, b, c):  a ^ b ^ c
+*                VRAX1(a, b):     a ^ ROL(b, 1)
+*                VXAR(a, b, n):   ROL(a ^ b, n), with 0 < n < 64
+*                VBCAX(a, b, c):  a ^ (b & ~c)
+*              which must be defined where the permutation is instantiated
+**************************************************/
+#define KECCAKF1600_STATEPERMUTE_X(NAME, T)                                           \
+static KECCAK_TARGET void NAME(T s[25])                                               \
+{                                                                                     \
+  int round;                                                                          \
+  T C0, C1, C2, C3, C4, D0, D1, D2, D3, D4;                                           \
+  T B[25];                                                                            \
+                                                                                      \
+  for(round = 0; round < NROUNDS; round++) {                                          \
+    C0 = VXOR3(VXOR3(s[0], s[5], s[10]), s[15], s[20]);                               \
+    C1 = VXOR3(VXOR3(s[1], s[6], s[11]), s[16], s[21]);                               \
+    C2 = VXOR3(VXOR3(s[2], s[7], s[12]), s[17], s[22]);                               \
+    C3 = VXOR3(VXOR3(s[3], s[8], s[13]), s[18], s[23]);                               \
+    C4 = VXOR3(VXOR3(s[4], s[9], s[14]), s[19], s[24]);                               \
+    D0 = VRAX1(C4, C1);                                                               \
+    D1 = VRAX1(C0, C2);                                                               \
+    D2 = VRAX1(C1, C3);                                                               \
+    D3 = VRAX1(C2, C4);                                                               \
+    D4 = VRAX1(C3, C0);                                                               \
+                                                                                      \
+    B[ 0] = s[ 0] ^ D0;                                                               \
+    B[10] = VXAR(s[ 1], D1,  1);                                                      \
+    B[20] = VXAR(s[ 2], D2, 62);                                                      \
+    B[ 5] = VXAR(s[ 3], D3, 28);                                                      \
+    B[15] = VXAR(s[ 4], D4, 27);                                                      \
+    B[16] = VXAR(s[ 5], D0, 36);                                                      \
+    B[ 1] = VXAR(s[ 6], D1, 44);                                                      \
+    B[11] = VXAR(s[ 7], D2,  6);                                                      \
+    B[21] = VXAR(s[ 8], D3, 55);                                                      \
+    B[ 6] = VXAR(s[ 9], D4, 20);                                                      \
+    B[ 7] = VXAR(s[10], D0,  3);                                                      \
+    B[17] = VXAR(s[11], D1, 10);                                                      \
+    B[ 2] = VXAR(s[12], D2, 43);                                                      \
+    B[12] = VXAR(s[13], D3, 25);                                                      \
+    B[22] = VXAR(s[14], D4, 39);                                                      \
+    B[23] = VXAR(s[15], D0, 41);                                                      \
+    B[ 8] = VXAR(s[16], D1, 45);                                                      \
+    B[18] = VXAR(s[17], D2, 15);                                                      \
+    B[ 3] = VXAR(s[18], D3, 21);                                                      \
+    B[13] = VXAR(s[19], D4,  8);                                                      \
+    B[14] = VXAR(s[20], D0, 18);                                                      \
+    B[24] = VXAR(s[21], D1,  2);                                                      \
+    B[ 9] = VXAR(s[22], D2, 61);                                                      \
+    B[19] = VXAR(s[23], D3, 56);                                                      \
+    B[ 4] = VXAR(s[24], D4, 14);                                                      \
+                                                                                      \
+    s[ 0] = VBCAX(B[ 0], B[ 2], B[ 1]);                                               \
+    s[ 1] = VBCAX(B[ 1], B[ 3], B[ 2]);                                               \
+    s[ 2] = VBCAX(B[ 2], B[ 4], B[ 3]);                                               \
+    s[ 3] = VBCAX(B[ 3], B[ 0], B[ 4]);                                               \
+    s[ 4] = VBCAX(B[ 4], B[ 1], B[ 0]);                                               \
+    s[ 5] = VBCAX(B[ 5], B[ 7], B[ 6]);                                               \
+    s[ 6] = VBCAX(B[ 6], B[ 8], B[ 7]);                                               \
+    s[ 7] = VBCAX(B[ 7], B[ 9], B[ 8]);                                               \
+    s[ 8] = VBCAX(B[ 8], B[ 5], B[ 9]);                                               \
+    s[ 9] = VBCAX(B[ 9], B[ 6], B[ 5]);                                               \
+    s[10] = VBCAX(B[10], B[12], B[11]);                                               \
+    s[11] = VBCAX(B[11], B[13], B[12]);                                               \
+    s[12] = VBCAX(B[12], B[14], B[13]);                                               \
+    s[13] = VBCAX(B[13], B[10], B[14]);                                               \
+    s[14] = VBCAX(B[14], B[11], B[10]);                                               \
+    s[15] = VBCAX(B[15], B[17], B[16]);                                               \
+    s[16] = VBCAX(B[16], B[18], B[17]);                                               \
+    s[17] = VBCAX(B[17], B[19], B[18]);                                               \
+    s[18] = VBCAX(B[18], B[15], B[19]);                                               \
+    s[19] = VBCAX(B[19], B[16], B[15]);                                               \
+    s[20] = VBCAX(B[20], B[22], B[21]);                                               \
+    s[21] = VBCAX(B[21], B[23], B[22]);                                               \
+    s[22] = VBCAX(B[22], B[24], B[23]);                                               \
+    s[23] = VBCAX(B[23], B[20], B[24]);                                               \
+    s[24] = VBCAX(B[24], B[21], B[20]);                                               \
+    s[ 0] ^= KeccakF_RoundConstants[round];                                           \
+  }                                                                                   \
+}
+
+#define VROL(a, offset) (((a) << (offset)) ^ ((a) >> (64-(offset))))
+
+#ifdef __ARM_NEON
+#define VXOR3(a, b, c) veor3q_u64(a, b, c)
+#define VRAX1(a, b) vrax1q_u64(a, b)
+#define VXAR(a, b, n) vxarq_u64(a, b, 64-(n))
+#define VBCAX(a, b, c) vbcaxq_u64(a, b, c)
+#else
+#define VXOR3(a, b, c) ((a) ^ (b) ^ (c))
+#define VRAX1(a, b) ((a) ^ VROL(b, 1))
+#define VXAR(a, b, n) VROL((a) ^ (b), n)
+#define VBCAX(a, b, c) ((a) ^ ((b) & ~(c)))
+#endif
+
+KECCAKF1600_STATEPERMUTE_X(KeccakF1600_StatePermute_x2, keccakx2_t)
+
+#ifdef KECCAK_X4
+KECCAKF1600_STATEPERMUTE_X(KeccakF1600_StatePermute_x4, keccakx4_t)
+#endif
+
+/*************************************************
+* Name:        load64
+*
+* Description: Load 8 bytes into uint64_t in little-endian order
+*
+* Arguments:   - const uint8_t *x: pointer to input byte array
+*
+* Returns the loaded 64-bit unsigned integer
+**************************************************/
+static uint64_t load64(const uint8_t x[8]) {
+  unsigned int i;
+  uint64_t r = 0;
+
+  for(i=0;i<8;i++)
+    r |= (uint64_t)x[i] << 8*i;
+
+  return r;
+}
+
+/*************************************************
+* Name:        store64
+*
+* Description: Store a 64-bit integer to array of 8 bytes in little-endian order
+*
+* Arguments:   - uint8_t *x: pointer to the output byte array (allocated)
+*              - uint64_t u: input 64-bit unsigned integer
+**************************************************/
+static void store64(uint8_t x[8], uint64_t u) {
+  unsigned int i;
+
+  for(i=0;i<8;i++)
+    x[i] = u >> 8*i;
+}
+
+/*************************************************
+* Name:        sha3_256_block
+*
+* Description: Loads block number blk of a SHA3-256 message into the rate words of a Keccak
+*              state. All blocks but the last one are full; the last one holds the remaining
+*              bytes, the domain-separation byte and the padding.
+*
+* Arguments:   - uint64_t *t: pointer to the output rate words (SHA3_256_RATE/8 words)
+*              - const uint8_t *in: pointer to the message
+*              - size_t inlen: length of the message in bytes
+*              - size_t blk: index of the block
+**************************************************/
+static void sha3_256_block(uint64_t t[SHA3_256_RATE/8], const uint8_t *in, size_t inlen, size_t blk)
+{
+  unsigned int i;
+
+  in += blk*SHA3_256_RATE;
+  inlen -= blk*SHA3_256_RATE;
+
+  if(inlen >= SHA3_256_RATE) {
+    for(i=0;i<SHA3_256_RATE/8;i++)
+      t[i] = load64(in+8*i);
+    return;
+  }
+
+  for(i=0;i<SHA3_256_RATE/8;i++)
+    t[i] = 0;
+  for(i=0;i<inlen;i++)
+    t[i/8] ^= (uint64_t)in[i] << 8*(i%8);
+
+  t[i/8] ^= (uint64_t)0x06 << 8*(i%8);
+  t[(SHA3_256_RATE-1)/8] ^= 1ULL << 63;
+}
+
+/*************************************************
+* Name:        sha3_256_x2_vec
+*
+* Description: SHA3-256 of two messages, which may have different lengths.
+*              Lane j of the state absorbs message j; once its last block has
+*              been permuted its hash is extracted and the lane is left idle.
+*
+* Arguments:   - uint8_t *h0, *h1: pointers to the outputs (32 bytes each)
+*              - const uint8_t *in0, *in1: pointers to the inputs
+*              - size_t inlen0, inlen1: lengths of the inputs in bytes
+**************************************************/
+static KECCAK_TARGET void sha3_256_x2_vec(uint8_t h0[32], uint8_t h1[32],
+                                          const uint8_t *in0, size_t inlen0,
+                                          const uint8_t *in1, size_t inlen1)
+{
+  BENCH_INIT();
+  unsigned int i, j;
+  size_t blk, nblocks[2];
+  uint8_t *h[2];
+  const uint8_t *in[2];
+  size_t inlen[2];
+  uint64_t t[SHA3_256_RATE/8];
+  keccakx2_t s[25];
+
+  h[0] = h0; h[1] = h1;
+  in[0] = in0; in[1] = in1;
+  inlen[0] = inlen0; inlen[1] = inlen1;
+
+  for(j=0;j<2;j++)
+    nblocks[j] = inlen[j]/SHA3_256_RATE + 1;
+
+  memset(s, 0, sizeof(s));
+
+  for(blk=0; blk < nblocks[0] || blk < nblocks[1]; blk++) {
+    for(j=0;j<2;j++) {
+      if(blk < nblocks[j]) {
+        sha3_256_block(t, in[j], inlen[j], blk);
+        for(i=0;i<SHA3_256_RATE/8;i++)
+          s[i][j] ^= t[i];
+      }
+    }
+
+    KeccakF1600_StatePermute_x2(s);
+
+    for(j=0;j<2;j++)
+      if(blk == nblocks[j]-1)
+        for(i=0;i<4;i++)
+          store64(h[j]+8*i, s[i][j]);
+  }
+  BENCH_TAIL();
+}
+
+#endif
+
+#ifdef KECCAK_X4
+
+/*************************************************
+* Name:        sha3_256_x4_vec
+*
+* Description: SHA3-256 of four messages of the same length
+*
+* Arguments:   - uint8_t *h0, ..., *h3: pointers to the outputs (32 bytes each)
+*              - const uint8_t *in0, ..., *in3: pointers to the inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+static KECCAK_TARGET void sha3_256_x4_vec(uint8_t h0[32], uint8_t h1[32], uint8_t h2[32], uint8_t h3[32],
+                                          const uint8_t *in0, const uint8_t *in1, const uint8_t *in2,
+                                          const uint8_t *in3, size_t inlen)
+{
+  BENCH_INIT();
+  unsigned int i, j;
+  size_t blk, nblocks;
+  uint8_t *h[4];
+  const uint8_t *in[4];
+  uint64_t t[SHA3_256_RATE/8];
+  keccakx4_t s[25];
+
+  h[0] = h0; h[1] = h1; h[2] = h2; h[3] = h3;
+  in[0] = in0; in[1] = in1; in[2] = in2; in[3] = in3;
+
+  nblocks = inlen/SHA3_256_RATE + 1;
+
+  memset(s, 0, sizeof(s));
+
+  for(blk=0;blk<nblocks;blk++) {
+    for(j=0;j<4;j++) {
+      sha3_256_block(t, in[j], inlen, blk);
+      for(i=0;i<SHA3_256_RATE/8;i++)
+        s[i][j] ^= t[i];
+    }
+
+    KeccakF1600_StatePermute_x4(s);
+  }
+
+  for(j=0;j<4;j++)
+    for(i=0;i<4;i++)
+      store64(h[j]+8*i, s[i][j]);
+  BENCH_TAIL();
+}
+
+#endif
+
+#if !defined(KECCAK_X2) || defined(KECCAK_DISPATCH)
+static void sha3_256_x2_scalar(uint8_t h0[32], uint8_t h1[32],
+                               const uint8_t *in0, size_t inlen0,
+                               const uint8_t *in1, size_t inlen1)
+{
+  sha3_256(h0, in0, inlen0);
+  sha3_256(h1, in1, inlen1);
+}
+#endif
+
+#if !defined(KECCAK_X4) || defined(KECCAK_DISPATCH)
+static void sha3_256_x4_pairs(uint8_t h0[32], uint8_t h1[32], uint8_t h2[32], uint8_t h3[32],
+                              const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3,
+                              size_t inlen)
+{
+  sha3_256_x2(h0, h1, in0, inlen, in1, inlen);
+  sha3_256_x2(h2, h3, in2, inlen, in3, inlen);
+}
+#endif
+
+#if defined(KECCAK_DISPATCH)
+
+static void (*sha3_256_x2_impl)(uint8_t *, uint8_t *, const uint8_t *, size_t, const uint8_t *, size_t) =
+  sha3_256_x2_scalar;
+static void (*sha3_256_x4_impl)(uint8_t *, uint8_t *, uint8_t *, uint8_t *,
+                                const uint8_t *, const uint8_t *, const uint8_t *, const uint8_t *, size_t) =
+  sha3_256_x4_pairs;
+
+/* Runs before main (and before any thread can hash), so the pointers are never written concurrently with a call */
+__attribute__((constructor)) static void sha3_256_x_select(void)
+{
+  if(KECCAK_SUPPORTED()) {
+    sha3_256_x2_impl = sha3_256_x2_vec;
+#ifdef KECCAK_X4
+    sha3_256_x4_impl = sha3_256_x4_vec;
+#endif
+  }
+}
+
+#elif defined(KECCAK_X4)
+#define sha3_256_x2_impl sha3_256_x2_vec
+#define sha3_256_x4_impl sha3_256_x4_vec
+#elif defined(KECCAK_X2)
+#define sha3_256_x2_impl sha3_256_x2_vec
+#define sha3_256_x4_impl sha3_256_x4_pairs
+#else
+#define sha3_256_x2_impl sha3_256_x2_scalar
+#define sha3_256_x4_impl sha3_256_x4_pairs
+#endif
+
+void sha3_256_x2(uint8_t h0[32], uint8_t h1[32],
+                 const uint8_t *in0, size_t inlen0,
+                 const uint8_t *in1, size_t inlen1)
+{
+  sha3_256_x2_impl(h0, h1, in0, inlen0, in1, inlen1);
+}
+
+void sha3_256_x4(uint8_t h0[32], uint8_t h1[32], uint8_t h2[32], uint8_t h3[32],
+                 const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3, size_t inlen)
+{
+  sha3_256_x4_impl(h0, h1, h2, h3, in0, in1, in2, in3, inlen);
+}
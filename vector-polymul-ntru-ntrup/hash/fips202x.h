@@ -0,0 +1,15 @@
+#ifndef FIPS202X_H
+#define FIPS202X_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* SHA3-256 of 2 or 4 independent messages, computed with one lane-parallel Keccak-f[1600] per message block.
+ * The messages of sha3_256_x2 may have different lengths; the outputs must not overlap any input. */
+void sha3_256_x2(uint8_t h0[32], uint8_t h1[32],
+                 const uint8_t *in0, size_t inlen0,
+                 const uint8_t *in1, size_t inlen1);
+void sha3_256_x4(uint8_t h0[32], uint8_t h1[32], uint8_t h2[32], uint8_t h3[32],
+                 const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3, size_t inlen);
+
+#endif
@@ -0,0 +1 @@
+../aarch64_tmvp/api.h
\ No newline at end of file
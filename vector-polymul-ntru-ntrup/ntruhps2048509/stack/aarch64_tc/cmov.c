@@ -0,0 +1 @@
+../aarch64_tmvp/cmov.c
\ No newline at end of file
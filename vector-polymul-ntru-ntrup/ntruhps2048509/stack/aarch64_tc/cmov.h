@@ -0,0 +1 @@
+../aarch64_tmvp/cmov.h
\ No newline at end of file
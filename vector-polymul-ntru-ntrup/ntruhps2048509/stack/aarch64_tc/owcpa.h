@@ -0,0 +1 @@
+../aarch64_tmvp/owcpa.h
\ No newline at end of file
@@ -0,0 +1 @@
+../aarch64_tmvp/poly_lift.c
\ No newline at end of file
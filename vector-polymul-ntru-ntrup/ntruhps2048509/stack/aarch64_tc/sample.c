@@ -0,0 +1 @@
+../aarch64_tmvp/sample.c
\ No newline at end of file
@@ -0,0 +1 @@
+../aarch64_tmvp/sample.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../speed/speed_stack.c
\ No newline at end of file
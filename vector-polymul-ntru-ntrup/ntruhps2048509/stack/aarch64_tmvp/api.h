@@ -0,0 +1,62 @@
+#ifndef API_H
+#define API_H
+
+#include <stdint.h>
+
+#define CRYPTO_SECRETKEYBYTES 935
+#define CRYPTO_PUBLICKEYBYTES 699
+#define CRYPTO_CIPHERTEXTBYTES 699
+#define CRYPTO_BYTES 32
+#define CRYPTO_PUBLICKEYEXPANDEDBYTES 16800
+#define CRYPTO_SECRETKEYEXPANDEDBYTES 50432
+
+#define CRYPTO_ALGNAME "ntruhps2048509"
+
+// Modified in NTRU-AMX to match PQC-NEON
+#define crypto_kem_keypair CRYPTO_NAMESPACE(keypair)
+int crypto_kem_keypair(uint8_t *pk, uint8_t *sk);
+
+#define crypto_kem_enc CRYPTO_NAMESPACE(enc)
+int crypto_kem_enc(uint8_t *c, uint8_t *k, const uint8_t *pk);
+
+#define crypto_kem_dec CRYPTO_NAMESPACE(dec)
+int crypto_kem_dec(uint8_t *k, const uint8_t *c, const uint8_t *sk);
+
+// Variants of crypto_kem_keypair and crypto_kem_enc that draw random bytes from a caller-owned RNG state (see
+// randombytes_ctx); a NULL ctx selects the calling thread's default state. Decapsulation uses no randomness. The
+// mmap (AMX) builds keep their scratch polynomials in process-wide buffers, so no KEM call is thread-safe there,
+// with or without a context.
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+#define crypto_kem_keypair_ctx CRYPTO_NAMESPACE(keypair_ctx)
+int crypto_kem_keypair_ctx(randombytes_ctx_t *ctx, uint8_t *pk, uint8_t *sk);
+
+#define crypto_kem_enc_ctx CRYPTO_NAMESPACE(enc_ctx)
+int crypto_kem_enc_ctx(randombytes_ctx_t *ctx, uint8_t *c, uint8_t *k, const uint8_t *pk);
+
+// Encapsulation against a public key prepared once with crypto_kem_pk_expand, which unpacks it and evaluates it for
+// the polynomial multiplier. The CRYPTO_PUBLICKEYEXPANDEDBYTES buffer is read as 16-bit coefficients and must be
+// 2-byte aligned; its layout is specific to the implementation and is not meant to be stored or transmitted.
+// crypto_kem_enc_expanded_ctx draws its random bytes from ctx, as crypto_kem_enc_ctx does.
+#define crypto_kem_pk_expand CRYPTO_NAMESPACE(pk_expand)
+int crypto_kem_pk_expand(uint8_t *pk_expanded, const uint8_t *pk);
+
+#define crypto_kem_enc_expanded CRYPTO_NAMESPACE(enc_expanded)
+int crypto_kem_enc_expanded(uint8_t *c, uint8_t *k, const uint8_t *pk_expanded);
+
+#define crypto_kem_enc_expanded_ctx CRYPTO_NAMESPACE(enc_expanded_ctx)
+int crypto_kem_enc_expanded_ctx(randombytes_ctx_t *ctx, uint8_t *c, uint8_t *k, const uint8_t *pk_expanded);
+
+// Decapsulation with a secret key prepared once with crypto_kem_sk_expand, which unpacks f, 1/f mod 3 and 1/h mod q
+// and evaluates them for the polynomial multiplier. The same alignment and layout caveats as for the expanded
+// public key apply to the CRYPTO_SECRETKEYEXPANDEDBYTES buffer, which must be kept as secret as sk.
+#define crypto_kem_sk_expand CRYPTO_NAMESPACE(sk_expand)
+int crypto_kem_sk_expand(uint8_t *sk_expanded, const uint8_t *sk);
+
+#define crypto_kem_dec_expanded CRYPTO_NAMESPACE(dec_expanded)
+int crypto_kem_dec_expanded(uint8_t *k, const uint8_t *c, const uint8_t *sk_expanded);
+
+#endif
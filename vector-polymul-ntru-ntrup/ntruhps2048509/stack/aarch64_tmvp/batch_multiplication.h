@@ -0,0 +1,10 @@
+#ifndef BATCH_MULTIPLICATION_H
+#define BATCH_MULTIPLICATION_H
+
+#include <stdint.h>
+
+void tmvp2_8x8(uint16_t *restrict c_in_mem, uint16_t *restrict a_in_mem);
+
+#endif
+
+
@@ -0,0 +1,95 @@
+#ifndef POLY_H
+#define POLY_H
+
+#include "params.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MODQ(X) ((X) & (NTRU_Q-1))
+
+typedef struct {
+    // The dispatch libraries also pass their polynomials to the CCHY23 TC multiplier, which declares them 32-byte aligned
+#ifdef POLY_RQ_MUL_DISPATCH
+    uint16_t coeffs[POLY_N] __attribute__((aligned(32)));
+#else
+    uint16_t coeffs[POLY_N];
+#endif
+} poly;
+
+// A multiplicand of poly_Rq_mul in the evaluated form of the multiplier
+// (7 toeplitz matrices of tmvp33 after ittc4, ittc3 and ittc32, 1200 coefficients each)
+#define NTRU_N_EXPANDED 8400
+
+typedef struct {
+    uint16_t coeffs[NTRU_N_EXPANDED];
+} poly_expanded;
+
+#define poly_mod_3_Phi_n CRYPTO_NAMESPACE(poly_mod_3_Phi_n)
+#define poly_mod_q_Phi_n CRYPTO_NAMESPACE(poly_mod_q_Phi_n)
+void poly_mod_3_Phi_n(poly *r);
+void poly_mod_q_Phi_n(poly *r);
+
+#define poly_Sq_tobytes CRYPTO_NAMESPACE(poly_Sq_tobytes)
+#define poly_Sq_frombytes CRYPTO_NAMESPACE(poly_Sq_frombytes)
+void poly_Sq_tobytes(unsigned char *r, const poly *a);
+void poly_Sq_frombytes(poly *r, const unsigned char *a);
+
+#define poly_Rq_sum_zero_tobytes CRYPTO_NAMESPACE(poly_Rq_sum_zero_tobytes)
+#define poly_Rq_sum_zero_frombytes CRYPTO_NAMESPACE(poly_Rq_sum_zero_frombytes)
+void poly_Rq_sum_zero_tobytes(unsigned char *r, const poly *a);
+void poly_Rq_sum_zero_frombytes(poly *r, const unsigned char *a);
+
+#define poly_S3_tobytes CRYPTO_NAMESPACE(poly_S3_tobytes)
+#define poly_S3_frombytes CRYPTO_NAMESPACE(poly_S3_frombytes)
+void poly_S3_tobytes(unsigned char msg[NTRU_PACK_TRINARY_BYTES], const poly *a);
+void poly_S3_frombytes(poly *r, const unsigned char msg[NTRU_PACK_TRINARY_BYTES]);
+
+// void poly_Signed_Sq_mul(poly *r, const poly *a, const poly *b);
+void poly_Signed_Rq_mul(poly *r, const poly *a, const poly *b);
+void poly_Signed_Rq_mul_get_G(int32_t G[3][512], poly *r, const poly *h, const poly *g);
+void poly_Signed_Rq_mul_with_G(poly *r, const poly *h, const int32_t G[3][512]);
+
+#define poly_S3_mul CRYPTO_NAMESPACE(poly_S3_mul)
+#define poly_lift CRYPTO_NAMESPACE(poly_lift)
+#define poly_Rq_to_S3 CRYPTO_NAMESPACE(poly_Rq_to_S3)
+void poly_S3_mul(poly *r, const poly *a, const poly *b);
+void poly_lift(poly *r, const poly *a);
+void poly_Rq_to_S3(poly *r, const poly *a);
+
+#define poly_Rq_mul CRYPTO_NAMESPACE(poly_Rq_mul)
+void poly_Rq_mul(poly *r, poly *a, poly *b);
+
+#ifdef POLY_RQ_MUL_DISPATCH
+// The engine poly_Rq_mul runs (see dispatch/poly_rq_mul_dispatch.c), the i-th engine linked in or NULL past the last
+// one, and a change of engine by name, which returns -1 if no such engine is linked in
+#define poly_Rq_mul_engine CRYPTO_NAMESPACE(poly_Rq_mul_engine)
+#define poly_Rq_mul_engine_name CRYPTO_NAMESPACE(poly_Rq_mul_engine_name)
+#define poly_Rq_mul_set_engine CRYPTO_NAMESPACE(poly_Rq_mul_set_engine)
+const char *poly_Rq_mul_engine(void);
+const char *poly_Rq_mul_engine_name(size_t i);
+int poly_Rq_mul_set_engine(const char *name);
+#endif
+
+// poly_Rq_mul(r, a, b) in two steps, so that the evaluation of a fixed b is done once
+#define poly_Rq_expand CRYPTO_NAMESPACE(poly_Rq_expand)
+#define poly_Rq_mul_expanded CRYPTO_NAMESPACE(poly_Rq_mul_expanded)
+void poly_Rq_expand(poly_expanded *r, poly *b);
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b);
+
+#define poly_R2_inv CRYPTO_NAMESPACE(poly_R2_inv)
+#define poly_Rq_inv CRYPTO_NAMESPACE(poly_Rq_inv)
+#define poly_S3_inv CRYPTO_NAMESPACE(poly_S3_inv)
+void poly_R2_inv(poly *r, const poly *a);
+void poly_Rq_inv(poly *r, const poly *a);
+void poly_S3_inv(poly *r, const poly *a);
+
+#define poly_Z3_to_SignedZ3 CRYPTO_NAMESPACE(poly_Z3_to_SignedZ3)
+#define poly_Z3_to_Zq CRYPTO_NAMESPACE(poly_Z3_to_Zq)
+#define poly_trinary_Zq_to_Z3 CRYPTO_NAMESPACE(poly_trinary_Zq_to_Z3)
+void poly_Z3_to_SignedZ3(poly *r);
+void poly_Z3_to_Zq(poly *r);
+void poly_trinary_Zq_to_Z3(poly *r);
+
+#endif
+
@@ -0,0 +1,85 @@
+#ifndef TMVP_H
+#define TMVP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "poly.h"
+
+// ensure TMVP_POLY_N <= POLY_N
+#define TMVP_POLY_N 576
+
+#define SB0 (TMVP_POLY_N / 4) // 144
+#define SB1 (SB0 / 3)        // 48
+#define SB2 (SB1 / 3)        // 16
+
+#define SB2_RES (2 * SB2) // 32  = 16*2, 32/16 = 2
+#define SB1_RES (2 * SB1) // 96  = 48*2, 96/16 = 6
+#define SB0_RES (2 * SB0) // 288 = 144*2, 288/16 = 18
+
+#define MASK (NTRU_Q - 1)
+
+#define inv3 43691
+#define inv5 52429
+#define inv7 28087
+#define inv9 36409
+#define inv15 61167
+
+#define inv49 22737
+#define inv35 44939
+#define inv45 20389
+#define inv75 51555
+#define inv525 7365
+#define inv105 36825
+#define inv225 17185
+#define inv315 12275
+#define inv25 23593
+
+void tmvp(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB);
+
+void ittc4(uint16_t *restrict w, uint16_t *restrict polynomial);
+void tc4(uint16_t *restrict w, uint16_t *restrict polynomial);
+void ttc4(uint16_t *restrict polynomial, uint16_t *restrict w);
+
+
+void ittc3(uint16_t *restrict w, uint16_t *restrict src);
+void ittc32(uint16_t *restrict w, uint16_t *restrict src);
+
+void tc33(uint16_t *restrict w, uint16_t *restrict src);
+void ttc33(uint16_t *restrict src, uint16_t *restrict w);
+
+void tmvp33(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *restrict polyB);
+
+// tmvp33 split into the evaluation of the toeplitz matrix and the rest, TMVP33_EXPANDED coefficients in between
+#define TMVP33_EXPANDED (5 * 5 * SB2 * 3)
+void tmvp33_expand(uint16_t *restrict toepa332, uint16_t *restrict toepA);
+void tmvp33_expanded(uint16_t *restrict polyC, const uint16_t *restrict toepa332, uint16_t *restrict polyB);
+
+#define SIZE_L (14 * SB0)
+#define SIZE_R (7 * SB0)
+#define SIZE_I (7 * SB0)
+
+#define F_L(des, src) ittc4(des, src)
+#define F_R(des, src) tc4(des, src)
+#define F_I(des, src) ttc4(des, src)
+#define F_MUL(des, srcL, srcR) { \
+    for(size_t i = 0; i < 7; i++){ \
+        tmvp33(des + i * SB0, srcL + 2 * i * SB0, srcR + i * SB0); \
+    } \
+}
+
+// F_MUL with the toeplitz matrices of F_L evaluated once by F_E
+#define SIZE_E (7 * TMVP33_EXPANDED)
+
+#define F_E(des, srcL) { \
+    for(size_t i = 0; i < 7; i++){ \
+        tmvp33_expand(des + i * TMVP33_EXPANDED, srcL + 2 * i * SB0); \
+    } \
+}
+#define F_MUL_E(des, srcE, srcR) { \
+    for(size_t i = 0; i < 7; i++){ \
+        tmvp33_expanded(des + i * SB0, srcE + i * TMVP33_EXPANDED, srcR + i * SB0); \
+    } \
+}
+
+#endif
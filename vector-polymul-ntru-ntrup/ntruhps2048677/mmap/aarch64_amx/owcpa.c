@@ -146,6 +146,34 @@ void owcpa_enc(unsigned char *c,
   poly_Rq_sum_zero_tobytes(c, ct);
 }
 
+void owcpa_pk_expand(poly_expanded *h,
+                     const unsigned char *pk)
+{
+  poly *b = h_enc;
+
+  poly_Rq_sum_zero_frombytes(b, pk);
+  poly_Rq_expand(h, b);
+}
+
+void owcpa_enc_expanded(unsigned char *c,
+                        const poly *r,
+                        const poly *m,
+                        const poly_expanded *h)
+{
+  int i;
+
+  poly *liftm = liftm_enc;
+  poly *ct = ct_enc;
+
+  poly_Rq_mul_expanded(ct, (poly*)r, h);
+
+  poly_lift(liftm, m);
+  for(i=0; i<NTRU_N; i++)
+    ct->coeffs[i] = ct->coeffs[i] + liftm->coeffs[i];
+
+  poly_Rq_sum_zero_tobytes(c, ct);
+}
+
 static poly *c_dec, *f_dec, *cf_dec, *mf_dec, *finv3_dec, *m_dec, *liftm_dec, *invh_dec, *r_dec, *b_dec;
 
 __attribute__((constructor)) static void alloc_dec(void) {
@@ -224,3 +252,82 @@ int owcpa_dec(unsigned char *rm,
 
   return fail;
 }
+
+void owcpa_sk_expand(poly_expanded sk[3],
+                     const unsigned char *secretkey)
+{
+  poly *f = f_dec, *finv3 = finv3_dec, *invh = invh_dec;
+
+  poly_S3_frombytes(f, secretkey);
+  poly_Z3_to_SignedZ3(f);
+  poly_Rq_expand(&sk[0], f);
+
+  poly_S3_frombytes(finv3, secretkey+NTRU_PACK_TRINARY_BYTES);
+  poly_Rq_expand(&sk[1], finv3);
+
+  poly_Sq_frombytes(invh, secretkey + 2 * NTRU_PACK_TRINARY_BYTES);
+  poly_Rq_expand(&sk[2], invh);
+}
+
+int owcpa_dec_expanded(unsigned char *rm,
+                       const unsigned char *ciphertext,
+                       const poly_expanded sk[3])
+{
+  int i;
+  int fail;
+
+  poly *c = c_dec, *cf = cf_dec;
+  poly *mf = mf_dec, *m = m_dec;
+  poly *liftm = liftm_dec, *r = r_dec;
+  poly *b = b_dec;
+
+  poly_Rq_sum_zero_frombytes(c, ciphertext);
+
+  poly_Rq_mul_expanded(cf, c, &sk[0]);
+  poly_Rq_to_S3(mf, cf);
+
+  poly_Rq_mul_expanded(m, mf, &sk[1]);
+  for (i = 0; i < NTRU_N; i++) {
+    m->coeffs[i] = MODQ(m->coeffs[i]);
+  }
+  poly_mod_3_Phi_n(m);
+  poly_S3_tobytes(rm+NTRU_PACK_TRINARY_BYTES, m);
+
+  fail = 0;
+
+  /* Check that the unused bits of the last byte of the ciphertext are zero */
+  fail |= owcpa_check_ciphertext(ciphertext);
+
+  /* For the IND-CCA2 KEM we must ensure that c = Enc(h, (r,m)).             */
+  /* We can avoid re-computing r*h + Lift(m) as long as we check that        */
+  /* r (defined as b/h mod (q, Phi_n)) and m are in the message space.       */
+  /* (m can take any value in S3 in NTRU_HRSS) */
+  fail |= owcpa_check_m(m);
+
+  /* b = c - Lift(m) mod (q, x^n - 1) */
+  poly_lift(liftm, m);
+  for(i=0; i<NTRU_N; i++)
+    b->coeffs[i] = MODQ(c->coeffs[i] - liftm->coeffs[i]);
+
+  /* r = b / h mod (q, Phi_n) */
+  poly_Rq_mul_expanded(r, b, &sk[2]);
+  poly_mod_q_Phi_n(r);
+
+  /* NOTE: Our definition of r as b/h mod (q, Phi_n) follows Figure 4 of     */
+  /*   [Sch18] https://eprint.iacr.org/2018/1174/20181203:032458.            */
+  /* This differs from Figure 10 of Saito--Xagawa--Yamakawa                  */
+  /*   [SXY17] https://eprint.iacr.org/2017/1005/20180516:055500             */
+  /* where r gets a final reduction modulo p.                                */
+  /* We need this change to use Proposition 1 of [Sch18].                    */
+
+  /* Proposition 1 of [Sch18] shows that re-encryption with (r,m) yields c.  */
+  /* if and only if fail==0 after the following call to owcpa_check_r        */
+  /* The procedure given in Fig. 8 of [Sch18] can be skipped because we have */
+  /* c(1) = 0 due to the use of poly_Rq_sum_zero_{to,from}bytes.             */
+  fail |= owcpa_check_r(r);
+
+  poly_trinary_Zq_to_Z3(r);
+  poly_S3_tobytes(rm, r);
+
+  return fail;
+}
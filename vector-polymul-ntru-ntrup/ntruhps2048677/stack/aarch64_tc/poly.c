@@ -59,6 +59,29 @@ void poly_Rq_mul(poly *r, poly *a, poly *b) {
     poly_mul_neon(r->coeffs, a->coeffs, b->coeffs);
 }
 
+void poly_Rq_expand(poly_expanded *r, poly *b) {
+    // 677, 678, 679
+    b->coeffs[NTRU_N] = 0;
+    b->coeffs[NTRU_N+1] = 0;
+    b->coeffs[NTRU_N+2] = 0;
+
+    /* initialization to 680-720 is omitted */
+
+    poly_neon_expand(r->coeffs, b->coeffs);
+}
+
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b) {
+    // 677, 678, 679
+    a->coeffs[NTRU_N] = 0;
+    a->coeffs[NTRU_N+1] = 0;
+    a->coeffs[NTRU_N+2] = 0;
+
+    /* initialization to 680-720 is omitted */
+
+    // Multiplication
+    poly_neon_mul_expanded(r->coeffs, a->coeffs, b->coeffs);
+}
+
 static void poly_R2_inv_to_Rq_inv(poly *r, const poly *ai, const poly *a) {
 
     poly b, c;
@@ -12,6 +12,14 @@ typedef struct {
     uint16_t coeffs[POLY_N] __attribute__((aligned(32)));
 } poly;
 
+// A multiplicand of poly_Rq_mul in the evaluated form of the multiplier
+// (9 tc5 parts evaluated by tc33, 400 coefficients each, then the k2 of all but the first 16)
+#define NTRU_N_EXPANDED 5392
+
+typedef struct {
+    uint16_t coeffs[NTRU_N_EXPANDED];
+} poly_expanded;
+
 #define poly_mod_3_Phi_n CRYPTO_NAMESPACE(poly_mod_3_Phi_n)
 #define poly_mod_q_Phi_n CRYPTO_NAMESPACE(poly_mod_q_Phi_n)
 void poly_mod_3_Phi_n(poly *r);
@@ -47,6 +55,12 @@ void poly_Rq_to_S3(poly *r, const poly *a);
 #define poly_Rq_mul CRYPTO_NAMESPACE(poly_Rq_mul)
 void poly_Rq_mul(poly *r, poly *a, poly *b);
 
+// poly_Rq_mul(r, a, b) in two steps, so that the evaluation of a fixed b is done once
+#define poly_Rq_expand CRYPTO_NAMESPACE(poly_Rq_expand)
+#define poly_Rq_mul_expanded CRYPTO_NAMESPACE(poly_Rq_mul_expanded)
+void poly_Rq_expand(poly_expanded *r, poly *b);
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b);
+
 #define poly_R2_inv CRYPTO_NAMESPACE(poly_R2_inv)
 #define poly_Rq_inv CRYPTO_NAMESPACE(poly_Rq_inv)
 #define poly_S3_inv CRYPTO_NAMESPACE(poly_S3_inv)
@@ -954,40 +954,39 @@ static void poly_neon_reduction(uint16_t *polynomial, uint16_t *tmp) {
     }
 }
 
-void tc33_mul(uint16_t *restrict polyC[9], uint16_t *restrict polyA[9], uint16_t *restrict polyB[9]) {
-    uint16_t tmp_aabb[9*SB2*50+224*8*2], tmp_cc[9*SB2_RES*25+224*32]; // 50, 25
-    uint16_t *tmp_aa = &tmp_aabb[9*SB2*0],
-             *tmp_bb = &tmp_aabb[9*SB2*25+224*8],
-             *tmp_aa1 = &tmp_aabb[9*SB2*25],
-             *tmp_bb1 = &tmp_aabb[9*SB2*50+224*8],
-             *tmp_cc1 = &tmp_cc[9*SB2_RES*25];
+/* B evaluated by tc33 (9*SB2*25) followed by its k2 (224*8), as schoolbook_8x8 expects */
+void tc33_expand(uint16_t *restrict polyE, uint16_t *restrict polyB[9]) {
+    uint16_t *tmp_bb = &polyE[0],
+             *tmp_bb1 = &polyE[9*SB2*25];
 
-    tc33(&tmp_aa[0*25*SB2], polyA[0]); /* 3.1k cycles, 3.1k/18 = 0.2k each */
     tc33(&tmp_bb[0*25*SB2], polyB[0]);
-
-    tc33(&tmp_aa[1*25*SB2], polyA[1]);
     tc33(&tmp_bb[1*25*SB2], polyB[1]);
-
-    tc33(&tmp_aa[2*25*SB2], polyA[2]);
     tc33(&tmp_bb[2*25*SB2], polyB[2]);
-
-    tc33(&tmp_aa[3*25*SB2], polyA[3]);
     tc33(&tmp_bb[3*25*SB2], polyB[3]);
-
-    tc33(&tmp_aa[4*25*SB2], polyA[4]);
     tc33(&tmp_bb[4*25*SB2], polyB[4]);
-
-    tc33(&tmp_aa[5*25*SB2], polyA[5]);
     tc33(&tmp_bb[5*25*SB2], polyB[5]);
-
-    tc33(&tmp_aa[6*25*SB2], polyA[6]);
     tc33(&tmp_bb[6*25*SB2], polyB[6]);
-
-    tc33(&tmp_aa[7*25*SB2], polyA[7]);
     tc33(&tmp_bb[7*25*SB2], polyB[7]);
+    tc33(&tmp_bb[8*25*SB2], polyB[8]);
+
+    k2(&tmp_bb1[0], &tmp_bb[16]);
+}
+
+void tc33_mul_expanded(uint16_t *restrict polyC[9], uint16_t *restrict polyA[9], const uint16_t *restrict polyE) {
+    uint16_t tmp_aa[9*SB2*25+224*8], tmp_cc[9*SB2_RES*25+224*32]; // 25, 25
+    uint16_t *tmp_bb = (uint16_t *)polyE,
+             *tmp_aa1 = &tmp_aa[9*SB2*25],
+             *tmp_cc1 = &tmp_cc[9*SB2_RES*25];
 
+    tc33(&tmp_aa[0*25*SB2], polyA[0]); /* 1.6k cycles, 1.6k/9 = 0.2k each */
+    tc33(&tmp_aa[1*25*SB2], polyA[1]);
+    tc33(&tmp_aa[2*25*SB2], polyA[2]);
+    tc33(&tmp_aa[3*25*SB2], polyA[3]);
+    tc33(&tmp_aa[4*25*SB2], polyA[4]);
+    tc33(&tmp_aa[5*25*SB2], polyA[5]);
+    tc33(&tmp_aa[6*25*SB2], polyA[6]);
+    tc33(&tmp_aa[7*25*SB2], polyA[7]);
     tc33(&tmp_aa[8*25*SB2], polyA[8]);
-    tc33(&tmp_bb[8*25*SB2], polyB[8]);
 
 /* Split 225 16x16 into 1 and 224 */
 
@@ -995,8 +994,7 @@ void tc33_mul(uint16_t *restrict polyC[9], uint16_t *restrict polyA[9], uint16_t
     schoolbook_16x16(&tmp_cc[0], &tmp_aa[0] , &tmp_bb[0]); /* without this function the whole code runs 0.5k cycles slower */
 
 //224x 16x16
-    k2(&tmp_aa1[0], &tmp_aa[16]); /* 1.5k cycles, 1.5k/2 = 0.7k each */
-    k2(&tmp_bb1[0], &tmp_bb[16]);
+    k2(&tmp_aa1[0], &tmp_aa[16]); /* 0.7k cycles */
     schoolbook_8x8(&tmp_cc[32], &tmp_aa[16], &tmp_bb[16]); /* 18k cycles */
     ik2(&tmp_cc[32], &tmp_cc1[0]); /* 2.4k cycles */
 
@@ -1012,6 +1010,13 @@ void tc33_mul(uint16_t *restrict polyC[9], uint16_t *restrict polyA[9], uint16_t
     itc33(polyC[8], &tmp_cc[8*25*SB2_RES]);
 }
 
+void tc33_mul(uint16_t *restrict polyC[9], uint16_t *restrict polyA[9], uint16_t *restrict polyB[9]) {
+    uint16_t tmp_bb[TC33_EXPANDED];
+
+    tc33_expand(tmp_bb, polyB);
+    tc33_mul_expanded(polyC, polyA, tmp_bb);
+}
+
 void poly_mul_neon(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB) {
     uint16_t *kaw[9], *kbw[9], *kcw[9];
     uint16_t tmp_ab[SB0 * 9 * 2];
@@ -1066,5 +1071,35 @@ void poly_mul_neon(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t
     poly_neon_reduction(polyC, tmp_ab); /* 0.4k cycles */
 }
 
+void poly_neon_expand(uint16_t *restrict polyE, uint16_t *restrict polyB) {
+    uint16_t *kbw[9];
+    uint16_t tmp_b[SB0 * 9];
 
+    for (int i = 0; i < 9; i++) {
+        kbw[i] = &tmp_b[i * SB0];
+    }
+
+    tc5(kbw, polyB); /* 0.6k cycles */
 
+    tc33_expand(polyE, kbw);
+}
+
+void poly_neon_mul_expanded(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict polyE) {
+    uint16_t *kaw[9], *kcw[9];
+    uint16_t tmp_a[SB0 * 9 * 2];
+    uint16_t tmp_c[SB0_RES * 9];
+
+    for (int i = 0; i < 9; i++) {
+        kaw[i] = &tmp_a[i * SB0];
+        kcw[i] = &tmp_c[i * SB0_RES];
+    }
+
+    tc5(kaw, polyA); /* 0.6k cycles */
+
+    tc33_mul_expanded(kcw, kaw, polyE);
+
+    itc5(tmp_a, kcw); /* 3.3k cycles */
+
+    // Ring reduction, Reduce from 1440 -> 720
+    poly_neon_reduction(polyC, tmp_a); /* 0.4k cycles */
+}
@@ -38,6 +38,10 @@ void schoolbook_16x16(uint16_t r[2 * 16], const uint16_t a[16], const uint16_t b
 
 void tc5(uint16_t *restrict w[9], uint16_t *restrict polynomial);
 void tc33_mul(uint16_t *restrict polyC[9], uint16_t *restrict polyA[9], uint16_t *restrict polyB[9]);
+// tc33_mul split into the evaluation of B and the rest, TC33_EXPANDED coefficients in between
+#define TC33_EXPANDED (9*SB2*25+224*8)
+void tc33_expand(uint16_t *restrict polyE, uint16_t *restrict polyB[9]);
+void tc33_mul_expanded(uint16_t *restrict polyC[9], uint16_t *restrict polyA[9], const uint16_t *restrict polyE);
 void tc33(uint16_t *restrict w, uint16_t *restrict src);
 void k2(uint16_t *restrict w, uint16_t *restrict src);
 void ik2(uint16_t *restrict w, uint16_t *restrict src);
@@ -45,6 +49,14 @@ void itc33(uint16_t *restrict dst, uint16_t *restrict w);
 void itc5(uint16_t *restrict polynomial, uint16_t *w[9]);
 
 
+// The stages of poly_mul_neon (see speed_polymul.c): the evaluation of an operand in TC_WAYS vectors of SB0
+// coefficients, tc33_mul and the interpolation of the TC_WAYS products of SB0_RES coefficients
+#define TC_WAYS 9
+#define F_EVAL(w, src) tc5(w, src)
+#define F_INTERP(dst, w) itc5(dst, w)
+
 void poly_mul_neon(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB);
+void poly_neon_expand(uint16_t *restrict polyE, uint16_t *restrict polyB);
+void poly_neon_mul_expanded(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict polyE);
 
 #endif
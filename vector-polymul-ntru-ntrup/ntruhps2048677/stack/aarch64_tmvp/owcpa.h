@@ -16,6 +16,28 @@ void owcpa_enc(unsigned char *c,
         const poly *m,
         const unsigned char *pk);
 
+// owcpa_enc split into the unpacking and evaluation of h, and the encryption with the result
+#define owcpa_pk_expand CRYPTO_NAMESPACE(owcpa_pk_expand)
+void owcpa_pk_expand(poly_expanded *h,
+        const unsigned char *pk);
+
+#define owcpa_enc_expanded CRYPTO_NAMESPACE(owcpa_enc_expanded)
+void owcpa_enc_expanded(unsigned char *c,
+        const poly *r,
+        const poly *m,
+        const poly_expanded *h);
+
+// owcpa_dec split into the unpacking and evaluation of f, finv3 and invh (in this order in sk), and the
+// decryption with the results
+#define owcpa_sk_expand CRYPTO_NAMESPACE(owcpa_sk_expand)
+void owcpa_sk_expand(poly_expanded sk[3],
+        const unsigned char *secretkey);
+
+#define owcpa_dec_expanded CRYPTO_NAMESPACE(owcpa_dec_expanded)
+int owcpa_dec_expanded(unsigned char *rm,
+        const unsigned char *ciphertext,
+        const poly_expanded sk[3]);
+
 #define owcpa_dec CRYPTO_NAMESPACE(owcpa_dec)
 int owcpa_dec(unsigned char *rm,
         const unsigned char *ciphertext,
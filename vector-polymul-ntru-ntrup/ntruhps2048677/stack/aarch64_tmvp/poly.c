@@ -61,6 +61,8 @@ void poly_S3_mul(poly *r, const poly *a, const poly *b) {
     poly_mod_3_Phi_n(r);
 }
 
+// Defined by dispatch/poly_rq_mul_dispatch.c in the dispatch libraries
+#ifndef POLY_RQ_MUL_DISPATCH
 void poly_Rq_mul(poly *r, poly *a, poly *b)
 {
     uint16_t coeffs_L[SIZE_L];
@@ -78,6 +80,30 @@ void poly_Rq_mul(poly *r, poly *a, poly *b)
     F_I(r->coeffs, coeffs_I);
 
 }
+#endif
+
+void poly_Rq_expand(poly_expanded *r, poly *b)
+{
+    uint16_t coeffs_L[SIZE_L];
+
+    F_L(coeffs_L, b->coeffs);
+    F_E(r->coeffs, coeffs_L);
+}
+
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b)
+{
+    uint16_t coeffs_R[SIZE_R];
+    uint16_t coeffs_I[SIZE_I];
+
+    // 677 - 679
+    a->coeffs[NTRU_N] = 0;
+    a->coeffs[NTRU_N+1] = 0;
+    a->coeffs[NTRU_N+2] = 0;
+
+    F_R(coeffs_R, a->coeffs);
+    F_MUL_E(coeffs_I, b->coeffs, coeffs_R);
+    F_I(r->coeffs, coeffs_I);
+}
 
 static void poly_R2_inv_to_Rq_inv(poly *r, const poly *ai, const poly *a) {
 
@@ -0,0 +1 @@
+../../../../PQC_NEON/neon/ntru/stack/neon-hps2048677/neon_sample_iid.c
\ No newline at end of file
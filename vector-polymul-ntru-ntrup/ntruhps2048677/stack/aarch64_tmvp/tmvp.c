@@ -1968,39 +1968,45 @@ schoolbook: 8*8 toeplitz matrix to vector -> tmvp2_combine
 output vector: tmvp33_combine
 */
 void tmvp33(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *restrict polyB) {
-    uint16_t toepa3[SB1 * 5 * 2]; // SB1 = 48
+    uint16_t toepa332[TMVP33_EXPANDED];
+
+    tmvp33_expand(toepa332, toepA);
+    tmvp33_expanded(polyC, toepa332, polyB);
+}
+
+void tmvp33_last(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *restrict polyB) {
+    uint16_t toepa332[TMVP33_EXPANDED];
 
-    uint16_t tmp[5 * 5 * SB2 * 4];
+    tmvp33_expand(toepa332, toepA);
+    tmvp33_last_expanded(polyC, toepa332, polyB);
+}
 
-    uint16_t *toepa332 = &tmp[5 * 5 * SB2 * 0];
-    uint16_t *kbcw = &tmp[5 * 5 * SB2 * 3];
+/*
+The toeplitz matrix part of tmvp33, it only depends on toepA.
+*/
+void tmvp33_expand(uint16_t *restrict toepa332, uint16_t *restrict toepA) {
+    uint16_t toepa3[SB1 * 5 * 2]; // SB1 = 48
 
     ittc3(toepa3, toepA); /* 1.8k cycles, 1.8k/9 = 0.2k each */
     ittc32(toepa332, toepa3); /* 5k cycles, 5k/9 = 0.5k each */
+}
+
+void tmvp33_expanded(uint16_t *restrict polyC, const uint16_t *restrict toepa332, uint16_t *restrict polyB) {
+    uint16_t kbcw[5 * 5 * SB2];
 
     tc33(kbcw, polyB); /* 1.3k cycles, 1.3k/9 = 0.1k each */
 
-    tmvp2_8x8(kbcw, toepa332); /* 12.6k cycles, 12.6k/9 = 1.4k each */
+    tmvp2_8x8(kbcw, (uint16_t *)toepa332); /* 12.6k cycles, 12.6k/9 = 1.4k each */
 
     ttc33(polyC, kbcw); /* 1.8k cycles, 1.8k/9 = 0.2k each */
 }
 
-void tmvp33_last(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *restrict polyB) {
-    uint16_t toepa3[SB1 * 5 * 2]; // SB1 = 48
-
-    uint16_t tmp[5 * 5 * SB2 * 4];
-
-    uint16_t *toepa332 = &tmp[5 * 5 * SB2 * 0];
-    uint16_t *kbcw = &tmp[5 * 5 * SB2 * 3];
-
-
-
-    ittc3(toepa3, toepA); /* 1.8k cycles, 1.8k/9 = 0.2k each */
-    ittc32(toepa332, toepa3); /* 5k cycles, 5k/9 = 0.5k each */
+void tmvp33_last_expanded(uint16_t *restrict polyC, const uint16_t *restrict toepa332, uint16_t *restrict polyB) {
+    uint16_t kbcw[5 * 5 * SB2];
 
     tc33(kbcw, polyB); /* 1.3k cycles, 1.3k/9 = 0.1k each */
 
-    tmvp2_8x8(kbcw, toepa332); /* 12.6k cycles, 12.6k/9 = 1.4k each */
+    tmvp2_8x8(kbcw, (uint16_t *)toepa332); /* 12.6k cycles, 12.6k/9 = 1.4k each */
 
 /* Let gcc know the last schoolbook is all zero */
     for(int i = 0; i < 16; i++){
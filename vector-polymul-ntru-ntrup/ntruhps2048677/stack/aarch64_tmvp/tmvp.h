@@ -52,6 +52,12 @@ void ttc33(uint16_t *restrict src, uint16_t *restrict w);
 void tmvp33(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *restrict polyB);
 void tmvp33_last(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *restrict polyB);
 
+// tmvp33 split into the evaluation of the toeplitz matrix and the rest, TMVP33_EXPANDED coefficients in between
+#define TMVP33_EXPANDED (5 * 5 * SB2 * 3)
+void tmvp33_expand(uint16_t *restrict toepa332, uint16_t *restrict toepA);
+void tmvp33_expanded(uint16_t *restrict polyC, const uint16_t *restrict toepa332, uint16_t *restrict polyB);
+void tmvp33_last_expanded(uint16_t *restrict polyC, const uint16_t *restrict toepa332, uint16_t *restrict polyB);
+
 #define SIZE_L (18 * SB0)
 #define SIZE_R (9 * SB0)
 #define SIZE_I (9 * SB0)
@@ -66,6 +72,21 @@ void tmvp33_last(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *r
     tmvp33_last(des + 8 * SB0, srcL + 2 * 8 * SB0, srcR + 8 * SB0); \
 }
 
+// F_MUL with the toeplitz matrices of F_L evaluated once by F_E
+#define SIZE_E (9 * TMVP33_EXPANDED)
+
+#define F_E(des, srcL) { \
+    for(size_t i = 0; i < 9; i++){ \
+        tmvp33_expand(des + i * TMVP33_EXPANDED, srcL + 2 * i * SB0); \
+    } \
+}
+#define F_MUL_E(des, srcE, srcR) { \
+    for(size_t i = 0; i < 8; i++){ \
+        tmvp33_expanded(des + i * SB0, srcE + i * TMVP33_EXPANDED, srcR + i * SB0); \
+    } \
+    tmvp33_last_expanded(des + 8 * SB0, srcE + 8 * TMVP33_EXPANDED, srcR + 8 * SB0); \
+}
+
 #endif
 
 
@@ -0,0 +1 @@
+../aarch64_tmvp/kem.c
\ No newline at end of file
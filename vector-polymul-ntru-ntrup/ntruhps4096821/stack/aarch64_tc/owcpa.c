@@ -0,0 +1 @@
+../aarch64_tmvp/owcpa.c
\ No newline at end of file
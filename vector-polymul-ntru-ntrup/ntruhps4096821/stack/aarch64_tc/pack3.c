@@ -0,0 +1 @@
+../aarch64_tmvp/pack3.c
\ No newline at end of file
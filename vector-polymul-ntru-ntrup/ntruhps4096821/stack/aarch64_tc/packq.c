@@ -0,0 +1 @@
+../aarch64_tmvp/packq.c
\ No newline at end of file
@@ -0,0 +1 @@
+../aarch64_tmvp/params.h
\ No newline at end of file
@@ -0,0 +1 @@
+../aarch64_tmvp/poly_mod.c
\ No newline at end of file
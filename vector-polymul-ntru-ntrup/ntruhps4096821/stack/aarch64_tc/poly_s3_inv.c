@@ -0,0 +1 @@
+../aarch64_tmvp/poly_s3_inv.c
\ No newline at end of file
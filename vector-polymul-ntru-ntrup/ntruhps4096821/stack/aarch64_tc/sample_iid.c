@@ -0,0 +1 @@
+../aarch64_tmvp/sample_iid.c
\ No newline at end of file
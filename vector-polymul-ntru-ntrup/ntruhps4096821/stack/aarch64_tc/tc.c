@@ -0,0 +1,830 @@
+#include <stdio.h>
+#include <arm_neon.h>
+#include "params.h"
+#include "poly.h"
+#include "batch_multiplication.h"
+
+#include "tc.h"
+
+void k2(uint16_t *restrict w, uint16_t *restrict src) {
+    for(int i = 0; i < TC33_PRODUCTS/4; i++) {
+        uint16x8x4_t a0, a1, a2;
+        a0.val[0] = vld1q_u16(&src[0]);     
+        a0.val[1] = vld1q_u16(&src[0] + 8); 
+        a0.val[2] = vld1q_u16(&src[0] + 16);
+        a0.val[3] = vld1q_u16(&src[0] + 24);
+        a2.val[0] = vld1q_u16(&src[32]);     
+        a2.val[1] = vld1q_u16(&src[32] + 8); 
+        a2.val[2] = vld1q_u16(&src[32] + 16);
+        a2.val[3] = vld1q_u16(&src[32] + 24);
+
+        a1.val[0] = vaddq_u16(a0.val[0], a0.val[1]);
+        a1.val[1] = vaddq_u16(a0.val[2], a0.val[3]);
+        a1.val[2] = vaddq_u16(a2.val[0], a2.val[1]);
+        a1.val[3] = vaddq_u16(a2.val[2], a2.val[3]);
+
+        vst1q_u16_x4(&w[0], a1);
+        src += 16*4;
+        w += 8*4;
+    }
+}
+
+
+void ik2(uint16_t *restrict w, uint16_t *restrict src) {
+    for(int i = 0; i < TC33_PRODUCTS/2; i++) {
+        uint16x8_t w0, w1, w2, w3;
+        w0 = vld1q_u16(&w[0]);
+        w1 = vld1q_u16(&w[8]);
+        w2 = vld1q_u16(&w[16]);
+        w3 = vld1q_u16(&w[24]);
+        uint16x8_t p0, p1;
+        p0 = vld1q_u16(&src[0]);
+        p1 = vld1q_u16(&src[8]);
+
+        p0 = vsubq_u16(p0, w0);
+        p0 = vsubq_u16(p0, w2);
+        p0 = vaddq_u16(p0, w1);
+
+        p1 = vsubq_u16(p1, w1);
+        p1 = vsubq_u16(p1, w3);
+        p1 = vaddq_u16(p1, w2);
+
+        vst1q_u16(&w[8], p0);
+        vst1q_u16(&w[16], p1);
+
+        uint16x8_t w01, w11, w21, w31;
+        w01 = vld1q_u16(&w[0+32]);
+        w11 = vld1q_u16(&w[8+32]);
+        w21 = vld1q_u16(&w[16+32]);
+        w31 = vld1q_u16(&w[24+32]);
+        uint16x8_t p01, p11;
+        p01 = vld1q_u16(&src[0+16]);
+        p11 = vld1q_u16(&src[8+16]);
+
+        p01 = vsubq_u16(p01, w01);
+        p01 = vsubq_u16(p01, w21);
+        p01 = vaddq_u16(p01, w11);
+
+        p11 = vsubq_u16(p11, w11);
+        p11 = vsubq_u16(p11, w31);
+        p11 = vaddq_u16(p11, w21);
+
+        vst1q_u16(&w[8+32], p01);
+        vst1q_u16(&w[16+32], p11);
+
+        src += 16*2;
+        w += 32*2;
+    }
+}
+
+
+void tc33(uint16_t *restrict w, uint16_t *restrict src) {
+    uint16_t *c0 = &src[0*SB2],
+             *c1 = &src[1*SB2],
+             *c2 = &src[2*SB2],
+             *c3 = &src[3*SB2],
+             *c4 = &src[4*SB2],
+             *c5 = &src[5*SB2],
+             *c6 = &src[6*SB2],
+             *c7 = &src[7*SB2],
+             *c8 = &src[8*SB2],
+             *w00 = &w[ 0*SB2],
+             *w01 = &w[ 1*SB2],
+             *w02 = &w[ 2*SB2],
+             *w03 = &w[ 3*SB2],
+             *w04 = &w[ 4*SB2],
+             *w05 = &w[ 5*SB2],
+             *w06 = &w[ 6*SB2],
+             *w07 = &w[ 7*SB2],
+             *w08 = &w[ 8*SB2],
+             *w09 = &w[ 9*SB2],
+             *w10 = &w[10*SB2],
+             *w11 = &w[11*SB2],
+             *w12 = &w[12*SB2],
+             *w13 = &w[13*SB2],
+             *w14 = &w[14*SB2],
+             *w15 = &w[15*SB2],
+             *w16 = &w[16*SB2],
+             *w17 = &w[17*SB2],
+             *w18 = &w[18*SB2],
+             *w19 = &w[19*SB2],
+             *w20 = &w[20*SB2],
+             *w21 = &w[21*SB2],
+             *w22 = &w[22*SB2],
+             *w23 = &w[23*SB2],
+             *w24 = &w[24*SB2];
+    // Utilize 22 SIMD registers
+    uint16x8_t a0, a1, a2, a3, a4, a5, a6, a7, a8, //9
+               tmp0, tmp1, tmp2, tmp3, // 4
+               s0, s1, s2, // 3
+               e0, e1, e2, // 3
+               t0, t1, t2; // 3
+    for (uint16_t addr = 0; addr < SB2; addr+=8) {
+        a0 = vld1q_u16(&c0[addr]);
+        a1 = vld1q_u16(&c1[addr]);
+        a2 = vld1q_u16(&c2[addr]);
+        a3 = vld1q_u16(&c3[addr]);
+        a4 = vld1q_u16(&c4[addr]);
+        a5 = vld1q_u16(&c5[addr]);
+        a6 = vld1q_u16(&c6[addr]);
+        a7 = vld1q_u16(&c7[addr]);
+        a8 = vld1q_u16(&c8[addr]);
+
+        tmp0 = vaddq_u16(a2, a0);
+        tmp1 = vaddq_u16(tmp0, a1);
+        tmp2 = vsubq_u16(tmp0, a1);
+        tmp3 = vaddq_u16(tmp2, a2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, a0);
+
+        vst1q_u16(&w00[addr], a0);
+        vst1q_u16(&w01[addr], tmp1);
+        vst1q_u16(&w02[addr], tmp2);
+        vst1q_u16(&w03[addr], tmp3);
+        vst1q_u16(&w04[addr], a2);
+
+        tmp0 = vaddq_u16(a8, a6);
+        tmp1 = vaddq_u16(tmp0, a7);
+        tmp2 = vsubq_u16(tmp0, a7);
+        tmp3 = vaddq_u16(tmp2, a8);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, a6);
+
+        vst1q_u16(&w20[addr], a6);
+        vst1q_u16(&w21[addr], tmp1);
+        vst1q_u16(&w22[addr], tmp2);
+        vst1q_u16(&w23[addr], tmp3);
+        vst1q_u16(&w24[addr], a8);
+
+        s0 = vaddq_u16(a0, a6);
+        s1 = vaddq_u16(a1, a7);
+        s2 = vaddq_u16(a2, a8);
+
+        e0 = vaddq_u16(s0, a3);
+        e1 = vaddq_u16(s1, a4);
+        e2 = vaddq_u16(s2, a5);
+
+        tmp0 = vaddq_u16(e2, e0);
+        tmp1 = vaddq_u16(tmp0, e1);
+        tmp2 = vsubq_u16(tmp0, e1);
+        tmp3 = vaddq_u16(tmp2, e2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, e0);
+
+        vst1q_u16(&w05[addr], e0);
+        vst1q_u16(&w06[addr], tmp1);
+        vst1q_u16(&w07[addr], tmp2);
+        vst1q_u16(&w08[addr], tmp3);
+        vst1q_u16(&w09[addr], e2);
+
+        e0 = vsubq_u16(s0, a3);
+        e1 = vsubq_u16(s1, a4);
+        e2 = vsubq_u16(s2, a5);
+
+        tmp0 = vaddq_u16(e2, e0);
+        tmp1 = vaddq_u16(tmp0, e1);
+        tmp2 = vsubq_u16(tmp0, e1);
+        tmp3 = vaddq_u16(tmp2, e2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, e0);
+
+        vst1q_u16(&w10[addr], e0);
+        vst1q_u16(&w11[addr], tmp1);
+        vst1q_u16(&w12[addr], tmp2);
+        vst1q_u16(&w13[addr], tmp3);
+        vst1q_u16(&w14[addr], e2);
+
+        t0 = vshlq_n_u16(a6, 1);
+        t1 = vshlq_n_u16(a7, 1);
+        t2 = vshlq_n_u16(a8, 1);
+        t0 = vsubq_u16(t0, a3);
+        t1 = vsubq_u16(t1, a4);
+        t2 = vsubq_u16(t2, a5);
+        t0 = vshlq_n_u16(t0, 1);
+        t1 = vshlq_n_u16(t1, 1);
+        t2 = vshlq_n_u16(t2, 1);
+        t0 = vaddq_u16(t0, a0);
+        t1 = vaddq_u16(t1, a1);
+        t2 = vaddq_u16(t2, a2);
+
+        tmp0 = vaddq_u16(t2, t0);
+        tmp1 = vaddq_u16(tmp0, t1);
+        tmp2 = vsubq_u16(tmp0, t1);
+        tmp3 = vaddq_u16(tmp2, t2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, t0);
+
+        vst1q_u16(&w15[addr], t0);
+        vst1q_u16(&w16[addr], tmp1);
+        vst1q_u16(&w17[addr], tmp2);
+        vst1q_u16(&w18[addr], tmp3);
+        vst1q_u16(&w19[addr], t2);
+    }
+}
+
+
+void itc33(uint16_t *restrict dst, uint16_t *restrict w) {
+    uint16_t *w0_mem[5],
+             *w1_mem[5],
+             *w2_mem[5],
+             *w3_mem[5],
+             *w4_mem[5];
+
+             w0_mem[0] = &w[0*SB2_RES+0*5*SB2_RES];
+             w1_mem[0] = &w[1*SB2_RES+0*5*SB2_RES];
+             w2_mem[0] = &w[2*SB2_RES+0*5*SB2_RES];
+             w3_mem[0] = &w[3*SB2_RES+0*5*SB2_RES];
+             w4_mem[0] = &w[4*SB2_RES+0*5*SB2_RES];
+
+             w0_mem[1] = &w[0*SB2_RES+1*5*SB2_RES];
+             w1_mem[1] = &w[1*SB2_RES+1*5*SB2_RES];
+             w2_mem[1] = &w[2*SB2_RES+1*5*SB2_RES];
+             w3_mem[1] = &w[3*SB2_RES+1*5*SB2_RES];
+             w4_mem[1] = &w[4*SB2_RES+1*5*SB2_RES];
+
+             w0_mem[2] = &w[0*SB2_RES+2*5*SB2_RES];
+             w1_mem[2] = &w[1*SB2_RES+2*5*SB2_RES];
+             w2_mem[2] = &w[2*SB2_RES+2*5*SB2_RES];
+             w3_mem[2] = &w[3*SB2_RES+2*5*SB2_RES];
+             w4_mem[2] = &w[4*SB2_RES+2*5*SB2_RES];
+
+             w0_mem[3] = &w[0*SB2_RES+3*5*SB2_RES];
+             w1_mem[3] = &w[1*SB2_RES+3*5*SB2_RES];
+             w2_mem[3] = &w[2*SB2_RES+3*5*SB2_RES];
+             w3_mem[3] = &w[3*SB2_RES+3*5*SB2_RES];
+             w4_mem[3] = &w[4*SB2_RES+3*5*SB2_RES];
+
+             w0_mem[4] = &w[0*SB2_RES+4*5*SB2_RES];
+             w1_mem[4] = &w[1*SB2_RES+4*5*SB2_RES];
+             w2_mem[4] = &w[2*SB2_RES+4*5*SB2_RES];
+             w3_mem[4] = &w[3*SB2_RES+4*5*SB2_RES];
+             w4_mem[4] = &w[4*SB2_RES+4*5*SB2_RES];
+
+    // 33 SIMD registers
+    uint16x8_t r0, r1, r2, r3, r4, // 4x1 = 4
+               v1, v2, v3,  // 3x1 = 3
+               c1, c2, c3, c11, c21, c31; // 6x1 = 6
+    uint16x8_t A[6][5]; // 4x5 = 20
+
+    for (uint16_t addr = 0; addr < SB2; addr+= 8) {
+// k = 0
+        A[0][0] = vld1q_u16(&w0_mem[0][addr]);
+        A[0][1] = vld1q_u16(&w0_mem[1][addr]);
+        A[0][2] = vld1q_u16(&w0_mem[2][addr]);
+        A[0][3] = vld1q_u16(&w0_mem[3][addr]);
+        A[0][4] = vld1q_u16(&w0_mem[4][addr]);
+
+        // v3 = (A[0][3] - A[0][1])*inv3
+        v3 = vsubq_u16(A[0][3], A[0][1]);
+        v3 = vmulq_n_u16(v3, inv3);
+
+        // v1 = (A[0][1] - A[0][2]) >> 1
+        v1 = vsubq_u16(A[0][1], A[0][2]);
+        v1 = vshrq_n_u16(v1, 1);
+
+        // v2 = (A[0][2] - A[0][0])
+        v2 = vsubq_u16(A[0][2], A[0][0]);
+
+        // c2 = v2 + v1 - A[0][4]
+        c2 = vaddq_u16(v2, v1);
+        c2 = vsubq_u16(c2, A[0][4]);
+
+        // c3 = (v2 - v3)>>1  + (A[0][4] << 1)
+        v2 = vsubq_u16(v2, v3);
+        v2 = vshrq_n_u16(v2, 1);
+        v3 = vshlq_n_u16(A[0][4], 1);
+        c3 = vaddq_u16(v2, v3);
+
+        // c1 = v1 - c3
+        c1 = vsubq_u16(v1, c3);
+
+        vst1q_u16(&dst[addr+0*SB2 + 0*SB1], A[0][0]);
+        vst1q_u16(&dst[addr+0*SB2 + 1*SB1], c1);
+        vst1q_u16(&dst[addr+0*SB2 + 2*SB1], c2);
+        vst1q_u16(&dst[addr+0*SB2 + 3*SB1], c3);
+        vst1q_u16(&dst[addr+0*SB2 + 4*SB1], A[0][4]);
+
+        for(int j = 0; j < 5; j++) {
+        r1 = vld1q_u16(&w1_mem[j][addr]); // 1
+        r2 = vld1q_u16(&w2_mem[j][addr]); // -1
+        r3 = vld1q_u16(&w3_mem[j][addr]); // -2
+        r4 = vld1q_u16(&w4_mem[j][addr]); // inf
+
+        // v3 = (r3 - r1)*inv3
+        v3 = vsubq_u16(r3, r1);
+        v3 = vmulq_n_u16(v3, inv3);
+
+        // v1 = (r1 - r2) >> 1
+        v1 = vsubq_u16(r1, r2);
+        v1 = vshrq_n_u16(v1, 1);
+
+        // v2 = (r2 - A[0][j])
+        v2 = vsubq_u16(r2, A[0][j]);
+
+        // c2 = v2 + v1 - r4
+        c2 = vaddq_u16(v2, v1);
+        c2 = vsubq_u16(c2, r4);
+
+        // c3 = (v2 - v3)>>1  + (r4 << 1)
+        v2 = vsubq_u16(v2, v3);
+        v2 = vshrq_n_u16(v2, 1);
+        v3 = vshlq_n_u16(r4, 1);
+        c3 = vaddq_u16(v2, v3);
+
+        // c1 = v1 - c3
+        c1 = vsubq_u16(v1, c3);
+
+// 2nd part
+        r0 = vld1q_u16(&w0_mem[j][addr+SB2]); // 0
+        r1 = vld1q_u16(&w1_mem[j][addr+SB2]); // 1
+        r2 = vld1q_u16(&w2_mem[j][addr+SB2]); // -1
+        r3 = vld1q_u16(&w3_mem[j][addr+SB2]); // -2
+        A[5][j] = vld1q_u16(&w4_mem[j][addr+SB2]); // inf
+
+        // v3 = (r3 - r1)*inv3
+        v3 = vsubq_u16(r3, r1);
+        v3 = vmulq_n_u16(v3, inv3);
+
+        // v1 = (r1 - r2) >> 1
+        v1 = vsubq_u16(r1, r2);
+        v1 = vshrq_n_u16(v1, 1);
+
+        // v2 = (r2 - r0)
+        v2 = vsubq_u16(r2, r0);
+
+        // c21 = v2 + v1 - A[5][j]
+        c21 = vaddq_u16(v2, v1);
+        c21 = vsubq_u16(c21, A[5][j]);
+
+        // c31 = (v2 - v3)>>1  + (A[5][j] << 1)
+        v2 = vsubq_u16(v2, v3);
+        v2 = vshrq_n_u16(v2, 1);
+        v3 = vshlq_n_u16(A[5][j], 1);
+        c31 = vaddq_u16(v2, v3);
+
+        // c11 = v1 - c31
+        c11 = vsubq_u16(v1, c31);
+
+        r0 = vaddq_u16(c1, r0);
+        A[1][j] = r0;
+
+        c11 = vaddq_u16(c2, c11);
+        A[2][j] = c11;
+
+        c21 = vaddq_u16(c3, c21);
+        A[3][j] = c21;
+
+        c31 = vaddq_u16(r4, c31);
+        A[4][j] = c31;
+        }
+
+        for(uint16_t k = 1; k < 3; k++) {
+        r0 = A[k][0];
+        r1 = A[k][1];
+        r2 = A[k][2];
+        r3 = A[k][3];
+        r4 = A[k][4];
+
+        // v3 = (r3 - r1)*inv3
+        v3 = vsubq_u16(r3, r1);
+        v3 = vmulq_n_u16(v3, inv3);
+
+        // v1 = (r1 - r2) >> 1
+        v1 = vsubq_u16(r1, r2);
+        v1 = vshrq_n_u16(v1, 1);
+
+        // v2 = (r2 - r0)
+        v2 = vsubq_u16(r2, r0);
+
+        // c2 = v2 + v1 - r4
+        c2 = vaddq_u16(v2, v1);
+        c2 = vsubq_u16(c2, r4);
+
+        // c3 = (v2 - v3)>>1  + (r4 << 1)
+        v2 = vsubq_u16(v2, v3);
+        v2 = vshrq_n_u16(v2, 1);
+        v3 = vshlq_n_u16(r4, 1);
+        c3 = vaddq_u16(v2, v3);
+
+        // c1 = v1 - c3
+        c1 = vsubq_u16(v1, c3);
+        
+        vst1q_u16(&dst[addr+k*SB2 + 0*SB1], r0);
+        vst1q_u16(&dst[addr+k*SB2 + 1*SB1], c1);
+        vst1q_u16(&dst[addr+k*SB2 + 2*SB1], c2);
+        vst1q_u16(&dst[addr+k*SB2 + 3*SB1], c3);
+        vst1q_u16(&dst[addr+k*SB2 + 4*SB1], r4);
+        }
+        for(uint16_t k = 3; k < 6; k++) {
+        r0 = A[k][0];
+        r1 = A[k][1];
+        r2 = A[k][2];
+        r3 = A[k][3];
+        r4 = A[k][4];
+
+        // v3 = (r3 - r1)*inv3
+        v3 = vsubq_u16(r3, r1);
+        v3 = vmulq_n_u16(v3, inv3);
+
+        // v1 = (r1 - r2) >> 1
+        v1 = vsubq_u16(r1, r2);
+        v1 = vshrq_n_u16(v1, 1);
+
+        // v2 = (r2 - r0)
+        v2 = vsubq_u16(r2, r0);
+
+        // c2 = v2 + v1 - r4
+        c2 = vaddq_u16(v2, v1);
+        c2 = vsubq_u16(c2, r4);
+
+        // c3 = (v2 - v3)>>1  + (r4 << 1)
+        v2 = vsubq_u16(v2, v3);
+        v2 = vshrq_n_u16(v2, 1);
+        v3 = vshlq_n_u16(r4, 1);
+        c3 = vaddq_u16(v2, v3);
+
+        // c1 = v1 - c3
+        c1 = vsubq_u16(v1, c3);
+
+        v1 = vld1q_u16(&dst[addr+k*SB2 + 0*SB1]);
+        r0 = vaddq_u16(v1, r0);
+        vst1q_u16(&dst[addr+k*SB2 + 0*SB1], r0);
+
+        v2 = vld1q_u16(&dst[addr+k*SB2 + 1*SB1]);
+        c1 = vaddq_u16(v2, c1);
+        vst1q_u16(&dst[addr+k*SB2 + 1*SB1], c1);
+
+        v3 = vld1q_u16(&dst[addr+k*SB2 + 2*SB1]);
+        c2 = vaddq_u16(v3, c2);
+        vst1q_u16(&dst[addr+k*SB2 + 2*SB1], c2);
+
+        v1 = vld1q_u16(&dst[addr+k*SB2 + 3*SB1]);
+        c3 = vaddq_u16(v1, c3);
+        vst1q_u16(&dst[addr+k*SB2 + 3*SB1], c3);
+
+        vst1q_u16(&dst[addr+k*SB2 + 4*SB1], r4);
+        }
+    }
+}
+
+
+/*
+Because the input has only degree 821, omit the calculation of 824-864
+
+The k2 of the value a = (a0, a1) at point p is w[3p] = a0, w[3p+1] = a1 and w[3p+2] = a0 + a1.
+*/
+void tc3k2(uint16_t *restrict w[15], uint16_t *restrict polynomial) {
+    uint16_t *c0 = &polynomial[0*SB0],
+             *c1 = &polynomial[2*SB0],
+             *c2 = &polynomial[4*SB0];
+    uint16x8_t r0, r1, r2, h0, h1, h2, p0, p1, p_1;
+    uint16x8_t zero;
+    zero = vmovq_n_u16(0);
+    for (uint16_t addr = 0; addr < SB0; addr+= 8){
+        r0 = vld1q_u16(&c0[addr]);
+        r1 = vld1q_u16(&c1[addr]);
+        r2 = vld1q_u16(&c2[addr]);
+        h0 = vld1q_u16(&c0[SB0 + addr]);
+        h1 = vld1q_u16(&c1[SB0 + addr]);
+        h2 = (addr < 8*13) ? vld1q_u16(&c2[SB0 + addr]) : zero;
+
+        vst1q_u16(&w[0][addr], r0); // A(0)   = r0
+        vst1q_u16(&w[1][addr], h0);
+        vst1q_u16(&w[2][addr], vaddq_u16(r0, h0));
+        vst1q_u16(&w[12][addr], r2); // A(inf) = r2
+        vst1q_u16(&w[13][addr], h2);
+        vst1q_u16(&w[14][addr], vaddq_u16(r2, h2));
+
+        p0 = vaddq_u16(r0, r2);   // p0  = r0 + r2
+        p1 = vaddq_u16(p0, r1);   // p1  = r0 + r1 + r2
+        p_1 = vsubq_u16(p0, r1);  // p_1 = r0 - r1 + r2
+        vst1q_u16(&w[3][addr], p1);  // A(1)  = r0 + r1 + r2
+        vst1q_u16(&w[6][addr], p_1); // A(-1) = r0 - r1 + r2
+        p0 = vaddq_u16(p_1, r2);
+        p0 = vshlq_n_u16(p0, 1);
+        p0 = vsubq_u16(p0, r0);   // p0  = 2*(p_1 + r2) - r0 = r0 - 2*r1 + 4*r2
+        vst1q_u16(&w[9][addr], p0);  // A(-2) = r0 - 2*r1 + 4*r2
+
+        r0 = vaddq_u16(h0, h2);   // r0  = h0 + h2
+        r2 = vaddq_u16(r0, h1);   // r2  = h0 + h1 + h2
+        r0 = vsubq_u16(r0, h1);   // r0  = h0 - h1 + h2
+        vst1q_u16(&w[4][addr], r2);
+        vst1q_u16(&w[5][addr], vaddq_u16(p1, r2));
+        vst1q_u16(&w[7][addr], r0);
+        vst1q_u16(&w[8][addr], vaddq_u16(p_1, r0));
+        r0 = vaddq_u16(r0, h2);
+        r0 = vshlq_n_u16(r0, 1);
+        r0 = vsubq_u16(r0, h0);   // r0  = h0 - 2*h1 + 4*h2
+        vst1q_u16(&w[10][addr], r0);
+        vst1q_u16(&w[11][addr], vaddq_u16(p0, r0));
+    }
+}
+
+/*
+The products of point p are l = w[3p], h = w[3p+1] and m = w[3p+2], the quarters of their k2 are q0 = l0,
+q1 = l1 + m0 - l0 - h0, q2 = h0 + m1 - l1 - h1 and q3 = h1. The quarters a, b, c and d (q0, ..., q3) of the 5
+coefficients are interpolated one after the other, with the coefficients multiplied by 2 so that they are integers
+mod 2^16, and divided by 2 at the end. Each output block of SB0 coefficients is the sum of the quarter j of one
+coefficient and the quarter j + 2 of the previous one.
+*/
+void itc3k2(uint16_t *restrict polynomial, uint16_t *w[15]) {
+    uint16x8_t l0, l1, h0, h1, m0, m1,
+               a0, a1, a2, a3, a4,
+               c0, c1, c2, c3, c4,
+               s1, s2, s3, t1, t2, t3;
+
+    for (uint16_t addr = 0; addr < SB0; addr+= 8) {
+        // quarters 0 and 2
+        l0 = vld1q_u16(&w[0][addr]);
+        l1 = vld1q_u16(&w[0][SB0 + addr]);
+        h0 = vld1q_u16(&w[1][addr]);
+        h1 = vld1q_u16(&w[1][SB0 + addr]);
+        m1 = vld1q_u16(&w[2][SB0 + addr]);
+        a0 = l0;
+        c0 = vaddq_u16(h0, m1);
+        c0 = vsubq_u16(c0, l1);
+        c0 = vsubq_u16(c0, h1); // c0 = h0 + m1 - l1 - h1
+        l0 = vld1q_u16(&w[3][addr]);
+        l1 = vld1q_u16(&w[3][SB0 + addr]);
+        h0 = vld1q_u16(&w[4][addr]);
+        h1 = vld1q_u16(&w[4][SB0 + addr]);
+        m1 = vld1q_u16(&w[5][SB0 + addr]);
+        a1 = l0;
+        c1 = vaddq_u16(h0, m1);
+        c1 = vsubq_u16(c1, l1);
+        c1 = vsubq_u16(c1, h1); // c1 = h0 + m1 - l1 - h1
+        l0 = vld1q_u16(&w[6][addr]);
+        l1 = vld1q_u16(&w[6][SB0 + addr]);
+        h0 = vld1q_u16(&w[7][addr]);
+        h1 = vld1q_u16(&w[7][SB0 + addr]);
+        m1 = vld1q_u16(&w[8][SB0 + addr]);
+        a2 = l0;
+        c2 = vaddq_u16(h0, m1);
+        c2 = vsubq_u16(c2, l1);
+        c2 = vsubq_u16(c2, h1); // c2 = h0 + m1 - l1 - h1
+        l0 = vld1q_u16(&w[9][addr]);
+        l1 = vld1q_u16(&w[9][SB0 + addr]);
+        h0 = vld1q_u16(&w[10][addr]);
+        h1 = vld1q_u16(&w[10][SB0 + addr]);
+        m1 = vld1q_u16(&w[11][SB0 + addr]);
+        a3 = l0;
+        c3 = vaddq_u16(h0, m1);
+        c3 = vsubq_u16(c3, l1);
+        c3 = vsubq_u16(c3, h1); // c3 = h0 + m1 - l1 - h1
+        l0 = vld1q_u16(&w[12][addr]);
+        l1 = vld1q_u16(&w[12][SB0 + addr]);
+        h0 = vld1q_u16(&w[13][addr]);
+        h1 = vld1q_u16(&w[13][SB0 + addr]);
+        m1 = vld1q_u16(&w[14][SB0 + addr]);
+        a4 = l0;
+        c4 = vaddq_u16(h0, m1);
+        c4 = vsubq_u16(c4, l1);
+        c4 = vsubq_u16(c4, h1); // c4 = h0 + m1 - l1 - h1
+        s1 = a0;
+        s1 = vmlaq_n_u16(s1, a1, (uint16_t)(2*inv3));
+        s1 = vmlaq_n_u16(s1, a3, (uint16_t)inv3);
+        s1 = vmlsq_n_u16(s1, a2, 2);
+        s1 = vmlsq_n_u16(s1, a4, 4); // 2*s1 = a0 + 2/3*a1 + 1/3*a3 - 2*a2 - 4*a4
+        s1 = vshrq_n_u16(s1, 1);
+        s2 = a1;
+        s2 = vaddq_u16(s2, a2);
+        s2 = vmlsq_n_u16(s2, a0, 2);
+        s2 = vmlsq_n_u16(s2, a4, 2); // 2*s2 = a1 + a2 - 2*a0 - 2*a4
+        s2 = vshrq_n_u16(s2, 1);
+        s3 = vmulq_n_u16(a1, (uint16_t)inv3);
+        s3 = vaddq_u16(s3, a2);
+        s3 = vmlaq_n_u16(s3, a4, 4);
+        s3 = vsubq_u16(s3, a0);
+        s3 = vmlsq_n_u16(s3, a3, (uint16_t)inv3); // 2*s3 = 1/3*a1 + a2 + 4*a4 - a0 - 1/3*a3
+        s3 = vshrq_n_u16(s3, 1);
+        t1 = c0;
+        t1 = vmlaq_n_u16(t1, c1, (uint16_t)(2*inv3));
+        t1 = vmlaq_n_u16(t1, c3, (uint16_t)inv3);
+        t1 = vmlsq_n_u16(t1, c2, 2);
+        t1 = vmlsq_n_u16(t1, c4, 4); // 2*t1 = c0 + 2/3*c1 + 1/3*c3 - 2*c2 - 4*c4
+        t1 = vshrq_n_u16(t1, 1);
+        t2 = c1;
+        t2 = vaddq_u16(t2, c2);
+        t2 = vmlsq_n_u16(t2, c0, 2);
+        t2 = vmlsq_n_u16(t2, c4, 2); // 2*t2 = c1 + c2 - 2*c0 - 2*c4
+        t2 = vshrq_n_u16(t2, 1);
+        t3 = vmulq_n_u16(c1, (uint16_t)inv3);
+        t3 = vaddq_u16(t3, c2);
+        t3 = vmlaq_n_u16(t3, c4, 4);
+        t3 = vsubq_u16(t3, c0);
+        t3 = vmlsq_n_u16(t3, c3, (uint16_t)inv3); // 2*t3 = 1/3*c1 + c2 + 4*c4 - c0 - 1/3*c3
+        t3 = vshrq_n_u16(t3, 1);
+        vst1q_u16(&polynomial[addr + 0*SB0], a0);
+        vst1q_u16(&polynomial[addr + 2*SB0], vaddq_u16(s1, c0));
+        vst1q_u16(&polynomial[addr + 4*SB0], vaddq_u16(s2, t1));
+        vst1q_u16(&polynomial[addr + 6*SB0], vaddq_u16(s3, t2));
+        vst1q_u16(&polynomial[addr + 8*SB0], vaddq_u16(a4, t3));
+        vst1q_u16(&polynomial[addr + 10*SB0], c4);
+
+        // quarters 1 and 3, in the same registers
+        l0 = vld1q_u16(&w[0][addr]);
+        l1 = vld1q_u16(&w[0][SB0 + addr]);
+        h0 = vld1q_u16(&w[1][addr]);
+        h1 = vld1q_u16(&w[1][SB0 + addr]);
+        m0 = vld1q_u16(&w[2][addr]);
+        a0 = vaddq_u16(l1, m0);
+        a0 = vsubq_u16(a0, l0);
+        a0 = vsubq_u16(a0, h0); // b0 = l1 + m0 - l0 - h0
+        c0 = h1;
+        l0 = vld1q_u16(&w[3][addr]);
+        l1 = vld1q_u16(&w[3][SB0 + addr]);
+        h0 = vld1q_u16(&w[4][addr]);
+        h1 = vld1q_u16(&w[4][SB0 + addr]);
+        m0 = vld1q_u16(&w[5][addr]);
+        a1 = vaddq_u16(l1, m0);
+        a1 = vsubq_u16(a1, l0);
+        a1 = vsubq_u16(a1, h0); // b1 = l1 + m0 - l0 - h0
+        c1 = h1;
+        l0 = vld1q_u16(&w[6][addr]);
+        l1 = vld1q_u16(&w[6][SB0 + addr]);
+        h0 = vld1q_u16(&w[7][addr]);
+        h1 = vld1q_u16(&w[7][SB0 + addr]);
+        m0 = vld1q_u16(&w[8][addr]);
+        a2 = vaddq_u16(l1, m0);
+        a2 = vsubq_u16(a2, l0);
+        a2 = vsubq_u16(a2, h0); // b2 = l1 + m0 - l0 - h0
+        c2 = h1;
+        l0 = vld1q_u16(&w[9][addr]);
+        l1 = vld1q_u16(&w[9][SB0 + addr]);
+        h0 = vld1q_u16(&w[10][addr]);
+        h1 = vld1q_u16(&w[10][SB0 + addr]);
+        m0 = vld1q_u16(&w[11][addr]);
+        a3 = vaddq_u16(l1, m0);
+        a3 = vsubq_u16(a3, l0);
+        a3 = vsubq_u16(a3, h0); // b3 = l1 + m0 - l0 - h0
+        c3 = h1;
+        l0 = vld1q_u16(&w[12][addr]);
+        l1 = vld1q_u16(&w[12][SB0 + addr]);
+        h0 = vld1q_u16(&w[13][addr]);
+        h1 = vld1q_u16(&w[13][SB0 + addr]);
+        m0 = vld1q_u16(&w[14][addr]);
+        a4 = vaddq_u16(l1, m0);
+        a4 = vsubq_u16(a4, l0);
+        a4 = vsubq_u16(a4, h0); // b4 = l1 + m0 - l0 - h0
+        c4 = h1;
+        s1 = a0;
+        s1 = vmlaq_n_u16(s1, a1, (uint16_t)(2*inv3));
+        s1 = vmlaq_n_u16(s1, a3, (uint16_t)inv3);
+        s1 = vmlsq_n_u16(s1, a2, 2);
+        s1 = vmlsq_n_u16(s1, a4, 4); // 2*s1 = a0 + 2/3*a1 + 1/3*a3 - 2*a2 - 4*a4
+        s1 = vshrq_n_u16(s1, 1);
+        s2 = a1;
+        s2 = vaddq_u16(s2, a2);
+        s2 = vmlsq_n_u16(s2, a0, 2);
+        s2 = vmlsq_n_u16(s2, a4, 2); // 2*s2 = a1 + a2 - 2*a0 - 2*a4
+        s2 = vshrq_n_u16(s2, 1);
+        s3 = vmulq_n_u16(a1, (uint16_t)inv3);
+        s3 = vaddq_u16(s3, a2);
+        s3 = vmlaq_n_u16(s3, a4, 4);
+        s3 = vsubq_u16(s3, a0);
+        s3 = vmlsq_n_u16(s3, a3, (uint16_t)inv3); // 2*s3 = 1/3*a1 + a2 + 4*a4 - a0 - 1/3*a3
+        s3 = vshrq_n_u16(s3, 1);
+        t1 = c0;
+        t1 = vmlaq_n_u16(t1, c1, (uint16_t)(2*inv3));
+        t1 = vmlaq_n_u16(t1, c3, (uint16_t)inv3);
+        t1 = vmlsq_n_u16(t1, c2, 2);
+        t1 = vmlsq_n_u16(t1, c4, 4); // 2*t1 = c0 + 2/3*c1 + 1/3*c3 - 2*c2 - 4*c4
+        t1 = vshrq_n_u16(t1, 1);
+        t2 = c1;
+        t2 = vaddq_u16(t2, c2);
+        t2 = vmlsq_n_u16(t2, c0, 2);
+        t2 = vmlsq_n_u16(t2, c4, 2); // 2*t2 = c1 + c2 - 2*c0 - 2*c4
+        t2 = vshrq_n_u16(t2, 1);
+        t3 = vmulq_n_u16(c1, (uint16_t)inv3);
+        t3 = vaddq_u16(t3, c2);
+        t3 = vmlaq_n_u16(t3, c4, 4);
+        t3 = vsubq_u16(t3, c0);
+        t3 = vmlsq_n_u16(t3, c3, (uint16_t)inv3); // 2*t3 = 1/3*c1 + c2 + 4*c4 - c0 - 1/3*c3
+        t3 = vshrq_n_u16(t3, 1);
+        vst1q_u16(&polynomial[addr + 1*SB0], a0);
+        vst1q_u16(&polynomial[addr + 3*SB0], vaddq_u16(s1, c0));
+        vst1q_u16(&polynomial[addr + 5*SB0], vaddq_u16(s2, t1));
+        vst1q_u16(&polynomial[addr + 7*SB0], vaddq_u16(s3, t2));
+        vst1q_u16(&polynomial[addr + 9*SB0], vaddq_u16(a4, t3));
+        vst1q_u16(&polynomial[addr + 11*SB0], c4);
+    }
+}
+
+
+static void poly_neon_reduction(uint16_t *polynomial, uint16_t *tmp) {
+    uint16x8_t mask;
+    uint16x8x3_t res, tmp1, tmp2;
+    mask = vdupq_n_u16(MASK);
+    for (uint16_t addr = 0; addr < 824; addr += 24) {
+        tmp2 = vld1q_u16_x3(&tmp[addr]);
+        tmp1 = vld1q_u16_x3(&tmp[addr + NTRU_N]);
+        res.val[0] = vaddq_u16(tmp1.val[0], tmp2.val[0]);
+        res.val[1] = vaddq_u16(tmp1.val[1], tmp2.val[1]);
+        res.val[2] = vaddq_u16(tmp1.val[2], tmp2.val[2]);
+        res.val[0] = vandq_u16(res.val[0], mask);
+        res.val[1] = vandq_u16(res.val[1], mask);
+        res.val[2] = vandq_u16(res.val[2], mask);
+        vst1q_u16_x3(&polynomial[addr], res);
+    }
+}
+
+/* B evaluated by tc33 (TC33_PRODUCTS*SB2) followed by its k2 (TC33_PRODUCTS*8), as schoolbook_8x8 expects */
+void tc33_expand(uint16_t *restrict polyE, uint16_t *restrict polyB[15]) {
+    uint16_t *tmp_bb = &polyE[0],
+             *tmp_bb1 = &polyE[TC33_PRODUCTS*SB2];
+
+    for (int i = 0; i < 15; i++) {
+        tc33(&tmp_bb[i*25*SB2], polyB[i]);
+    }
+    // The last product of the batch is a zero one
+    for (int i = 15*25*SB2; i < TC33_PRODUCTS*SB2; i++) {
+        tmp_bb[i] = 0;
+    }
+
+    k2(&tmp_bb1[0], &tmp_bb[0]);
+}
+
+void tc33_mul_expanded(uint16_t *restrict polyC[15], uint16_t *restrict polyA[15], const uint16_t *restrict polyE) {
+    uint16_t tmp_aa[TC33_EXPANDED], tmp_cc[TC33_PRODUCTS*SB2_RES+TC33_PRODUCTS*16];
+    uint16_t *tmp_bb = (uint16_t *)polyE,
+             *tmp_aa1 = &tmp_aa[TC33_PRODUCTS*SB2],
+             *tmp_cc1 = &tmp_cc[TC33_PRODUCTS*SB2_RES];
+
+    for (int i = 0; i < 15; i++) {
+        tc33(&tmp_aa[i*25*SB2], polyA[i]);
+    }
+    for (int i = 15*25*SB2; i < TC33_PRODUCTS*SB2; i++) {
+        tmp_aa[i] = 0;
+    }
+
+/* 375 16x16 and a zero one, so that no product is left to a scalar schoolbook_16x16 */
+    k2(&tmp_aa1[0], &tmp_aa[0]);
+    schoolbook_8x8(&tmp_cc[0], &tmp_aa[0], &tmp_bb[0]);
+    ik2(&tmp_cc[0], &tmp_cc1[0]);
+
+    for (int i = 0; i < 15; i++) {
+        itc33(polyC[i], &tmp_cc[i*25*SB2_RES]);
+    }
+}
+
+void tc33_mul(uint16_t *restrict polyC[15], uint16_t *restrict polyA[15], uint16_t *restrict polyB[15]) {
+    uint16_t tmp_bb[TC33_EXPANDED];
+
+    tc33_expand(tmp_bb, polyB);
+    tc33_mul_expanded(polyC, polyA, tmp_bb);
+}
+
+void poly_mul_neon(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB) {
+    uint16_t *kaw[15], *kbw[15], *kcw[15];
+    uint16_t tmp_ab[SB0 * 15 * 2];
+    uint16_t tmp_c[SB0_RES * 15];
+
+    for (int i = 0; i < 15; i++) {
+        kaw[i] = &tmp_ab[(2 * i) * SB0];     // A(0), ..., A(f)
+        kbw[i] = &tmp_ab[(2 * i + 1) * SB0]; // B(0), ..., B(f)
+        kcw[i] = &tmp_c[i * SB0_RES];
+    }
+
+    tc3k2(kaw, polyA);
+    tc3k2(kbw, polyB);
+
+    tc33_mul(kcw, kaw, kbw);
+
+    itc3k2(tmp_ab, kcw);
+
+    // Ring reduction, Reduce from 1728 -> 864
+    poly_neon_reduction(polyC, tmp_ab);
+}
+
+void poly_neon_expand(uint16_t *restrict polyE, uint16_t *restrict polyB) {
+    uint16_t *kbw[15];
+    uint16_t tmp_b[SB0 * 15];
+
+    for (int i = 0; i < 15; i++) {
+        kbw[i] = &tmp_b[i * SB0];
+    }
+
+    tc3k2(kbw, polyB);
+
+    tc33_expand(polyE, kbw);
+}
+
+void poly_neon_mul_expanded(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict polyE) {
+    uint16_t *kaw[15], *kcw[15];
+    uint16_t tmp_a[SB0 * 15 * 2];
+    uint16_t tmp_c[SB0_RES * 15];
+
+    for (int i = 0; i < 15; i++) {
+        kaw[i] = &tmp_a[i * SB0];
+        kcw[i] = &tmp_c[i * SB0_RES];
+    }
+
+    tc3k2(kaw, polyA);
+
+    tc33_mul_expanded(kcw, kaw, polyE);
+
+    itc3k2(tmp_a, kcw);
+
+    // Ring reduction, Reduce from 1728 -> 864
+    poly_neon_reduction(polyC, tmp_a);
+}
@@ -0,0 +1,48 @@
+#ifndef TC_H
+#define TC_H
+
+#include <stdint.h>
+
+#include "params.h"
+
+// ensure TC_POLY_N <= POLY_N
+#define TC_POLY_N 864
+
+#define SB0 (TC_POLY_N / 6) // 144, half of the 288 of tc3
+#define SB1 (SB0 / 3)        // 48
+#define SB2 (SB1 / 3)        // 16
+
+#define SB2_RES (2 * SB2) // 32  = 16*2, 32/16 = 2
+#define SB1_RES (2 * SB1) // 96  = 48*2, 96/16 = 6
+#define SB0_RES (2 * SB0) // 288 = 144*2, 288/16 = 18
+
+#define MASK (NTRU_Q - 1)
+
+#define inv3 43691
+
+void tc3k2(uint16_t *restrict w[15], uint16_t *restrict polynomial);
+// The 15*25 16x16 products of tc33, padded with a zero one to a multiple of 8 for schoolbook_8x8
+#define TC33_PRODUCTS 376
+void tc33_mul(uint16_t *restrict polyC[15], uint16_t *restrict polyA[15], uint16_t *restrict polyB[15]);
+// tc33_mul split into the evaluation of B and the rest, TC33_EXPANDED coefficients in between
+#define TC33_EXPANDED (TC33_PRODUCTS*SB2+TC33_PRODUCTS*8)
+void tc33_expand(uint16_t *restrict polyE, uint16_t *restrict polyB[15]);
+void tc33_mul_expanded(uint16_t *restrict polyC[15], uint16_t *restrict polyA[15], const uint16_t *restrict polyE);
+void tc33(uint16_t *restrict w, uint16_t *restrict src);
+void k2(uint16_t *restrict w, uint16_t *restrict src);
+void ik2(uint16_t *restrict w, uint16_t *restrict src);
+void itc33(uint16_t *restrict dst, uint16_t *restrict w);
+void itc3k2(uint16_t *restrict polynomial, uint16_t *w[15]);
+
+
+// The stages of poly_mul_neon (see speed_polymul.c): the evaluation of an operand in TC_WAYS vectors of SB0
+// coefficients, tc33_mul and the interpolation of the TC_WAYS products of SB0_RES coefficients
+#define TC_WAYS 15
+#define F_EVAL(w, src) tc3k2(w, src)
+#define F_INTERP(dst, w) itc3k2(dst, w)
+
+void poly_mul_neon(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB);
+void poly_neon_expand(uint16_t *restrict polyE, uint16_t *restrict polyB);
+void poly_neon_mul_expanded(uint16_t *restrict polyC, uint16_t *restrict polyA, const uint16_t *restrict polyE);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef OWCPA_H
+#define OWCPA_H
+
+#include "params.h"
+#include "poly.h"
+
+// Modified in NTRU-AMX to match PQC-NEON
+#define owcpa_keypair CRYPTO_NAMESPACE(owcpa_keypair)
+void owcpa_keypair(unsigned char *pk,
+        unsigned char *sk,
+        const unsigned char seed[NTRU_SAMPLE_FG_BYTES]);
+
+#define owcpa_enc CRYPTO_NAMESPACE(owcpa_enc)
+void owcpa_enc(unsigned char *c,
+        const poly *r,
+        const poly *m,
+        const unsigned char *pk);
+
+// owcpa_enc split into the unpacking and evaluation of h, and the encryption with the result
+#define owcpa_pk_expand CRYPTO_NAMESPACE(owcpa_pk_expand)
+void owcpa_pk_expand(poly_expanded *h,
+        const unsigned char *pk);
+
+#define owcpa_enc_expanded CRYPTO_NAMESPACE(owcpa_enc_expanded)
+void owcpa_enc_expanded(unsigned char *c,
+        const poly *r,
+        const poly *m,
+        const poly_expanded *h);
+
+// owcpa_dec split into the unpacking and evaluation of f, finv3 and invh (in this order in sk), and the
+// decryption with the results
+#define owcpa_sk_expand CRYPTO_NAMESPACE(owcpa_sk_expand)
+void owcpa_sk_expand(poly_expanded sk[3],
+        const unsigned char *secretkey);
+
+#define owcpa_dec_expanded CRYPTO_NAMESPACE(owcpa_dec_expanded)
+int owcpa_dec_expanded(unsigned char *rm,
+        const unsigned char *ciphertext,
+        const poly_expanded sk[3]);
+
+#define owcpa_dec CRYPTO_NAMESPACE(owcpa_dec)
+int owcpa_dec(unsigned char *rm,
+        const unsigned char *ciphertext,
+        const unsigned char *secretkey);
+#endif
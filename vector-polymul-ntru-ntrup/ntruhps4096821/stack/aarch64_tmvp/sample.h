@@ -0,0 +1,27 @@
+#ifndef SAMPLE_H
+#define SAMPLE_H
+
+#include "params.h"
+#include "poly.h"
+
+#include "crypto_sort.h"
+
+void sample_fg(poly *f, poly *g, const unsigned char uniformbytes[NTRU_SAMPLE_FG_BYTES]);
+void sample_rm(poly *r, poly *m, const unsigned char uniformbytes[NTRU_SAMPLE_RM_BYTES]);
+
+void sample_iid(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_IID_BYTES]);
+
+void sample_fixed_type(poly *r, const unsigned char uniformbytes[NTRU_SAMPLE_FT_BYTES]);
+void sample_fixed_type_xN(poly *r[], const unsigned char *uniformbytes[], size_t n);
+
+// Added in NTRU-sampling, see reference/Reference_Implementation/crypto_kem/ntruhps2048677/sample.h
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+void sample_iid_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+void sample_fixed_type_stream(poly *r, randombytes_ctx_t *ctx, unsigned long long offset);
+void sample_rm_stream(poly *r, poly *m, randombytes_ctx_t *ctx);
+
+#endif
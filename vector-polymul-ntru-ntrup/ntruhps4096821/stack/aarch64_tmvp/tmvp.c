@@ -0,0 +1,1122 @@
+
+#include <stdio.h>
+#include <arm_neon.h>
+
+#include "params.h"
+#include "poly.h"
+#include "batch_multiplication.h"
+
+#include "tmvp.h"
+/*
+w points to 15 (ordered) output 8x8 Toeplitz Matrix,
+src points to 1 input 48x48 Toeplitz Matrix
+*/
+
+void ittc32(uint16_t *restrict w, uint16_t *restrict src){
+             uint16x8_t z0, z1, z2, z3, z4;
+             uint16x8_t p0, p1, p2, p3, p4;
+             uint16x8_t t0, t1;
+             uint16x8_t z20, z21, z22, z23, z24;
+             uint16x8_t p20, p21, p22, p23, p24;
+             uint16x8_t t20, t21;
+             uint16x8_t z80, z81, z82, z83, z84;
+             uint16x8_t p80, p81, p82, p83, p84;
+             uint16x8_t t80, t81;
+             uint16x8_t z820, z821, z822, z823, z824;
+             uint16x8_t p820, p821, p822, p823, p824;
+             uint16x8_t t820, t821;
+
+             for (uint16_t num = 0; num < 5; num++) {
+                z0 = vld1q_u16(&src[1*SB2+num*2*SB1]);
+                z1 = vld1q_u16(&src[2*SB2+num*2*SB1]);
+                z2 = vld1q_u16(&src[3*SB2+num*2*SB1]);
+                z3 = vld1q_u16(&src[4*SB2+num*2*SB1]);
+                z4 = vld1q_u16(&src[5*SB2+num*2*SB1]);
+
+                p3 = vsubq_u16(z3, z1); //p3 = z3 - z1
+                p0 = vsubq_u16(z4, z2);
+                p0 = vshlq_n_u16(p0, 1);
+                p0 = vaddq_u16(p0, p3); //p0 =  2*z4 + z3 -2*z2 - z1
+
+                t0 = vsubq_u16(z2, z3); //t0 = z2 - z3
+                p1 = vshlq_n_u16(z2, 2);
+                p1 = vaddq_u16(p1, z3);
+                p1 = vaddq_u16(p1, z1);
+                p1 = vsubq_u16(p1, t0); //p1 = 2*z3 + 3*z2 + z1
+
+                p2 = vsubq_u16(t0, p3); //p2 = -2*z3 + z2 + z1
+
+                p4 = vsubq_u16(z0, z2);
+                t1 = vshlq_n_u16(p3, 1);
+                p4 = vsubq_u16(p4, t1); //p4 = -2*z3 - z2 + 2*z1 + *z0
+
+
+
+                z20 = vld1q_u16(&src[0*SB2+num*2*SB1]);
+                z21 = z0;
+                z22 = z1;
+                z23 = z2;
+                z24 = z3;
+
+                p23 = vsubq_u16(z23, z21); //p23 = z23 - z21
+                p20 = vsubq_u16(z24, z22);
+                p20 = vshlq_n_u16(p20, 1);
+                p20 = vaddq_u16(p20, p23); //p20 =  2*z24 + z23 -2*z22 - z21
+
+                t20 = vsubq_u16(z22, z23); //t20 = z22 - z23
+                p21 = vshlq_n_u16(z22, 2);
+                p21 = vaddq_u16(p21, z23);
+                p21 = vaddq_u16(p21, z21);
+                p21 = vsubq_u16(p21, t20); //p21 = 2*z23 + 3*z22 + z21
+
+                p22 = vsubq_u16(t20, p23); //p22 = -2*z23 + z22 + z21
+
+                p24 = vsubq_u16(z20, z22);
+                t21 = vshlq_n_u16(p23, 1);
+                p24 = vsubq_u16(p24, t21); //p24 = -2*z23 - z22 + 2*z21 + z20
+
+
+
+
+                z80 = vld1q_u16(&src[1*SB2+8+num*2*SB1]);
+                z81 = vld1q_u16(&src[2*SB2+8+num*2*SB1]);
+                z82 = vld1q_u16(&src[3*SB2+8+num*2*SB1]);
+                z83 = vld1q_u16(&src[4*SB2+8+num*2*SB1]);
+                z84 = vld1q_u16(&src[5*SB2+8+num*2*SB1]);
+
+                p83 = vsubq_u16(z83, z81); //p83 = z83 - z81
+                p80 = vsubq_u16(z84, z82);
+                p80 = vshlq_n_u16(p80, 1);
+                p80 = vaddq_u16(p80, p83); //p80 =  2*z84 + z83 -2*z82 - z81
+
+                t80 = vsubq_u16(z82, z83); //t80 = z82 - z83
+                p81 = vshlq_n_u16(z82, 2);
+                p81 = vaddq_u16(p81, z83);
+                p81 = vaddq_u16(p81, z81);
+                p81 = vsubq_u16(p81, t80); //p81 = 2*z83 + 3*z82 + z81
+
+                p82 = vsubq_u16(t80, p83); //p82 = -2*z83 + z82 + z81
+
+                p84 = vsubq_u16(z80, z82);
+                t81 = vshlq_n_u16(p83, 1);
+                p84 = vsubq_u16(p84, t81); //p84 = -2*z83 - z82 + 2*z81 + z80
+
+
+
+
+                z820 = vld1q_u16(&src[0*SB2+8+num*2*SB1]);
+                z821 = z80;
+                z822 = z81;
+                z823 = z82;
+                z824 = z83;
+
+                p823 = vsubq_u16(z823, z821); //p823 = z823 - z821
+                p820 = vsubq_u16(z824, z822);
+                p820 = vshlq_n_u16(p820, 1);
+                p820 = vaddq_u16(p820, p823); //p820 =  2*z824 + z823 -2*z822 - z821
+
+                t820 = vsubq_u16(z822, z823); //t820 = z822 - z823
+                p821 = vshlq_n_u16(z822, 2);
+                p821 = vaddq_u16(p821, z823);
+                p821 = vaddq_u16(p821, z821);
+                p821 = vsubq_u16(p821, t820); //p821 = 2*z823 + 3*z822 + z821
+
+                p822 = vsubq_u16(t820, p823); //p822 = -2*z823 + z822 + z821
+
+                p824 = vsubq_u16(z820, z822);
+                t821 = vshlq_n_u16(p823, 1);
+                p824 = vsubq_u16(p824, t821); //p824 = -2*z823 - z822 + 2*z821 + z820
+
+
+
+                uint16x8_t a0, a1, a2;
+                uint16x8_t r0, r1;
+                //p0
+        a1 = p0;
+        a2 = p80;
+        a0 = p820;
+
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+8 ], r0);
+        vst1q_u16(&w[num*15*SB2+24], r1);
+        vst1q_u16(&w[num*15*SB2+40], a1);
+
+
+
+        a1 = p820;
+        a0 = p20;
+        a2 = p0;
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+0 ], r0);
+        vst1q_u16(&w[num*15*SB2+16], r1);
+        vst1q_u16(&w[num*15*SB2+32], a1);
+                //p1
+        a1 = p1;
+        a2 = p81;
+        a0 = p821;
+
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+8 +1*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+24+1*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+40+1*3*SB2], a1);
+
+
+
+        a1 = p821;
+        a0 = p21;
+        a2 = p1;
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+0 +1*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+16+1*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+32+1*3*SB2], a1);
+                //p2
+        a1 = p2;
+        a2 = p82;
+        a0 = p822;
+
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+8 +2*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+24+2*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+40+2*3*SB2], a1);
+
+
+
+        a1 = p822;
+        a0 = p22;
+        a2 = p2;
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+0 +2*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+16+2*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+32+2*3*SB2], a1);
+                //p3
+        a1 = p3;
+        a2 = p83;
+        a0 = p823;
+
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+8 +3*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+24+3*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+40+3*3*SB2], a1);
+
+
+
+        a1 = p823;
+        a0 = p23;
+        a2 = p3;
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+0 +3*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+16+3*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+32+3*3*SB2], a1);
+                //p4
+        a1 = p4;
+        a2 = p84;
+        a0 = p824;
+
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+8 +4*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+24+4*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+40+4*3*SB2], a1);
+
+
+
+        a1 = p824;
+        a0 = p24;
+        a2 = p4;
+
+        r0 = vsubq_u16(a1, a2);
+        r1 = vsubq_u16(a0, a1);
+
+        vst1q_u16(&w[num*15*SB2+0 +4*3*SB2], r0);
+        vst1q_u16(&w[num*15*SB2+16+4*3*SB2], r1);
+        vst1q_u16(&w[num*15*SB2+32+4*3*SB2], a1);
+             }
+}
+/*
+w points to 5 (ordered) output 48x48 Toeplitz Matrix,
+src points to 1 input 144x144 Toeplitz Matrix
+*/
+void ittc3(uint16_t *restrict w, uint16_t *restrict src){
+    uint16_t *w0_mem =  &w[1*SB1],
+             *w1_mem =  &w[3*SB1],
+             *w2_mem =  &w[5*SB1],
+             *w3_mem =  &w[7*SB1],
+             *w4_mem =  &w[9*SB1],
+             *w20_mem = &w[0*SB1],
+             *w21_mem = &w[2*SB1],
+             *w22_mem = &w[4*SB1],
+             *w23_mem = &w[6*SB1],
+             *w24_mem = &w[8*SB1],
+
+             *c2 = &src[0*SB1+3*SB1],
+             *c3 = &src[1*SB1+3*SB1],
+             *c4 = &src[2*SB1+3*SB1],
+             *c1 = &src[2*SB1],
+             *c0 = &src[1*SB1],
+             *c20= &src[0*SB1];
+
+             uint16x8_t z0, z1, z2, z3, z4;
+             uint16x8_t p0, p1, p2, p3, p4;
+             uint16x8_t t0, t1;
+             uint16x8_t z20, z21, z22, z23, z24;
+             uint16x8_t p20, p21, p22, p23, p24;
+             uint16x8_t t20, t21;
+
+             for (uint16_t addr = 0; addr < SB1; addr+= 8) {
+                z0 = vld1q_u16(&c0[addr]);
+                z1 = vld1q_u16(&c1[addr]);
+                z2 = vld1q_u16(&c2[addr]);
+                z3 = vld1q_u16(&c3[addr]);
+                z4 = vld1q_u16(&c4[addr]);
+
+                p3 = vsubq_u16(z3, z1); //p3 = z3 - z1
+                p0 = vsubq_u16(z4, z2);
+                p0 = vshlq_n_u16(p0, 1);
+                p0 = vaddq_u16(p0, p3); //p0 =  2*z4 + z3 -2*z2 - z1
+
+                t0 = vsubq_u16(z2, z3); //t0 = z2 - z3
+                p1 = vshlq_n_u16(z2, 2);
+                p1 = vaddq_u16(p1, z3);
+                p1 = vaddq_u16(p1, z1);
+                p1 = vsubq_u16(p1, t0); //p1 = 2*z3 + 3*z2 + z1
+
+                p2 = vsubq_u16(t0, p3); //p2 = -2*z3 + z2 + z1
+
+                p4 = vsubq_u16(z0, z2);
+                t1 = vshlq_n_u16(p3, 1);
+                p4 = vsubq_u16(p4, t1); //p4 = -2*z3 - z2 + 2*z1 + z0
+
+                vst1q_u16(&w0_mem[addr], p0);
+                vst1q_u16(&w1_mem[addr], p1);
+                vst1q_u16(&w2_mem[addr], p2);
+                vst1q_u16(&w3_mem[addr], p3);
+                vst1q_u16(&w4_mem[addr], p4);
+
+                z20 = vld1q_u16(&c20[addr]);
+                z21 = z0;
+                z22 = z1;
+                z23 = z2;
+                z24 = z3;
+
+                p23 = vsubq_u16(z23, z21); //p23 = z23 - z21
+                p20 = vsubq_u16(z24, z22);
+                p20 = vshlq_n_u16(p20, 1);
+                p20 = vaddq_u16(p20, p23); //p20 =  2*z24 + z23 -2*z22 - z21
+
+                t20 = vsubq_u16(z22, z23); //t20 = z22 - z23
+                p21 = vshlq_n_u16(z22, 2);
+                p21 = vaddq_u16(p21, z23);
+                p21 = vaddq_u16(p21, z21);
+                p21 = vsubq_u16(p21, t20); //p21 = 2*z23 + 3*z22 + z21
+
+                p22 = vsubq_u16(t20, p23); //p22 = -2*z23 + z22 + z21
+
+                p24 = vsubq_u16(z20, z22);
+                t21 = vshlq_n_u16(p23, 1);
+                p24 = vsubq_u16(p24, t21); //p24 = -2*z23 - z22 + 2*z21 + z20
+
+                vst1q_u16(&w20_mem[addr], p20);
+                vst1q_u16(&w21_mem[addr], p21);
+                vst1q_u16(&w22_mem[addr], p22);
+                vst1q_u16(&w23_mem[addr], p23);
+                vst1q_u16(&w24_mem[addr], p24);
+             }
+}
+
+static void ext_copy(uint16_t *restrict dst, uint16_t *restrict src, size_t len){
+    for (size_t i = 0; i < len; i += 8) {
+        vst1q_u16(&dst[i], vld1q_u16(&src[i]));
+    }
+}
+
+/*
+ext points to 1 output size-(12*SB0) vector, the diagonals -6*SB0, ..., 6*SB0 - 1 of the 864x864 Toeplitz matrix of
+the multiplication by polynomial in Rq, ext[i] = polynomial[(i - 6*SB0) mod 821].
+The copies are rounded up to multiples of 8 coefficients, what each one writes past its end is overwritten by the next one.
+*/
+static void toeplitz_ext(uint16_t *restrict ext, uint16_t *restrict polynomial){
+    ext_copy(&ext[0], &polynomial[2*NTRU_N - 6*SB0], 6*SB0 - NTRU_N);
+    ext_copy(&ext[6*SB0 - NTRU_N], &polynomial[0], NTRU_N);
+    ext_copy(&ext[6*SB0], &polynomial[0], NTRU_N);
+    ext_copy(&ext[6*SB0 + NTRU_N], &polynomial[0], 6*SB0 - NTRU_N);
+}
+
+/*
+w points to 15 (ordered) output 144x144 Toeplitz matrix,
+polynomial points to 1 input 864x864 Toeplitz matrix
+
+The 288x288 matrix for each evaluation point of tc3 is a combination of the 5 block diagonals of the 3x3 blocks of
+the input, with the coefficients of the transposed interpolation of tc3 multiplied by 2 so that they are integers
+mod 2^16. ttc3k2 divides the result by 2.
+Each of them is split by k2 into the 3 matrices M0 = T(0), M1 = T(-1) - T(0) and M2 = T(1) - T(0) of its block
+diagonals T(-1), T(0) and T(1), which are made of its quarters q0, ..., q3: T(-1) = (q0, q1), T(0) = (q1, q2) and
+T(1) = (q2, q3). The quarter j of the block diagonal L of the input is e(8 - 2*L + j).
+*/
+void ittc3k2(uint16_t *restrict w, uint16_t *restrict polynomial){
+    uint16_t ext[12*SB0 + 8];
+    uint16_t *w0_mem = &w[0*SB0],
+             *w1_mem = &w[6*SB0],
+             *w2_mem = &w[12*SB0],
+             *w3_mem = &w[18*SB0],
+             *w4_mem = &w[24*SB0];
+
+             uint16x8_t e0, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11;
+             uint16x8_t q0, q1, q2, q3;
+
+             toeplitz_ext(ext, polynomial);
+
+             for (uint16_t addr = 0; addr < SB0; addr+= 8) {
+                e0 = vld1q_u16(&ext[0*SB0 + addr]);
+                e1 = vld1q_u16(&ext[1*SB0 + addr]);
+                e2 = vld1q_u16(&ext[2*SB0 + addr]);
+                e3 = vld1q_u16(&ext[3*SB0 + addr]);
+                e4 = vld1q_u16(&ext[4*SB0 + addr]);
+                e5 = vld1q_u16(&ext[5*SB0 + addr]);
+                e6 = vld1q_u16(&ext[6*SB0 + addr]);
+                e7 = vld1q_u16(&ext[7*SB0 + addr]);
+                e8 = vld1q_u16(&ext[8*SB0 + addr]);
+                e9 = vld1q_u16(&ext[9*SB0 + addr]);
+                e10 = vld1q_u16(&ext[10*SB0 + addr]);
+                e11 = vld1q_u16(&ext[11*SB0 + addr]);
+
+                // point 0
+                q0 = vshlq_n_u16(e8, 1);
+                q0 = vaddq_u16(q0, e6);
+                q0 = vmlsq_n_u16(q0, e4, 2);
+                q0 = vsubq_u16(q0, e2); // q0 = 2*e8 + e6 - 2*e4 - e2
+                q1 = vshlq_n_u16(e9, 1);
+                q1 = vaddq_u16(q1, e7);
+                q1 = vmlsq_n_u16(q1, e5, 2);
+                q1 = vsubq_u16(q1, e3); // q1 = 2*e9 + e7 - 2*e5 - e3
+                q2 = vshlq_n_u16(e10, 1);
+                q2 = vaddq_u16(q2, e8);
+                q2 = vmlsq_n_u16(q2, e6, 2);
+                q2 = vsubq_u16(q2, e4); // q2 = 2*e10 + e8 - 2*e6 - e4
+                q3 = vshlq_n_u16(e11, 1);
+                q3 = vaddq_u16(q3, e9);
+                q3 = vmlsq_n_u16(q3, e7, 2);
+                q3 = vsubq_u16(q3, e5); // q3 = 2*e11 + e9 - 2*e7 - e5
+
+                vst1q_u16(&w0_mem[0*SB0 + addr], q1); // M0 = (q1, q2)
+                vst1q_u16(&w0_mem[1*SB0 + addr], q2);
+                vst1q_u16(&w0_mem[2*SB0 + addr], vsubq_u16(q0, q1)); // M1 = (q0 - q1, q1 - q2)
+                vst1q_u16(&w0_mem[3*SB0 + addr], vsubq_u16(q1, q2));
+                vst1q_u16(&w0_mem[4*SB0 + addr], vsubq_u16(q2, q1)); // M2 = (q2 - q1, q3 - q2)
+                vst1q_u16(&w0_mem[5*SB0 + addr], vsubq_u16(q3, q2));
+
+                // point 1
+                q0 = vmulq_n_u16(e6, (uint16_t)(2*inv3));
+                q0 = vaddq_u16(q0, e4);
+                q0 = vmlaq_n_u16(q0, e2, (uint16_t)inv3); // q0 = 2/3*e6 + e4 + 1/3*e2
+                q1 = vmulq_n_u16(e7, (uint16_t)(2*inv3));
+                q1 = vaddq_u16(q1, e5);
+                q1 = vmlaq_n_u16(q1, e3, (uint16_t)inv3); // q1 = 2/3*e7 + e5 + 1/3*e3
+                q2 = vmulq_n_u16(e8, (uint16_t)(2*inv3));
+                q2 = vaddq_u16(q2, e6);
+                q2 = vmlaq_n_u16(q2, e4, (uint16_t)inv3); // q2 = 2/3*e8 + e6 + 1/3*e4
+                q3 = vmulq_n_u16(e9, (uint16_t)(2*inv3));
+                q3 = vaddq_u16(q3, e7);
+                q3 = vmlaq_n_u16(q3, e5, (uint16_t)inv3); // q3 = 2/3*e9 + e7 + 1/3*e5
+
+                vst1q_u16(&w1_mem[0*SB0 + addr], q1); // M0 = (q1, q2)
+                vst1q_u16(&w1_mem[1*SB0 + addr], q2);
+                vst1q_u16(&w1_mem[2*SB0 + addr], vsubq_u16(q0, q1)); // M1 = (q0 - q1, q1 - q2)
+                vst1q_u16(&w1_mem[3*SB0 + addr], vsubq_u16(q1, q2));
+                vst1q_u16(&w1_mem[4*SB0 + addr], vsubq_u16(q2, q1)); // M2 = (q2 - q1, q3 - q2)
+                vst1q_u16(&w1_mem[5*SB0 + addr], vsubq_u16(q3, q2));
+
+                // point -1
+                q0 = vmulq_n_u16(e6, (uint16_t)(-2));
+                q0 = vaddq_u16(q0, e4);
+                q0 = vaddq_u16(q0, e2); // q0 = -2*e6 + e4 + e2
+                q1 = vmulq_n_u16(e7, (uint16_t)(-2));
+                q1 = vaddq_u16(q1, e5);
+                q1 = vaddq_u16(q1, e3); // q1 = -2*e7 + e5 + e3
+                q2 = vmulq_n_u16(e8, (uint16_t)(-2));
+                q2 = vaddq_u16(q2, e6);
+                q2 = vaddq_u16(q2, e4); // q2 = -2*e8 + e6 + e4
+                q3 = vmulq_n_u16(e9, (uint16_t)(-2));
+                q3 = vaddq_u16(q3, e7);
+                q3 = vaddq_u16(q3, e5); // q3 = -2*e9 + e7 + e5
+
+                vst1q_u16(&w2_mem[0*SB0 + addr], q1); // M0 = (q1, q2)
+                vst1q_u16(&w2_mem[1*SB0 + addr], q2);
+                vst1q_u16(&w2_mem[2*SB0 + addr], vsubq_u16(q0, q1)); // M1 = (q0 - q1, q1 - q2)
+                vst1q_u16(&w2_mem[3*SB0 + addr], vsubq_u16(q1, q2));
+                vst1q_u16(&w2_mem[4*SB0 + addr], vsubq_u16(q2, q1)); // M2 = (q2 - q1, q3 - q2)
+                vst1q_u16(&w2_mem[5*SB0 + addr], vsubq_u16(q3, q2));
+
+                // point -2
+                q0 = vmulq_n_u16(e6, (uint16_t)inv3);
+                q0 = vmlsq_n_u16(q0, e2, (uint16_t)inv3); // q0 = 1/3*e6 - 1/3*e2
+                q1 = vmulq_n_u16(e7, (uint16_t)inv3);
+                q1 = vmlsq_n_u16(q1, e3, (uint16_t)inv3); // q1 = 1/3*e7 - 1/3*e3
+                q2 = vmulq_n_u16(e8, (uint16_t)inv3);
+                q2 = vmlsq_n_u16(q2, e4, (uint16_t)inv3); // q2 = 1/3*e8 - 1/3*e4
+                q3 = vmulq_n_u16(e9, (uint16_t)inv3);
+                q3 = vmlsq_n_u16(q3, e5, (uint16_t)inv3); // q3 = 1/3*e9 - 1/3*e5
+
+                vst1q_u16(&w3_mem[0*SB0 + addr], q1); // M0 = (q1, q2)
+                vst1q_u16(&w3_mem[1*SB0 + addr], q2);
+                vst1q_u16(&w3_mem[2*SB0 + addr], vsubq_u16(q0, q1)); // M1 = (q0 - q1, q1 - q2)
+                vst1q_u16(&w3_mem[3*SB0 + addr], vsubq_u16(q1, q2));
+                vst1q_u16(&w3_mem[4*SB0 + addr], vsubq_u16(q2, q1)); // M2 = (q2 - q1, q3 - q2)
+                vst1q_u16(&w3_mem[5*SB0 + addr], vsubq_u16(q3, q2));
+
+                // point inf
+                q0 = vmulq_n_u16(e6, (uint16_t)(-4));
+                q0 = vmlsq_n_u16(q0, e4, 2);
+                q0 = vmlaq_n_u16(q0, e2, 4);
+                q0 = vmlaq_n_u16(q0, e0, 2); // q0 = -4*e6 - 2*e4 + 4*e2 + 2*e0
+                q1 = vmulq_n_u16(e7, (uint16_t)(-4));
+                q1 = vmlsq_n_u16(q1, e5, 2);
+                q1 = vmlaq_n_u16(q1, e3, 4);
+                q1 = vmlaq_n_u16(q1, e1, 2); // q1 = -4*e7 - 2*e5 + 4*e3 + 2*e1
+                q2 = vmulq_n_u16(e8, (uint16_t)(-4));
+                q2 = vmlsq_n_u16(q2, e6, 2);
+                q2 = vmlaq_n_u16(q2, e4, 4);
+                q2 = vmlaq_n_u16(q2, e2, 2); // q2 = -4*e8 - 2*e6 + 4*e4 + 2*e2
+                q3 = vmulq_n_u16(e9, (uint16_t)(-4));
+                q3 = vmlsq_n_u16(q3, e7, 2);
+                q3 = vmlaq_n_u16(q3, e5, 4);
+                q3 = vmlaq_n_u16(q3, e3, 2); // q3 = -4*e9 - 2*e7 + 4*e5 + 2*e3
+
+                vst1q_u16(&w4_mem[0*SB0 + addr], q1); // M0 = (q1, q2)
+                vst1q_u16(&w4_mem[1*SB0 + addr], q2);
+                vst1q_u16(&w4_mem[2*SB0 + addr], vsubq_u16(q0, q1)); // M1 = (q0 - q1, q1 - q2)
+                vst1q_u16(&w4_mem[3*SB0 + addr], vsubq_u16(q1, q2));
+                vst1q_u16(&w4_mem[4*SB0 + addr], vsubq_u16(q2, q1)); // M2 = (q2 - q1, q3 - q2)
+                vst1q_u16(&w4_mem[5*SB0 + addr], vsubq_u16(q3, q2));
+             }
+}
+
+/*
+Because the output has only degree 821, omit the calculation of 824-864
+
+w points to 15 (ordered) input size-144 vectors,
+polynomial points to 1 output size-864 vector
+
+The outputs of the k2 of point p are v = (w[3p] + w[3p+1], w[3p] + w[3p+2]).
+*/
+void ttc3k2(uint16_t *restrict polynomial, uint16_t *restrict w){
+    uint16_t *w0_mem = &w[0*SB0],
+             *w1_mem = &w[3*SB0],
+             *w2_mem = &w[6*SB0],
+             *w3_mem = &w[9*SB0],
+             *w4_mem = &w[12*SB0],
+             *dst0 = &polynomial[0*SB0],
+             *dst1 = &polynomial[2*SB0],
+             *dst2 = &polynomial[4*SB0];
+
+             uint16x8_t p0, p1, p2, p3, p4, h0, h1, h2, h3, h4;
+             uint16x8_t k0, k1, k2;
+             uint16x8_t mask;
+             mask = vdupq_n_u16(MASK);
+
+             for (uint16_t addr = 0; addr < SB0; addr+= 8){
+                k0 = vld1q_u16(&w0_mem[addr]);
+                p0 = vaddq_u16(k0, vld1q_u16(&w0_mem[SB0 + addr]));
+                h0 = vaddq_u16(k0, vld1q_u16(&w0_mem[2*SB0 + addr]));
+                k0 = vld1q_u16(&w1_mem[addr]);
+                p1 = vaddq_u16(k0, vld1q_u16(&w1_mem[SB0 + addr]));
+                h1 = vaddq_u16(k0, vld1q_u16(&w1_mem[2*SB0 + addr]));
+                k0 = vld1q_u16(&w2_mem[addr]);
+                p2 = vaddq_u16(k0, vld1q_u16(&w2_mem[SB0 + addr]));
+                h2 = vaddq_u16(k0, vld1q_u16(&w2_mem[2*SB0 + addr]));
+                k0 = vld1q_u16(&w3_mem[addr]);
+                p3 = vaddq_u16(k0, vld1q_u16(&w3_mem[SB0 + addr]));
+                h3 = vaddq_u16(k0, vld1q_u16(&w3_mem[2*SB0 + addr]));
+                k0 = vld1q_u16(&w4_mem[addr]);
+                p4 = vaddq_u16(k0, vld1q_u16(&w4_mem[SB0 + addr]));
+                h4 = vaddq_u16(k0, vld1q_u16(&w4_mem[2*SB0 + addr]));
+
+                k0 = vaddq_u16(p1, p2);
+                k0 = vaddq_u16(k0, p4);
+                k0 = vmlaq_n_u16(k0, p3, 4); //k0 = p1 + p2 + 4*p3 + p4
+                k0 = vshrq_n_u16(k0, 1);
+
+                k1 = vsubq_u16(p1, p2);
+                k1 = vmlsq_n_u16(k1, p3, 2); //k1 = p1 - p2 - 2*p3
+                k1 = vshrq_n_u16(k1, 1);
+
+                k2 = vaddq_u16(p0, p1);
+                k2 = vaddq_u16(k2, p2);
+                k2 = vaddq_u16(k2, p3); //k2 = p0 + p1 + p2 + p3
+                k2 = vshrq_n_u16(k2, 1);
+
+                k0 = vandq_u16(k0, mask);
+                k1 = vandq_u16(k1, mask);
+                k2 = vandq_u16(k2, mask);
+                vst1q_u16(&dst0[addr], k0);
+                vst1q_u16(&dst1[addr], k1);
+                vst1q_u16(&dst2[addr], k2);
+
+                k0 = vaddq_u16(h1, h2);
+                k0 = vaddq_u16(k0, h4);
+                k0 = vmlaq_n_u16(k0, h3, 4); //k0 = h1 + h2 + 4*h3 + h4
+                k0 = vshrq_n_u16(k0, 1);
+
+                k1 = vsubq_u16(h1, h2);
+                k1 = vmlsq_n_u16(k1, h3, 2); //k1 = h1 - h2 - 2*h3
+                k1 = vshrq_n_u16(k1, 1);
+
+                k0 = vandq_u16(k0, mask);
+                k1 = vandq_u16(k1, mask);
+                vst1q_u16(&dst0[SB0 + addr], k0);
+                vst1q_u16(&dst1[SB0 + addr], k1);
+
+                if (addr < 8*13) {
+                    k2 = vaddq_u16(h0, h1);
+                    k2 = vaddq_u16(k2, h2);
+                    k2 = vaddq_u16(k2, h3); //k2 = h0 + h1 + h2 + h3
+                    k2 = vshrq_n_u16(k2, 1);
+                    k2 = vandq_u16(k2, mask);
+                    vst1q_u16(&dst2[SB0 + addr], k2);
+                }
+             }
+}
+
+/*
+Because the input has only degree 821, omit the calculation of 824-864
+
+w points to 15 (ordered) output size-144 vectors,
+polynomial points to 1 input size-864 vector
+
+The k2 of the value a = (a0, a1) at point p is w[3p] = a0 + a1, w[3p+1] = a1 and w[3p+2] = a0.
+*/
+void tc3k2(uint16_t *restrict w, uint16_t *restrict polynomial) {
+    uint16_t *w0_mem = &w[0*SB0],
+             *w1_mem = &w[3*SB0],
+             *w2_mem = &w[6*SB0],
+             *w3_mem = &w[9*SB0],
+             *w4_mem = &w[12*SB0],
+             *c0 = &polynomial[0*SB0],
+             *c1 = &polynomial[2*SB0],
+             *c2 = &polynomial[4*SB0];
+    uint16x8_t r0, r1, r2, h0, h1, h2, p0, p1, p_1;
+    uint16x8_t zero;
+    zero = vmovq_n_u16(0);
+    for (uint16_t addr = 0; addr < SB0; addr+= 8){
+        r0 = vld1q_u16(&c0[addr]);
+        r1 = vld1q_u16(&c1[addr]);
+        r2 = vld1q_u16(&c2[addr]);
+        h0 = vld1q_u16(&c0[SB0 + addr]);
+        h1 = vld1q_u16(&c1[SB0 + addr]);
+        h2 = (addr < 8*13) ? vld1q_u16(&c2[SB0 + addr]) : zero;
+
+        vst1q_u16(&w0_mem[addr], vaddq_u16(r0, h0)); // A(0)   = r0
+        vst1q_u16(&w0_mem[SB0 + addr], h0);
+        vst1q_u16(&w0_mem[2*SB0 + addr], r0);
+        vst1q_u16(&w4_mem[addr], vaddq_u16(r2, h2)); // A(inf) = r2
+        vst1q_u16(&w4_mem[SB0 + addr], h2);
+        vst1q_u16(&w4_mem[2*SB0 + addr], r2);
+
+        p0 = vaddq_u16(r0, r2);   // p0  = r0 + r2
+        p1 = vaddq_u16(p0, r1);   // p1  = r0 + r1 + r2
+        p_1 = vsubq_u16(p0, r1);  // p_1 = r0 - r1 + r2
+        vst1q_u16(&w1_mem[2*SB0 + addr], p1);  // A(1)  = r0 + r1 + r2
+        vst1q_u16(&w2_mem[2*SB0 + addr], p_1); // A(-1) = r0 - r1 + r2
+        p0 = vaddq_u16(p_1, r2);
+        p0 = vshlq_n_u16(p0, 1);
+        p0 = vsubq_u16(p0, r0);   // p0  = 2*(p_1 + r2) - r0 = r0 - 2*r1 + 4*r2
+        vst1q_u16(&w3_mem[2*SB0 + addr], p0);  // A(-2) = r0 - 2*r1 + 4*r2
+
+        r0 = vaddq_u16(h0, h2);   // r0  = h0 + h2
+        r2 = vaddq_u16(r0, h1);   // r2  = h0 + h1 + h2
+        r0 = vsubq_u16(r0, h1);   // r0  = h0 - h1 + h2
+        vst1q_u16(&w1_mem[SB0 + addr], r2);
+        vst1q_u16(&w1_mem[addr], vaddq_u16(p1, r2));
+        vst1q_u16(&w2_mem[SB0 + addr], r0);
+        vst1q_u16(&w2_mem[addr], vaddq_u16(p_1, r0));
+        r0 = vaddq_u16(r0, h2);
+        r0 = vshlq_n_u16(r0, 1);
+        r0 = vsubq_u16(r0, h0);   // r0  = h0 - 2*h1 + 4*h2
+        vst1q_u16(&w3_mem[SB0 + addr], r0);
+        vst1q_u16(&w3_mem[addr], vaddq_u16(p0, r0));
+    }
+}
+
+
+/*
+w points to 25 (ordered) output size-16 vectors,
+src points to 1 input size-144 vector
+*/
+void tc33(uint16_t *restrict w, uint16_t *restrict src) {
+    uint16_t *c0 = &src[0*SB2],
+             *c1 = &src[1*SB2],
+             *c2 = &src[2*SB2],
+             *c3 = &src[3*SB2],
+             *c4 = &src[4*SB2],
+             *c5 = &src[5*SB2],
+             *c6 = &src[6*SB2],
+             *c7 = &src[7*SB2],
+             *c8 = &src[8*SB2],
+             *w00 = &w[ 0*SB2],
+             *w01 = &w[ 1*SB2],
+             *w02 = &w[ 2*SB2],
+             *w03 = &w[ 3*SB2],
+             *w04 = &w[ 4*SB2],
+             *w05 = &w[ 5*SB2],
+             *w06 = &w[ 6*SB2],
+             *w07 = &w[ 7*SB2],
+             *w08 = &w[ 8*SB2],
+             *w09 = &w[ 9*SB2],
+             *w10 = &w[10*SB2],
+             *w11 = &w[11*SB2],
+             *w12 = &w[12*SB2],
+             *w13 = &w[13*SB2],
+             *w14 = &w[14*SB2],
+             *w15 = &w[15*SB2],
+             *w16 = &w[16*SB2],
+             *w17 = &w[17*SB2],
+             *w18 = &w[18*SB2],
+             *w19 = &w[19*SB2],
+             *w20 = &w[20*SB2],
+             *w21 = &w[21*SB2],
+             *w22 = &w[22*SB2],
+             *w23 = &w[23*SB2],
+             *w24 = &w[24*SB2];
+    // Utilize 22 SIMD registers
+    uint16x8_t a0, a1, a2, a3, a4, a5, a6, a7, a8, //9
+               tmp0, tmp1, tmp2, tmp3, // 4
+               s0, s1, s2, // 3
+               e0, e1, e2, // 3
+               t0, t1, t2; // 3
+    for (uint16_t addr = 0; addr < SB2; addr+=8)
+    {
+        a0 = vld1q_u16(&c0[addr]);
+        a1 = vld1q_u16(&c1[addr]);
+        a2 = vld1q_u16(&c2[addr]);
+        a3 = vld1q_u16(&c3[addr]);
+        a4 = vld1q_u16(&c4[addr]);
+        a5 = vld1q_u16(&c5[addr]);
+        a6 = vld1q_u16(&c6[addr]);
+        a7 = vld1q_u16(&c7[addr]);
+        a8 = vld1q_u16(&c8[addr]);
+
+        tmp0 = vaddq_u16(a2, a0);
+        tmp1 = vaddq_u16(tmp0, a1);
+        tmp2 = vsubq_u16(tmp0, a1);
+        tmp3 = vaddq_u16(tmp2, a2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, a0);
+
+        vst1q_u16(&w00[addr], a0);
+        vst1q_u16(&w01[addr], tmp1);
+        vst1q_u16(&w02[addr], tmp2);
+        vst1q_u16(&w03[addr], tmp3);
+        vst1q_u16(&w04[addr], a2);
+
+        tmp0 = vaddq_u16(a8, a6);
+        tmp1 = vaddq_u16(tmp0, a7);
+        tmp2 = vsubq_u16(tmp0, a7);
+        tmp3 = vaddq_u16(tmp2, a8);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, a6);
+
+        vst1q_u16(&w20[addr], a6);
+        vst1q_u16(&w21[addr], tmp1);
+        vst1q_u16(&w22[addr], tmp2);
+        vst1q_u16(&w23[addr], tmp3);
+        vst1q_u16(&w24[addr], a8);
+
+        s0 = vaddq_u16(a0, a6);
+        s1 = vaddq_u16(a1, a7);
+        s2 = vaddq_u16(a2, a8);
+
+        e0 = vaddq_u16(s0, a3);
+        e1 = vaddq_u16(s1, a4);
+        e2 = vaddq_u16(s2, a5);
+
+        tmp0 = vaddq_u16(e2, e0);
+        tmp1 = vaddq_u16(tmp0, e1);
+        tmp2 = vsubq_u16(tmp0, e1);
+        tmp3 = vaddq_u16(tmp2, e2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, e0);
+
+        vst1q_u16(&w05[addr], e0);
+        vst1q_u16(&w06[addr], tmp1);
+        vst1q_u16(&w07[addr], tmp2);
+        vst1q_u16(&w08[addr], tmp3);
+        vst1q_u16(&w09[addr], e2);
+
+        e0 = vsubq_u16(s0, a3);
+        e1 = vsubq_u16(s1, a4);
+        e2 = vsubq_u16(s2, a5);
+
+        tmp0 = vaddq_u16(e2, e0);
+        tmp1 = vaddq_u16(tmp0, e1);
+        tmp2 = vsubq_u16(tmp0, e1);
+        tmp3 = vaddq_u16(tmp2, e2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, e0);
+
+        vst1q_u16(&w10[addr], e0);
+        vst1q_u16(&w11[addr], tmp1);
+        vst1q_u16(&w12[addr], tmp2);
+        vst1q_u16(&w13[addr], tmp3);
+        vst1q_u16(&w14[addr], e2);
+
+        t0 = vshlq_n_u16(a6, 1);
+        t1 = vshlq_n_u16(a7, 1);
+        t2 = vshlq_n_u16(a8, 1);
+        t0 = vsubq_u16(t0, a3);
+        t1 = vsubq_u16(t1, a4);
+        t2 = vsubq_u16(t2, a5);
+        t0 = vshlq_n_u16(t0, 1);
+        t1 = vshlq_n_u16(t1, 1);
+        t2 = vshlq_n_u16(t2, 1);
+        t0 = vaddq_u16(t0, a0);
+        t1 = vaddq_u16(t1, a1);
+        t2 = vaddq_u16(t2, a2);
+
+        tmp0 = vaddq_u16(t2, t0);
+        tmp1 = vaddq_u16(tmp0, t1);
+        tmp2 = vsubq_u16(tmp0, t1);
+        tmp3 = vaddq_u16(tmp2, t2);
+        tmp3 = vshlq_n_u16(tmp3, 1);
+        tmp3 = vsubq_u16(tmp3, t0);
+
+        vst1q_u16(&w15[addr], t0);
+        vst1q_u16(&w16[addr], tmp1);
+        vst1q_u16(&w17[addr], tmp2);
+        vst1q_u16(&w18[addr], tmp3);
+        vst1q_u16(&w19[addr], t2);
+    }
+}
+
+/*
+w points to 25 (ordered) input size-16 vectors,
+src points to 1 output size-144 vector
+*/
+
+void ttc33(uint16_t *restrict src, uint16_t *restrict w){
+    uint16_t *k0 = &src[0*SB2],
+             *k1 = &src[1*SB2],
+             *k2 = &src[2*SB2],
+             *k3 = &src[3*SB2],
+             *k4 = &src[4*SB2],
+             *k5 = &src[5*SB2],
+             *k6 = &src[6*SB2],
+             *k7 = &src[7*SB2],
+             *k8 = &src[8*SB2],
+             *w00 = &w[ 0*SB2],
+             *w01 = &w[ 1*SB2],
+             *w02 = &w[ 2*SB2],
+             *w03 = &w[ 3*SB2],
+             *w04 = &w[ 4*SB2],
+             *w05 = &w[ 5*SB2],
+             *w06 = &w[ 6*SB2],
+             *w07 = &w[ 7*SB2],
+             *w08 = &w[ 8*SB2],
+             *w09 = &w[ 9*SB2],
+             *w10 = &w[10*SB2],
+             *w11 = &w[11*SB2],
+             *w12 = &w[12*SB2],
+             *w13 = &w[13*SB2],
+             *w14 = &w[14*SB2],
+             *w15 = &w[15*SB2],
+             *w16 = &w[16*SB2],
+             *w17 = &w[17*SB2],
+             *w18 = &w[18*SB2],
+             *w19 = &w[19*SB2],
+             *w20 = &w[20*SB2],
+             *w21 = &w[21*SB2],
+             *w22 = &w[22*SB2],
+             *w23 = &w[23*SB2],
+             *w24 = &w[24*SB2];
+
+             uint16x8_t p0, p1, p2, p3, p4, p5, p6, p7, p8, p9;
+             uint16x8_t p10, p11, p12, p13, p14, p15, p16, p17, p18, p19;
+             uint16x8_t p20, p21, p22, p23, p24;
+             uint16x8_t tmp;
+             uint16x8_t c0, c1, c2, c3, c4, c5, c6, c7, c8, c9;
+             uint16x8_t c10, c11, c12, c13, c14;
+
+             for (uint16_t addr = 0; addr < SB2; addr+= 8){
+//P0
+                p0 = vld1q_u16(&w00[addr]);
+                p1 = vld1q_u16(&w01[addr]);
+                p1 = vmulq_n_u16(p1, inv3);
+                p2 = vld1q_u16(&w02[addr]);
+                p3 = vld1q_u16(&w03[addr]);
+                p3 = vmulq_n_u16(p3, inv3);
+                p4 = vld1q_u16(&w04[addr]);
+
+                tmp = vshlq_n_u16(p3, 2);
+                tmp = vaddq_u16(tmp, p1);
+                tmp = vaddq_u16(tmp, p2);
+                c0 = vshrq_n_u16(tmp, 1);
+                c0 = vaddq_u16(c0, p4);
+
+                tmp = vsubq_u16(p1, p2);
+                tmp = vshrq_n_u16(tmp, 1);
+                c1 = vsubq_u16(tmp, p3);
+
+                tmp = vaddq_u16(p1, p2);
+                tmp = vaddq_u16(tmp, p3);
+                tmp = vaddq_u16(tmp, p0);
+                c2 = vshrq_n_u16(tmp, 1);
+
+
+//P1
+                p5 = vld1q_u16(&w05[addr]);
+                p6 = vld1q_u16(&w06[addr]);
+                p6 = vmulq_n_u16(p6, inv3);
+                p7 = vld1q_u16(&w07[addr]);
+                p8 = vld1q_u16(&w08[addr]);
+                p8 = vmulq_n_u16(p8, inv3);
+                p9 = vld1q_u16(&w09[addr]);
+
+                tmp = vshlq_n_u16(p8, 2);
+                tmp = vaddq_u16(tmp, p6);
+                tmp = vaddq_u16(tmp, p7);
+                c3 = vshrq_n_u16(tmp, 1);
+                c3 = vaddq_u16(c3, p9);
+
+                tmp = vsubq_u16(p6, p7);
+                tmp = vshrq_n_u16(tmp, 1);
+                c4 = vsubq_u16(tmp, p8);
+
+                tmp = vaddq_u16(p6, p7);
+                tmp = vaddq_u16(tmp, p8);
+                tmp = vaddq_u16(tmp, p5);
+                c5 = vshrq_n_u16(tmp, 1);
+
+
+//P2
+                p10 = vld1q_u16(&w10[addr]);
+                p11 = vld1q_u16(&w11[addr]);
+                p11 = vmulq_n_u16(p11, inv3);
+                p12 = vld1q_u16(&w12[addr]);
+                p13 = vld1q_u16(&w13[addr]);
+                p13 = vmulq_n_u16(p13, inv3);
+                p14 = vld1q_u16(&w14[addr]);
+
+                tmp = vshlq_n_u16(p13, 2);
+                tmp = vaddq_u16(tmp, p11);
+                tmp = vaddq_u16(tmp, p12);
+                c6 = vshrq_n_u16(tmp, 1);
+                c6 = vaddq_u16(c6, p14);
+
+                tmp = vsubq_u16(p11, p12);
+                tmp = vshrq_n_u16(tmp, 1);
+                c7 = vsubq_u16(tmp, p13);
+
+                tmp = vaddq_u16(p11, p12);
+                tmp = vaddq_u16(tmp, p13);
+                tmp = vaddq_u16(tmp, p10);
+                c8 = vshrq_n_u16(tmp, 1);
+
+
+//P3
+                p15 = vld1q_u16(&w15[addr]);
+                p16 = vld1q_u16(&w16[addr]);
+                p16 = vmulq_n_u16(p16, inv3);
+                p17 = vld1q_u16(&w17[addr]);
+                p18 = vld1q_u16(&w18[addr]);
+                p18 = vmulq_n_u16(p18, inv3);
+                p19 = vld1q_u16(&w19[addr]);
+
+                tmp = vshlq_n_u16(p18, 2);
+                tmp = vaddq_u16(tmp, p16);
+                tmp = vaddq_u16(tmp, p17);
+                c9 = vshrq_n_u16(tmp, 1);
+                c9 = vaddq_u16(c9, p19);
+
+                tmp = vsubq_u16(p16, p17);
+                tmp = vshrq_n_u16(tmp, 1);
+                c10 = vsubq_u16(tmp, p18);
+
+                tmp = vaddq_u16(p16, p17);
+                tmp = vaddq_u16(tmp, p18);
+                tmp = vaddq_u16(tmp, p15);
+                c11 = vshrq_n_u16(tmp, 1);
+
+
+//P4
+                p20 = vld1q_u16(&w20[addr]);
+                p21 = vld1q_u16(&w21[addr]);
+                p21 = vmulq_n_u16(p21, inv3);
+                p22 = vld1q_u16(&w22[addr]);
+                p23 = vld1q_u16(&w23[addr]);
+                p23 = vmulq_n_u16(p23, inv3);
+                p24 = vld1q_u16(&w24[addr]);
+
+                tmp = vshlq_n_u16(p23, 2);
+                tmp = vaddq_u16(tmp, p21);
+                tmp = vaddq_u16(tmp, p22);
+                c12 = vshrq_n_u16(tmp, 1);
+                c12 = vaddq_u16(c12, p24);
+
+                tmp = vsubq_u16(p21, p22);
+                tmp = vshrq_n_u16(tmp, 1);
+                c13 = vsubq_u16(tmp, p23);
+
+                tmp = vaddq_u16(p21, p22);
+                tmp = vaddq_u16(tmp, p23);
+                tmp = vaddq_u16(tmp, p20);
+                c14 = vshrq_n_u16(tmp, 1);
+
+
+//P1, P3 div by 3
+                c3 = vmulq_n_u16(c3, inv3);
+                c4 = vmulq_n_u16(c4, inv3);
+                c5 = vmulq_n_u16(c5, inv3);
+
+                c9 = vmulq_n_u16(c9, inv3);
+                c10 = vmulq_n_u16(c10, inv3);
+                c11 = vmulq_n_u16(c11, inv3);
+
+
+//K0
+                tmp = vshlq_n_u16(c9, 2);
+                tmp = vaddq_u16(tmp, c3);
+                tmp = vaddq_u16(tmp, c6);
+                tmp = vshrq_n_u16(tmp, 1);
+                tmp = vaddq_u16(tmp, c12);
+                vst1q_u16(&k0[addr], tmp);
+
+                tmp = vsubq_u16(c3, c6);
+                tmp = vshrq_n_u16(tmp, 1);
+                tmp = vsubq_u16(tmp, c9);
+                vst1q_u16(&k3[addr], tmp);
+
+                tmp = vaddq_u16(c3, c6);
+                tmp = vaddq_u16(tmp, c9);
+                tmp = vaddq_u16(tmp, c0);
+                tmp = vshrq_n_u16(tmp, 1);
+                vst1q_u16(&k6[addr], tmp);
+
+
+//K1
+                tmp = vshlq_n_u16(c10, 2);
+                tmp = vaddq_u16(tmp, c4);
+                tmp = vaddq_u16(tmp, c7);
+                tmp = vshrq_n_u16(tmp, 1);
+                tmp = vaddq_u16(tmp, c13);
+                vst1q_u16(&k1[addr], tmp);
+
+                tmp = vsubq_u16(c4, c7);
+                tmp = vshrq_n_u16(tmp, 1);
+                tmp = vsubq_u16(tmp, c10);
+                vst1q_u16(&k4[addr], tmp);
+
+                tmp = vaddq_u16(c4, c7);
+                tmp = vaddq_u16(tmp, c10);
+                tmp = vaddq_u16(tmp, c1);
+                tmp = vshrq_n_u16(tmp, 1);
+                vst1q_u16(&k7[addr], tmp);
+
+
+//K2
+                tmp = vshlq_n_u16(c11, 2);
+                tmp = vaddq_u16(tmp, c5);
+                tmp = vaddq_u16(tmp, c8);
+                tmp = vshrq_n_u16(tmp, 1);
+                tmp = vaddq_u16(tmp, c14);
+                vst1q_u16(&k2[addr], tmp);
+
+                tmp = vsubq_u16(c5, c8);
+                tmp = vshrq_n_u16(tmp, 1);
+                tmp = vsubq_u16(tmp, c11);
+                vst1q_u16(&k5[addr], tmp);
+
+                tmp = vaddq_u16(c5, c8);
+                tmp = vaddq_u16(tmp, c11);
+                tmp = vaddq_u16(tmp, c2);
+                tmp = vshrq_n_u16(tmp, 1);
+                vst1q_u16(&k8[addr], tmp);
+
+             }
+}
+
+/*
+toeplitz matrix:
+    tmvp3_split -> tmvp32_split -> mixed schoolbook
+input vector:
+    tmvp33_split -> mixed schoolbook
+
+mixed schoolbook:
+    vertor: tmvp2_split -> schoolbook
+
+schoolbook: 8*8 toeplitz matrix to vector -> tmvp2_combine
+
+output vector: tmvp33_combine
+*/
+void tmvp33(uint16_t *restrict polyC, uint16_t *restrict toepA, uint16_t *restrict polyB) {
+    uint16_t toepa332[TMVP33_EXPANDED];
+
+    tmvp33_expand(toepa332, toepA);
+    tmvp33_expanded(polyC, toepa332, polyB);
+}
+
+/*
+The toeplitz matrix part of tmvp33, it only depends on toepA.
+*/
+void tmvp33_expand(uint16_t *restrict toepa332, uint16_t *restrict toepA) {
+    uint16_t toepa3[SB1 * 5 * 2]; // SB1 = 48
+
+    ittc3(toepa3, toepA);
+    ittc32(toepa332, toepa3);
+}
+
+void tmvp33_expanded(uint16_t *restrict polyC, const uint16_t *restrict toepa332, uint16_t *restrict polyB) {
+    uint16_t kbcw[5 * 5 * SB2];
+
+    tc33(kbcw, polyB);
+
+    tmvp2_8x8(kbcw, (uint16_t *)toepa332);
+
+    ttc33(polyC, kbcw);
+}
+
+/*
+tmvp3k2332 method.
+1 tmvp3, 5 tmvp2 (k2), and 15 tmvp332.
+*/
+void tmvp(uint16_t *restrict polyC, uint16_t *restrict polyA, uint16_t *restrict polyB){
+    uint16_t tmp[SB0 * 15 * 4]; // SB0 = 144
+
+    uint16_t *toepa = &tmp[0 * SB0]; /* fifteen 144*144 toeplitz matrix, needs fifteen length-288 vectors to store */
+    uint16_t *kbw   = &tmp[30* SB0]; /* fifteen 144*144 vectors*/
+    uint16_t *kcw   = &tmp[45* SB0]; /* fifteen 144*144 vectors*/
+
+    ittc3k2(toepa, polyA);
+
+    tc3k2(kbw, polyB);
+
+    for(int i = 0; i < 15; i++){
+        tmvp33(&kcw[i * SB0], &toepa[i * SB0 * 2], &kbw[i * SB0]);
+    }
+
+    ttc3k2(polyC, kcw);
+
+}
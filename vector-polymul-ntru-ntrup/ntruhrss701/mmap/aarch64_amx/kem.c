@@ -1,24 +1,41 @@
+#include <stddef.h>
+
 #include "api.h"
 #include "cmov.h"
 #include "fips202.h"
+#include "fips202x.h"
 #include "owcpa.h"
 #include "params.h"
 #include "randombytes.h"
 #include "sample.h"
 #include "memory_alloc.h"
 
+// The expanded secret key of crypto_kem_sk_expand holds f, finv3 and invh in evaluated form, then the PRF key
+#define NTRU_SK_EXPANDED_PRFKEY (3 * sizeof(poly_expanded))
+
+// api.h sizes the expanded keys for every multiplier that shares it (aarch64_tc and AMX use the aarch64_tmvp api.h)
+__extension__ _Static_assert(CRYPTO_PUBLICKEYEXPANDEDBYTES >= sizeof(poly_expanded),
+                             "CRYPTO_PUBLICKEYEXPANDEDBYTES cannot hold the expanded public key");
+__extension__ _Static_assert(CRYPTO_SECRETKEYEXPANDEDBYTES >= NTRU_SK_EXPANDED_PRFKEY + NTRU_PRFKEYBYTES,
+                             "CRYPTO_SECRETKEYEXPANDEDBYTES cannot hold the expanded secret key");
+
 // API FUNCTIONS
-int crypto_kem_keypair(uint8_t *pk, uint8_t *sk) {
+int crypto_kem_keypair_ctx(randombytes_ctx_t *ctx, uint8_t *pk, uint8_t *sk) {
     uint8_t seed[NTRU_SAMPLE_FG_BYTES];
 
-    randombytes(seed, NTRU_SAMPLE_FG_BYTES);
+    randombytes_ctx(ctx, seed, NTRU_SAMPLE_FG_BYTES);
     owcpa_keypair(pk, sk, seed);
 
-    randombytes(sk + NTRU_OWCPA_SECRETKEYBYTES, NTRU_PRFKEYBYTES);
+    randombytes_ctx(ctx, sk + NTRU_OWCPA_SECRETKEYBYTES, NTRU_PRFKEYBYTES);
 
     return 0;
 }
 
+int crypto_kem_keypair(uint8_t *pk, uint8_t *sk) {
+    return crypto_kem_keypair_ctx(NULL, pk, sk);
+}
+
+// Shared by all threads, like the buffers of owcpa.c: the mmap builds are not thread-safe (see api.h)
 static poly *r_, *m_;
 
 __attribute__((constructor)) static void alloc_r_m(void) {
@@ -26,13 +43,14 @@ __attribute__((constructor)) static void alloc_r_m(void) {
     m_ = MEMORY_ALLOC(32 * ((NTRU_N + 31) / 32) * sizeof(uint16_t));
 }
 
-int crypto_kem_enc(uint8_t *c, uint8_t *k, const uint8_t *pk) {
-    poly *r = r_, *m = m_;
+// Samples r and m, derives the shared secret k from them and lifts r to the ring, the part of
+// encapsulation that does not depend on the public key
+static void crypto_kem_enc_sample(randombytes_ctx_t *ctx, uint8_t *k, poly *r, poly *m) {
 
     uint8_t rm[NTRU_OWCPA_MSGBYTES];
     uint8_t rm_seed[NTRU_SAMPLE_RM_BYTES];
 
-    randombytes(rm_seed, NTRU_SAMPLE_RM_BYTES);
+    randombytes_ctx(ctx, rm_seed, NTRU_SAMPLE_RM_BYTES);
 
     sample_rm(r, m, rm_seed);
 
@@ -41,32 +59,96 @@ int crypto_kem_enc(uint8_t *c, uint8_t *k, const uint8_t *pk) {
     sha3_256(k, rm, NTRU_OWCPA_MSGBYTES);
 
     poly_Z3_to_SignedZ3(r);
+}
+
+int crypto_kem_enc_ctx(randombytes_ctx_t *ctx, uint8_t *c, uint8_t *k, const uint8_t *pk) {
+    poly *r = r_, *m = m_;
+
+    crypto_kem_enc_sample(ctx, k, r, m);
     owcpa_enc(c, r, m, pk);
 
     return 0;
 }
 
+int crypto_kem_enc(uint8_t *c, uint8_t *k, const uint8_t *pk) {
+    return crypto_kem_enc_ctx(NULL, c, k, pk);
+}
+
+int crypto_kem_pk_expand(uint8_t *pk_expanded, const uint8_t *pk) {
+    owcpa_pk_expand((poly_expanded *)pk_expanded, pk);
+
+    return 0;
+}
+
+int crypto_kem_enc_expanded_ctx(randombytes_ctx_t *ctx, uint8_t *c, uint8_t *k, const uint8_t *pk_expanded) {
+    poly *r = r_, *m = m_;
+
+    crypto_kem_enc_sample(ctx, k, r, m);
+    owcpa_enc_expanded(c, r, m, (const poly_expanded *)pk_expanded);
+
+    return 0;
+}
+
+int crypto_kem_enc_expanded(uint8_t *c, uint8_t *k, const uint8_t *pk_expanded) {
+    return crypto_kem_enc_expanded_ctx(NULL, c, k, pk_expanded);
+}
+
+// Derives the shared secret from the decrypted message rm, or from the PRF key and c if decryption failed
+static void crypto_kem_dec_finish(uint8_t *k, const uint8_t *c, const uint8_t *prfkey,
+                                  const uint8_t *rm, int fail) {
+    int i;
+    uint8_t k_rej[NTRU_SHAREDKEYBYTES];
+    uint8_t buf[NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES];
+
+    /* shake(secret PRF key || input ciphertext) */
+    for (i = 0; i < NTRU_PRFKEYBYTES; i++) {
+        buf[i] = prfkey[i];
+    }
+    for (i = 0; i < NTRU_CIPHERTEXTBYTES; i++) {
+        buf[NTRU_PRFKEYBYTES + i] = c[i];
+    }
+
+    /* Both hashes share one pass of a 2-way Keccak */
+    sha3_256_x2(k, k_rej, rm, NTRU_OWCPA_MSGBYTES, buf, NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES);
+
+    cmov(k, k_rej, NTRU_SHAREDKEYBYTES, (unsigned char)fail);
+}
+
 int crypto_kem_dec(uint8_t *k, const uint8_t *c, const uint8_t *sk) {
-    int i, fail;
+    int fail;
     uint8_t rm[NTRU_OWCPA_MSGBYTES];
-    uint8_t buf[NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES];
 
     fail = owcpa_dec(rm, c, sk);
     /* If fail = 0 then c = Enc(h, rm). There is no need to re-encapsulate. */
     /* See comment in owcpa_dec for details.                                */
 
-    sha3_256(k, rm, NTRU_OWCPA_MSGBYTES);
+    crypto_kem_dec_finish(k, c, sk + NTRU_OWCPA_SECRETKEYBYTES, rm, fail);
 
-    /* shake(secret PRF key || input ciphertext) */
+    return 0;
+}
+
+int crypto_kem_sk_expand(uint8_t *sk_expanded, const uint8_t *sk) {
+    int i;
+
+    owcpa_sk_expand((poly_expanded *)sk_expanded, sk);
+
+    /* The PRF key follows the expanded f, finv3 and invh */
     for (i = 0; i < NTRU_PRFKEYBYTES; i++) {
-        buf[i] = sk[i + NTRU_OWCPA_SECRETKEYBYTES];
+        sk_expanded[i + NTRU_SK_EXPANDED_PRFKEY] = sk[i + NTRU_OWCPA_SECRETKEYBYTES];
     }
-    for (i = 0; i < NTRU_CIPHERTEXTBYTES; i++) {
-        buf[NTRU_PRFKEYBYTES + i] = c[i];
-    }
-    sha3_256(rm, buf, NTRU_PRFKEYBYTES + NTRU_CIPHERTEXTBYTES);
 
-    cmov(k, rm, NTRU_SHAREDKEYBYTES, (unsigned char)fail);
+    return 0;
+}
+
+int crypto_kem_dec_expanded(uint8_t *k, const uint8_t *c, const uint8_t *sk_expanded) {
+    int fail;
+    uint8_t rm[NTRU_OWCPA_MSGBYTES];
+
+    fail = owcpa_dec_expanded(rm, c, (const poly_expanded *)sk_expanded);
+    /* If fail = 0 then c = Enc(h, rm). There is no need to re-encapsulate. */
+    /* See comment in owcpa_dec for details.                                */
+
+    crypto_kem_dec_finish(k, c, sk_expanded + NTRU_SK_EXPANDED_PRFKEY, rm, fail);
 
     return 0;
 }
@@ -1,5 +1,6 @@
 
 #include <arm_neon.h>
+#include <string.h>
 #include "poly.h"
 
 #include "tmvp.h"
@@ -62,6 +63,8 @@ void poly_S3_mul(poly *r, const poly *a, const poly *b) {
     poly_mod_3_Phi_n(r);
 }
 
+// Defined by dispatch/poly_rq_mul_dispatch.c in the dispatch libraries
+#ifndef POLY_RQ_MUL_DISPATCH
 void poly_Rq_mul(poly *r, poly *a, poly *b)
 {
     uint16_t coeffs_L[SIZE_L];
@@ -78,6 +81,29 @@ void poly_Rq_mul(poly *r, poly *a, poly *b)
     F_I(r->coeffs, coeffs_R);
 
 }
+#endif
+
+void poly_Rq_expand(poly_expanded *r, poly *b)
+{
+    // 701 - 703
+    b->coeffs[NTRU_N]=0;
+    b->coeffs[NTRU_N+1]=0;
+    b->coeffs[NTRU_N+2]=0;
+
+    F_R(r->coeffs, b->coeffs);
+}
+
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b)
+{
+    uint16_t coeffs_L[SIZE_L];
+    uint16_t coeffs_R[SIZE_R];
+
+    F_L(coeffs_L, a->coeffs);
+    // F_MUL overwrites its input vector
+    memcpy(coeffs_R, b->coeffs, sizeof(coeffs_R));
+    F_MUL(coeffs_R, coeffs_L);
+    F_I(r->coeffs, coeffs_R);
+}
 
 void poly_Sq_mul(poly *r, poly *a, poly *b)
 {
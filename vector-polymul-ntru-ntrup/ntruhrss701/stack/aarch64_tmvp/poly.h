@@ -12,6 +12,14 @@ typedef struct {
     uint16_t coeffs[POLY_N];
 } poly;
 
+// A multiplicand of poly_Rq_mul in the evaluated form of the multiplier
+// (the 9 tc5 parts of the TMVP input vector, 144 coefficients each)
+#define NTRU_N_EXPANDED 1296
+
+typedef struct {
+    uint16_t coeffs[NTRU_N_EXPANDED];
+} poly_expanded;
+
 #define poly_mod_3_Phi_n CRYPTO_NAMESPACE(poly_mod_3_Phi_n)
 #define poly_mod_q_Phi_n CRYPTO_NAMESPACE(poly_mod_q_Phi_n)
 void poly_mod_3_Phi_n(poly *r);
@@ -47,8 +55,25 @@ void poly_Rq_to_S3(poly *r, const poly *a);
 #define poly_Sq_mul CRYPTO_NAMESPACE(poly_Sq_mul)
 #define poly_Rq_mul CRYPTO_NAMESPACE(poly_Rq_mul)
 void poly_Rq_mul(poly *r, poly *a, poly *b);
+
+#ifdef POLY_RQ_MUL_DISPATCH
+// The engine poly_Rq_mul runs (see dispatch/poly_rq_mul_dispatch.c), the i-th engine linked in or NULL past the last
+// one, and a change of engine by name, which returns -1 if no such engine is linked in
+#define poly_Rq_mul_engine CRYPTO_NAMESPACE(poly_Rq_mul_engine)
+#define poly_Rq_mul_engine_name CRYPTO_NAMESPACE(poly_Rq_mul_engine_name)
+#define poly_Rq_mul_set_engine CRYPTO_NAMESPACE(poly_Rq_mul_set_engine)
+const char *poly_Rq_mul_engine(void);
+const char *poly_Rq_mul_engine_name(size_t i);
+int poly_Rq_mul_set_engine(const char *name);
+#endif
 void poly_Sq_mul(poly *r, poly *a, poly *b);
 
+// poly_Rq_mul(r, a, b) in two steps, so that the evaluation of a fixed b is done once
+#define poly_Rq_expand CRYPTO_NAMESPACE(poly_Rq_expand)
+#define poly_Rq_mul_expanded CRYPTO_NAMESPACE(poly_Rq_mul_expanded)
+void poly_Rq_expand(poly_expanded *r, poly *b);
+void poly_Rq_mul_expanded(poly *r, poly *a, const poly_expanded *b);
+
 #define poly_R2_inv CRYPTO_NAMESPACE(poly_R2_inv)
 #define poly_Rq_inv CRYPTO_NAMESPACE(poly_Rq_inv)
 #define poly_S3_inv CRYPTO_NAMESPACE(poly_S3_inv)
@@ -1,6 +1,8 @@
 
 #include "randombytes.h"
 
+#include <string.h>
+
 #ifdef BENCH_RAND
 #define ACC rand_cycles
 
@@ -40,6 +42,56 @@ randombytes_init(unsigned char *entropy_input,
   (void)security_strength;
 }
 
+void
+randombytes_ctx_init(randombytes_ctx_t *ctx,
+                     unsigned char *entropy_input,
+                     unsigned char *personalization_string,
+                     int security_strength)
+{
+  (void)ctx;
+  randombytes_init(entropy_input, personalization_string, security_strength);
+}
+
+int randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen)
+{
+  (void)ctx;
+  randombytes(x, xlen);
+  return 0;
+}
+
+static __thread unsigned char stream_buf[RANDOMBYTES_STREAM_MAX_BYTES];
+static __thread unsigned long long stream_len;
+
+int randombytes_stream_begin(randombytes_ctx_t *ctx, unsigned long long xlen)
+{
+  (void)ctx;
+  if (xlen > RANDOMBYTES_STREAM_MAX_BYTES) return -1;
+  randombytes(stream_buf, xlen);
+  stream_len = xlen;
+  return 0;
+}
+
+int randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset,
+                            unsigned long long len)
+{
+  (void)ctx;
+  if (offset > stream_len || len > stream_len - offset) return -1;
+  memcpy(out, stream_buf + offset, len);
+  return 0;
+}
+
+int randombytes_stream_end(randombytes_ctx_t *ctx)
+{
+  volatile unsigned char *v = stream_buf;
+  unsigned long long i;
+
+  (void)ctx;
+  /* the random bytes of the request would otherwise stay in the buffer until the next one */
+  for (i = 0; i < stream_len; i++) v[i] = 0;
+  stream_len = 0;
+  return 0;
+}
+
 #if defined(NORAND) || defined(BENCH) || defined(BENCH_RAND)
 
 #pragma message("using non-random randombytes!")
@@ -49,14 +101,15 @@ randombytes_init(unsigned char *entropy_input,
 
 #include "rng.h"
 
-unsigned char __attribute__((aligned (16)))keybytes[crypto_rng_KEYBYTES] = {
+// Modified in NTRU-sampling: thread-local, so that each thread has its own RNG state
+__thread unsigned char __attribute__((aligned (16)))keybytes[crypto_rng_KEYBYTES] = {
   0x49, 0x54, 0xcc, 0x49, 0xa4, 0x94, 0xba, 0x0,
   0x41, 0x76, 0x78, 0x17, 0x5f, 0xb9, 0xfb, 0x23,
   0x18, 0x91, 0x65, 0xb7, 0x90, 0xb4, 0x9f, 0x65,
   0x91, 0x6c, 0xe4, 0xc1, 0xde, 0xac, 0xf4, 0x6c
 };
-unsigned char __attribute__((aligned (16)))outbytes[crypto_rng_OUTPUTBYTES];
-unsigned long long pos = crypto_rng_OUTPUTBYTES;
+__thread unsigned char __attribute__((aligned (16)))outbytes[crypto_rng_OUTPUTBYTES];
+__thread unsigned long long pos = crypto_rng_OUTPUTBYTES;
 
 
 static void randombytes_internal(uint8_t *x, size_t xlen){
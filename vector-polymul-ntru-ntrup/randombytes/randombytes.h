@@ -6,13 +6,35 @@
 
 void randombytes(uint8_t *out, size_t outlen);
 
+// Added in NTRU-sampling for API compatibility with rng_opt/rng.h, with the same signatures, since the KEMs call these
+// functions through that header. This benchmark RNG has no caller-owned state: ctx is ignored and every context of a
+// thread shares the thread's state, as in randombytes_init/randombytes. randombytes_ctx always returns 0
+#ifndef RANDOMBYTES_CTX_T
+#define RANDOMBYTES_CTX_T
+typedef struct randombytes_ctx_s randombytes_ctx_t;
+#endif
+
+void randombytes_ctx_init(randombytes_ctx_t *ctx, unsigned char *entropy_input, unsigned char *personalization_string,
+                          int security_strength);
+int randombytes_ctx(randombytes_ctx_t *ctx, unsigned char *x, unsigned long long xlen);
+
+// Added in NTRU-sampling for API compatibility with rng_opt/rng.h. The ChaCha20 output cannot be generated at an
+// arbitrary offset, so randombytes_stream_begin draws the whole request into a thread-local buffer, which limits it to
+// RANDOMBYTES_STREAM_MAX_BYTES bytes
+#define RANDOMBYTES_STREAM_MAX_BYTES 4096
+
+int randombytes_stream_begin(randombytes_ctx_t *ctx, unsigned long long xlen);
+int randombytes_stream_read(randombytes_ctx_t *ctx, unsigned char *out, unsigned long long offset,
+                            unsigned long long len);
+int randombytes_stream_end(randombytes_ctx_t *ctx);
+
 #if defined(NORAND) || defined(BENCH) || defined(BENCH_RAND)
 
 #include "rng.h"
 
-extern unsigned char keybytes[crypto_rng_KEYBYTES];
-extern unsigned char outbytes[crypto_rng_OUTPUTBYTES];
-extern unsigned long long pos;
+extern __thread unsigned char keybytes[crypto_rng_KEYBYTES];
+extern __thread unsigned char outbytes[crypto_rng_OUTPUTBYTES];
+extern __thread unsigned long long pos;
 
 #endif
 
@@ -4,12 +4,7 @@
 #include <stdint.h>
 #include <stddef.h>
 
-// Modified in NTRU-sampling to match PQC_NEON
-#ifndef CRYPTO_NAMESPACE
-#define CRYPTO_NAMESPACE(s) s
-#endif
-
-#define crypto_sort_int32 CRYPTO_NAMESPACE(crypto_sort_int32)
+// Modified in NTRU-sampling: compiled once, in ntru_common, for all parameter sets, hence not namespaced
 
 void crypto_sort_int32(int32_t *, size_t);
 void crypto_sort_uint32(uint32_t *, size_t);